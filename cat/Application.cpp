@@ -5,6 +5,7 @@
 
 #include <iostream>
 #include "Application.h"
+#include "Benchmark.h"
 
 #include "anari_test_scenes.h"
 #include "anari_test_scenes/scenes/scene.h"
@@ -33,6 +34,7 @@
 // stb_image
 #include "stb_image_write.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
@@ -96,6 +98,15 @@ std::string padString(T value, char pad, std::size_t length)
   out << std::setfill(pad) << std::setw(length) << value;
   return out.str();
 }
+
+#if defined(USE_KOKKOS)
+void initializeKokkos(unsigned int numThreads)
+{
+  Kokkos::InitializationSettings kokkosSettings;
+  kokkosSettings.set_num_threads(static_cast<int>(numThreads));
+  Kokkos::initialize(kokkosSettings);
+}
+#endif
 } // namespace
 
 namespace anari_cat {
@@ -245,16 +256,127 @@ Application::Application(int argc, char *argv[])
   runCmd->add_option("-s,--scene", m_scene, "Scene name. Ex: <category:scene>")
       ->capture_default_str();
 
+  //
+  // [Subcommand: 'benchmark']
+  // The benchmark subcommand renders each scene non-interactively for a
+  // number of trials, summarizes the timed frames statistically and
+  // optionally compares them with an earlier summary. It exits non-zero on a
+  // significant slowdown.
+  //
+  auto *benchmarkCmd = m_impl->app->add_subcommand("benchmark")->callback(
+      [this] { onBenchmark(); });
+
+  benchmarkCmd->add_flag("-a,--animate", m_animate, "Play animation")
+      ->capture_default_str();
+  benchmarkCmd
+      ->add_flag(
+          "-o,--orthographic", m_orthographic, "Enable orthographic camera")
+      ->capture_default_str();
+  benchmarkCmd
+      ->add_option("--size", m_size, "Frame dimensions. Ex: --size 1920 1080")
+      ->expected(2) // width height
+      ->capture_default_str();
+  benchmarkCmd->add_option("-d,--device", m_device_id, "Device ID")
+      ->capture_default_str();
+  benchmarkCmd
+      ->add_option("-l,--library", m_library, "ANARI implementation name")
+      ->capture_default_str();
+  benchmarkCmd
+      ->add_option("-r,--renderer", m_renderer, "ANARI renderer subtype")
+      ->capture_default_str();
+  benchmarkCmd
+      ->add_option("-s,--scene",
+          m_scenes,
+          "Scene names, each benchmarked in turn. Ex: <category:scene>")
+      ->capture_default_str();
+
+  benchmarkCmd
+      ->add_option("--trials",
+          m_trials,
+          "Number of trials per scene. Each trial builds the scene again.")
+      ->check(CLI::PositiveNumber)
+      ->group("statistics")
+      ->capture_default_str();
+  benchmarkCmd
+      ->add_option("-w,--warmup",
+          m_warmup_frames,
+          "Untimed frames rendered at the start of each trial.")
+      ->group("statistics")
+      ->capture_default_str();
+  benchmarkCmd
+      ->add_option(
+          "-n,--num-frames", m_benchmark_frames, "Timed frames per trial.")
+      ->check(CLI::PositiveNumber)
+      ->group("statistics")
+      ->capture_default_str();
+  benchmarkCmd
+      ->add_option("-j,--json",
+          m_summary,
+          "Save the statistics and samples of every scene to a JSON file.")
+      ->group("statistics")
+      ->capture_default_str();
+  benchmarkCmd
+      ->add_option("-b,--baseline",
+          m_baseline,
+          "Compare with the JSON file of an earlier benchmark and exit with"
+          " an error on a significant slowdown.")
+      ->check(CLI::ExistingFile)
+      ->group("statistics");
+  benchmarkCmd
+      ->add_option("--slowdown",
+          m_slowdown,
+          "Median slowdown (fraction of the baseline) that counts as a"
+          " regression.")
+      ->check(CLI::NonNegativeNumber)
+      ->group("statistics")
+      ->capture_default_str();
+  benchmarkCmd
+      ->add_option("--alpha",
+          m_significance,
+          "Significance level of the Mann-Whitney U test against the"
+          " baseline.")
+      ->check(CLI::Range(0.0, 1.0))
+      ->group("statistics")
+      ->capture_default_str();
+
+  //
+  // Animation options, shared by 'run' and 'benchmark' so that both replay
+  // the same scene updates and camera poses on every run.
+  //
+  for (auto *cmd : {runCmd, benchmarkCmd}) {
+    cmd->add_option("--time-step",
+           m_time_step,
+           "Seconds each animation frame advances the scene. 0 follows the"
+           " wall clock.")
+        ->check(CLI::NonNegativeNumber)
+        ->group("animation")
+        ->capture_default_str();
+    cmd->add_option("--seed", m_seed, "Seed of random scene updates.")
+        ->group("animation")
+        ->capture_default_str();
+    cmd->add_option("--camera-path",
+           m_camera_path,
+           "Move the camera along a scripted path (without GUI).")
+        ->check(CLI::IsMember(anari::scenes::getAvailableCameraPaths()))
+        ->group("animation");
+    cmd->add_option(
+           "--path-frames", m_path_frames, "Frames per loop of the camera path.")
+        ->check(CLI::PositiveNumber)
+        ->group("animation")
+        ->capture_default_str();
+  }
+
 #if defined(USE_KOKKOS)
   //
   // Kokkos command line options.
   //
-  runCmd
-      ->add_option("--kokkos-num-threads",
-          m_impl->kokkosNumThreads,
-          "No. of threads for kokkos")
-      ->group("Kokkos")
-      ->capture_default_str();
+  for (auto *cmd : {runCmd, benchmarkCmd}) {
+    cmd->add_option("--kokkos-num-threads",
+           m_impl->kokkosNumThreads,
+           "No. of threads for kokkos")
+        ->group("Kokkos")
+        ->capture_default_str();
+  }
 #endif
 
   // take snapshot of commandline args for reuse in `exec`
@@ -333,6 +455,7 @@ anari_viewer::WindowArray Application::setupWindows()
       // Start scene construct timer.
       m_impl->metricsRecorder->StartTimer(anari_cat::TIME_SCENE_BUILD);
       auto s = anari::scenes::createScene(m_impl->device, category, scene);
+      this->configureAnimation(s);
       anari::scenes::commit(s);
       auto w = anari::scenes::getWorld(s);
       viewport->setWorld(w, true);
@@ -453,7 +576,7 @@ void Application::teardown()
 int Application::exec()
 {
   CLI11_PARSE((*m_impl->app), m_impl->argc, m_impl->argv);
-  return EXIT_SUCCESS;
+  return m_exit_code;
 }
 
 bool Application::getANARIDevices()
@@ -569,25 +692,10 @@ void Application::onRun()
     return;
   }
 
-  if (m_device_id >= m_impl->deviceNames.size()) {
-    std::cerr << "Invalid device ID!" << " ID must be within [0, "
-              << m_impl->deviceNames.size() << ")\n";
+  if (!this->createDevice()) {
     return;
   }
 
-  //
-  // Create device.
-  //
-  const char *deviceName = m_impl->deviceNames[m_device_id].c_str();
-  m_impl->device = anari::newDevice(m_impl->library, deviceName);
-
-#ifdef USE_GLES2
-  anari::setParameter(m_impl->device, m_impl->device, "glAPI", "OpenGL_ES");
-#else
-  anari::setParameter(m_impl->device, m_impl->device, "glAPI", "OpenGL");
-#endif
-  anari::commitParameters(m_impl->device, m_impl->device);
-
   m_impl->initRendererId = 0;
   m_impl->initCategoryId = 0;
   m_impl->initSceneId = 0;
@@ -640,9 +748,7 @@ void Application::onRun()
   // Required by some scenes which accelerate builds and frequent updates.
   //
 #if defined(USE_KOKKOS)
-  Kokkos::InitializationSettings kokkosSettings;
-  kokkosSettings.set_num_threads(static_cast<int>(m_impl->kokkosNumThreads));
-  Kokkos::initialize(kokkosSettings);
+  initializeKokkos(m_impl->kokkosNumThreads);
 #endif
 
   m_impl->csv.open(
@@ -704,6 +810,7 @@ void Application::onRun()
     m_impl->metricsRecorder->StartTimer(anari_cat::TIME_SCENE_BUILD);
     auto scene = anari::scenes::createScene(
         m_impl->device, initCategory.c_str(), initScene.c_str());
+    this->configureAnimation(scene);
     anari::scenes::commit(scene);
     auto world = anari::scenes::getWorld(scene);
     anari::commitParameters(m_impl->device, world);
@@ -711,35 +818,7 @@ void Application::onRun()
     //
     // Setup camera view frustum.
     //
-    anari::scenes::box3 bounds;
-    if (!anari::getProperty(
-            m_impl->device, world, "bounds", bounds, ANARI_WAIT)) {
-      std::cerr
-          << "WARNING: bounds not returned by the device! Using unit cube.\n";
-    }
-    m_impl->manipulator.setConfig(
-        /*at=*/0.5f * (bounds[0] + bounds[1]),
-        /*dist=*/1.25f * linalg::length(bounds[1] - bounds[0]),
-        /*azel=*/{0.f, 0.f});
-    anari::setParameter(
-        m_impl->device, camera, "direction", m_impl->manipulator.dir());
-    anari::setParameter(m_impl->device, camera, "up", m_impl->manipulator.up());
-    if (m_orthographic) {
-      anari::setParameter(m_impl->device,
-          camera,
-          "position",
-          m_impl->manipulator.eye_FixedDistance());
-      anari::setParameter(m_impl->device,
-          camera,
-          "height",
-          m_impl->manipulator.distance() * 0.75f);
-    } else {
-      anari::setParameter(
-          m_impl->device, camera, "position", m_impl->manipulator.eye());
-    }
-    anari::setParameter(
-        m_impl->device, camera, "aspect", m_size[0] / float(m_size[1]));
-    anari::commitParameters(m_impl->device, camera);
+    const auto bounds = this->setupCamera(world, camera);
     //
     // Setup frame
     //
@@ -763,12 +842,17 @@ void Application::onRun()
     timestampTimer.start();
     std::array<MetricStatistics, MetricType::COUNT> statistics = {};
     while (m_impl->frameTimeStamp < m_timespan) {
-      if (m_animate) {
+      if (m_animate || !m_camera_path.empty()) {
         //
         // Start scene update timer.
         //
         m_impl->metricsRecorder->StartTimer(anari_cat::TIME_SCENE_UPDATE);
-        anari::scenes::computeNextFrame(scene);
+        if (m_animate) {
+          anari::scenes::computeNextFrame(scene);
+        }
+        if (!m_camera_path.empty()) {
+          this->followCameraPath(camera, bounds, m_impl->framesRendered);
+        }
         //
         // Stop scene update timer.
         //
@@ -879,6 +963,299 @@ void Application::onRun()
   }
 }
 
+void Application::onBenchmark()
+{
+  m_exit_code = EXIT_FAILURE;
+
+  if (!this->getANARIRenderers()) {
+    return;
+  }
+
+  if (!this->getANARITestScenes()) {
+    return;
+  }
+
+  for (const auto &name : m_scenes) {
+    if (std::find(m_impl->sceneNames.begin(), m_impl->sceneNames.end(), name)
+        == m_impl->sceneNames.end()) {
+      std::cerr << "Scene " << name
+                << " is invalid. Please run the 'list scenes' subcommand.\n";
+      return;
+    }
+  }
+
+  BenchmarkReport baseline;
+  if (!m_baseline.empty() && !ReadBenchmarkJson(m_baseline, baseline)) {
+    std::cerr << "Failed to read benchmark baseline \"" << m_baseline
+              << "\"\n";
+    return;
+  }
+
+  if (!this->createDevice()) {
+    return;
+  }
+
+#if defined(USE_KOKKOS)
+  initializeKokkos(m_impl->kokkosNumThreads);
+#endif
+
+  BenchmarkReport report;
+  report.Library = m_library;
+  report.Device = m_impl->deviceNames[m_device_id];
+  report.Renderer = m_renderer;
+  report.Size = {m_size[0], m_size[1]};
+  report.Animate = m_animate;
+  report.TimeStep = m_time_step;
+  report.Seed = m_seed;
+  report.CameraPath = m_camera_path;
+  report.PathFrames = m_camera_path.empty() ? 0 : m_path_frames;
+  report.Trials = m_trials;
+  report.WarmupFrames = m_warmup_frames;
+  report.Frames = m_benchmark_frames;
+  report.Baseline = m_baseline;
+  if (!m_baseline.empty() && !SameWorkload(baseline, report)) {
+    std::cerr << "WARNING: the baseline rendered a different workload (frame"
+                 " size, animation, camera path or frame counts).\n";
+  }
+
+  const RegressionThresholds thresholds{m_slowdown, m_significance};
+
+  //
+  // Objects shared by every trial. Accumulation stays off so that each frame
+  // does the same amount of work.
+  //
+  auto frame = anari::newObject<anari::Frame>(m_impl->device);
+  auto renderer =
+      anari::newObject<anari::Renderer>(m_impl->device, m_renderer.c_str());
+  auto camera = anari::newObject<anari::Camera>(
+      m_impl->device, (m_orthographic ? "orthographic" : "perspective"));
+  anari::commitParameters(m_impl->device, renderer);
+  anari::setParameter(
+      m_impl->device, frame, "size", anari::math::uint2{m_size.data()});
+  anari::setParameter(
+      m_impl->device, frame, "channel.color", ANARI_UFIXED8_RGBA_SRGB);
+  anari::setParameter(m_impl->device, frame, "accumulation", false);
+  anari::setParameter(m_impl->device, frame, "camera", camera);
+  anari::setParameter(m_impl->device, frame, "renderer", renderer);
+
+  std::size_t regressions = 0;
+  for (const auto &name : m_scenes) {
+    const auto separator = name.find(':');
+    const auto category = name.substr(0, separator);
+    const auto sceneName = name.substr(separator + 1);
+
+    SceneBenchmark benchmark;
+    benchmark.Scene = name;
+    auto &samples = benchmark.Samples;
+
+    for (std::size_t trial = 1; trial <= m_trials; ++trial) {
+      std::cout << "\r" << name << ": trial " << trial << "/" << m_trials;
+      std::cout.flush();
+      const auto trialStart = BeginTrial(benchmark);
+      //
+      // Build the scene again for every trial so that each starts from the
+      // same state.
+      //
+      Timer buildTimer;
+      buildTimer.start();
+      auto scene = anari::scenes::createScene(
+          m_impl->device, category.c_str(), sceneName.c_str());
+      this->configureAnimation(scene);
+      anari::scenes::commit(scene);
+      auto world = anari::scenes::getWorld(scene);
+      anari::commitParameters(m_impl->device, world);
+      samples[TIME_SCENE_BUILD].push_back(buildTimer.millisecondsElapsed());
+
+      const auto bounds = this->setupCamera(world, camera);
+      anari::setParameter(m_impl->device, frame, "world", world);
+      anari::commitParameters(m_impl->device, frame);
+
+      bool deviceReportsDuration = true;
+      for (std::size_t i = 0; i < m_warmup_frames + m_benchmark_frames; ++i) {
+        const bool timed = i >= m_warmup_frames;
+        Timer frameTimer;
+        frameTimer.start();
+        if (m_animate || !m_camera_path.empty()) {
+          Timer updateTimer;
+          updateTimer.start();
+          if (m_animate) {
+            anari::scenes::computeNextFrame(scene);
+          }
+          if (!m_camera_path.empty()) {
+            this->followCameraPath(camera, bounds, i);
+          }
+          if (timed) {
+            samples[TIME_SCENE_UPDATE].push_back(
+                updateTimer.millisecondsElapsed());
+          }
+        }
+        anari::render(m_impl->device, frame);
+        anari::wait(m_impl->device, frame);
+        const float appMs = frameTimer.millisecondsElapsed();
+
+        float duration = 0.f;
+        deviceReportsDuration = deviceReportsDuration
+            && anari::getProperty(m_impl->device, frame, "duration", duration);
+        if (timed) {
+          samples[LATENCY_APPLICATION].push_back(appMs);
+          if (deviceReportsDuration) {
+            samples[LATENCY_ANARI_DEVICE].push_back(duration * 1000.0);
+          }
+        }
+      }
+      // A device that does not report every duration is not compared on it.
+      if (!deviceReportsDuration) {
+        samples[LATENCY_ANARI_DEVICE].clear();
+        benchmark.TrialMedians[LATENCY_ANARI_DEVICE].clear();
+      }
+      EndTrial(benchmark, trialStart);
+
+      anari::unsetParameter(m_impl->device, frame, "world");
+      anari::commitParameters(m_impl->device, frame);
+      anari::scenes::release(scene);
+    }
+    std::cout << '\n';
+
+    const auto match = std::find_if(baseline.Scenes.begin(),
+        baseline.Scenes.end(),
+        [&](const SceneBenchmark &b) { return b.Scene == name; });
+    if (match != baseline.Scenes.end()) {
+      benchmark.Comparisons = CompareBenchmarks(*match, benchmark, thresholds);
+    } else if (!m_baseline.empty()) {
+      std::cerr << "WARNING: scene " << name << " is not in the baseline.\n";
+    }
+
+    //
+    // Print this scene's summary.
+    //
+    std::cout << "\n" << name << " (" << m_trials << " trials x "
+              << m_benchmark_frames << " frames)\n";
+    for (const MetricType type : BenchmarkMetrics) {
+      if (samples[type].empty()) {
+        continue;
+      }
+      const auto stats = ComputeSampleStatistics(samples[type]);
+      const auto *units = GetUnits(type);
+      std::cout << GetLabel(type) << "\n\tMedian\t"
+                << toStringWithPrecision(stats.Median, 2) << units << " ["
+                << toStringWithPrecision(stats.MedianLow, 2) << ", "
+                << toStringWithPrecision(stats.MedianHigh, 2) << "] 95% CI"
+                << "\n\tp95\t" << toStringWithPrecision(stats.P95, 2) << units
+                << "\n\tp99\t" << toStringWithPrecision(stats.P99, 2) << units
+                << "\n\tOutliers\t" << stats.Outliers << '/' << stats.Count
+                << '\n';
+    }
+    for (const auto &c : benchmark.Comparisons) {
+      const double change = c.BaselineMedian > 0.0
+          ? (c.Median / c.BaselineMedian - 1.0) * 100.0
+          : 0.0;
+      std::cout << (c.Regressed ? "SLOWER" : "ok") << '\t' << GetLabel(c.Type)
+                << ' ' << toStringWithPrecision(c.BaselineMedian, 2) << " -> "
+                << toStringWithPrecision(c.Median, 2) << GetUnits(c.Type)
+                << " (" << (change >= 0.0 ? "+" : "")
+                << toStringWithPrecision(change, 1) << "%, p="
+                << c.PValue << ")\n";
+      regressions += c.Regressed ? 1 : 0;
+    }
+    report.Scenes.push_back(std::move(benchmark));
+  }
+
+  anari::release(m_impl->device, camera);
+  anari::release(m_impl->device, renderer);
+  anari::release(m_impl->device, frame);
+  anari::release(m_impl->device, m_impl->device);
+  m_impl->device = nullptr;
+
+  if (!WriteBenchmarkJson(m_summary, report)) {
+    std::cerr << "Failed to write benchmark summary \"" << m_summary << "\"\n";
+    return;
+  }
+  std::cout << "\nSaved benchmark summary to "
+            << std::filesystem::absolute(m_summary) << '\n';
+
+  if (regressions > 0) {
+    std::cout << regressions << " significant slowdown(s) against "
+              << m_baseline << '\n';
+    return;
+  }
+  m_exit_code = EXIT_SUCCESS;
+}
+
+bool Application::createDevice()
+{
+  if (m_device_id >= m_impl->deviceNames.size()) {
+    std::cerr << "Invalid device ID!" << " ID must be within [0, "
+              << m_impl->deviceNames.size() << ")\n";
+    return false;
+  }
+
+  const char *deviceName = m_impl->deviceNames[m_device_id].c_str();
+  m_impl->device = anari::newDevice(m_impl->library, deviceName);
+
+#ifdef USE_GLES2
+  anari::setParameter(m_impl->device, m_impl->device, "glAPI", "OpenGL_ES");
+#else
+  anari::setParameter(m_impl->device, m_impl->device, "glAPI", "OpenGL");
+#endif
+  anari::commitParameters(m_impl->device, m_impl->device);
+  return true;
+}
+
+void Application::configureAnimation(anari::scenes::SceneHandle scene)
+{
+  anari::scenes::setParameter(scene, "animationTimeStep", m_time_step);
+  anari::scenes::setParameter(scene, "animationSeed", m_seed);
+}
+
+anari::scenes::Bounds Application::setupCamera(
+    anari::World world, anari::Camera camera)
+{
+  anari::scenes::box3 bounds;
+  if (!anari::getProperty(
+          m_impl->device, world, "bounds", bounds, ANARI_WAIT)) {
+    std::cerr
+        << "WARNING: bounds not returned by the device! Using unit cube.\n";
+  }
+  m_impl->manipulator.setConfig(
+      /*at=*/0.5f * (bounds[0] + bounds[1]),
+      /*dist=*/1.25f * linalg::length(bounds[1] - bounds[0]),
+      /*azel=*/{0.f, 0.f});
+  anari::setParameter(
+      m_impl->device, camera, "direction", m_impl->manipulator.dir());
+  anari::setParameter(m_impl->device, camera, "up", m_impl->manipulator.up());
+  if (m_orthographic) {
+    anari::setParameter(m_impl->device,
+        camera,
+        "position",
+        m_impl->manipulator.eye_FixedDistance());
+    anari::setParameter(m_impl->device,
+        camera,
+        "height",
+        m_impl->manipulator.distance() * 0.75f);
+  } else {
+    anari::setParameter(
+        m_impl->device, camera, "position", m_impl->manipulator.eye());
+  }
+  anari::setParameter(
+      m_impl->device, camera, "aspect", m_size[0] / float(m_size[1]));
+  anari::commitParameters(m_impl->device, camera);
+  return bounds;
+}
+
+void Application::followCameraPath(anari::Camera camera,
+    const anari::scenes::Bounds &bounds,
+    std::size_t frame)
+{
+  const float phase =
+      static_cast<float>(frame % m_path_frames) / float(m_path_frames);
+  const auto pose =
+      anari::scenes::getCameraPathPose(bounds, m_camera_path, phase);
+  anari::setParameter(m_impl->device, camera, "position", pose.position);
+  anari::setParameter(m_impl->device, camera, "direction", pose.direction);
+  anari::setParameter(m_impl->device, camera, "up", pose.up);
+  anari::commitParameters(m_impl->device, camera);
+}
+
 void Application::logMetrics(const ScrollingBuffer::ElementT &metricData)
 {
   if (m_gui) {
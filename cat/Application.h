@@ -4,6 +4,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -11,6 +12,8 @@
 #include "anari_viewer/Application.h"
 #include "anari_viewer/windows/Viewport.h"
 
+#include "anari_test_scenes.h"
+
 #include "PerformanceMetrics.h"
 
 namespace anari_cat {
@@ -46,6 +49,23 @@ class Application : anari_viewer::Application
   std::string m_scene = "perf:particles";
   std::vector<unsigned int> m_size = {1920, 1080};
 
+  // animation
+  float m_time_step = 1.f / 60.f;
+  std::size_t m_path_frames = 120;
+  std::string m_camera_path;
+  std::uint32_t m_seed = 0;
+
+  // benchmark
+  double m_significance = 0.05;
+  double m_slowdown = 0.05;
+  int m_exit_code = 0;
+  std::size_t m_benchmark_frames = 100;
+  std::size_t m_trials = 5;
+  std::size_t m_warmup_frames = 10;
+  std::string m_baseline;
+  std::string m_summary = "benchmark.json";
+  std::vector<std::string> m_scenes = {"perf:particles"};
+
   struct Impl;
   std::unique_ptr<Impl> m_impl;
 
@@ -62,6 +82,14 @@ class Application : anari_viewer::Application
 
   void onList(ListItemType type);
   void onRun();
+  void onBenchmark();
+
+  bool createDevice();
+  void configureAnimation(anari::scenes::SceneHandle scene);
+  anari::scenes::Bounds setupCamera(anari::World world, anari::Camera camera);
+  void followCameraPath(anari::Camera camera,
+      const anari::scenes::Bounds &bounds,
+      std::size_t frame);
 
   void logMetrics(const ScrollingBuffer::ElementT &metricData);
   void logProgress();
@@ -0,0 +1,250 @@
+// Copyright 2023-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Benchmark.h"
+
+// anari_test_scenes
+#include "scenes/Statistics.h"
+// json
+#include "scenes/file/nlohmann/json.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <utility>
+
+namespace anari_cat {
+
+using anari::scenes::mannWhitneyGreater;
+using anari::scenes::sortedPercentile;
+
+namespace {
+
+int FindMetric(const std::string &identifier)
+{
+  for (int type = 0; type < MetricType::COUNT; ++type) {
+    if (identifier == GetIdentifier(type))
+      return type;
+  }
+  return -1;
+}
+
+void ReadNumbers(const nlohmann::json &object,
+    const char *key,
+    std::vector<double> &values)
+{
+  if (!object.contains(key))
+    return;
+  for (const auto &v : object[key]) {
+    if (v.is_number())
+      values.push_back(v.get<double>());
+  }
+}
+
+} // namespace
+
+SampleStatistics ComputeSampleStatistics(std::vector<double> samples)
+{
+  SampleStatistics s;
+  s.Count = samples.size();
+  if (samples.empty())
+    return s;
+  std::sort(samples.begin(), samples.end());
+  const double n = static_cast<double>(samples.size());
+
+  s.Mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+  s.Median = sortedPercentile(samples, 50.0);
+  s.P5 = sortedPercentile(samples, 5.0);
+  s.P95 = sortedPercentile(samples, 95.0);
+  s.P99 = sortedPercentile(samples, 99.0);
+  s.Minimum = samples.front();
+  s.Maximum = samples.back();
+
+  // The 1-based ranks n/2 -/+ 1.96 sqrt(n)/2 bracket the median with ~95%
+  // confidence (normal approximation to the binomial).
+  const double halfWidth = 1.96 * std::sqrt(n) / 2.0;
+  const auto lo = static_cast<std::size_t>(
+      std::clamp(std::floor(n / 2.0 - halfWidth), 1.0, n));
+  const auto hi = static_cast<std::size_t>(
+      std::clamp(std::ceil(n / 2.0 + 1.0 + halfWidth), 1.0, n));
+  s.MedianLow = samples[lo - 1];
+  s.MedianHigh = samples[hi - 1];
+
+  const double q1 = sortedPercentile(samples, 25.0);
+  const double q3 = sortedPercentile(samples, 75.0);
+  const double fence = 1.5 * (q3 - q1);
+  s.Outliers = std::count_if(samples.begin(), samples.end(), [&](double v) {
+    return v < q1 - fence || v > q3 + fence;
+  });
+  return s;
+}
+
+TrialStart BeginTrial(const SceneBenchmark &benchmark)
+{
+  TrialStart start = {};
+  for (int type = 0; type < MetricType::COUNT; ++type)
+    start[type] = benchmark.Samples[type].size();
+  return start;
+}
+
+void EndTrial(SceneBenchmark &benchmark, const TrialStart &start)
+{
+  for (int type = 0; type < MetricType::COUNT; ++type) {
+    const auto &samples = benchmark.Samples[type];
+    if (samples.size() <= start[type])
+      continue;
+    std::vector<double> trial(samples.begin() + start[type], samples.end());
+    std::sort(trial.begin(), trial.end());
+    benchmark.TrialMedians[type].push_back(sortedPercentile(trial, 50.0));
+  }
+}
+
+std::vector<MetricComparison> CompareBenchmarks(const SceneBenchmark &baseline,
+    const SceneBenchmark &candidate,
+    const RegressionThresholds &thresholds)
+{
+  std::vector<MetricComparison> comparisons;
+  for (const MetricType type : BenchmarkMetrics) {
+    const auto &before = baseline.TrialMedians[type];
+    const auto &after = candidate.TrialMedians[type];
+    if (before.empty() || after.empty())
+      continue;
+    MetricComparison c;
+    c.Type = type;
+    c.BaselineMedian = ComputeSampleStatistics(before).Median;
+    c.Median = ComputeSampleStatistics(after).Median;
+    c.PValue = mannWhitneyGreater(before, after);
+    c.Regressed = c.PValue < thresholds.Significance
+        && c.Median > c.BaselineMedian * (1.0 + thresholds.Slowdown);
+    comparisons.push_back(c);
+  }
+  return comparisons;
+}
+
+bool WriteBenchmarkJson(const std::string &path, const BenchmarkReport &report)
+{
+  using nlohmann::json;
+  json scenes = json::object();
+  for (const auto &scene : report.Scenes) {
+    json metrics = json::object();
+    for (const MetricType type : BenchmarkMetrics) {
+      const auto &samples = scene.Samples[type];
+      if (samples.empty())
+        continue;
+      const auto s = ComputeSampleStatistics(samples);
+      metrics[GetIdentifier(type)] = {
+          {"units", GetUnits(type)},
+          {"count", s.Count},
+          {"mean", s.Mean},
+          {"median", s.Median},
+          {"median_ci95", {s.MedianLow, s.MedianHigh}},
+          {"p5", s.P5},
+          {"p95", s.P95},
+          {"p99", s.P99},
+          {"min", s.Minimum},
+          {"max", s.Maximum},
+          {"outliers", s.Outliers},
+          {"samples", samples},
+          {"trial_medians", scene.TrialMedians[type]},
+      };
+    }
+    json entry = {{"metrics", metrics}};
+    if (!scene.Comparisons.empty()) {
+      json comparisons = json::object();
+      for (const auto &c : scene.Comparisons) {
+        comparisons[GetIdentifier(c.Type)] = {
+            {"baseline_median", c.BaselineMedian},
+            {"median", c.Median},
+            {"change", c.BaselineMedian > 0.0
+                    ? c.Median / c.BaselineMedian - 1.0
+                    : 0.0},
+            // NaN (too few samples to test) is written as null
+            {"p_value", c.PValue},
+            {"regressed", c.Regressed},
+        };
+      }
+      entry["comparison"] = comparisons;
+    }
+    scenes[scene.Scene] = entry;
+  }
+
+  json out = {
+      {"version", 2},
+      {"library", report.Library},
+      {"device", report.Device},
+      {"renderer", report.Renderer},
+      {"size", report.Size},
+      {"animate", report.Animate},
+      {"time_step", report.TimeStep},
+      {"seed", report.Seed},
+      {"camera_path", report.CameraPath},
+      {"path_frames", report.PathFrames},
+      {"trials", report.Trials},
+      {"warmup_frames", report.WarmupFrames},
+      {"frames", report.Frames},
+      {"scenes", scenes},
+  };
+  if (!report.Baseline.empty())
+    out["baseline"] = report.Baseline;
+
+  std::ofstream file(path, std::ios::out | std::ios::trunc);
+  if (!file)
+    return false;
+  file << out.dump(2) << '\n';
+  return bool(file);
+}
+
+bool ReadBenchmarkJson(const std::string &path, BenchmarkReport &report)
+{
+  using nlohmann::json;
+  std::ifstream file(path);
+  if (!file)
+    return false;
+  const json in = json::parse(file, nullptr, /*allow_exceptions=*/false);
+  if (!in.is_object() || !in.contains("scenes"))
+    return false;
+
+  report = BenchmarkReport{};
+  report.Library = in.value("library", "");
+  report.Device = in.value("device", "");
+  report.Renderer = in.value("renderer", "");
+  report.Animate = in.value("animate", false);
+  report.TimeStep = in.value("time_step", 0.f);
+  report.Seed = in.value("seed", std::uint32_t(0));
+  report.CameraPath = in.value("camera_path", "");
+  report.PathFrames = in.value("path_frames", std::size_t(0));
+  report.Trials = in.value("trials", std::size_t(0));
+  report.WarmupFrames = in.value("warmup_frames", std::size_t(0));
+  report.Frames = in.value("frames", std::size_t(0));
+  if (in.contains("size") && in["size"].is_array() && in["size"].size() == 2)
+    report.Size = {in["size"][0].get<unsigned int>(),
+        in["size"][1].get<unsigned int>()};
+
+  for (const auto &[name, entry] : in["scenes"].items()) {
+    SceneBenchmark scene;
+    scene.Scene = name;
+    if (entry.contains("metrics")) {
+      for (const auto &[id, metric] : entry["metrics"].items()) {
+        const int type = FindMetric(id);
+        if (type < 0)
+          continue;
+        ReadNumbers(metric, "samples", scene.Samples[type]);
+        // Missing from version 1 files, whose metrics are not compared with
+        ReadNumbers(metric, "trial_medians", scene.TrialMedians[type]);
+      }
+    }
+    report.Scenes.push_back(std::move(scene));
+  }
+  return true;
+}
+
+bool SameWorkload(const BenchmarkReport &a, const BenchmarkReport &b)
+{
+  return a.Size == b.Size && a.Animate == b.Animate && a.TimeStep == b.TimeStep
+      && a.Seed == b.Seed && a.CameraPath == b.CameraPath
+      && a.PathFrames == b.PathFrames && a.WarmupFrames == b.WarmupFrames
+      && a.Frames == b.Frames;
+}
+
+} // namespace anari_cat
@@ -0,0 +1,119 @@
+// Copyright 2023-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "MetricType.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace anari_cat {
+
+// The metrics a headless benchmark records. LATENCY_APPLICATION is the wall
+// time of one frame (scene update, render and wait) and TIME_SCENE_BUILD is
+// sampled once per trial.
+constexpr std::array<MetricType, 4> BenchmarkMetrics = {
+    LATENCY_ANARI_DEVICE,
+    LATENCY_APPLICATION,
+    TIME_SCENE_UPDATE,
+    TIME_SCENE_BUILD,
+};
+
+// Order statistics of one metric's samples.
+struct SampleStatistics
+{
+  std::size_t Count = 0;
+  double Mean = 0;
+  double Median = 0;
+  double P5 = 0;
+  double P95 = 0;
+  double P99 = 0;
+  double Minimum = 0;
+  double Maximum = 0;
+  // Distribution-free 95% confidence interval of the median, from the order
+  // statistics whose ranks bracket it.
+  double MedianLow = 0;
+  double MedianHigh = 0;
+  // Samples outside Tukey's fences (1.5 IQR beyond the quartiles). They are
+  // counted, not dropped: the percentiles above are already robust to them.
+  std::size_t Outliers = 0;
+};
+
+SampleStatistics ComputeSampleStatistics(std::vector<double> samples);
+
+// A slowdown counts when the candidate's trial medians are significantly
+// larger and their median grew by more than `Slowdown` (a fraction of the
+// baseline's).
+struct RegressionThresholds
+{
+  double Slowdown = 0.05;
+  double Significance = 0.05;
+};
+
+struct MetricComparison
+{
+  MetricType Type = LATENCY_ANARI_DEVICE;
+  // Medians of the trial medians
+  double BaselineMedian = 0;
+  double Median = 0;
+  double PValue = 0;
+  bool Regressed = false;
+};
+
+// All samples collected for one scene, over every trial, per metric, and the
+// median of each trial. Frames of one trial share its scene build and warmup
+// and are not independent, so comparisons treat the trial as the unit.
+struct SceneBenchmark
+{
+  std::string Scene;
+  std::array<std::vector<double>, MetricType::COUNT> Samples = {};
+  std::array<std::vector<double>, MetricType::COUNT> TrialMedians = {};
+  // Filled when the run is compared with a baseline holding the same scene.
+  std::vector<MetricComparison> Comparisons;
+};
+
+// Sample counts per metric, taken when a trial starts.
+using TrialStart = std::array<std::size_t, MetricType::COUNT>;
+TrialStart BeginTrial(const SceneBenchmark &benchmark);
+// Append the median of the samples each metric collected since `start`.
+void EndTrial(SceneBenchmark &benchmark, const TrialStart &start);
+
+// Compare the metrics both benchmarks have trial medians of.
+std::vector<MetricComparison> CompareBenchmarks(const SceneBenchmark &baseline,
+    const SceneBenchmark &candidate,
+    const RegressionThresholds &thresholds);
+
+struct BenchmarkReport
+{
+  std::string Library;
+  std::string Device;
+  std::string Renderer;
+  std::array<unsigned int, 2> Size = {};
+  bool Animate = false;
+  // The animation clock and camera path that fix each frame's workload
+  float TimeStep = 0;
+  std::uint32_t Seed = 0;
+  std::string CameraPath;
+  std::size_t PathFrames = 0;
+  std::size_t Trials = 0;
+  std::size_t WarmupFrames = 0;
+  std::size_t Frames = 0;
+  std::string Baseline;
+  std::vector<SceneBenchmark> Scenes;
+};
+
+// The JSON summary holds the run's settings and, per scene and metric, the
+// statistics, the raw samples and trial medians (so the file can serve as a
+// later baseline) and any baseline comparison.
+bool WriteBenchmarkJson(const std::string &path, const BenchmarkReport &report);
+bool ReadBenchmarkJson(const std::string &path, BenchmarkReport &report);
+
+// Whether two benchmarks replayed the same workload: the same frame size,
+// animation clock, camera path and frame counts.
+bool SameWorkload(const BenchmarkReport &a, const BenchmarkReport &b);
+
+} // namespace anari_cat
@@ -0,0 +1,132 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+namespace anari_cat {
+
+// The metrics anariCat records. Kept apart from the GUI side of
+// PerformanceMetrics.h so the headless benchmark code builds without ImGui.
+
+enum MetricType : int
+{
+  // The timestamp (in seconds) of collected data.
+  TIMESTAMP,
+  // This corresponds to the duration property on ANARIFrame
+  LATENCY_ANARI_DEVICE,
+  // Counts how many times the event loop requested anari for a frame but the
+  // frame was not yet ready.
+  DROPPED_FRAMES,
+  // Total time it takes from the moment ANARIFrame is ready to presentation.
+  LATENCY_PRESENTATION,
+  // This corresponds to the perceived latency in an interactive application.
+  // Includes all internal computations, scene updates, rendering tasks and OS
+  // event polling.
+  LATENCY_APPLICATION,
+  // Complete user interface rendering.
+  LATENCY_UI,
+  // Time taken to update a parameter, and commit the scene.
+  TIME_SCENE_UPDATE,
+  // Time taken to construct a scene.
+  TIME_SCENE_BUILD,
+  COUNT
+};
+
+// Defines the variation of a MetricType over time.
+enum TimeVarianceType : int
+{
+  INVARIANT,
+  VARIANT
+};
+
+inline TimeVarianceType GetTimeVariance(int metricType)
+{
+  switch (metricType) {
+  case MetricType::TIMESTAMP:
+  case MetricType::LATENCY_ANARI_DEVICE:
+  case MetricType::DROPPED_FRAMES:
+  case MetricType::LATENCY_PRESENTATION:
+  case MetricType::LATENCY_APPLICATION:
+  case MetricType::LATENCY_UI:
+  case MetricType::TIME_SCENE_UPDATE:
+    return VARIANT;
+  case MetricType::TIME_SCENE_BUILD:
+  default:
+    return INVARIANT;
+  }
+}
+
+inline const char *GetLabel(int metricType)
+{
+  switch (metricType) {
+  case MetricType::TIMESTAMP:
+    return "Timestamp";
+  case MetricType::LATENCY_ANARI_DEVICE:
+    return "Device";
+  case MetricType::DROPPED_FRAMES:
+    return "Dropped";
+  case MetricType::LATENCY_PRESENTATION:
+    return "Present";
+  case MetricType::LATENCY_APPLICATION:
+    return "App";
+  case MetricType::LATENCY_UI:
+    return "UI";
+  case MetricType::TIME_SCENE_UPDATE:
+    return "Scene update";
+  case MetricType::TIME_SCENE_BUILD:
+    return "Scene build";
+  default:
+    return nullptr;
+  }
+}
+
+// Stable, machine-readable name of a metric (e.g. JSON keys).
+inline const char *GetIdentifier(int metricType)
+{
+  switch (metricType) {
+  case MetricType::TIMESTAMP:
+    return "timestamp";
+  case MetricType::LATENCY_ANARI_DEVICE:
+    return "device";
+  case MetricType::DROPPED_FRAMES:
+    return "dropped";
+  case MetricType::LATENCY_PRESENTATION:
+    return "present";
+  case MetricType::LATENCY_APPLICATION:
+    return "app";
+  case MetricType::LATENCY_UI:
+    return "ui";
+  case MetricType::TIME_SCENE_UPDATE:
+    return "scene_update";
+  case MetricType::TIME_SCENE_BUILD:
+    return "scene_build";
+  default:
+    return nullptr;
+  }
+}
+
+inline const char *GetUnits(int metricType)
+{
+  switch (metricType) {
+  case MetricType::TIMESTAMP:
+    return "s";
+  case MetricType::LATENCY_ANARI_DEVICE:
+    return "ms";
+  case MetricType::DROPPED_FRAMES:
+    return "frames";
+  case MetricType::LATENCY_PRESENTATION:
+    return "ms";
+  case MetricType::LATENCY_APPLICATION:
+    return "ms";
+  case MetricType::LATENCY_UI:
+    return "ms";
+  case MetricType::TIME_SCENE_UPDATE:
+    return "ms";
+  case MetricType::TIME_SCENE_BUILD:
+    return "ms";
+  default:
+    return nullptr;
+  }
+}
+
+} // namespace anari_cat
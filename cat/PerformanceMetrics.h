@@ -1,6 +1,7 @@
 // Copyright 2021-2026 The Khronos Group
 // SPDX-License-Identifier: Apache-2.0
 
+#include "MetricType.h"
 #include "Timer.h"
 
 #include <imgui.h> // for ImVector
@@ -12,102 +13,6 @@
 
 namespace anari_cat {
 
-enum MetricType : int
-{
-  // The timestamp (in seconds) of collected data.
-  TIMESTAMP,
-  // This corresponds to the duration property on ANARIFrame
-  LATENCY_ANARI_DEVICE,
-  // Counts how many times the event loop requested anari for a frame but the
-  // frame was not yet ready.
-  DROPPED_FRAMES,
-  // Total time it takes from the moment ANARIFrame is ready to presentation.
-  LATENCY_PRESENTATION,
-  // This corresponds to the perceived latency in an interactive application.
-  // Includes all internal computations, scene updates, rendering tasks and OS
-  // event polling.
-  LATENCY_APPLICATION,
-  // Complete user interface rendering.
-  LATENCY_UI,
-  // Time taken to update a parameter, and commit the scene.
-  TIME_SCENE_UPDATE,
-  // Time taken to construct a scene.
-  TIME_SCENE_BUILD,
-  COUNT
-};
-
-// Defines the variation of a MetricType over time.
-enum TimeVarianceType : int
-{
-  INVARIANT,
-  VARIANT
-};
-
-inline TimeVarianceType GetTimeVariance(int metricType)
-{
-  switch (metricType) {
-  case MetricType::TIMESTAMP:
-  case MetricType::LATENCY_ANARI_DEVICE:
-  case MetricType::DROPPED_FRAMES:
-  case MetricType::LATENCY_PRESENTATION:
-  case MetricType::LATENCY_APPLICATION:
-  case MetricType::LATENCY_UI:
-  case MetricType::TIME_SCENE_UPDATE:
-    return VARIANT;
-  case MetricType::TIME_SCENE_BUILD:
-  default:
-    return INVARIANT;
-  }
-}
-
-inline const char *GetLabel(int metricType)
-{
-  switch (metricType) {
-  case MetricType::TIMESTAMP:
-    return "Timestamp";
-  case MetricType::LATENCY_ANARI_DEVICE:
-    return "Device";
-  case MetricType::DROPPED_FRAMES:
-    return "Dropped";
-  case MetricType::LATENCY_PRESENTATION:
-    return "Present";
-  case MetricType::LATENCY_APPLICATION:
-    return "App";
-  case MetricType::LATENCY_UI:
-    return "UI";
-  case MetricType::TIME_SCENE_UPDATE:
-    return "Scene update";
-  case MetricType::TIME_SCENE_BUILD:
-    return "Scene build";
-  default:
-    return nullptr;
-  }
-}
-
-inline const char *GetUnits(int metricType)
-{
-  switch (metricType) {
-  case MetricType::TIMESTAMP:
-    return "s";
-  case MetricType::LATENCY_ANARI_DEVICE:
-    return "ms";
-  case MetricType::DROPPED_FRAMES:
-    return "frames";
-  case MetricType::LATENCY_PRESENTATION:
-    return "ms";
-  case MetricType::LATENCY_APPLICATION:
-    return "ms";
-  case MetricType::LATENCY_UI:
-    return "ms";
-  case MetricType::TIME_SCENE_UPDATE:
-    return "ms";
-  case MetricType::TIME_SCENE_BUILD:
-    return "ms";
-  default:
-    return nullptr;
-  }
-}
-
 struct MetricStatistics
 {
   float Mean = 0;
@@ -28,7 +28,7 @@ SCHEMA_VERSION = 2
 
 # Metrics shown in the PDF, in display order. The C++ reporters keep their own
 # copy (kReportMetrics); both are independent readers of the one contract.
-METRICS = ["ssim", "psnr"]
+METRICS = ["ssim", "psnr", "match"]
 
 
 # --- Sidecar loading ---------------------------------------------------------
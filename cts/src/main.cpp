@@ -8,10 +8,12 @@
 #include "cts/BuiltinTests.h"
 #include "cts/Catalog.h"
 #include "cts/Expansion.h"
+#include "cts/Fingerprint.h"
 #include "cts/HtmlReport.h"
 #include "cts/RendererParams.h"
 #include "cts/Report.h"
 #include "cts/Runner.h"
+#include "cts/Scaling.h"
 #include "cts/Workdir.h"
 // anari
 #include "anari/anari_cpp.hpp"
@@ -19,9 +21,9 @@
 // nlohmann json (vendored with the glTF loader)
 #include "scenes/file/nlohmann/json.hpp"
 // std
+#include <algorithm>
 #include <cmath>
 #include <cstring>
-#include <fstream>
 #include <iostream>
 #include <limits>
 #include <set>
@@ -29,6 +31,13 @@
 #include <string>
 #include <vector>
 
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
 using namespace anari::cts;
 
 namespace {
@@ -75,11 +84,31 @@ struct Options
   // value is the user-facing default; <=1 disables it.
   uint32_t accumulationFrames = 16;
   bool denoise = false;
+  // generate/run: device instances rendering concurrently, and the threads
+  // scoring and writing their output (0: one per hardware thread).
+  uint32_t jobs = 1;
+  uint32_t publishThreads = 0;
+  // run: keep results whose inputs are unchanged, except those made by the
+  // listed device builds.
+  bool incremental = false;
+  std::set<std::string> changedSince;
+  // run: time each Case (warm-up and timed frames), optionally against the
+  // timings of a baseline workdir.
+  bool perf = false;
+  uint32_t warmupFrames = 3;
+  uint32_t timedFrames = 10;
+  std::string baseline;
+  TimingThresholds perfThresholds;
+  // run: measure the scaling Tests only, reading device memory use from this
+  // device property when named.
+  bool scaling = false;
+  std::string memoryProperty;
   // report: itemize every case, write an HTML file, and embed images in it.
   // The positional arg holds the workdir.
   bool includeAll = false;
   bool embed = false;
   std::string htmlOut;
+  std::string csvOut; // report: the scaling measurements as one CSV
   std::vector<std::string> positionals;
 };
 
@@ -117,6 +146,35 @@ options:
   --no-accumulation    render each channel once (equivalent to --accumulation 1)
   --denoise            set the renderer "denoise" parameter (warns, but still
                        sets it, if the device lacks ANARI_KHR_RENDERER_DENOISE)
+  -j, --jobs <n>       render on n device instances at once, each created from
+                       its own library handle (generate/run; default: 1)
+  --publish-threads <n>
+                       threads scoring renders and writing images when --jobs
+                       is above 1 (default: one per hardware thread)
+  --incremental        keep each result whose inputs (test, axis values, device
+                       build, render options, ground truth) are unchanged (run)
+  --changed-since <build>
+                       with --incremental, render again the results made by this
+                       device build (repeatable)
+  --perf               also time each rendered case: untimed warm-up frames,
+                       then timed frames, recorded in its sidecar (run; renders
+                       on one device, ignoring --jobs)
+  --warmup <n>         untimed frames before timing (default: 3)
+  --frames <n>         timed frames per case (default: 10)
+  --baseline <dir>     with --perf or --scaling, compare against this earlier
+                       workdir; a case whose frame times are significantly
+                       slower fails
+  --perf-median <fraction>
+                       median slowdown that counts as a regression (default: 0.10)
+  --perf-p95 <fraction>
+                       95th percentile slowdown that counts (default: 0.25)
+  --perf-alpha <p>     Mann-Whitney significance level (default: 0.05)
+  --scaling            run only the scaling tests, timing each case (with
+                       --warmup and --frames) and writing its throughput to a
+                       CSV beside its sidecar (run; renders on one device)
+  --memory-property <name>
+                       with --scaling, a device-specific UINT64 property of the
+                       device reporting its memory use in bytes
   --stdin              read newline-separated filter patterns from stdin (run)
   --verbose            print ANARI warnings
 
@@ -125,6 +183,8 @@ report options:
   --embed              inline images in the HTML (portable single file; embeds
                        only the initially-shown cases unless combined with --all)
   --all                itemize every case (default: failures only)
+  --csv <path>         write the scaling measurements as one CSV, each test's
+                       rows ordered by workload
 
 query-device-info options:
   --type <name>        restrict to object types whose name contains <name>
@@ -203,6 +263,36 @@ Options parseOptions(int argc, char **argv, int start)
       o.accumulationFrames = 1;
     else if (a == "--denoise")
       o.denoise = true;
+    else if (a == "--jobs" || a == "-j")
+      o.jobs = std::max(1u, parseDim(next(), o.jobs));
+    else if (a == "--publish-threads")
+      o.publishThreads = parseDim(next(), o.publishThreads);
+    else if (a == "--incremental")
+      o.incremental = true;
+    else if (a == "--changed-since")
+      o.changedSince.insert(next());
+    else if (a == "--perf")
+      o.perf = true;
+    else if (a == "--warmup")
+      o.warmupFrames = parseDim(next(), o.warmupFrames);
+    else if (a == "--frames")
+      o.timedFrames = parseDim(next(), o.timedFrames);
+    else if (a == "--baseline")
+      o.baseline = next();
+    else if (a == "--perf-median")
+      o.perfThresholds.median =
+          parseFloat(next(), float(o.perfThresholds.median));
+    else if (a == "--perf-p95")
+      o.perfThresholds.p95 = parseFloat(next(), float(o.perfThresholds.p95));
+    else if (a == "--scaling")
+      o.scaling = true;
+    else if (a == "--memory-property")
+      o.memoryProperty = next();
+    else if (a == "--csv")
+      o.csvOut = next();
+    else if (a == "--perf-alpha")
+      o.perfThresholds.significance =
+          parseFloat(next(), float(o.perfThresholds.significance));
     else if (a == "--stdin")
       o.useStdin = true;
     else if (a == "--type")
@@ -273,6 +363,74 @@ anari::Device loadDevice(const std::string &name, anari::Library &lib)
   return d;
 }
 
+// Load `jobs` independent devices for --jobs, each through its own library
+// handle. Releases whatever was loaded and returns false on any failure.
+bool loadDevices(const std::string &name,
+    uint32_t jobs,
+    std::vector<anari::Library> &libs,
+    std::vector<anari::Device> &devices)
+{
+  for (uint32_t i = 0; i < jobs; ++i) {
+    anari::Library lib = nullptr;
+    auto d = loadDevice(name, lib);
+    if (!d) {
+      for (size_t j = 0; j < devices.size(); ++j) {
+        anari::release(devices[j], devices[j]);
+        anari::unloadLibrary(libs[j]);
+      }
+      libs.clear();
+      devices.clear();
+      return false;
+    }
+    libs.push_back(lib);
+    devices.push_back(d);
+  }
+  return true;
+}
+
+// Identify the build of a loaded device library by the fingerprint of its
+// file, found from the library's entry point. Empty if it cannot be found.
+std::string deviceLibraryBuild(const std::string &name)
+{
+  const std::string libName = name.substr(0, name.find(','));
+  const std::string location =
+      name.find(',') != std::string::npos ? name.substr(name.find(',') + 1) : "";
+  std::string path;
+#ifdef _WIN32
+  HMODULE module =
+      GetModuleHandleA((location + "anari_library_" + libName + ".dll").c_str());
+  char buffer[MAX_PATH];
+  if (module && GetModuleFileNameA(module, buffer, MAX_PATH) > 0)
+    path = buffer;
+#else
+#ifdef __APPLE__
+  const char *extension = ".dylib";
+#else
+  const char *extension = ".so";
+#endif
+  const std::string file =
+      location + "libanari_library_" + libName + extension;
+  if (void *lib = dlopen(file.c_str(), RTLD_LAZY | RTLD_NOLOAD)) {
+    const std::string entry = "anari_library_" + libName + "_new_library";
+    Dl_info info;
+    if (void *symbol = dlsym(lib, entry.c_str());
+        symbol && dladdr(symbol, &info) && info.dli_fname)
+      path = info.dli_fname;
+    dlclose(lib);
+  }
+#endif
+  return path.empty() ? std::string() : fileFingerprint(path);
+}
+
+void releaseDevices(
+    std::vector<anari::Library> &libs, std::vector<anari::Device> &devices)
+{
+  for (size_t i = 0; i < devices.size(); ++i) {
+    anari::release(devices[i], devices[i]);
+    anari::unloadLibrary(libs[i]);
+  }
+}
+
 Catalog buildCatalog()
 {
   Catalog catalog;
@@ -418,11 +576,11 @@ int cmdCheckProperties(const Options &o)
 int cmdGenerate(const Options &o)
 {
   const std::string deviceName = o.device.empty() ? "helide" : o.device;
-  anari::Library lib = nullptr;
-  auto d = loadDevice(deviceName, lib);
-  if (!d)
+  std::vector<anari::Library> libs;
+  std::vector<anari::Device> devices;
+  if (!loadDevices(deviceName, o.jobs, libs, devices))
     return 2;
-  const auto features = deviceExtensions(lib, "default");
+  const auto features = deviceExtensions(libs.front(), "default");
   warnIfDenoiseUnsupported(deviceName, features, o.denoise);
 
   auto catalog = buildCatalog();
@@ -434,15 +592,15 @@ int cmdGenerate(const Options &o)
   ro.denoise = o.denoise;
   ro.rendererParams = o.rendererParams;
   ro.device = {deviceName, "default", o.renderer};
-  Runner runner(d, Workdir(o.workdir), ro);
+  ro.publishThreads = o.publishThreads;
+  Runner runner(devices, Workdir(o.workdir), ro);
 
   auto s = runner.generate(catalog, Filter{o.filter}, features);
   std::cout << "generate (" << deviceName << "): " << s.passed << " generated, "
             << s.skipped << " skipped, " << s.failed << " failed (of "
-            << s.total << ")\n";
+            << s.total << "), " << s.worldsReused << " world builds saved\n";
 
-  anari::release(d, d);
-  anari::unloadLibrary(lib);
+  releaseDevices(libs, devices);
   return s.failed > 0 ? 1 : 0;
 }
 
@@ -452,11 +610,18 @@ int cmdRun(const Options &o)
     std::cerr << "error: run requires a <device>\n";
     return 2;
   }
-  anari::Library lib = nullptr;
-  auto d = loadDevice(o.device, lib);
-  if (!d)
+  const bool timed = o.perf || o.scaling;
+  if (timed && o.jobs > 1)
+    std::cerr << "warning: --perf and --scaling render on one device; "
+                 "ignoring --jobs\n";
+  if (!o.baseline.empty() && !timed)
+    std::cerr << "warning: --baseline has no effect without --perf or "
+                 "--scaling\n";
+  std::vector<anari::Library> libs;
+  std::vector<anari::Device> devices;
+  if (!loadDevices(o.device, timed ? 1 : o.jobs, libs, devices))
     return 2;
-  const auto features = deviceExtensions(lib, "default");
+  const auto features = deviceExtensions(libs.front(), "default");
   warnIfDenoiseUnsupported(o.device, features, o.denoise);
 
   auto catalog = buildCatalog();
@@ -468,7 +633,21 @@ int cmdRun(const Options &o)
   ro.denoise = o.denoise;
   ro.rendererParams = o.rendererParams;
   ro.device = {o.device, "default", o.renderer};
-  Runner runner(d, Workdir(o.workdir), ro);
+  ro.device.build = deviceLibraryBuild(o.device);
+  ro.publishThreads = o.publishThreads;
+  ro.incremental = o.incremental;
+  ro.changedSince = o.changedSince;
+  ro.perf.enabled = o.perf;
+  ro.perf.warmupFrames = o.warmupFrames;
+  ro.perf.frames = o.timedFrames;
+  ro.perf.baseline = o.baseline;
+  ro.perf.thresholds = o.perfThresholds;
+  ro.scaling.enabled = o.scaling;
+  ro.scaling.memoryProperty = o.memoryProperty;
+  if (o.incremental && ro.device.build.empty())
+    std::cerr << "warning: could not identify the build of '" << o.device
+              << "'; --incremental will not notice changes to it\n";
+  Runner runner(devices, Workdir(o.workdir), ro);
 
   RunSummary s;
   if (o.useStdin) {
@@ -481,6 +660,9 @@ int cmdRun(const Options &o)
       s.passed += part.passed;
       s.failed += part.failed;
       s.skipped += part.skipped;
+      s.worldsReused += part.worldsReused;
+      s.unchanged += part.unchanged;
+      s.timingRegressions += part.timingRegressions;
     }
   } else {
     s = runner.run(catalog, Filter{o.filter}, features);
@@ -488,10 +670,15 @@ int cmdRun(const Options &o)
 
   std::cout << "run (" << o.device << "): " << s.passed << " passed, "
             << s.failed << " failed, " << s.skipped << " skipped (of "
-            << s.total << ")\n";
-
-  anari::release(d, d);
-  anari::unloadLibrary(lib);
+            << s.total << "), " << s.worldsReused << " world builds saved\n";
+  if (o.incremental)
+    std::cout << "incremental (device build " << ro.device.build
+              << "): " << s.unchanged << " results unchanged\n";
+  if (timed && !o.baseline.empty())
+    std::cout << "perf (baseline " << o.baseline
+              << "): " << s.timingRegressions << " timing regressions\n";
+
+  releaseDevices(libs, devices);
   return s.failed > 0 ? 1 : 0;
 }
 
@@ -508,15 +695,21 @@ int cmdReport(const Options &o)
     html.includeAll = o.includeAll;
     html.embed = o.embed;
     html.htmlPath = o.htmlOut;
-    const std::string doc = generateHtml(workdir, results, html);
-    std::ofstream out(o.htmlOut, std::ios::binary);
-    if (!out || !(out << doc)) {
+    if (!writeHtmlFile(workdir, results, html)) {
       std::cerr << "error: failed to write HTML report '" << o.htmlOut << "'\n";
       return 2;
     }
     std::cout << "wrote " << o.htmlOut << "\n";
   }
 
+  if (!o.csvOut.empty()) {
+    if (!writeScalingCsv(o.csvOut, results)) {
+      std::cerr << "error: failed to write CSV '" << o.csvOut << "'\n";
+      return 2;
+    }
+    std::cout << "wrote " << o.csvOut << "\n";
+  }
+
   return summarize(results).failed > 0 ? 1 : 0;
 }
 
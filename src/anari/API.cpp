@@ -7,6 +7,7 @@
 #include "anari/backend/DeviceImpl.h"
 #include "anari/backend/LibraryImpl.h"
 #include "anari/ext/anari_ext_interface.h"
+#include "CatchExceptions.h"
 // std
 #include <cstdlib>
 #include <limits>
@@ -15,32 +16,6 @@
 #include <stdexcept>
 #include <string>
 
-#ifdef ANARI_FRONTEND_CATCH_EXCEPTIONS
-#define ANARI_CATCH_BEGIN try {
-#define ANARI_CATCH_END(a)                                                     \
-  }                                                                            \
-  catch (const std::exception &e)                                              \
-  {                                                                            \
-    fprintf(stderr,                                                            \
-        "TERMINATING DUE TO UNCAUGHT ANARI EXCEPTION (std::exception): %s\n",  \
-        e.what());                                                             \
-    std::terminate();                                                          \
-    return a;                                                                  \
-  }                                                                            \
-  catch (...)                                                                  \
-  {                                                                            \
-    fprintf(stderr,                                                            \
-        "TERMINATING DUE TO UNCAUGHT ANARI EXCEPTION (unknown type)\n");       \
-    std::terminate();                                                          \
-    return a;                                                                  \
-  }
-#else
-#define ANARI_CATCH_BEGIN {
-#define ANARI_CATCH_END(a) }
-#endif
-#define ANARI_NORETURN /**/
-#define ANARI_CATCH_END_NORETURN() ANARI_CATCH_END(ANARI_NORETURN)
-
 namespace {
 template <typename T, typename... Args>
 static std::unique_ptr<T> make_unique(Args &&...args)
@@ -0,0 +1,37 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+// Wrap the bodies of functions called through the C API, so that no
+// exception crosses into the application
+
+// std
+#include <cstdio>
+#include <exception>
+
+#ifdef ANARI_FRONTEND_CATCH_EXCEPTIONS
+#define ANARI_CATCH_BEGIN try {
+#define ANARI_CATCH_END(a)                                                     \
+  }                                                                            \
+  catch (const std::exception &e)                                              \
+  {                                                                            \
+    fprintf(stderr,                                                            \
+        "TERMINATING DUE TO UNCAUGHT ANARI EXCEPTION (std::exception): %s\n",  \
+        e.what());                                                             \
+    std::terminate();                                                          \
+    return a;                                                                  \
+  }                                                                            \
+  catch (...)                                                                  \
+  {                                                                            \
+    fprintf(stderr,                                                            \
+        "TERMINATING DUE TO UNCAUGHT ANARI EXCEPTION (unknown type)\n");       \
+    std::terminate();                                                          \
+    return a;                                                                  \
+  }
+#else
+#define ANARI_CATCH_BEGIN {
+#define ANARI_CATCH_END(a) }
+#endif
+#define ANARI_NORETURN /**/
+#define ANARI_CATCH_END_NORETURN() ANARI_CATCH_END(ANARI_NORETURN)
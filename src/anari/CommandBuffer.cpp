@@ -0,0 +1,213 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "anari/backend/CommandBuffer.h"
+#include "anari/anari_cpp/Traits.h"
+#include "anari/frontend/type_utility.h"
+// std
+#include <algorithm>
+#include <cstring>
+
+namespace anari {
+
+enum HeaderFlags : uint16_t
+{
+  OBJECT_IS_PLACEHOLDER = 1,
+  VALUE_IS_PLACEHOLDER = 2,
+  VALUE_IS_NULL = 4
+};
+
+// Followed by the name, then the value, each padded to 8 bytes
+struct CommandBuffer::Header
+{
+  uint32_t words;
+  uint16_t op;
+  uint16_t flags;
+  ANARIDataType type;
+  uint32_t nameSize;
+  uint32_t valueSize;
+  uint32_t pad;
+  ANARIObject object;
+};
+
+static size_t wordsOf(size_t bytes)
+{
+  return (bytes + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+}
+
+// Recording //
+
+CommandBuffer::Header *CommandBuffer::append(Op op,
+    ANARIObject object,
+    const char *name,
+    ANARIDataType type,
+    size_t valueSize)
+{
+  size_t nameSize = name ? std::strlen(name) + 1 : 0;
+  size_t words =
+      wordsOf(sizeof(Header)) + wordsOf(nameSize) + wordsOf(valueSize);
+  if (m_end + words > m_arena.size())
+    m_arena.resize(std::max(m_end + words, 2 * m_arena.size()));
+
+  uint64_t *record = m_arena.data() + m_end;
+  // clears the padding too, so sub-word values read back zero extended
+  std::fill(record, record + words, uint64_t(0));
+  m_end += words;
+  m_count++;
+
+  auto *header = reinterpret_cast<Header *>(record);
+  header->words = uint32_t(words);
+  header->op = op;
+  header->flags = isPlaceholder(object) ? OBJECT_IS_PLACEHOLDER : 0;
+  header->type = type;
+  header->nameSize = uint32_t(nameSize);
+  header->valueSize = uint32_t(valueSize);
+  header->object = object;
+  if (name)
+    std::memcpy(record + wordsOf(sizeof(Header)), name, nameSize);
+  return header;
+}
+
+ANARIObject CommandBuffer::newObject(
+    ANARIDataType objectType, const char *subtype)
+{
+  if (!isObject(objectType) || isArray(objectType)
+      || objectType == ANARI_DEVICE)
+    return nullptr;
+
+  ANARIObject placeholder = nullptr;
+  if (!m_free.empty()) {
+    placeholder = m_free.back();
+    m_free.pop_back();
+  } else {
+    m_objects.push_back(nullptr);
+    placeholder = reinterpret_cast<ANARIObject>(&m_objects.back());
+  }
+  m_placeholders.insert(placeholder);
+  append(NEW_OBJECT, placeholder, subtype, objectType, 0);
+  return placeholder;
+}
+
+void CommandBuffer::setParameter(
+    ANARIObject object, const char *name, ANARIDataType type, const void *mem)
+{
+  size_t valueSize = 0;
+  if (mem && type == ANARI_STRING)
+    valueSize = std::strlen((const char *)mem) + 1;
+  else if (mem)
+    valueSize = sizeOf(type);
+
+  Header *header = append(SET_PARAMETER, object, name, type, valueSize);
+  auto *value = reinterpret_cast<uint64_t *>(header) + wordsOf(sizeof(Header))
+      + wordsOf(header->nameSize);
+
+  if (mem == nullptr)
+    header->flags |= VALUE_IS_NULL;
+  else if (type == ANARI_VOID_POINTER)
+    std::memcpy(value, &mem, sizeof(mem));
+  else
+    std::memcpy(value, mem, valueSize);
+
+  if (mem && isObject(type) && isPlaceholder(*(const ANARIObject *)mem))
+    header->flags |= VALUE_IS_PLACEHOLDER;
+}
+
+void CommandBuffer::unsetParameter(ANARIObject object, const char *name)
+{
+  append(UNSET_PARAMETER, object, name, ANARI_UNKNOWN, 0);
+}
+
+void CommandBuffer::commitParameters(ANARIObject object)
+{
+  append(COMMIT_PARAMETERS, object, nullptr, ANARI_UNKNOWN, 0);
+}
+
+void CommandBuffer::release(ANARIObject object)
+{
+  if (isPlaceholder(object))
+    m_released.push_back(object);
+  append(RELEASE, object, nullptr, ANARI_UNKNOWN, 0);
+}
+
+// Submission //
+
+bool CommandBuffer::next(size_t &offset, Command &cmd)
+{
+  if (offset >= m_end)
+    return false;
+
+  uint64_t *record = m_arena.data() + offset;
+  auto *header = reinterpret_cast<const Header *>(record);
+  offset += header->words;
+
+  auto *name = record + wordsOf(sizeof(Header));
+  auto *value = name + wordsOf(header->nameSize);
+
+  cmd.op = Op(header->op);
+  cmd.type = header->type;
+  cmd.name = header->nameSize ? (const char *)name : nullptr;
+  cmd.object = header->object;
+  if (cmd.op != NEW_OBJECT && (header->flags & OBJECT_IS_PLACEHOLDER))
+    cmd.object = *reinterpret_cast<ANARIObject *>(header->object);
+
+  cmd.objectValue = nullptr;
+  if (header->flags & VALUE_IS_NULL)
+    cmd.value = nullptr;
+  else if (header->flags & VALUE_IS_PLACEHOLDER) {
+    cmd.objectValue = **reinterpret_cast<ANARIObject *const *>(value);
+    cmd.value = &cmd.objectValue;
+  } else if (cmd.type == ANARI_VOID_POINTER)
+    cmd.value = *reinterpret_cast<const void *const *>(value);
+  else
+    cmd.value = value;
+
+  return true;
+}
+
+void CommandBuffer::setObject(ANARIObject placeholder, ANARIObject handle)
+{
+  *reinterpret_cast<ANARIObject *>(placeholder) = handle;
+}
+
+ANARIObject CommandBuffer::getObject(ANARIObject placeholder) const
+{
+  return isPlaceholder(placeholder)
+      ? *reinterpret_cast<ANARIObject *>(placeholder)
+      : nullptr;
+}
+
+bool CommandBuffer::isPlaceholder(ANARIObject object) const
+{
+  return object != nullptr && m_placeholders.count(object) != 0;
+}
+
+size_t CommandBuffer::size() const
+{
+  return m_count;
+}
+
+bool CommandBuffer::empty() const
+{
+  return m_count == 0;
+}
+
+void CommandBuffer::clear()
+{
+  m_end = 0;
+  m_count = 0;
+
+  for (auto placeholder : m_released) {
+    if (m_placeholders.erase(placeholder) == 0)
+      continue;
+    *reinterpret_cast<ANARIObject *>(placeholder) = nullptr;
+    m_free.push_back(placeholder);
+  }
+  m_released.clear();
+}
+
+ANARICommandBuffer CommandBuffer::this_buffer()
+{
+  return reinterpret_cast<ANARICommandBuffer>(this);
+}
+
+} // namespace anari
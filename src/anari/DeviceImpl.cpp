@@ -2,8 +2,10 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "anari/backend/DeviceImpl.h"
+#include "CatchExceptions.h"
 
 #include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
 namespace anari {
@@ -17,12 +19,188 @@ ANARIObject DeviceImpl::newObject(const char *objectType, const char *type)
   return nullptr;
 }
 
+static void setParametersImpl(ANARIDevice d,
+    ANARIObject object,
+    const ANARIParameterValue *params,
+    uint64_t count) ANARI_CATCH_BEGIN
+{
+  reinterpret_cast<DeviceImpl *>(d)->setParameters(object, params, count);
+}
+ANARI_CATCH_END_NORETURN()
+
+static void setParameterOnObjectsImpl(ANARIDevice d,
+    const ANARIObject *objects,
+    uint64_t count,
+    const char *name,
+    ANARIDataType type,
+    const void *values,
+    uint64_t valueStride) ANARI_CATCH_BEGIN
+{
+  reinterpret_cast<DeviceImpl *>(d)->setParameterOnObjects(
+      objects, count, name, type, values, valueStride);
+}
+ANARI_CATCH_END_NORETURN()
+
+static CommandBuffer &bufferRef(ANARICommandBuffer b)
+{
+  return *reinterpret_cast<CommandBuffer *>(b);
+}
+
+static ANARICommandBuffer newCommandBufferImpl() ANARI_CATCH_BEGIN
+{
+  return (new CommandBuffer)->this_buffer();
+}
+ANARI_CATCH_END(nullptr)
+
+static void releaseCommandBufferImpl(ANARICommandBuffer b) ANARI_CATCH_BEGIN
+{
+  delete &bufferRef(b);
+}
+ANARI_CATCH_END_NORETURN()
+
+static ANARIObject commandBufferNewObjectImpl(ANARICommandBuffer b,
+    ANARIDataType objectType,
+    const char *subtype) ANARI_CATCH_BEGIN
+{
+  return bufferRef(b).newObject(objectType, subtype);
+}
+ANARI_CATCH_END(nullptr)
+
+static void commandBufferSetParameterImpl(ANARICommandBuffer b,
+    ANARIObject object,
+    const char *name,
+    ANARIDataType type,
+    const void *mem) ANARI_CATCH_BEGIN
+{
+  bufferRef(b).setParameter(object, name, type, mem);
+}
+ANARI_CATCH_END_NORETURN()
+
+static void commandBufferUnsetParameterImpl(ANARICommandBuffer b,
+    ANARIObject object,
+    const char *name) ANARI_CATCH_BEGIN
+{
+  bufferRef(b).unsetParameter(object, name);
+}
+ANARI_CATCH_END_NORETURN()
+
+static void commandBufferCommitParametersImpl(
+    ANARICommandBuffer b, ANARIObject object) ANARI_CATCH_BEGIN
+{
+  bufferRef(b).commitParameters(object);
+}
+ANARI_CATCH_END_NORETURN()
+
+static void commandBufferReleaseImpl(
+    ANARICommandBuffer b, ANARIObject object) ANARI_CATCH_BEGIN
+{
+  bufferRef(b).release(object);
+}
+ANARI_CATCH_END_NORETURN()
+
+static void submitCommandBufferImpl(
+    ANARIDevice d, ANARICommandBuffer b) ANARI_CATCH_BEGIN
+{
+  reinterpret_cast<DeviceImpl *>(d)->submitCommandBuffer(bufferRef(b));
+  bufferRef(b).clear();
+}
+ANARI_CATCH_END_NORETURN()
+
+static ANARIObject commandBufferGetObjectImpl(
+    ANARICommandBuffer b, ANARIObject placeholder) ANARI_CATCH_BEGIN
+{
+  return bufferRef(b).getObject(placeholder);
+}
+ANARI_CATCH_END(nullptr)
+
 void (*DeviceImpl::getProcAddress(const char *name))(void)
 {
-  (void)name;
+  using Fcn = void (*)(void);
+  static const struct
+  {
+    const char *name;
+    Fcn fcn;
+  } functions[] = {
+      {"anariSetParameters", reinterpret_cast<Fcn>(&setParametersImpl)},
+      {"anariSetParameterOnObjects",
+          reinterpret_cast<Fcn>(&setParameterOnObjectsImpl)},
+      {"anariNewCommandBuffer", reinterpret_cast<Fcn>(&newCommandBufferImpl)},
+      {"anariReleaseCommandBuffer",
+          reinterpret_cast<Fcn>(&releaseCommandBufferImpl)},
+      {"anariCommandBufferNewObject",
+          reinterpret_cast<Fcn>(&commandBufferNewObjectImpl)},
+      {"anariCommandBufferSetParameter",
+          reinterpret_cast<Fcn>(&commandBufferSetParameterImpl)},
+      {"anariCommandBufferUnsetParameter",
+          reinterpret_cast<Fcn>(&commandBufferUnsetParameterImpl)},
+      {"anariCommandBufferCommitParameters",
+          reinterpret_cast<Fcn>(&commandBufferCommitParametersImpl)},
+      {"anariCommandBufferRelease",
+          reinterpret_cast<Fcn>(&commandBufferReleaseImpl)},
+      {"anariSubmitCommandBuffer",
+          reinterpret_cast<Fcn>(&submitCommandBufferImpl)},
+      {"anariCommandBufferGetObject",
+          reinterpret_cast<Fcn>(&commandBufferGetObjectImpl)}};
+
+  for (const auto &f : functions) {
+    if (std::strcmp(name, f.name) == 0)
+      return f.fcn;
+  }
   return nullptr;
 }
 
+void DeviceImpl::setParameters(
+    ANARIObject object, const ANARIParameterValue *params, uint64_t count)
+{
+  for (uint64_t i = 0; i < count; i++)
+    setParameter(object, params[i].name, params[i].type, params[i].value);
+}
+
+void DeviceImpl::setParameterOnObjects(const ANARIObject *objects,
+    uint64_t count,
+    const char *name,
+    ANARIDataType type,
+    const void *values,
+    uint64_t valueStride)
+{
+  auto *value = static_cast<const uint8_t *>(values);
+  for (uint64_t i = 0; i < count; i++)
+    setParameter(
+        objects[i], name, type, value ? value + i * valueStride : nullptr);
+}
+
+void DeviceImpl::submitCommandBuffer(CommandBuffer &buffer)
+{
+  CommandBuffer::Command cmd;
+  for (size_t offset = 0; buffer.next(offset, cmd);) {
+    if (cmd.op == CommandBuffer::NEW_OBJECT) {
+      buffer.setObject(cmd.object, newObjectOfType(cmd.type, cmd.name));
+      continue;
+    }
+
+    // objects which failed to be created are skipped
+    if (cmd.object == nullptr)
+      continue;
+
+    switch (cmd.op) {
+    case CommandBuffer::SET_PARAMETER:
+      setParameter(cmd.object, cmd.name, cmd.type, cmd.value);
+      break;
+    case CommandBuffer::UNSET_PARAMETER:
+      unsetParameter(cmd.object, cmd.name);
+      break;
+    case CommandBuffer::COMMIT_PARAMETERS:
+      commitParameters(cmd.object);
+      break;
+    case CommandBuffer::RELEASE:
+      release(cmd.object);
+      break;
+    default:
+      break;
+    }
+  }
+}
+
 // Device definitions /////////////////////////////////////////////////////////
 
 DeviceImpl::DeviceImpl(ANARILibrary library)
@@ -51,6 +229,41 @@ bool DeviceImpl::handleIsDevice(ANARIObject obj) const
   return static_cast<const void *>(obj) == static_cast<const void *>(this);
 }
 
+ANARIObject DeviceImpl::newObjectOfType(
+    ANARIDataType objectType, const char *subtype)
+{
+  switch (objectType) {
+  case ANARI_CAMERA:
+    return newCamera(subtype);
+  case ANARI_FRAME:
+    return newFrame();
+  case ANARI_GEOMETRY:
+    return newGeometry(subtype);
+  case ANARI_GROUP:
+    return newGroup();
+  case ANARI_INSTANCE:
+    return newInstance(subtype);
+  case ANARI_LIGHT:
+    return newLight(subtype);
+  case ANARI_MATERIAL:
+    return newMaterial(subtype);
+  case ANARI_RENDERER:
+    return newRenderer(subtype);
+  case ANARI_SAMPLER:
+    return newSampler(subtype);
+  case ANARI_SPATIAL_FIELD:
+    return newSpatialField(subtype);
+  case ANARI_SURFACE:
+    return newSurface();
+  case ANARI_VOLUME:
+    return newVolume(subtype);
+  case ANARI_WORLD:
+    return newWorld();
+  default:
+    return nullptr;
+  }
+}
+
 ANARI_TYPEFOR_DEFINITION(DeviceImpl *);
 
 } // namespace anari
@@ -5,6 +5,7 @@
 
 // anari
 #include "anari/anari.h"
+#include "anari/ext/anari_bulk_parameters.h"
 #include "anari/frontend/anari_extension_utility.h"
 #include "anari/frontend/type_utility.h"
 // std
@@ -45,6 +46,7 @@ using World        = ANARIWorld;
 
 using StatusCallback          = ANARIStatusCallback;
 using Parameter               = ANARIParameter;
+using ParameterValue          = ANARIParameterValue;
 using FrameCompletionCallback = ANARIFrameCompletionCallback;
 using MemoryDeleter           = ANARIMemoryDeleter;
 
@@ -242,6 +244,29 @@ void setParameterAs(Device d, Object o, const char *name, DataType type, T &&v);
 template <typename T>
 void setAndReleaseParameter(Device d, Object o, const char *name, const T &v);
 
+// Bulk parameter updates, falling back to one anariSetParameter() per value
+// on devices without the "anariSetParameters" extension functions
+template <typename T>
+ParameterValue parameterValue(const char *name, const T &v);
+ParameterValue parameterValue(const char *name, const char *v);
+ParameterValue parameterValue(const char *name, DataType type, const void *v);
+
+void setParameters(
+    Device d, Object o, const ParameterValue *params, uint64_t count);
+void setParameterOnObjects(Device d,
+    const Object *objects,
+    uint64_t count,
+    const char *name,
+    DataType type,
+    const void *values,
+    uint64_t valueStride);
+template <typename T>
+void setParameterOnObjects(Device d,
+    const Object *objects,
+    uint64_t count,
+    const char *name,
+    const T *values);
+
 void unsetParameter(Device, Object, const char *id);
 void unsetAllParameters(Device, Object);
 void commitParameters(Device, Object);
@@ -566,6 +566,77 @@ inline void setAndReleaseParameter(
   anariRelease(d, v);
 }
 
+template <typename T>
+inline ParameterValue parameterValue(const char *name, const T &v)
+{
+  static_assert(detail::getType<T>() != ANARI_UNKNOWN,
+      "Only types corresponding to DataType values can be set "
+      "as parameters on objects.");
+  static_assert(!std::is_same<T, bool>::value,
+      "anari::parameterValue() needs bool values stored as uint32_t");
+  constexpr bool isVoidPtr = detail::getType<T>() == ANARI_VOID_POINTER;
+  return {name,
+      ANARITypeFor<T>::value,
+      isVoidPtr ? *((const void *const *)&v) : (const void *)&v};
+}
+
+inline ParameterValue parameterValue(const char *name, const char *v)
+{
+  return {name, ANARI_STRING, v};
+}
+
+inline ParameterValue parameterValue(
+    const char *name, DataType type, const void *v)
+{
+  return {name, type, v};
+}
+
+inline void setParameters(
+    Device d, Object o, const ParameterValue *params, uint64_t count)
+{
+  auto fcn = (PFNANARISETPARAMETERS)anariDeviceGetProcAddress(
+      d, "anariSetParameters");
+  if (fcn)
+    fcn(d, o, params, count);
+  else {
+    for (uint64_t i = 0; i < count; i++)
+      anariSetParameter(d, o, params[i].name, params[i].type, params[i].value);
+  }
+}
+
+inline void setParameterOnObjects(Device d,
+    const Object *objects,
+    uint64_t count,
+    const char *name,
+    DataType type,
+    const void *values,
+    uint64_t valueStride)
+{
+  auto fcn = (PFNANARISETPARAMETERONOBJECTS)anariDeviceGetProcAddress(
+      d, "anariSetParameterOnObjects");
+  if (fcn)
+    fcn(d, objects, count, name, type, values, valueStride);
+  else {
+    auto *value = (const uint8_t *)values;
+    for (uint64_t i = 0; i < count; i++)
+      anariSetParameter(d, objects[i], name, type, value + i * valueStride);
+  }
+}
+
+template <typename T>
+inline void setParameterOnObjects(Device d,
+    const Object *objects,
+    uint64_t count,
+    const char *name,
+    const T *values)
+{
+  static_assert(detail::getType<T>() != ANARI_UNKNOWN,
+      "Only types corresponding to DataType values can be set "
+      "as parameters on objects.");
+  setParameterOnObjects(
+      d, objects, count, name, ANARITypeFor<T>::value, values, sizeof(T));
+}
+
 inline void unsetParameter(Device d, Object o, const char *id)
 {
   anariUnsetParameter(d, o, id);
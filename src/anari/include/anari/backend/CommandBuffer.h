@@ -0,0 +1,106 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+// anari
+#include "anari/anari.h"
+#include "anari/ext/anari_command_buffer.h"
+// std
+#include <cstdint>
+#include <deque>
+#include <unordered_set>
+#include <vector>
+
+namespace anari {
+
+// Backing store of an ANARICommandBuffer. Commands are packed back to back
+// into one growing arena, each holding its name and a copy of its value, so
+// recording does not allocate once the arena reached its working size.
+//
+// Objects created by the buffer are named by placeholders, which are the
+// addresses of slots owned by the buffer and filled with the real handles on
+// submission. Whether a handle is a placeholder is decided while recording,
+// so submitting never has to look handles up. Slots of placeholders released
+// by the buffer are reused by later newObject() calls once it was cleared.
+struct CommandBuffer
+{
+  enum Op : uint16_t
+  {
+    NEW_OBJECT,
+    SET_PARAMETER,
+    UNSET_PARAMETER,
+    COMMIT_PARAMETERS,
+    RELEASE
+  };
+
+  // A decoded command, pointers stay valid until the buffer is cleared
+  struct Command
+  {
+    Op op;
+    // Target object, or the placeholder created by NEW_OBJECT
+    ANARIObject object;
+    // Parameter name, or the subtype of NEW_OBJECT (nullptr if none)
+    const char *name;
+    // Parameter type, or the object type of NEW_OBJECT
+    ANARIDataType type;
+    // Value as the mem argument of anariSetParameter() expects it
+    const void *value;
+    // Storage of a resolved object value
+    ANARIObject objectValue;
+  };
+
+  // Recording //
+
+  ANARIObject newObject(ANARIDataType objectType, const char *subtype);
+  void setParameter(ANARIObject object,
+      const char *name,
+      ANARIDataType type,
+      const void *mem);
+  void unsetParameter(ANARIObject object, const char *name);
+  void commitParameters(ANARIObject object);
+  void release(ANARIObject object);
+
+  // Submission //
+
+  // Decodes the command at 'offset' and advances it, returns false at the end.
+  // Placeholders are replaced by the handles set with setObject().
+  bool next(size_t &offset, Command &cmd);
+
+  // Sets the real handle of a placeholder returned by newObject()
+  void setObject(ANARIObject placeholder, ANARIObject handle);
+  // Real handle of a placeholder, nullptr if it is not (yet) known
+  ANARIObject getObject(ANARIObject placeholder) const;
+
+  bool isPlaceholder(ANARIObject object) const;
+
+  // Number of commands recorded since the last clear()
+  size_t size() const;
+  bool empty() const;
+
+  // Drops the recorded commands but keeps the arena, placeholders released
+  // by the dropped commands are recycled and no longer resolve
+  void clear();
+
+  ANARICommandBuffer this_buffer();
+
+ private:
+  struct Header;
+
+  Header *append(Op op,
+      ANARIObject object,
+      const char *name,
+      ANARIDataType type,
+      size_t valueSize);
+
+  std::vector<uint64_t> m_arena;
+  size_t m_end{0};
+  size_t m_count{0};
+  std::deque<ANARIObject> m_objects;
+  std::unordered_set<ANARIObject> m_placeholders;
+  // Placeholders released since the last clear(), and slots free for reuse
+  std::vector<ANARIObject> m_released;
+  std::vector<ANARIObject> m_free;
+};
+
+} // namespace anari
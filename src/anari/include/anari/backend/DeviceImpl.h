@@ -6,7 +6,9 @@
 // anari
 #include "anari/anari.h"
 #include "anari/anari_cpp/Traits.h"
+#include "anari/ext/anari_bulk_parameters.h"
 
+#include "anari/backend/CommandBuffer.h"
 #include "anari/backend/LibraryImpl.h"
 
 namespace anari {
@@ -199,6 +201,25 @@ struct DeviceImpl
   // Optionally allow dynamic lookup of special extension functions
   virtual void (*getProcAddress(const char *name))(void);
 
+  // Implement the bulk parameter extension, looked up as "anariSetParameters"
+  // and "anariSetParameterOnObjects" through getProcAddress(). The defaults
+  // call setParameter() once per value, devices can override them to take
+  // their locks once per call instead.
+  virtual void setParameters(
+      ANARIObject object, const ANARIParameterValue *params, uint64_t count);
+  virtual void setParameterOnObjects(const ANARIObject *objects,
+      uint64_t count,
+      const char *name,
+      ANARIDataType type,
+      const void *values,
+      uint64_t valueStride);
+
+  // Implement anariSubmitCommandBuffer() of the command buffer extension, the
+  // other functions of which only record into the buffer. The default replays
+  // the commands through the virtual interface above, devices can override it
+  // to apply a whole buffer at once. The buffer is cleared by the caller.
+  virtual void submitCommandBuffer(CommandBuffer &buffer);
+
   /////////////////////////////////////////////////////////////////////////////
   // Helper/other functions and data members
   /////////////////////////////////////////////////////////////////////////////
@@ -218,6 +239,9 @@ struct DeviceImpl
   const void *defaultStatusCallbackUserPtr() const;
 
   bool handleIsDevice(ANARIObject obj) const;
+
+  // Calls the new<Type>() method matching a non-array object type
+  ANARIObject newObjectOfType(ANARIDataType objectType, const char *subtype);
 };
 
 ANARI_TYPEFOR_SPECIALIZATION(DeviceImpl *, ANARI_DEVICE);
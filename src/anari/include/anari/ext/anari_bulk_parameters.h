@@ -0,0 +1,38 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <anari/ext/anari_ext_interface.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Sets count parameters on one object, as if anariSetParameter() was called
+// for each of them in order, with ANARIParameterValue::value as its mem
+typedef void (*PFNANARISETPARAMETERS)(ANARIDevice, ANARIObject,
+    const ANARIParameterValue*, uint64_t count);
+
+// Sets the same parameter on count objects, the value of objects[i] is read
+// from values + i * valueStride, so a stride of 0 sets the same value on all;
+// null values pass a null mem for every object
+typedef void (*PFNANARISETPARAMETERONOBJECTS)(ANARIDevice,
+    const ANARIObject *objects, uint64_t count, const char *name,
+    ANARIDataType type, const void *values, uint64_t valueStride);
+
+typedef struct ANARI_EXT_bulk_parameters_interface_s {
+    PFNANARISETPARAMETERS anariSetParameters;
+    PFNANARISETPARAMETERONOBJECTS anariSetParameterOnObjects;
+} ANARI_EXT_bulk_parameters_interface;
+
+static inline int init_ANARI_EXT_bulk_parameters_interface(ANARIDevice device, ANARI_EXT_bulk_parameters_interface *iface) {
+    int ok = 1;
+    ok = ok && (iface->anariSetParameters = (PFNANARISETPARAMETERS)anariDeviceGetProcAddress(device, "anariSetParameters"));
+    ok = ok && (iface->anariSetParameterOnObjects = (PFNANARISETPARAMETERONOBJECTS)anariDeviceGetProcAddress(device, "anariSetParameterOnObjects"));
+    return ok;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -0,0 +1,69 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <anari/ext/anari_ext_interface.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Commands recorded without touching a device, then applied with one submit.
+// A buffer is recorded by one thread at a time and may be handed to another
+// thread for submission.
+typedef struct ANARICommandBuffer_s *ANARICommandBuffer;
+
+typedef ANARICommandBuffer (*PFNANARINEWCOMMANDBUFFER)(void);
+typedef void (*PFNANARIRELEASECOMMANDBUFFER)(ANARICommandBuffer);
+
+// Records the creation of an object of any non-array type. The returned
+// placeholder stands for the object in later commands of this buffer and of
+// later recordings until the buffer releases it, anariCommandBufferGetObject()
+// gives the real handle once the buffer was submitted. The placeholder of a
+// released object may be handed out again by a later recording.
+typedef ANARIObject (*PFNANARICOMMANDBUFFERNEWOBJECT)(ANARICommandBuffer,
+    ANARIDataType objectType, const char *subtype);
+typedef void (*PFNANARICOMMANDBUFFERSETPARAMETER)(ANARICommandBuffer,
+    ANARIObject, const char *name, ANARIDataType, const void *mem);
+typedef void (*PFNANARICOMMANDBUFFERUNSETPARAMETER)(ANARICommandBuffer,
+    ANARIObject, const char *name);
+typedef void (*PFNANARICOMMANDBUFFERCOMMITPARAMETERS)(ANARICommandBuffer,
+    ANARIObject);
+typedef void (*PFNANARICOMMANDBUFFERRELEASE)(ANARICommandBuffer, ANARIObject);
+
+// Applies the recorded commands in order and empties the buffer for reuse
+typedef void (*PFNANARISUBMITCOMMANDBUFFER)(ANARIDevice, ANARICommandBuffer);
+// Real handle of a placeholder, nullptr before its buffer was submitted
+typedef ANARIObject (*PFNANARICOMMANDBUFFERGETOBJECT)(ANARICommandBuffer,
+    ANARIObject placeholder);
+
+typedef struct ANARI_EXT_command_buffer_interface_s {
+    PFNANARINEWCOMMANDBUFFER anariNewCommandBuffer;
+    PFNANARIRELEASECOMMANDBUFFER anariReleaseCommandBuffer;
+    PFNANARICOMMANDBUFFERNEWOBJECT anariCommandBufferNewObject;
+    PFNANARICOMMANDBUFFERSETPARAMETER anariCommandBufferSetParameter;
+    PFNANARICOMMANDBUFFERUNSETPARAMETER anariCommandBufferUnsetParameter;
+    PFNANARICOMMANDBUFFERCOMMITPARAMETERS anariCommandBufferCommitParameters;
+    PFNANARICOMMANDBUFFERRELEASE anariCommandBufferRelease;
+    PFNANARISUBMITCOMMANDBUFFER anariSubmitCommandBuffer;
+    PFNANARICOMMANDBUFFERGETOBJECT anariCommandBufferGetObject;
+} ANARI_EXT_command_buffer_interface;
+
+static inline int init_ANARI_EXT_command_buffer_interface(ANARIDevice device, ANARI_EXT_command_buffer_interface *iface) {
+    int ok = 1;
+    ok = ok && (iface->anariNewCommandBuffer = (PFNANARINEWCOMMANDBUFFER)anariDeviceGetProcAddress(device, "anariNewCommandBuffer"));
+    ok = ok && (iface->anariReleaseCommandBuffer = (PFNANARIRELEASECOMMANDBUFFER)anariDeviceGetProcAddress(device, "anariReleaseCommandBuffer"));
+    ok = ok && (iface->anariCommandBufferNewObject = (PFNANARICOMMANDBUFFERNEWOBJECT)anariDeviceGetProcAddress(device, "anariCommandBufferNewObject"));
+    ok = ok && (iface->anariCommandBufferSetParameter = (PFNANARICOMMANDBUFFERSETPARAMETER)anariDeviceGetProcAddress(device, "anariCommandBufferSetParameter"));
+    ok = ok && (iface->anariCommandBufferUnsetParameter = (PFNANARICOMMANDBUFFERUNSETPARAMETER)anariDeviceGetProcAddress(device, "anariCommandBufferUnsetParameter"));
+    ok = ok && (iface->anariCommandBufferCommitParameters = (PFNANARICOMMANDBUFFERCOMMITPARAMETERS)anariDeviceGetProcAddress(device, "anariCommandBufferCommitParameters"));
+    ok = ok && (iface->anariCommandBufferRelease = (PFNANARICOMMANDBUFFERRELEASE)anariDeviceGetProcAddress(device, "anariCommandBufferRelease"));
+    ok = ok && (iface->anariSubmitCommandBuffer = (PFNANARISUBMITCOMMANDBUFFER)anariDeviceGetProcAddress(device, "anariSubmitCommandBuffer"));
+    ok = ok && (iface->anariCommandBufferGetObject = (PFNANARICOMMANDBUFFERGETOBJECT)anariDeviceGetProcAddress(device, "anariCommandBufferGetObject"));
+    return ok;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -103,6 +103,7 @@ void setParameter(SceneHandle s, const std::string &name, Any val)
 
 void commit(SceneHandle s)
 {
+  s->resetAnimation();
   s->commit();
 }
 
@@ -118,7 +119,12 @@ Bounds getBounds(SceneHandle s)
 
 std::vector<ParameterInfo> getParameters(SceneHandle s)
 {
-  return s->parameters();
+  auto parameters = s->parameters();
+  if (s->animated()) {
+    const auto animation = TestScene::animationParameters();
+    parameters.insert(parameters.end(), animation.begin(), animation.end());
+  }
+  return parameters;
 }
 
 std::vector<Camera> getCameras(SceneHandle s)
@@ -133,6 +139,7 @@ bool isAnimated(SceneHandle s)
 
 void computeNextFrame(SceneHandle s)
 {
+  s->advanceAnimation();
   s->computeNextFrame();
 }
 
@@ -74,6 +74,18 @@ ANARI_TEST_SCENES_INTERFACE void computeNextFrame(SceneHandle s);
 // Free the underlying scene (and all ANARI objects created by it)
 ANARI_TEST_SCENES_INTERFACE void release(SceneHandle s);
 
+// Scripted camera paths //////////////////////////////////////////////////////
+
+// Get the names of the camera paths getCameraPathPose() can follow
+ANARI_TEST_SCENES_INTERFACE std::vector<std::string> getAvailableCameraPaths();
+
+// Get the camera pose at 'phase' along a named path around 'bounds' (e.g. from
+// getBounds()). The path repeats every 1.0 of phase and starts at the default
+// view from +Z. A pose depends only on the arguments, so replaying the same
+// phases replays the same poses; an unknown path stays at the start.
+ANARI_TEST_SCENES_INTERFACE Camera getCameraPathPose(
+    const Bounds &bounds, const std::string &path, float phase);
+
 // Scene registration /////////////////////////////////////////////////////////
 
 using SceneConstructorFcn = std::function<TestScene *(anari::Device)>;
@@ -57,6 +57,11 @@ bool readableImage(const std::filesystem::path &path)
   return loadPNG(path.string()).valid();
 }
 
+bool readableArtifact(const std::filesystem::path &path, bool raw)
+{
+  return raw ? loadRaw(path.string()).valid() : readableImage(path);
+}
+
 struct FilesystemArtifactWriter : public ArtifactWriter
 {
   bool writeImage(
@@ -77,6 +82,7 @@ struct StagedImage
   std::filesystem::path finalPath;
   std::filesystem::path stagedPath;
   std::filesystem::path backupPath;
+  bool raw{false};
   bool installed{false};
 };
 
@@ -95,7 +101,9 @@ struct ImageTransaction
     std::set<std::filesystem::path> finalPaths;
     for (const auto &artifact : images) {
       const auto finalPath = artifact.path.lexically_normal();
-      if (!finalPaths.insert(finalPath).second || !artifact.image.valid()
+      const bool raw = artifact.raw.valid();
+      if (!finalPaths.insert(finalPath).second
+          || !(raw || artifact.image.valid())
           || !createParentDirectory(finalPath))
         return false;
 
@@ -109,9 +117,12 @@ struct ImageTransaction
       StagedImage staged;
       staged.finalPath = finalPath;
       staged.stagedPath = temporarySibling(finalPath, "stage");
+      staged.raw = raw;
       m_images.push_back(staged);
-      if (!m_writer.writeImage(staged.stagedPath, artifact.image)
-          || !readableImage(staged.stagedPath))
+      const bool written = raw
+          ? m_writer.writeRaw(staged.stagedPath, artifact.raw)
+          : m_writer.writeImage(staged.stagedPath, artifact.image);
+      if (!written || !readableArtifact(staged.stagedPath, raw))
         return false;
     }
     return true;
@@ -141,7 +152,7 @@ struct ImageTransaction
     }
 
     for (const auto &image : m_images) {
-      if (!readableImage(image.finalPath))
+      if (!readableArtifact(image.finalPath, image.raw))
         return false;
     }
     return true;
@@ -15,10 +15,13 @@ namespace anari {
 namespace cts {
 
 // One image and the final path at which it becomes visible to CTS consumers.
+// A raw artifact (raw.valid()) is written with saveRaw's format instead of as
+// a PNG, and `image` is then ignored.
 struct ImageArtifact
 {
   std::filesystem::path path;
   Image image;
+  RawImage raw{};
 };
 
 // The serialization seam used by ArtifactPublisher. Tests can inject an
@@ -31,6 +34,11 @@ struct ArtifactWriter
       const std::filesystem::path &path, const Image &image) = 0;
   virtual bool writeSidecar(
       const std::filesystem::path &path, const CaseResult &result) = 0;
+  // Raw ground truth; adapters that only intercept images keep this default.
+  virtual bool writeRaw(const std::filesystem::path &path, const RawImage &raw)
+  {
+    return saveRaw(path.string(), raw);
+  }
 };
 
 // Transactional publication for one Case. Images are staged and validated
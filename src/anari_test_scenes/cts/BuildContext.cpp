@@ -18,16 +18,19 @@ anari::Device BuildContext::device() const
 std::string BuildContext::getString(
     const std::string &name, const std::string &valIfNotFound) const
 {
+  noteRead(name);
   return m_params.getParamString(name, valIfNotFound);
 }
 
 bool BuildContext::has(const std::string &name) const
 {
+  noteRead(name);
   return m_params.hasParam(name) || m_bindings.find(name) != m_bindings.end();
 }
 
 Any BuildContext::value(const std::string &name) const
 {
+  noteRead(name);
   const auto binding = m_bindings.find(name);
   if (binding != m_bindings.end())
     return Any(binding->second);
@@ -36,6 +39,7 @@ Any BuildContext::value(const std::string &name) const
 
 const ParameterBinding &BuildContext::binding(const std::string &name) const
 {
+  noteRead(name);
   const auto it = m_bindings.find(name);
   if (it == m_bindings.end()) {
     throw std::invalid_argument(
@@ -44,6 +48,16 @@ const ParameterBinding &BuildContext::binding(const std::string &name) const
   return it->second;
 }
 
+const std::set<std::string> &BuildContext::readNames() const
+{
+  return m_readNames;
+}
+
+void BuildContext::noteRead(const std::string &name) const
+{
+  m_readNames.insert(name);
+}
+
 void BuildContext::set(const std::string &name, const Any &value)
 {
   if (value.isBinding()) {
@@ -9,6 +9,7 @@
 // helium
 #include "helium/utility/ParameterizedObject.h"
 // std
+#include <set>
 #include <string>
 #include <unordered_map>
 
@@ -30,6 +31,7 @@ struct BuildContext
   template <typename T>
   T get(const std::string &name, T valIfNotFound) const
   {
+    noteRead(name);
     return m_params.getParam<T>(name, valIfNotFound);
   }
 
@@ -56,8 +58,15 @@ struct BuildContext
     m_params.setParam(name, v);
   }
 
+  // Every name looked up so far through get/getString/has/value/binding. The
+  // runner reuses a world for a later Case only if these read the same.
+  const std::set<std::string> &readNames() const;
+
  private:
+  void noteRead(const std::string &name) const;
+
   anari::Device m_device{nullptr};
+  mutable std::set<std::string> m_readNames;
   helium::ParameterizedObject m_params;
   std::unordered_map<std::string, ParameterBinding> m_bindings;
 };
@@ -41,6 +41,15 @@ inline const char *channelName(Channel c)
   return "unknown";
 }
 
+// Whether a channel's ground truth is its raw buffer (see RawImage) rather
+// than an 8-bit image: depth and the id channels, whose values an RGBA
+// visualization cannot hold exactly.
+inline bool hasRawGroundTruth(Channel c)
+{
+  return c == Channel::Depth || c == Channel::PrimitiveId
+      || c == Channel::ObjectId || c == Channel::InstanceId;
+}
+
 // Inverse of channelName; defaults to Color for an unknown name so a
 // best-effort read of an older or foreign sidecar still yields a Channel.
 inline Channel channelFromName(const std::string &name)
@@ -0,0 +1,74 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Fingerprint.h"
+// std
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace anari {
+namespace cts {
+
+void Fingerprint::mix(const void *data, size_t bytes)
+{
+  const auto *p = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < bytes; ++i) {
+    m_hash ^= p[i];
+    m_hash *= 0x100000001b3ull;
+  }
+}
+
+Fingerprint &Fingerprint::add(const void *data, size_t bytes)
+{
+  const uint64_t length = bytes;
+  mix(&length, sizeof(length));
+  mix(data, bytes);
+  return *this;
+}
+
+Fingerprint &Fingerprint::add(const std::string &s)
+{
+  return add(s.data(), s.size());
+}
+
+Fingerprint &Fingerprint::add(const char *s)
+{
+  return add(s, s ? std::strlen(s) : 0);
+}
+
+Fingerprint &Fingerprint::add(double v)
+{
+  return add(&v, sizeof(v));
+}
+
+Fingerprint &Fingerprint::add(uint64_t v)
+{
+  return add(&v, sizeof(v));
+}
+
+std::string Fingerprint::hex() const
+{
+  char text[17];
+  std::snprintf(text, sizeof(text), "%016llx", (unsigned long long)m_hash);
+  return text;
+}
+
+std::string fileFingerprint(const std::filesystem::path &path)
+{
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  if (!in)
+    return {};
+  Fingerprint fp;
+  std::vector<char> chunk(1 << 16);
+  while (in) {
+    in.read(chunk.data(), chunk.size());
+    if (in.gcount() > 0)
+      fp.add(chunk.data(), size_t(in.gcount()));
+  }
+  return in.eof() ? fp.hex() : std::string();
+}
+
+} // namespace cts
+} // namespace anari
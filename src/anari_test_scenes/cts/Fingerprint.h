@@ -0,0 +1,42 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace anari {
+namespace cts {
+
+// A running 64-bit FNV-1a hash of everything that determines an output, shown
+// as 16 hex digits. Not cryptographic: it only has to notice that an input
+// changed, so an incremental run knows which Cases to render again.
+//
+// Each add() also hashes the length of what it adds, so neighbouring fields
+// cannot run into each other ("ab" + "c" differs from "a" + "bc").
+struct Fingerprint
+{
+  Fingerprint &add(const void *data, size_t bytes);
+  Fingerprint &add(const std::string &s);
+  Fingerprint &add(const char *s);
+  Fingerprint &add(double v);
+  Fingerprint &add(uint64_t v);
+
+  std::string hex() const;
+
+ private:
+  void mix(const void *data, size_t bytes);
+
+  uint64_t m_hash{0xcbf29ce484222325ull};
+};
+
+// The fingerprint of a file's contents, or an empty string if it cannot be
+// read.
+std::string fileFingerprint(const std::filesystem::path &path);
+
+} // namespace cts
+} // namespace anari
@@ -9,6 +9,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstring>
+#include <deque>
 #include <limits>
 
 namespace anari {
@@ -125,11 +126,24 @@ bool checkedMultiply(size_t a, size_t b, size_t &result)
   return true;
 }
 
+// Clamp with min/max rather than branches so the conversion loops below
+// vectorize; max(0, x) also sends NaN to 0.
 uint8_t toU8(float value)
 {
-  const float scaled = value * 255.f;
-  return static_cast<uint8_t>(
-      scaled < 0.f ? 0.f : (scaled > 255.f ? 255.f : scaled));
+  return static_cast<uint8_t>(std::min(255.f, std::max(0.f, value * 255.f)));
+}
+
+// The id palette as RGBA8, converted once instead of per pixel.
+const std::vector<std::array<uint8_t, 4>> &idPalette()
+{
+  static const std::vector<std::array<uint8_t, 4>> palette = [] {
+    const auto &colors = scenes::colors::palette;
+    std::vector<std::array<uint8_t, 4>> out(colors.size());
+    for (size_t i = 0; i < colors.size(); ++i)
+      out[i] = {toU8(colors[i].x), toU8(colors[i].y), toU8(colors[i].z), 255};
+    return out;
+  }();
+  return palette;
 }
 
 } // namespace
@@ -197,8 +211,9 @@ FrameReadbackResult decodeFrameChannel(Channel channel,
       break;
     case ANARI_FLOAT32_VEC4: {
       const auto *pixels = static_cast<const float *>(mapped.data);
+      auto *dst = result.image.rgba.data();
       for (size_t i = 0; i < outputBytes; ++i)
-        result.image.rgba[i] = toU8(pixels[i]);
+        dst[i] = toU8(pixels[i]);
       break;
     }
     }
@@ -206,13 +221,17 @@ FrameReadbackResult decodeFrameChannel(Channel channel,
     const auto *pixels = static_cast<const float *>(mapped.data);
     const float scale = depthScale > 0.f ? 1.f / depthScale : 0.f;
     auto *dst = result.image.rgba.data();
-    for (size_t i = 0; i < pixelCount; ++i, dst += 4) {
-      const uint8_t gray =
-          std::isfinite(pixels[i]) ? toU8(pixels[i] * scale) : 255;
-      dst[0] = gray;
-      dst[1] = gray;
-      dst[2] = gray;
-      dst[3] = 255;
+    for (size_t i = 0; i < pixelCount; ++i) {
+      const float depth = pixels[i];
+      // Non-finite depth (background) maps to white. Written as a compare
+      // rather than std::isfinite so the select stays branch-free.
+      const bool background =
+          !(std::abs(depth) <= std::numeric_limits<float>::max());
+      const uint8_t gray = background ? 255 : toU8(depth * scale);
+      dst[4 * i + 0] = gray;
+      dst[4 * i + 1] = gray;
+      dst[4 * i + 2] = gray;
+      dst[4 * i + 3] = 255;
     }
   } else if (channel == Channel::Albedo) {
     auto *dst = result.image.rgba.data();
@@ -266,14 +285,19 @@ FrameReadbackResult decodeFrameChannel(Channel channel,
   } else if (channel == Channel::PrimitiveId || channel == Channel::ObjectId
       || channel == Channel::InstanceId) {
     const auto *pixels = static_cast<const uint32_t *>(mapped.data);
+    const auto &palette = idPalette();
     auto *dst = result.image.rgba.data();
-    for (size_t i = 0; i < pixelCount; ++i, dst += 4) {
-      const auto color = scenes::colors::getColorFromPalette(pixels[i]);
-      dst[0] = toU8(color.x);
-      dst[1] = toU8(color.y);
-      dst[2] = toU8(color.z);
-      dst[3] = 255;
-    }
+    for (size_t i = 0; i < pixelCount; ++i, dst += 4)
+      std::memcpy(dst, palette[pixels[i] % palette.size()].data(), 4);
+  }
+
+  if (hasRawGroundTruth(channel)) {
+    result.raw.format = channel == Channel::Depth ? RawImage::Format::Float32
+                                                  : RawImage::Format::UInt32;
+    result.raw.width = mapped.width;
+    result.raw.height = mapped.height;
+    result.raw.values.resize(pixelCount);
+    std::memcpy(result.raw.values.data(), mapped.data, inputBytes);
   }
 
   return result;
@@ -291,5 +315,30 @@ FrameReadbackResult readFrameChannel(anari::Device device,
       channel, mapped.descriptor(), expectedWidth, expectedHeight, depthScale);
 }
 
+std::vector<FrameReadbackResult> readFrameChannels(anari::Device device,
+    anari::Frame frame,
+    const std::vector<Channel> &channels,
+    uint32_t expectedWidth,
+    uint32_t expectedHeight,
+    float depthScale)
+{
+  // A deque never moves its elements, so the mappings can stay in place
+  // until all of them are unmapped together on return.
+  std::deque<ScopedFrameMapping> mappings;
+  for (Channel channel : channels)
+    mappings.emplace_back(device, frame, frameChannelParameter(channel));
+
+  std::vector<FrameReadbackResult> results;
+  results.reserve(channels.size());
+  for (size_t i = 0; i < channels.size(); ++i) {
+    results.push_back(decodeFrameChannel(channels[i],
+        mappings[i].descriptor(),
+        expectedWidth,
+        expectedHeight,
+        depthScale));
+  }
+  return results;
+}
+
 } // namespace cts
 } // namespace anari
@@ -10,6 +10,7 @@
 // std
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace anari {
 namespace cts {
@@ -35,9 +36,11 @@ enum class FrameReadbackError
 };
 
 // A decoded comparison image or a structured validation/conversion failure.
+// A channel with hasRawGroundTruth() also keeps its buffer verbatim in `raw`.
 struct FrameReadbackResult
 {
   Image image;
+  RawImage raw;
   FrameReadbackError error{FrameReadbackError::None};
   std::string detail;
 
@@ -67,5 +70,17 @@ FrameReadbackResult readFrameChannel(
     uint32_t expectedHeight,
     float depthScale = 1.f);
 
+// Read several Channels of one rendered frame: every Channel is mapped before
+// any is decoded, and all of them are unmapped together once the last one is
+// decoded (or decoding throws). Results follow `channels` order; each fails or
+// succeeds on its own.
+std::vector<FrameReadbackResult> readFrameChannels(
+    anari::Device device,
+    anari::Frame frame,
+    const std::vector<Channel> &channels,
+    uint32_t expectedWidth,
+    uint32_t expectedHeight,
+    float depthScale = 1.f);
+
 } // namespace cts
 } // namespace anari
@@ -4,7 +4,14 @@
 #include "HtmlReport.h"
 
 #include "Report.h"
+#include "Scaling.h"
+#include "Timing.h"
+#include "Workdir.h"
+
+#include "helium/ParallelFor.h"
+
 // std
+#include <algorithm>
 #include <array>
 #include <cctype>
 #include <cmath>
@@ -386,7 +393,7 @@ function initMask(pane) {
       canvas.replaceWith(fb);
       slider.disabled = true;
       over.disabled = true;
-      slider.title = 'interactive thresholding needs an embedded (--embed) report';
+      slider.title = 'interactive thresholding covers the initially-shown cases (regenerate with --all)';
       return;
     }
     canvas.width = w; canvas.height = h;
@@ -437,46 +444,135 @@ std::string categoryId(const std::string &category)
   return id;
 }
 
-std::string readFileBytes(const std::filesystem::path &path, bool &ok)
+// What every row of one document shares.
+struct ReportContext
 {
-  std::ifstream in(path, std::ios::binary);
-  if (!in) {
-    ok = false;
-    return {};
+  std::filesystem::path root;
+  bool embed{false};
+  bool includeAll{false};
+  std::string srcPrefix;
+  // Cached diff thumbnails, by the diff's workdir-relative path.
+  std::map<std::string, std::filesystem::path> thumbnails;
+};
+
+// Where an image's pixels come from: a file inlined as a base64 data URI as
+// the document is written, or an already-escaped URL. Both are empty when
+// there is nothing to show.
+struct ImageSource
+{
+  std::filesystem::path inlineFile;
+  std::string url;
+
+  bool empty() const
+  {
+    return inlineFile.empty() && url.empty();
   }
-  std::ostringstream buffer;
-  buffer << in.rdbuf();
-  ok = true;
-  return buffer.str();
+};
+
+void writeImageSource(std::ostream &os, const ImageSource &src)
+{
+  if (src.inlineFile.empty()) {
+    os << src.url;
+    return;
+  }
+  os << "data:image/png;base64,";
+  writeBase64File(os, src.inlineFile);
 }
 
-// The src for a channel image, or empty when there is nothing to show: an
-// absent path, a missing file, or an image excluded from an embedded file
-// because its Case is not in the initial (embedded) selection. srcPrefix
-// rebases the sidecar's workdir-relative path onto the HTML document's
-// directory for non-embedded references.
-std::string imageSrc(const std::filesystem::path &root,
+// The source for a channel image, or none: an absent path, a missing file, or
+// an image excluded from an embedded file because its Case is not in the
+// initial (embedded) selection. srcPrefix rebases the sidecar's workdir-
+// relative path onto the HTML document's directory for references.
+ImageSource imageSource(const ReportContext &ctx,
     const std::string &relPath,
-    bool embed,
-    bool selected,
-    const std::string &srcPrefix)
+    bool inlined,
+    bool selected)
 {
-  if (relPath.empty())
+  if (relPath.empty() || (inlined && !selected))
     return {};
-  const auto abs = root / relPath;
-  if (embed) {
-    if (!selected)
-      return {};
-    bool ok = false;
-    const std::string bytes = readFileBytes(abs, ok);
-    if (!ok)
-      return {};
-    return "data:image/png;base64," + base64Encode(bytes);
-  }
+  const auto abs = ctx.root / relPath;
   std::error_code ec;
   if (!std::filesystem::is_regular_file(abs, ec))
     return {};
-  return htmlEscape(srcPrefix + relPath);
+  if (inlined)
+    return {abs, {}};
+  return {{}, htmlEscape(ctx.srcPrefix + relPath)};
+}
+
+// The diff is the one image the mask canvas reads back, and a canvas drawn
+// from a file:// reference is tainted. So a selected Case always inlines its
+// diff: full size when embedding, else its cached thumbnail. Other diffs fall
+// back to a reference, which the script shows as a static image.
+ImageSource diffSource(
+    const ReportContext &ctx, const std::string &relPath, bool selected)
+{
+  if (ctx.embed)
+    return imageSource(ctx, relPath, true, selected);
+  if (selected) {
+    auto thumbnail = ctx.thumbnails.find(relPath);
+    if (thumbnail != ctx.thumbnails.end())
+      return {thumbnail->second, {}};
+  }
+  return imageSource(ctx, relPath, false, selected);
+}
+
+// Bring the thumbnail of every diff a non-embedded report inlines up to date,
+// in parallel, and return the usable ones by the diff's workdir-relative path.
+// A cached thumbnail of the same edge is reused unless its source is newer; a
+// diff that cannot be read or downscaled is left out and referenced instead.
+std::map<std::string, std::filesystem::path> prepareThumbnails(
+    const std::filesystem::path &root,
+    const std::map<std::string, CaseResult> &results,
+    const HtmlOptions &opts)
+{
+  std::map<std::string, std::filesystem::path> thumbnails;
+  if (opts.embed || opts.thumbnailEdge == 0)
+    return thumbnails;
+
+  std::vector<std::string> sources;
+  for (const auto &[key, r] : results) {
+    if (!opts.includeAll && r.verdict != Verdict::Failed)
+      continue;
+    for (const auto &ch : r.channels)
+      if (!ch.diffImage.empty())
+        sources.push_back(ch.diffImage);
+  }
+  if (sources.empty())
+    return thumbnails;
+
+  // Thumbnails of each edge length are kept apart, so a report with another
+  // edge never picks up a cached thumbnail of the wrong size.
+  const std::filesystem::path dir = Workdir(root).thumbnailsDir()
+      / std::to_string(opts.thumbnailEdge);
+  std::vector<uint8_t> ready(sources.size(), 0);
+  helium::tasking::parallelFor(sources.size(), opts.threads, [&](size_t i) {
+    const auto source = root / sources[i];
+    const auto thumbnail = dir / sources[i];
+    std::error_code ec;
+    const auto sourceTime = std::filesystem::last_write_time(source, ec);
+    if (ec)
+      return;
+    const auto cachedTime = std::filesystem::last_write_time(thumbnail, ec);
+    if (!ec && cachedTime >= sourceTime) {
+      ready[i] = 1;
+      return;
+    }
+    const Image image = loadPNG(source.string());
+    if (!image.valid())
+      return;
+    // Stage and rename, so an interrupted write never looks current.
+    auto staged = thumbnail;
+    staged += ".tmp";
+    if (!savePNG(staged.string(), downscaleMax(image, opts.thumbnailEdge)))
+      return;
+    std::filesystem::rename(staged, thumbnail, ec);
+    ready[i] = !ec;
+  });
+
+  for (size_t i = 0; i < sources.size(); ++i)
+    if (ready[i])
+      thumbnails.emplace(sources[i], dir / sources[i]);
+  return thumbnails;
 }
 
 // The prefix that rebases a workdir-relative image path onto the HTML
@@ -571,41 +667,62 @@ const char *verdictLabel(Verdict v)
   return "Skipped";
 }
 
-// The one-line metric summary shown on a collapsed row (first channel).
+// The one-line metric summary shown on a collapsed row (first channel, or a
+// scaling Case's render throughput).
+// A metric's score in the table's units, and its threshold at the table's
+// precision.
+std::string metricScore(const std::string &name, double value)
+{
+  if (name == "psnr")
+    return std::isfinite(value) ? fixed(value, 1) + " dB" : "—";
+  if (name == "match")
+    return std::isfinite(value) ? fixed(value * 100.0, 2) + "%" : "—";
+  return fixed(value, 3);
+}
+
+std::string metricThreshold(const std::string &name, double value)
+{
+  if (name == "psnr")
+    return fixed(value, 0);
+  if (name == "match")
+    return fixed(value * 100.0, 0) + "%";
+  return fixed(value, 2);
+}
+
 std::string primaryMetric(const CaseResult &r)
 {
+  if (r.verdict != Verdict::Skipped && r.scaling) {
+    const double mrays = throughput(r).mraysPerSecond;
+    return std::isfinite(mrays) ? fixed(mrays, 1) + " Mrays/s" : "—";
+  }
   if (r.verdict == Verdict::Skipped || r.channels.empty())
     return "skipped";
   const ChannelResult &ch = r.channels.front();
   std::string out;
   auto ssim = ch.metrics.find("ssim");
   auto psnr = ch.metrics.find("psnr");
+  auto match = ch.metrics.find("match");
   if (ssim != ch.metrics.end())
     out += "SSIM " + fixed(ssim->second, 3);
   if (psnr != ch.metrics.end())
     out += (out.empty() ? "" : " · ") + std::string("PSNR ")
         + fixed(psnr->second, 1) + " dB";
+  if (match != ch.metrics.end())
+    out += (out.empty() ? "" : " · ") + std::string("match ")
+        + metricScore("match", match->second);
   return out.empty() ? "—" : out;
 }
 
-void appendComparePane(std::ostringstream &os,
-    const std::filesystem::path &root,
+void appendComparePane(std::ostream &os,
+    const ReportContext &ctx,
     const ChannelResult &ch,
-    bool embed,
-    bool selected,
-    const std::string &srcPrefix)
+    bool selected)
 {
-  const std::string result =
-      imageSrc(root, ch.resultImage, embed, selected, srcPrefix);
-  const std::string truth =
-      imageSrc(root, ch.groundTruthImage, embed, selected, srcPrefix);
-  // Always embed the diff (the only image the mask canvas reads back), so its
-  // interactive threshold and "over actual" work even in a non-embedded report
-  // where a referenced file:// diff would taint the canvas. Bounded by the same
-  // `selected` rule as embedding, so a failures-only report embeds only failed
-  // cases' diffs. The larger result/reference images still follow `embed`.
-  const std::string diff =
-      imageSrc(root, ch.diffImage, /*embed=*/true, selected, srcPrefix);
+  const ImageSource result =
+      imageSource(ctx, ch.resultImage, ctx.embed, selected);
+  const ImageSource truth =
+      imageSource(ctx, ch.groundTruthImage, ctx.embed, selected);
+  const ImageSource diff = diffSource(ctx, ch.diffImage, selected);
 
   os << "<div class=\"compare\">";
 
@@ -621,14 +738,18 @@ void appendComparePane(std::ostringstream &os,
   os << "</div>";
   if (!result.empty() || !truth.empty()) {
     os << "<div class=\"stage\" data-ab=\"result\">";
-    if (!result.empty())
+    if (!result.empty()) {
       os << "<img class=\"layer\" data-role=\"result\" loading=\"lazy\" alt=\"actual\" "
-            "src=\""
-         << result << "\">";
-    if (!truth.empty())
+            "src=\"";
+      writeImageSource(os, result);
+      os << "\">";
+    }
+    if (!truth.empty()) {
       os << "<img class=\"layer\" data-role=\"groundTruth\" loading=\"lazy\" "
-            "alt=\"reference\" src=\""
-         << truth << "\">";
+            "alt=\"reference\" src=\"";
+      writeImageSource(os, truth);
+      os << "\">";
+    }
     os << "<span class=\"tag actual\">ACTUAL — THIS RUN</span>"
           "<span class=\"tag reference\">REFERENCE — GROUND TRUTH</span></div>"
           "<div class=\"cap-line\">Click image or toggle to flip between "
@@ -641,10 +762,10 @@ void appendComparePane(std::ostringstream &os,
 
   // Difference-mask pane: an interactive canvas that thresholds the diff image
   // live (slider), paints exceeded pixels red, and can composite them over a
-  // dimmed actual render. The canvas reads diff pixels; the diff is always
-  // embedded (above) so this works regardless of --embed. The tainted-canvas
-  // fallback below still guards cases whose diff is not embedded (an
-  // initially-hidden passing case in a failures-only report).
+  // dimmed actual render. The canvas reads diff pixels, which diffSource()
+  // inlines for every selected Case; the script's tainted-canvas fallback
+  // guards the rest (an initially-hidden passing case in a failures-only
+  // report).
   os << "<div class=\"mask-pane\"><div class=\"pane-head\"><span "
         "class=\"lbl\">Difference mask<span class=\"chan chan-"
      << channelName(ch.channel) << "\">" << channelTag(ch.channel)
@@ -654,8 +775,9 @@ void appendComparePane(std::ostringstream &os,
           "class=\"over-actual\"> over actual</label>";
   os << "</div>";
   if (!diff.empty()) {
-    os << "<div class=\"maskbox\"><canvas class=\"maskcanvas\" data-diff=\""
-       << diff << "\"></canvas></div>";
+    os << "<div class=\"maskbox\"><canvas class=\"maskcanvas\" data-diff=\"";
+    writeImageSource(os, diff);
+    os << "\"></canvas></div>";
     os << "<div class=\"threshrow\"><span class=\"tlabel\">threshold</span>"
           "<input type=\"range\" class=\"threshslider\" min=\"0\" max=\"255\" "
           "value=\"16\" aria-label=\"difference threshold\"><span class=\"tval "
@@ -670,52 +792,63 @@ void appendComparePane(std::ostringstream &os,
   os << "</div>"; // compare
 }
 
-void appendMetricsTable(std::ostringstream &os, const CaseResult &r)
+void appendMetricsTable(std::ostream &os, const CaseResult &r)
 {
+  // One column per metric any channel recorded, in report order: image
+  // channels have SSIM and PSNR, raw depth and id channels a match fraction.
+  std::vector<std::string> columns;
+  for (const auto &m : kReportMetrics) {
+    for (const auto &ch : r.channels) {
+      if (ch.metrics.count(m)) {
+        columns.push_back(m);
+        break;
+      }
+    }
+  }
+  std::string grid;
+  if (columns.size() != 2) {
+    grid = " style=\"grid-template-columns:repeat("
+        + std::to_string(columns.size() + 1) + ",1fr) 70px\"";
+  }
+
   os << "<div><div class=\"lbl\">Channel metrics</div><div class=\"tbl\">"
-        "<div class=\"thead\"><div>Channel</div><div>SSIM</div><div>PSNR</div>"
-        "<div class=\"res\">Result</div></div>";
+        "<div class=\"thead\""
+     << grid << "><div>Channel</div>";
+  for (const auto &m : columns) {
+    std::string label = m;
+    std::transform(label.begin(), label.end(), label.begin(), ::toupper);
+    os << "<div>" << htmlEscape(label) << "</div>";
+  }
+  os << "<div class=\"res\">Result</div></div>";
   for (const auto &ch : r.channels) {
-    auto ssim = ch.metrics.find("ssim");
-    auto psnr = ch.metrics.find("psnr");
     const bool ok = ch.passed;
-    os << "<div class=\"trow\"><div class=\"kmono dark-fg\">"
+    os << "<div class=\"trow\"" << grid << "><div class=\"kmono dark-fg\">"
        << htmlEscape(channelName(ch.channel)) << "</div>";
-    // SSIM
-    os << "<div class=\"kmono "
-       << (ssim != ch.metrics.end() && metricPasses(ssim->second, ch, "ssim")
-                  ? "dark-fg"
-                  : "fail-fg")
-       << "\">";
-    if (ssim != ch.metrics.end()) {
-      os << fixed(ssim->second, 3);
-      auto t = ch.thresholds.find("ssim");
-      if (t != ch.thresholds.end())
-        os << " <span class=\"skip-fg\">/ " << fixed(t->second, 2) << "</span>";
-    } else
-      os << "—";
-    os << "</div>";
-    // PSNR
-    os << "<div class=\"kmono "
-       << (psnr != ch.metrics.end() && metricPasses(psnr->second, ch, "psnr")
-                  ? "dark-fg"
-                  : "fail-fg")
-       << "\">";
-    if (psnr != ch.metrics.end()) {
-      os << fixed(psnr->second, 1) << " dB";
-      auto t = ch.thresholds.find("psnr");
-      if (t != ch.thresholds.end())
-        os << " <span class=\"skip-fg\">/ " << fixed(t->second, 0) << "</span>";
-    } else
-      os << "—";
-    os << "</div>";
+    for (const auto &m : columns) {
+      auto it = ch.metrics.find(m);
+      os << "<div class=\"kmono "
+         << (it != ch.metrics.end() && metricPasses(it->second, ch, m)
+                    ? "dark-fg"
+                    : "fail-fg")
+         << "\">";
+      if (it != ch.metrics.end()) {
+        os << metricScore(m, it->second);
+        auto t = ch.thresholds.find(m);
+        if (t != ch.thresholds.end()) {
+          os << " <span class=\"skip-fg\">/ " << metricThreshold(m, t->second)
+             << "</span>";
+        }
+      } else
+        os << "—";
+      os << "</div>";
+    }
     os << "<div class=\"res " << (ok ? "pass-fg" : "fail-fg") << "\">"
        << (ok ? "PASS" : "FAIL") << "</div></div>";
   }
   os << "</div></div>";
 }
 
-void appendConfigTable(std::ostringstream &os, const CaseResult &r)
+void appendConfigTable(std::ostream &os, const CaseResult &r)
 {
   const std::string device =
       r.device.library + " · " + r.device.device + " / " + r.device.renderer;
@@ -733,6 +866,24 @@ void appendConfigTable(std::ostringstream &os, const CaseResult &r)
   rowKV("Axes", axisText(r));
   rowKV("Detail", r.detail);
   rowKV("Duration", dur);
+  if (r.scaling) {
+    const ScalingResult &sc = *r.scaling;
+    const Throughput t = throughput(r);
+    rowKV("Workload",
+        std::to_string(sc.elements) + " " + sc.unit + " at "
+            + std::to_string(sc.width) + "x" + std::to_string(sc.height));
+    rowKV("Built",
+        std::isfinite(t.elementsPerSecond)
+            ? fixed(t.elementsPerSecond / 1e6, 2) + " M " + sc.unit + "/s"
+            : "");
+    rowKV("Rendered",
+        std::isfinite(t.mraysPerSecond) ? fixed(t.mraysPerSecond, 1) + " Mrays/s"
+                                        : "");
+    rowKV("Memory",
+        sc.memoryBytes ? std::to_string(*sc.memoryBytes) + " bytes ("
+                + fixed(t.bytesPerElement, 1) + " per element)"
+                       : "");
+  }
   os << "<div class=\"r\"><span class=\"kk\">Ground truth</span><span "
         "class=\"vv\" style=\"color:var(--link);\">"
      << htmlEscape(r.groundTruthKey.empty() ? "—" : r.groundTruthKey)
@@ -740,6 +891,55 @@ void appendConfigTable(std::ostringstream &os, const CaseResult &r)
   os << "</div></div>";
 }
 
+// Timings of a performance run: each measure's median and 95th percentile,
+// against the baseline run's when the Case was compared with one.
+void appendTimingTable(std::ostream &os, const TimingResult &t)
+{
+  os << "<div><div class=\"lbl\">Timing (" << t.frameMs.size()
+     << " frames after " << t.warmupFrames
+     << " warm-up)</div><div class=\"tbl\">"
+        "<div class=\"thead\"><div>Measure</div><div>Median</div><div>p95</div>"
+        "<div class=\"res\">Result</div></div>";
+  auto ms = [](double v) { return fixed(v, 2) + " ms"; };
+  auto row = [&](const std::string &measure,
+                 const std::string &median,
+                 const std::string &p95,
+                 const char *result,
+                 const char *fg) {
+    os << "<div class=\"trow\"><div class=\"kmono dark-fg\">"
+       << htmlEscape(measure) << "</div><div class=\"kmono " << fg << "\">"
+       << median << "</div><div class=\"kmono " << fg << "\">" << p95
+       << "</div><div class=\"res " << fg << "\">" << result << "</div></div>";
+  };
+  if (t.comparisons.empty()) {
+    row("frame", ms(median(t.frameMs)), ms(percentile(t.frameMs, 95.0)), "—",
+        "dark-fg");
+    if (!t.deviceMs.empty()) {
+      row("device", ms(median(t.deviceMs)), ms(percentile(t.deviceMs, 95.0)),
+          "—", "dark-fg");
+    }
+    row("build", ms(t.buildMs), "—", "—", "dark-fg");
+    row("commit", ms(t.commitMs), "—", "—", "dark-fg");
+  } else {
+    for (const auto &c : t.comparisons) {
+      const bool tested = std::isfinite(c.pValue);
+      const char *fg =
+          c.regressed ? "fail-fg" : (tested ? "dark-fg" : "skip-fg");
+      const std::string change = c.baselineMedian > 0.0
+          ? " <span class=\"skip-fg\">("
+              + (c.median >= c.baselineMedian ? std::string("+") : "")
+              + fixed((c.median / c.baselineMedian - 1.0) * 100.0, 1) + "%)</span>"
+          : "";
+      row(c.measure,
+          fixed(c.baselineMedian, 2) + " → " + ms(c.median) + change,
+          tested ? fixed(c.baselineP95, 2) + " → " + ms(c.p95) : "—",
+          c.regressed ? "SLOWER" : (tested ? "OK" : "—"),
+          c.regressed ? "fail-fg" : fg);
+    }
+  }
+  os << "</div></div>";
+}
+
 bool hasAnyImage(const CaseResult &r)
 {
   for (const auto &ch : r.channels)
@@ -749,17 +949,14 @@ bool hasAnyImage(const CaseResult &r)
   return false;
 }
 
-void appendTestRow(std::ostringstream &os,
-    const std::filesystem::path &root,
+void appendTestRow(std::ostream &os,
+    const ReportContext &ctx,
     const std::string &key,
-    const CaseResult &r,
-    bool embed,
-    bool includeAll,
-    const std::string &srcPrefix)
+    const CaseResult &r)
 {
   // Embedded reports carry images only for the initially-shown Cases (failures
   // unless --all); passing Cases still appear, with their metadata.
-  const bool selected = includeAll || r.verdict == Verdict::Failed;
+  const bool selected = ctx.includeAll || r.verdict == Verdict::Failed;
   const char *vc = verdictClass(r.verdict);
   const std::string name = r.test + " / " + r.caseId;
   const std::string searchText =
@@ -802,12 +999,15 @@ void appendTestRow(std::ostringstream &os,
   } else {
     // One comparison block per channel.
     for (const auto &ch : r.channels)
-      appendComparePane(os, root, ch, embed, selected, srcPrefix);
+      appendComparePane(os, ctx, ch, selected);
   }
-  if (!r.channels.empty()) {
+  if (!r.channels.empty() || r.timing) {
     os << "<div class=\"meta\">";
-    appendMetricsTable(os, r);
+    if (!r.channels.empty())
+      appendMetricsTable(os, r);
     appendConfigTable(os, r);
+    if (r.timing)
+      appendTimingTable(os, *r.timing);
     os << "</div>";
   }
   os << "</div>"; // panel
@@ -889,13 +1089,37 @@ std::string base64Encode(const std::string &bytes)
   return out;
 }
 
-std::string generateHtml(const std::filesystem::path &workdir,
+bool writeBase64File(std::ostream &out, const std::filesystem::path &path)
+{
+  std::ifstream in(path, std::ios::binary);
+  if (!in)
+    return false;
+  // A multiple of 3 bytes, so only the final chunk carries padding.
+  std::string chunk(3 * 16384, '\0');
+  while (in) {
+    in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    const auto n = static_cast<size_t>(in.gcount());
+    if (n == 0)
+      break;
+    chunk.resize(n);
+    out << base64Encode(chunk);
+  }
+  return in.eof() && bool(out);
+}
+
+void writeHtml(std::ostream &os,
+    const std::filesystem::path &workdir,
     const std::map<std::string, CaseResult> &results,
     const HtmlOptions &opts)
 {
   const Summary s = summarize(results);
-  const std::string srcPrefix =
-      opts.embed ? std::string() : imageSrcPrefix(workdir, opts.htmlPath);
+  ReportContext ctx;
+  ctx.root = workdir;
+  ctx.embed = opts.embed;
+  ctx.includeAll = opts.includeAll;
+  if (!opts.embed)
+    ctx.srcPrefix = imageSrcPrefix(workdir, opts.htmlPath);
+  ctx.thumbnails = prepareThumbnails(workdir, results, opts);
   const int executed = s.passed + s.failed;
   const int passRate = executed > 0
       ? static_cast<int>(std::lround(100.0 * s.passed / executed))
@@ -910,7 +1134,6 @@ std::string generateHtml(const std::filesystem::path &workdir,
   const std::string runName = workdir.filename().string();
   const std::string title = "ANARI CTS — " + runName;
 
-  std::ostringstream os;
   os << "<!DOCTYPE html>\n<html lang=\"en\"><head><meta charset=\"utf-8\">"
         "<meta name=\"viewport\" content=\"width=device-width, "
         "initial-scale=1\"><title>"
@@ -962,6 +1185,12 @@ std::string generateHtml(const std::filesystem::path &workdir,
      << fixed(wallMs, 0)
      << " ms</div><div class=\"sub\">SSIM ≥ 0.70 · PSNR ≥ "
         "20</div></div>";
+  if (s.timed > 0) {
+    os << "<div class=\"stat\"><div class=\"k\">Timing regressions</div>"
+          "<div class=\"v kmono\">"
+       << s.timingRegressions << "</div><div class=\"sub\">of " << s.timed
+       << " timed cases</div></div>";
+  }
   os << "</div></section>";
 
   // Toolbar: search + status filter + count.
@@ -1025,7 +1254,7 @@ std::string generateHtml(const std::filesystem::path &workdir,
          << c.failed << "F</span><span class=\"kmono skip-fg\" data-c=\"s\">"
          << c.skipped << "S</span></span></div>";
     }
-    appendTestRow(os, workdir, key, r, opts.embed, opts.includeAll, srcPrefix);
+    appendTestRow(os, ctx, key, r);
   }
   os << "</div>"; // #list
 
@@ -1035,8 +1264,69 @@ std::string generateHtml(const std::filesystem::path &workdir,
   os << "</section>";
 
   os << "</div><script>" << kScript << "</script></body></html>\n";
+}
+
+bool writeHtmlFile(const std::filesystem::path &workdir,
+    const std::map<std::string, CaseResult> &results,
+    const HtmlOptions &opts)
+{
+  const std::filesystem::path &path = opts.htmlPath;
+  std::error_code ec;
+  if (path.has_parent_path())
+    std::filesystem::create_directories(path.parent_path(), ec);
+  std::filesystem::path tmp = path;
+  tmp += ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!out)
+      return false;
+    writeHtml(out, workdir, results, opts);
+    if (!out) {
+      out.close();
+      std::filesystem::remove(tmp, ec);
+      return false;
+    }
+  }
+  std::filesystem::rename(tmp, path, ec);
+  if (ec) {
+    std::error_code ignored;
+    std::filesystem::remove(tmp, ignored);
+    return false;
+  }
+  return true;
+}
+
+std::string generateHtml(const std::filesystem::path &workdir,
+    const std::map<std::string, CaseResult> &results,
+    const HtmlOptions &opts)
+{
+  std::ostringstream os;
+  writeHtml(os, workdir, results, opts);
   return os.str();
 }
 
+Image downscaleMax(const Image &image, uint32_t maxEdge)
+{
+  const uint32_t edge = std::max(image.width, image.height);
+  if (!image.valid() || maxEdge == 0 || edge <= maxEdge)
+    return image;
+  Image out;
+  out.width = std::max<uint32_t>(1, uint64_t(image.width) * maxEdge / edge);
+  out.height = std::max<uint32_t>(1, uint64_t(image.height) * maxEdge / edge);
+  out.rgba.assign(out.pixelCount() * 4, 0);
+  // Every source pixel lands in exactly one output pixel.
+  for (uint32_t y = 0; y < image.height; ++y) {
+    const size_t oy = uint64_t(y) * out.height / image.height;
+    for (uint32_t x = 0; x < image.width; ++x) {
+      const size_t ox = uint64_t(x) * out.width / image.width;
+      const uint8_t *src = &image.rgba[(size_t(y) * image.width + x) * 4];
+      uint8_t *dst = &out.rgba[(oy * out.width + ox) * 4];
+      for (int c = 0; c < 4; ++c)
+        dst[c] = std::max(dst[c], src[c]);
+    }
+  }
+  return out;
+}
+
 } // namespace cts
 } // namespace anari
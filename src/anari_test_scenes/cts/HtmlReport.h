@@ -3,17 +3,22 @@
 
 #pragma once
 
+#include "Image.h"
 #include "Sidecar.h"
 // std
+#include <cstdint>
 #include <filesystem>
 #include <map>
+#include <ostream>
 #include <string>
 
 // The HTML report: a single self-contained, interactive document rendered from
 // a run's results tree. Every Case's metadata is always present so the client
 // can filter by verdict and search without a server; which images travel with
 // the file depends on `embed` and the initial filter (a passing Case is not
-// embedded in a failures-only report). See Report.h for the shared aggregation.
+// embedded in a failures-only report). The document is streamed Case by Case,
+// so producing it holds at most one image in memory whatever the catalog size.
+// See Report.h for the shared aggregation.
 namespace anari {
 namespace cts {
 
@@ -31,18 +36,46 @@ struct HtmlOptions
   // Empty keeps them workdir-relative (only correct for a document placed in
   // the workdir root).
   std::filesystem::path htmlPath;
+  // The longest edge of the cached diff thumbnails a non-embedded report
+  // inlines for its difference masks (see Workdir::thumbnailsDir()); 0
+  // references the full-size diffs instead.
+  uint32_t thumbnailEdge{256};
+  // Worker threads generating thumbnails; 0 uses the hardware concurrency.
+  uint32_t threads{0};
 };
 
-// Render the full HTML document for a run's results tree.
+// Stream the full HTML document for a run's results tree to `out`.
+void writeHtml(std::ostream &out,
+    const std::filesystem::path &workdir,
+    const std::map<std::string, CaseResult> &results,
+    const HtmlOptions &opts);
+
+// Write the document to opts.htmlPath through a temporary sibling renamed into
+// place, creating parent directories as needed; false on failure.
+bool writeHtmlFile(const std::filesystem::path &workdir,
+    const std::map<std::string, CaseResult> &results,
+    const HtmlOptions &opts);
+
+// The full HTML document as one string.
 std::string generateHtml(const std::filesystem::path &workdir,
     const std::map<std::string, CaseResult> &results,
     const HtmlOptions &opts);
 
+// A copy of `image` at most `maxEdge` pixels on its longer side, keeping the
+// aspect ratio. Each output pixel takes the per-channel maximum of the source
+// pixels it covers, so no difference above a threshold is lost to averaging.
+// Images already within the bound are returned unchanged.
+Image downscaleMax(const Image &image, uint32_t maxEdge);
+
 // Escape text for HTML text and double-quoted attribute content.
 std::string htmlEscape(const std::string &text);
 
 // Standard base64 of arbitrary bytes (no line wrapping).
 std::string base64Encode(const std::string &bytes);
 
+// Stream a file's bytes to `out` as base64, reading a chunk at a time; false
+// when the file cannot be read.
+bool writeBase64File(std::ostream &out, const std::filesystem::path &path);
+
 } // namespace cts
 } // namespace anari
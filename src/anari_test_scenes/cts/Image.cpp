@@ -6,7 +6,10 @@
 #include "stb_image.h"
 #include "stb_image_write.h"
 // std
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 
 namespace anari {
 namespace cts {
@@ -14,25 +17,27 @@ namespace cts {
 Image loadPNG(const std::string &path)
 {
   int w = 0, h = 0, channels = 0;
-  // Files are stored top-left; flip on load so row 0 lands at the bottom again,
-  // keeping the in-memory Image in ANARI's bottom-left convention. Restore the
-  // global flag afterward so we don't leak it into the scene texture loader,
-  // which manages this flag itself.
-  stbi_set_flip_vertically_on_load(1);
   // Force 4 channels (RGBA) regardless of the file's native channel count.
   unsigned char *pixels = stbi_load(path.c_str(), &w, &h, &channels, 4);
-  stbi_set_flip_vertically_on_load(0);
   if (pixels == nullptr || w <= 0 || h <= 0) {
     if (pixels)
       stbi_image_free(pixels);
     return {};
   }
 
+  // Files are stored top-left; flip here so row 0 lands at the bottom again,
+  // keeping the in-memory Image in ANARI's bottom-left convention. Flipping
+  // rows ourselves rather than through stb's global flip flag keeps loads and
+  // saves safe to run from several threads at once.
   Image image;
   image.width = static_cast<uint32_t>(w);
   image.height = static_cast<uint32_t>(h);
-  const size_t count = static_cast<size_t>(w) * h * 4;
-  image.rgba.assign(pixels, pixels + count);
+  const size_t stride = static_cast<size_t>(w) * 4;
+  image.rgba.resize(stride * h);
+  for (int y = 0; y < h; ++y) {
+    const unsigned char *row = pixels + stride * (h - 1 - y);
+    std::copy(row, row + stride, image.rgba.data() + stride * y);
+  }
   stbi_image_free(pixels);
   return image;
 }
@@ -50,20 +55,85 @@ bool savePNG(const std::string &path, const Image &image)
       return false;
   }
 
-  // Image rows run bottom-to-top (ANARI convention); flip on write so the PNG
-  // file is stored top-left and views right-side-up. Restore the global flag
-  // afterward to keep this self-contained.
-  const int stride = static_cast<int>(image.width) * 4;
-  stbi_flip_vertically_on_write(1);
+  // Image rows run bottom-to-top (ANARI convention); write them in reverse so
+  // the PNG file is stored top-left and views right-side-up.
+  const size_t stride = static_cast<size_t>(image.width) * 4;
+  std::vector<uint8_t> flipped(image.rgba.size());
+  for (uint32_t y = 0; y < image.height; ++y) {
+    const uint8_t *row = image.rgba.data() + stride * (image.height - 1 - y);
+    std::copy(row, row + stride, flipped.data() + stride * y);
+  }
   const int ok = stbi_write_png(path.c_str(),
       static_cast<int>(image.width),
       static_cast<int>(image.height),
       4,
-      image.rgba.data(),
-      stride);
-  stbi_flip_vertically_on_write(0);
+      flipped.data(),
+      static_cast<int>(stride));
   return ok != 0;
 }
 
+namespace {
+
+constexpr char kRawMagic[8] = {'A', 'N', 'A', 'R', 'I', 'R', 'A', 'W'};
+
+} // namespace
+
+RawImage loadRaw(const std::string &path)
+{
+  std::ifstream in(path, std::ios::binary);
+  char magic[sizeof(kRawMagic)] = {};
+  uint32_t header[3] = {};
+  if (!in.read(magic, sizeof(magic))
+      || std::memcmp(magic, kRawMagic, sizeof(magic)) != 0
+      || !in.read(reinterpret_cast<char *>(header), sizeof(header)))
+    return {};
+
+  RawImage image;
+  image.format = static_cast<RawImage::Format>(header[0]);
+  image.width = header[1];
+  image.height = header[2];
+  if ((image.format != RawImage::Format::Float32
+          && image.format != RawImage::Format::UInt32)
+      || image.width == 0 || image.height == 0)
+    return {};
+
+  // Size the buffer from the file, not the header, so a corrupt header cannot
+  // request an arbitrary allocation.
+  const auto dataStart = in.tellg();
+  in.seekg(0, std::ios::end);
+  const auto dataBytes = static_cast<uint64_t>(in.tellg() - dataStart);
+  if (dataBytes != uint64_t(image.width) * image.height * sizeof(uint32_t))
+    return {};
+  in.seekg(dataStart);
+  image.values.resize(image.pixelCount());
+  if (!in.read(reinterpret_cast<char *>(image.values.data()),
+          static_cast<std::streamsize>(dataBytes)))
+    return {};
+  return image;
+}
+
+bool saveRaw(const std::string &path, const RawImage &image)
+{
+  if (!image.valid())
+    return false;
+
+  const std::filesystem::path p(path);
+  if (p.has_parent_path()) {
+    std::error_code ec;
+    std::filesystem::create_directories(p.parent_path(), ec);
+    if (ec)
+      return false;
+  }
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  const uint32_t header[3] = {
+      static_cast<uint32_t>(image.format), image.width, image.height};
+  out.write(kRawMagic, sizeof(kRawMagic));
+  out.write(reinterpret_cast<const char *>(header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(image.values.data()),
+      static_cast<std::streamsize>(image.values.size() * sizeof(uint32_t)));
+  return bool(out);
+}
+
 } // namespace cts
 } // namespace anari
@@ -34,6 +34,35 @@ struct Image
   }
 };
 
+// A frame buffer kept exactly as the device wrote it, one 32-bit value per
+// pixel in Image's row order: float32 for depth, uint32 for the id channels.
+// Ground truth for those channels is stored this way and compared value for
+// value, where an 8-bit visualization would quantize depth and fold ids
+// together.
+struct RawImage
+{
+  enum class Format : uint32_t
+  {
+    Float32 = 1,
+    UInt32 = 2,
+  };
+
+  Format format{Format::Float32};
+  uint32_t width{0};
+  uint32_t height{0};
+  std::vector<uint32_t> values; // width * height bit patterns
+
+  bool valid() const
+  {
+    return width > 0 && height > 0
+        && values.size() == static_cast<size_t>(width) * height;
+  }
+  size_t pixelCount() const
+  {
+    return static_cast<size_t>(width) * height;
+  }
+};
+
 // Load a PNG as RGBA8. Returns an invalid Image (valid() == false) on failure.
 Image loadPNG(const std::string &path);
 
@@ -42,5 +71,12 @@ Image loadPNG(const std::string &path);
 bool savePNG(
     const std::string &path, const Image &image);
 
+// Read and write a RawImage: an 8-byte "ANARIRAW" magic, then the format,
+// width and height as uint32, then the values, all in native byte order
+// (little-endian on every supported platform). loadRaw returns an invalid
+// RawImage on failure; saveRaw creates parent directories as needed.
+RawImage loadRaw(const std::string &path);
+bool saveRaw(const std::string &path, const RawImage &image);
+
 } // namespace cts
 } // namespace anari
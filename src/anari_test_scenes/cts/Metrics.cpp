@@ -2,10 +2,17 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "Metrics.h"
+
+#include "helium/ParallelFor.h"
+
 // std
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <limits>
+#include <memory>
 #include <vector>
 
 namespace anari {
@@ -15,112 +22,182 @@ namespace {
 
 constexpr double kDataRange = 255.0;
 
+// SSIM window size, and its half width
+constexpr int kWin = 7;
+constexpr int kPad = (kWin - 1) / 2;
+
+// Output rows per unit of SSIM work. Fixed, so the order in which the partial
+// sums are added up does not depend on the thread count.
+constexpr int kBandRows = 64;
+
 bool comparable(const Image &a, const Image &b)
 {
   return a.valid() && b.valid() && a.width == b.width && a.height == b.height;
 }
 
-// One channel of an image, with alpha composited over a white background and
-// rounded to 8 bits (matching skimage rgba2rgb + img_as_ubyte). Values 0..255.
-std::vector<double> compositedChannel(const Image &img, int c)
+// A channel value composited over a white background by its alpha and
+// rounded to 8 bits (matching skimage rgba2rgb + img_as_ubyte), for every
+// (value, alpha) pair
+using CompositeTable = std::array<std::array<uint8_t, 256>, 256>;
+
+const CompositeTable &compositeTable()
 {
-  std::vector<double> out(img.pixelCount());
-  for (size_t i = 0; i < out.size(); ++i) {
-    const double v = img.rgba[i * 4 + c];
-    const double a = img.rgba[i * 4 + 3];
-    double composited = v * a / kDataRange + (kDataRange - a);
-    composited = std::round(composited);
-    out[i] = composited < 0.0 ? 0.0 : (composited > 255.0 ? 255.0 : composited);
-  }
-  return out;
+  static const CompositeTable table = []() {
+    CompositeTable t;
+    for (int a = 0; a < 256; ++a) {
+      for (int v = 0; v < 256; ++v) {
+        double composited = double(v) * a / kDataRange + (kDataRange - a);
+        composited = std::round(composited);
+        composited = std::min(255.0, std::max(0.0, composited));
+        t[a][v] = static_cast<uint8_t>(composited);
+      }
+    }
+    return t;
+  }();
+  return table;
 }
 
-// scipy 'reflect' boundary: edge sample duplicated (-1 -> 0, N -> N-1).
-int reflectIndex(int i, int n)
+// One row of one channel, composited
+void compositeRow(
+    const Image &img, int row, int c, const CompositeTable &t, int32_t *out)
 {
-  if (n == 1)
-    return 0;
-  while (i < 0 || i >= n) {
-    if (i < 0)
-      i = -i - 1;
-    if (i >= n)
-      i = 2 * n - i - 1;
-  }
-  return i;
+  const uint8_t *px =
+      img.rgba.data() + static_cast<size_t>(row) * img.width * 4;
+  for (uint32_t i = 0; i < img.width; ++i)
+    out[i] = t[px[i * 4 + 3]][px[i * 4 + c]];
 }
 
-// Separable 7x7 box mean with reflect boundary == scipy uniform_filter(size=7).
-std::vector<double> boxMean(
-    const std::vector<double> &in, int w, int h, int win)
+// The window statistics of one image row: the sums of x, y, x^2, y^2 and xy
+// over the kWin pixels starting at each output column
+struct RowSums
 {
-  const int r = win / 2;
-  const double inv = 1.0 / win;
-
-  std::vector<double> tmp(in.size());
-  for (int y = 0; y < h; ++y) {
-    for (int x = 0; x < w; ++x) {
-      double sum = 0.0;
-      for (int k = -r; k <= r; ++k)
-        sum += in[static_cast<size_t>(y) * w + reflectIndex(x + k, w)];
-      tmp[static_cast<size_t>(y) * w + x] = sum * inv;
-    }
+  std::array<std::vector<int32_t>, 5> s;
+
+  void resize(size_t n)
+  {
+    for (auto &v : s)
+      v.resize(n);
   }
+};
 
-  std::vector<double> out(in.size());
-  for (int y = 0; y < h; ++y) {
-    for (int x = 0; x < w; ++x) {
-      double sum = 0.0;
-      for (int k = -r; k <= r; ++k)
-        sum += tmp[static_cast<size_t>(reflectIndex(y + k, h)) * w + x];
-      out[static_cast<size_t>(y) * w + x] = sum * inv;
-    }
+// The rows one thread works on
+struct SsimScratch
+{
+  // composited x and y of one image row, then x^2, y^2 and xy
+  RowSums values;
+  // the RowSums of the rows in the window, and their total
+  std::array<RowSums, kWin> ring;
+  RowSums acc;
+  // one output row of the SSIM map
+  std::vector<double> map;
+
+  explicit SsimScratch(int width)
+  {
+    values.resize(width);
+    for (auto &r : ring)
+      r.resize(width - 2 * kPad);
+    acc.resize(width - 2 * kPad);
+    map.resize(width - 2 * kPad);
   }
-  return out;
-}
+};
 
-double ssimChannel(
-    const std::vector<double> &x, const std::vector<double> &y, int w, int h)
+// Sum of the SSIM map over the interior output rows [r0, r1) of one channel.
+//
+// Only interior pixels count towards the mean, and their windows lie wholly
+// inside the image, so the box sums need no boundary handling. The inputs
+// are 8-bit, so every sum is exact in 32-bit integers. A window's statistics
+// come from horizontal kWin-sums of each row, accumulated down the columns
+// and updated as rows enter and leave the window. The inner loops run over
+// contiguous arrays without branches, which compilers vectorize.
+double ssimBand(const Image &ref,
+    const Image &cand,
+    int c,
+    int r0,
+    int r1,
+    SsimScratch &scratch)
 {
-  constexpr int win = 7;
+  const int w = static_cast<int>(ref.width);
+  const int ow = w - 2 * kPad;
+  auto &values = scratch.values.s;
+  auto &ring = scratch.ring;
+  auto &acc = scratch.acc;
+  double *map = scratch.map.data();
+  const CompositeTable &table = compositeTable();
+
   const double c1 = (0.01 * kDataRange) * (0.01 * kDataRange);
   const double c2 = (0.03 * kDataRange) * (0.03 * kDataRange);
-  const double np = static_cast<double>(win) * win;
+  const double np = static_cast<double>(kWin) * kWin;
+  const double invNp = 1.0 / np;
   const double covNorm = np / (np - 1.0); // sample covariance
 
-  const size_t n = x.size();
-  std::vector<double> xx(n), yy(n), xy(n);
-  for (size_t i = 0; i < n; ++i) {
-    xx[i] = x[i] * x[i];
-    yy[i] = y[i] * y[i];
-    xy[i] = x[i] * y[i];
-  }
-
-  const auto ux = boxMean(x, w, h, win);
-  const auto uy = boxMean(y, w, h, win);
-  const auto uxx = boxMean(xx, w, h, win);
-  const auto uyy = boxMean(yy, w, h, win);
-  const auto uxy = boxMean(xy, w, h, win);
+  for (auto &v : acc.s)
+    std::fill(v.begin(), v.end(), 0);
 
-  // Average the SSIM map over the valid interior (crop the window border).
-  const int pad = (win - 1) / 2;
   double sum = 0.0;
-  size_t count = 0;
-  for (int yy2 = pad; yy2 < h - pad; ++yy2) {
-    for (int xx2 = pad; xx2 < w - pad; ++xx2) {
-      const size_t i = static_cast<size_t>(yy2) * w + xx2;
-      const double vx = covNorm * (uxx[i] - ux[i] * ux[i]);
-      const double vy = covNorm * (uyy[i] - uy[i] * uy[i]);
-      const double vxy = covNorm * (uxy[i] - ux[i] * uy[i]);
-      const double a1 = 2.0 * ux[i] * uy[i] + c1;
+  // Input rows r0 - kPad .. r1 + kPad - 1 pass through the window
+  for (int iy = r0 - kPad, n = 0; iy < r1 + kPad; ++iy, ++n) {
+    RowSums &row = ring[n % kWin];
+    if (n >= kWin) {
+      for (int k = 0; k < 5; ++k) {
+        int32_t *a = acc.s[k].data();
+        const int32_t *leaving = row.s[k].data();
+        for (int i = 0; i < ow; ++i)
+          a[i] -= leaving[i];
+      }
+    }
+
+    compositeRow(ref, iy, c, table, values[0].data());
+    compositeRow(cand, iy, c, table, values[1].data());
+    const int32_t *x = values[0].data();
+    const int32_t *y = values[1].data();
+    int32_t *xx = values[2].data();
+    int32_t *yy = values[3].data();
+    int32_t *xy = values[4].data();
+    for (int i = 0; i < w; ++i) {
+      xx[i] = x[i] * x[i];
+      yy[i] = y[i] * y[i];
+      xy[i] = x[i] * y[i];
+    }
+    for (int k = 0; k < 5; ++k) {
+      const int32_t *v = values[k].data();
+      int32_t *out = row.s[k].data();
+      for (int i = 0; i < ow; ++i) {
+        out[i] = v[i] + v[i + 1] + v[i + 2] + v[i + 3] + v[i + 4] + v[i + 5]
+            + v[i + 6];
+      }
+    }
+
+    for (int k = 0; k < 5; ++k) {
+      int32_t *a = acc.s[k].data();
+      const int32_t *entering = row.s[k].data();
+      for (int i = 0; i < ow; ++i)
+        a[i] += entering[i];
+    }
+
+    if (n < kWin - 1)
+      continue;
+
+    const int32_t *ax = acc.s[0].data();
+    const int32_t *ay = acc.s[1].data();
+    const int32_t *axx = acc.s[2].data();
+    const int32_t *ayy = acc.s[3].data();
+    const int32_t *axy = acc.s[4].data();
+    for (int i = 0; i < ow; ++i) {
+      const double ux = ax[i] * invNp;
+      const double uy = ay[i] * invNp;
+      const double vx = covNorm * (axx[i] * invNp - ux * ux);
+      const double vy = covNorm * (ayy[i] * invNp - uy * uy);
+      const double vxy = covNorm * (axy[i] * invNp - ux * uy);
+      const double a1 = 2.0 * ux * uy + c1;
       const double a2 = 2.0 * vxy + c2;
-      const double b1 = ux[i] * ux[i] + uy[i] * uy[i] + c1;
+      const double b1 = ux * ux + uy * uy + c1;
       const double b2 = vx + vy + c2;
-      sum += (a1 * a2) / (b1 * b2);
-      ++count;
+      map[i] = (a1 * a2) / (b1 * b2);
     }
+    for (int i = 0; i < ow; ++i)
+      sum += map[i];
   }
-  return count ? sum / static_cast<double>(count)
-               : std::numeric_limits<double>::quiet_NaN();
+  return sum;
 }
 
 } // namespace
@@ -130,47 +207,103 @@ double psnr(const Image &reference, const Image &candidate)
   if (!comparable(reference, candidate))
     return std::numeric_limits<double>::quiet_NaN();
 
-  double squaredError = 0.0;
-  size_t count = 0;
-  for (int c = 0; c < 3; ++c) {
-    const auto r = compositedChannel(reference, c);
-    const auto k = compositedChannel(candidate, c);
-    for (size_t i = 0; i < r.size(); ++i) {
-      const double d = r[i] - k[i];
-      squaredError += d * d;
-      ++count;
+  const CompositeTable &table = compositeTable();
+  const size_t n = reference.pixelCount();
+  const uint8_t *r = reference.rgba.data();
+  const uint8_t *k = candidate.rgba.data();
+
+  // Exact: every term is an integer below 2^16
+  uint64_t squaredError = 0;
+  for (size_t i = 0; i < n; ++i) {
+    for (int c = 0; c < 3; ++c) {
+      const int d = int(table[r[i * 4 + 3]][r[i * 4 + c]])
+          - int(table[k[i * 4 + 3]][k[i * 4 + c]]);
+      squaredError += uint64_t(d * d);
     }
   }
 
+  const size_t count = n * 3;
   if (count == 0)
     return std::numeric_limits<double>::quiet_NaN();
 
-  const double mse = squaredError / static_cast<double>(count);
+  const double mse =
+      static_cast<double>(squaredError) / static_cast<double>(count);
   if (mse == 0.0)
     return std::numeric_limits<double>::infinity();
 
   return 10.0 * std::log10(kDataRange * kDataRange / mse);
 }
 
-double ssim(const Image &reference, const Image &candidate)
+double ssim(const Image &reference, const Image &candidate, uint32_t threads)
 {
   if (!comparable(reference, candidate))
     return std::numeric_limits<double>::quiet_NaN();
 
-  constexpr int win = 7;
   const int w = static_cast<int>(reference.width);
   const int h = static_cast<int>(reference.height);
-  if (w < win || h < win)
+  if (w < kWin || h < kWin)
     return std::numeric_limits<double>::quiet_NaN();
 
+  // Interior output rows kPad .. h - kPad - 1, in bands of kBandRows
+  const int rows = h - 2 * kPad;
+  const int bands = (rows + kBandRows - 1) / kBandRows;
+  std::vector<std::array<double, 3>> bandSums(bands);
+
+  // One scratch per thread, made by the thread on its first band
+  std::vector<std::unique_ptr<SsimScratch>> scratch(
+      helium::tasking::parallelThreadCount(bands, threads));
+  helium::tasking::parallelFor(bands, threads, [&](size_t b, uint32_t worker) {
+    if (!scratch[worker])
+      scratch[worker] = std::make_unique<SsimScratch>(w);
+    const int r0 = kPad + int(b) * kBandRows;
+    const int r1 = std::min(r0 + kBandRows, kPad + rows);
+    for (int c = 0; c < 3; ++c) {
+      bandSums[b][c] =
+          ssimBand(reference, candidate, c, r0, r1, *scratch[worker]);
+    }
+  });
+
+  const double count = static_cast<double>(rows) * (w - 2 * kPad);
   double sum = 0.0;
   for (int c = 0; c < 3; ++c) {
-    const auto x = compositedChannel(reference, c);
-    const auto y = compositedChannel(candidate, c);
-    sum += ssimChannel(x, y, w, h);
+    double channelSum = 0.0;
+    for (const auto &s : bandSums)
+      channelSum += s[c];
+    sum += channelSum / count;
   }
   return sum / 3.0;
 }
 
+bool rawValuesMatch(
+    RawImage::Format format, uint32_t reference, uint32_t candidate)
+{
+  if (format == RawImage::Format::UInt32 || reference == candidate)
+    return reference == candidate;
+  float a = 0.f, b = 0.f;
+  std::memcpy(&a, &reference, sizeof(a));
+  std::memcpy(&b, &candidate, sizeof(b));
+  if (!std::isfinite(a) || !std::isfinite(b))
+    return !std::isfinite(a) && !std::isfinite(b);
+  return std::abs(a - b)
+      <= kRawDepthTolerance * std::max(std::abs(a), std::abs(b));
+}
+
+double rawMatch(const RawImage &reference, const RawImage &candidate)
+{
+  if (!reference.valid() || !candidate.valid()
+      || reference.format != candidate.format
+      || reference.width != candidate.width
+      || reference.height != candidate.height)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  const size_t n = reference.pixelCount();
+  size_t matching = 0;
+  for (size_t i = 0; i < n; ++i) {
+    matching += rawValuesMatch(
+        reference.format, reference.values[i], candidate.values[i]);
+  }
+  return static_cast<double>(matching) / static_cast<double>(n);
+}
+
 } // namespace cts
 } // namespace anari
@@ -4,6 +4,8 @@
 #pragma once
 
 #include "Image.h"
+// std
+#include <cstdint>
 
 namespace anari {
 namespace cts {
@@ -23,10 +25,26 @@ double psnr(
 // 7x7 uniform window and sample covariance. 1.0 means identical. NaN if the
 // images differ in size, are invalid, or are smaller than the window.
 // Mirrors skimage.metrics.structural_similarity(..., channel_axis=2).
+//
+// Rows are split between `threads` threads (0: one per hardware thread); the
+// score does not depend on how many.
 double ssim(
-    const Image &reference, const Image &candidate);
+    const Image &reference, const Image &candidate, uint32_t threads = 1);
+
+// Channels with raw ground truth (hasRawGroundTruth) are scored on their
+// values instead. Two ids match when equal. Two depths match when within
+// kRawDepthTolerance of each other, relative to the larger. A non-finite
+// (background) depth matches only another non-finite one.
+constexpr float kRawDepthTolerance = 1e-3f;
+
+bool rawValuesMatch(
+    RawImage::Format format, uint32_t reference, uint32_t candidate);
+
+// The fraction of pixels whose raw values match, in [0, 1]; 1.0 means
+// identical. NaN if the two differ in size or format or are invalid.
+double rawMatch(const RawImage &reference, const RawImage &candidate);
 
-// Whether a score clears its threshold. Both metrics are higher-is-better, so
+// Whether a score clears its threshold. Every metric is higher-is-better, so
 // this is score > threshold; a NaN score (e.g. mismatched images) never passes.
 inline bool metricPassed(double score, double threshold)
 {
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "Report.h"
+#include "Timing.h"
 // std
 #include <algorithm>
 #include <cmath>
@@ -12,7 +13,7 @@
 namespace anari {
 namespace cts {
 
-const std::vector<std::string> kReportMetrics = {"ssim", "psnr"};
+const std::vector<std::string> kReportMetrics = {"ssim", "psnr", "match"};
 
 namespace {
 
@@ -115,6 +116,11 @@ Summary summarize(const std::map<std::string, CaseResult> &results)
       ++cat.skipped;
       break;
     }
+    if (r.timing) {
+      ++s.timed;
+      if (!timingRegressions(r).empty())
+        ++s.timingRegressions;
+    }
   }
   return s;
 }
@@ -182,6 +188,9 @@ void writeTextSummary(std::ostream &out,
     out << "    " << std::left << std::setw(12) << cat << std::right
         << std::setw(4) << c.passed << " passed  " << std::setw(4) << c.failed
         << " failed  " << std::setw(4) << c.skipped << " skipped\n";
+  if (s.timed > 0)
+    out << "  timing: " << s.timed << " cases timed, " << s.timingRegressions
+        << " slower than baseline\n";
 
   const auto keys = reportCaseKeys(results, includeAll);
   if (keys.empty())
@@ -199,6 +208,8 @@ void writeTextSummary(std::ostream &out,
         << (!scores.empty() ? scores : reason) << "\n";
     if (!r.description.empty())
       out << "      Description: " << r.description << "\n";
+    for (const auto &t : timingRegressions(r))
+      out << "      Timing: " << describeTiming(t) << "\n";
   }
 }
 
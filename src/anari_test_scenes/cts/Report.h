@@ -47,6 +47,9 @@ struct Summary
   int skipped{0};
   std::map<std::string, CategoryCounts> categories;
   std::vector<std::string> failures;
+  // Cases of a performance run, and those slower than its baseline
+  int timed{0};
+  int timingRegressions{0};
 };
 
 Summary summarize(const std::map<std::string, CaseResult> &results);
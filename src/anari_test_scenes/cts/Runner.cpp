@@ -4,23 +4,35 @@
 #include "Runner.h"
 #include "BuildContext.h"
 #include "Expansion.h"
+#include "Fingerprint.h"
 #include "FrameFormats.h"
 #include "FrameReadback.h"
 #include "Metrics.h"
+#include "Scaling.h"
 #include "Sidecar.h"
 #include "Value.h"
 #include "ViewBuilder.h"
 #include "WorldBuilder.h"
 // anari
 #include "anari/frontend/anari_device_introspection.hpp"
+// helium
+#include "helium/TaskQueue.h"
 // std
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <cstdio>
 #include <exception>
+#include <filesystem>
+#include <functional>
 #include <iostream>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <utility>
 
 namespace anari {
@@ -49,59 +61,144 @@ const char *channelFrameParam(Channel ch)
   return "channel.color";
 }
 
-// Render one channel of an already-assembled world with a caller-owned camera
-// and renderer. chFmt is the buffer format the Case requested for this channel
-// (the comparison image is always 8-bit RGBA). depthScale deterministically
-// maps depth to gray.
-Image renderChannel(anari::Device d,
+// Render channels of an already-assembled world with a caller-owned camera
+// and renderer, in as few frames as possible: one frame carries every channel,
+// each mapped once after a single wait. Accumulation refines only color, so
+// with it color renders alone and the other channels share a second,
+// single-sample frame. formats[i] is the buffer format the Case requested for
+// channels[i] (the comparison image is always 8-bit RGBA). depthScale
+// deterministically maps depth to gray. Results follow `channels` order.
+std::vector<FrameReadbackResult> renderChannels(anari::Device d,
     anari::World world,
     anari::Camera camera,
     anari::Renderer renderer,
-    Channel ch,
+    const std::vector<Channel> &channels,
+    const std::vector<ANARIDataType> &formats,
     uint32_t w,
     uint32_t h,
     float depthScale,
-    ANARIDataType chFmt,
     uint32_t accumulationFrames)
 {
+  std::vector<FrameReadbackResult> results(channels.size());
+
+  auto renderFrame = [&](const std::vector<size_t> &indices, bool accumulate) {
+    UniqueAnariObject<anari::Frame> frame(d, anari::newObject<anari::Frame>(d));
+    const auto f = frame.get();
+    anari::setParameter(d, f, "size", anari::math::vec<uint32_t, 2>(w, h));
+    // The frame always carries a color buffer; it takes the Case's requested
+    // format only when color is one of the channels read.
+    ANARIDataType colorFmt = ANARI_UFIXED8_RGBA_SRGB;
+    std::vector<Channel> read;
+    for (size_t i : indices) {
+      read.push_back(channels[i]);
+      if (channels[i] == Channel::Color)
+        colorFmt = formats[i];
+      else
+        anari::setParameter(d, f, channelFrameParam(channels[i]), formats[i]);
+    }
+    anari::setParameter(d, f, "channel.color", colorFmt);
+    anari::setParameter(d, f, "renderer", renderer);
+    anari::setParameter(d, f, "camera", camera);
+    anari::setParameter(d, f, "world", world);
+    if (accumulate)
+      anari::setParameter(d, f, "accumulation", true);
+    anari::commitParameters(d, f);
+
+    // The frame is created fresh each call, so accumulation starts at sample
+    // 0; rendering the same frame N times refines the image (matches
+    // tests/frame.cpp's progressive-rendering check).
+    const uint32_t renders = accumulate ? accumulationFrames : 1;
+    for (uint32_t i = 0; i < renders; ++i) {
+      anari::render(d, f);
+      anari::wait(d, f);
+    }
+
+    auto readbacks = readFrameChannels(d, f, read, w, h, depthScale);
+    for (size_t k = 0; k < indices.size(); ++k)
+      results[indices[k]] = std::move(readbacks[k]);
+  };
+
+  const bool accumulate = accumulationFrames > 1
+      && std::find(channels.begin(), channels.end(), Channel::Color)
+          != channels.end();
+  std::vector<size_t> color;
+  std::vector<size_t> others;
+  for (size_t i = 0; i < channels.size(); ++i)
+    (accumulate && channels[i] == Channel::Color ? color : others).push_back(i);
+  if (!color.empty())
+    renderFrame(color, true);
+  if (!others.empty())
+    renderFrame(others, false);
+  return results;
+}
+
+// Time the frames of an assembled scene for performance mode: committing the
+// frame and rendering the first one, then `warmup` untimed and `frames` timed
+// renders. Only the color channel is written and nothing accumulates, so every
+// timed frame does the same work.
+void timeFrames(anari::Device d,
+    anari::World world,
+    anari::Camera camera,
+    anari::Renderer renderer,
+    uint32_t w,
+    uint32_t h,
+    ANARIDataType colorFmt,
+    uint32_t warmup,
+    uint32_t frames,
+    TimingResult &timing)
+{
+  using Clock = std::chrono::steady_clock;
+  auto msSince = [](Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+        .count();
+  };
+
   UniqueAnariObject<anari::Frame> frame(d, anari::newObject<anari::Frame>(d));
   const auto f = frame.get();
   anari::setParameter(d, f, "size", anari::math::vec<uint32_t, 2>(w, h));
-  // The frame always carries a color buffer; only the channel being read needs
-  // the Case's requested format, so non-color channels keep a plain color
-  // buffer.
-  anari::setParameter(d,
-      f,
-      "channel.color",
-      ch == Channel::Color ? chFmt : ANARI_UFIXED8_RGBA_SRGB);
-  if (ch != Channel::Color)
-    anari::setParameter(d, f, channelFrameParam(ch), chFmt);
+  anari::setParameter(d, f, "channel.color", colorFmt);
   anari::setParameter(d, f, "renderer", renderer);
   anari::setParameter(d, f, "camera", camera);
   anari::setParameter(d, f, "world", world);
-  // Depth, normal, albedo, and id channels do not benefit from accumulation.
-  const bool accumulate = accumulationFrames > 1 && ch == Channel::Color;
-  if (accumulate)
-    anari::setParameter(d, f, "accumulation", true);
+
+  // Devices defer commits until a frame needs them, so the scene's commits
+  // are paid for by the first render.
+  auto start = Clock::now();
   anari::commitParameters(d, f);
+  anari::render(d, f);
+  anari::wait(d, f);
+  timing.commitMs = msSince(start);
 
-  // The frame is created fresh each call, so accumulation starts at sample 0;
-  // rendering the same frame N times refines the image (matches
-  // tests/frame.cpp's progressive-rendering check).
-  if (accumulate) {
-    for (uint32_t i = 0; i < accumulationFrames; ++i) {
-      anari::render(d, f);
-      anari::wait(d, f);
-    }
-  } else {
+  for (uint32_t i = 0; i < warmup; ++i) {
     anari::render(d, f);
     anari::wait(d, f);
   }
 
-  auto readback = readFrameChannel(d, f, ch, w, h, depthScale);
-  if (!readback)
-    throw std::runtime_error(readback.detail);
-  return std::move(readback.image);
+  timing.warmupFrames = warmup;
+  bool deviceReports = true;
+  for (uint32_t i = 0; i < frames; ++i) {
+    start = Clock::now();
+    anari::render(d, f);
+    anari::wait(d, f);
+    timing.frameMs.push_back(msSince(start));
+    float duration = 0.f;
+    deviceReports = deviceReports
+        && anari::getProperty(d, f, "duration", duration, ANARI_NO_WAIT);
+    timing.deviceMs.push_back(duration * 1e3);
+  }
+  if (!deviceReports)
+    timing.deviceMs.clear();
+}
+
+// The device's memory use in bytes, from a device-specific property of the
+// device object (see ScalingOptions::memoryProperty); nothing when the property
+// is unnamed or not reported.
+std::optional<int64_t> deviceMemory(anari::Device d, const std::string &name)
+{
+  uint64_t bytes = 0;
+  if (name.empty() || !anari::getProperty(d, d, name.c_str(), bytes, ANARI_WAIT))
+    return std::nullopt;
+  return int64_t(bytes);
 }
 
 // The default render camera: a perspective camera framing the world bounds.
@@ -153,6 +250,34 @@ RunSummary workdirFailureSummary(const Catalog &catalog, const Filter &filter)
   return summary;
 }
 
+// The difference image of a raw channel: white where the raw values do not
+// match (see rawValuesMatch), black elsewhere. Invalid if the sizes or formats
+// differ.
+Image makeRawDiffImage(const RawImage &reference, const RawImage &candidate)
+{
+  if (!reference.valid() || !candidate.valid()
+      || reference.format != candidate.format
+      || reference.width != candidate.width
+      || reference.height != candidate.height)
+    return {};
+  Image diff;
+  diff.width = reference.width;
+  diff.height = reference.height;
+  diff.rgba.resize(reference.pixelCount() * 4);
+  for (size_t i = 0; i < reference.pixelCount(); ++i) {
+    const uint8_t v = rawValuesMatch(reference.format,
+                          reference.values[i],
+                          candidate.values[i])
+        ? 0
+        : 255;
+    diff.rgba[i * 4 + 0] = v;
+    diff.rgba[i * 4 + 1] = v;
+    diff.rgba[i * 4 + 2] = v;
+    diff.rgba[i * 4 + 3] = 255;
+  }
+  return diff;
+}
+
 // Per-pixel absolute RGB difference between two equal-sized images, with opaque
 // alpha so the result is viewable. Returns an invalid Image if the sizes differ
 // (then the caller skips the debug images).
@@ -198,6 +323,26 @@ Image makeThresholdImage(const Image &diff, uint8_t threshold)
   return out;
 }
 
+// The value a Case gives an axis, as compared between Cases for world reuse;
+// distinct from every value when the Case does not have the axis.
+std::string caseValueString(const Case &c, const std::string &axisName)
+{
+  for (const auto &cv : c.values) {
+    if (cv.axisName == axisName)
+      return "=" + anyToString(cv.value);
+  }
+  return "";
+}
+
+// Worlds kept per device and Test; a Test whose build reads an axis that
+// changes every Case keeps only its most recent worlds alive.
+constexpr size_t kMaxCachedWorlds = 8;
+
+// Part of every Case fingerprint; bumped when the runner changes how it
+// renders or scores, so incremental runs do not keep results made the old way.
+// 2: depth and id channels are scored on raw ground truth.
+constexpr uint64_t kFingerprintVersion = 2;
+
 // Diff intensity (0..255) above which the threshold mask marks a pixel: ~0.05
 // of full range, matching the legacy debug-image cutoff.
 constexpr uint8_t kDiffThreshold8 = 13;
@@ -212,11 +357,25 @@ Runner::Runner(anari::Device device,
     Workdir workdir,
     RunOptions options,
     std::shared_ptr<ArtifactWriter> artifactWriter)
-    : m_device(device),
+    : Runner(std::vector<anari::Device>{device},
+          std::move(workdir),
+          std::move(options),
+          std::move(artifactWriter))
+{}
+
+Runner::Runner(std::vector<anari::Device> devices,
+    Workdir workdir,
+    RunOptions options,
+    std::shared_ptr<ArtifactWriter> artifactWriter)
+    : m_device(devices.empty() ? nullptr : devices.front()),
+      m_devices(std::move(devices)),
       m_workdir(std::move(workdir)),
       m_artifacts(m_workdir, std::move(artifactWriter)),
       m_options(std::move(options))
-{}
+{
+  if (m_devices.empty())
+    throw std::invalid_argument("Runner needs at least one device");
+}
 
 void Runner::resolveCapabilities(const std::set<std::string> &features)
 {
@@ -247,7 +406,7 @@ void Runner::resolveRendererParamTypes()
   }
 }
 
-void Runner::applyRendererParams(anari::Renderer renderer)
+void Runner::applyRendererParams(anari::Device d, anari::Renderer renderer)
 {
   for (const auto &param : m_options.rendererParams) {
     const auto it = m_rendererParamTypes.find(param.name);
@@ -260,40 +419,82 @@ void Runner::applyRendererParams(anari::Renderer renderer)
       continue;
     }
     anariSetParameter(
-        m_device, renderer, param.name.c_str(), parsed->type, parsed->data());
+        d, renderer, param.name.c_str(), parsed->type, parsed->data());
   }
 }
 
-Runner::SceneObjects Runner::buildScene(const TestDef &test, const Case &c)
+Runner::SceneObjects Runner::buildScene(anari::Device d,
+    const TestDef &test,
+    const Case &c,
+    WorldCache *worlds,
+    uint32_t width,
+    uint32_t height)
 {
   SceneObjects scene;
   if (!test.build)
     return scene;
 
-  BuildContext ctx(m_device);
+  BuildContext ctx(d);
   for (const auto &cv : c.values)
     ctx.set(cv.axisName, cv.value);
 
-  scene.world = UniqueAnariObject<anari::World>(m_device, test.build(ctx));
-  if (!scene.world)
-    return scene;
+  if (worlds && worlds->test != &test) {
+    worlds->entries.clear();
+    worlds->test = &test;
+  }
 
-  scene.bounds = worldBounds(m_device, scene.world.get());
-  scene.camera = UniqueAnariObject<anari::Camera>(m_device,
+  const WorldCache::Entry *cached = nullptr;
+  if (worlds) {
+    for (const auto &entry : worlds->entries) {
+      if (std::all_of(entry.reads.begin(), entry.reads.end(), [&](auto &r) {
+            return caseValueString(c, r.first) == r.second;
+          })) {
+        cached = &entry;
+        break;
+      }
+    }
+  }
+
+  if (cached) {
+    anari::retain(d, cached->world.get());
+    scene.world = UniqueAnariObject<anari::World>(d, cached->world.get());
+    scene.bounds = cached->bounds;
+    worlds->reused++;
+  } else {
+    scene.world = UniqueAnariObject<anari::World>(d, test.build(ctx));
+    if (!scene.world)
+      return scene;
+    scene.bounds = worldBounds(d, scene.world.get());
+
+    if (worlds) {
+      WorldCache::Entry entry;
+      for (const auto &name : ctx.readNames())
+        entry.reads[name] = caseValueString(c, name);
+      anari::retain(d, scene.world.get());
+      entry.world = UniqueAnariObject<anari::World>(d, scene.world.get());
+      entry.bounds = scene.bounds;
+      if (worlds->entries.size() == kMaxCachedWorlds)
+        worlds->entries.erase(worlds->entries.begin());
+      worlds->entries.push_back(std::move(entry));
+    }
+  }
+  scene.camera = UniqueAnariObject<anari::Camera>(d,
       test.cameraBuild
           ? test.cameraBuild(ctx, scene.bounds)
-          : defaultCamera(
-                m_device, scene.bounds, m_options.width, m_options.height));
-  scene.renderer = UniqueAnariObject<anari::Renderer>(m_device,
+          : defaultCamera(d,
+              scene.bounds,
+              width ? width : m_options.width,
+              height ? height : m_options.height));
+  scene.renderer = UniqueAnariObject<anari::Renderer>(d,
       configuredRenderer(
-          m_device, m_options.device.renderer, m_options.ambientRadiance));
+          d, m_options.device.renderer, m_options.ambientRadiance));
   if (scene.renderer) {
-    applyRendererParams(scene.renderer.get());
+    applyRendererParams(d, scene.renderer.get());
     if (test.rendererConfig)
       test.rendererConfig(ctx, scene.renderer.get());
     if (m_denoiseEnabled)
-      anari::setParameter(m_device, scene.renderer.get(), "denoise", true);
-    anari::commitParameters(m_device, scene.renderer.get());
+      anari::setParameter(d, scene.renderer.get(), "denoise", true);
+    anari::commitParameters(d, scene.renderer.get());
   }
   return scene;
 }
@@ -343,256 +544,715 @@ void Runner::writeCaseFailure(const TestDef &test,
 
 std::vector<Image> Runner::renderCase(const TestDef &test, const Case &c)
 {
-  SceneObjects scene = buildScene(test, c);
+  return renderCase(m_device, nullptr, test, c);
+}
+
+std::vector<Image> Runner::renderCase(anari::Device d,
+    WorldCache *worlds,
+    const TestDef &test,
+    const Case &c,
+    TimingResult *timing,
+    std::vector<RawImage> *raws)
+{
+  const auto buildStart = std::chrono::steady_clock::now();
+  SceneObjects scene = buildScene(d, test, c, timing ? nullptr : worlds);
   if (!scene.valid())
     return {};
 
+  if (timing) {
+    timing->buildMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - buildStart)
+                          .count();
+    timeFrames(d,
+        scene.world.get(),
+        scene.camera.get(),
+        scene.renderer.get(),
+        m_options.width,
+        m_options.height,
+        caseChannelFormat(c, Channel::Color),
+        m_options.perf.warmupFrames,
+        m_options.perf.frames,
+        *timing);
+  }
+
   // Deterministic depth scale derived from the (shared) scene bounds: the
   // default camera sits within one bounds diagonal of the center, so 2x is a
   // conservative bound that covers the whole near..far range.
   const float depthScale =
       2.0f * anari::math::length(scene.bounds[1] - scene.bounds[0]);
 
+  std::vector<ANARIDataType> formats;
+  for (Channel ch : test.channels)
+    formats.push_back(caseChannelFormat(c, ch));
+  auto readbacks = renderChannels(d,
+      scene.world.get(),
+      scene.camera.get(),
+      scene.renderer.get(),
+      test.channels,
+      formats,
+      m_options.width,
+      m_options.height,
+      depthScale,
+      m_effectiveAccumulationFrames);
+
   std::vector<Image> images;
-  images.reserve(test.channels.size());
-  for (Channel ch : test.channels) {
-    const ANARIDataType chFmt = caseChannelFormat(c, ch);
-    images.push_back(renderChannel(m_device,
-        scene.world.get(),
-        scene.camera.get(),
-        scene.renderer.get(),
-        ch,
-        m_options.width,
-        m_options.height,
-        depthScale,
-        chFmt,
-        m_effectiveAccumulationFrames));
+  images.reserve(readbacks.size());
+  for (auto &readback : readbacks) {
+    if (!readback)
+      throw std::runtime_error(readback.detail);
+    images.push_back(std::move(readback.image));
+    if (raws)
+      raws->push_back(std::move(readback.raw));
   }
   return images;
 }
 
-RunSummary Runner::generate(const Catalog &catalog,
+RunSummary Runner::runCases(const Catalog &catalog,
     const Filter &filter,
-    const std::set<std::string> &referenceFeatures)
+    const RenderStage &render,
+    const PublishStage &publish)
 {
-  resolveCapabilities(referenceFeatures);
-  if (!m_workdir.writeGitignore())
-    return workdirFailureSummary(catalog, filter);
-  RunSummary summary;
+  std::vector<std::pair<const TestDef *, Case>> cases;
+  // Indices into `cases` of the Cases sharing one ground truth key, in catalog
+  // order. A group is rendered on one device and published by one task, so a
+  // shared ground truth image is still written by the last of its variants.
+  std::vector<std::vector<size_t>> groups;
   for (const TestDef *test : catalog.filter(filter)) {
-    // Behavioral tests verify themselves at run time and have no ground truth.
-    if (test->behaviorCheck) {
-      const int n = static_cast<int>(expand(*test).size());
-      summary.total += n;
-      summary.skipped += n;
+    // Scaling Tests run only in a scaling run, and only they do.
+    if (bool(test->scaling) != m_options.scaling.enabled)
       continue;
+    std::map<std::string, size_t> groupOfKey;
+    for (Case &c : expand(*test)) {
+      auto [it, added] = groupOfKey.emplace(c.groundTruthKey(), groups.size());
+      if (added)
+        groups.emplace_back();
+      groups[it->second].push_back(cases.size());
+      cases.emplace_back(test, std::move(c));
     }
-    for (const Case &c : expand(*test)) {
-      summary.total++;
-      if (!isSupported(*test, referenceFeatures)) {
-        summary.skipped++;
-        continue;
-      }
-      // A throwing build helper (or fatal) loses only this Case's ground
-      // truth; the rest of the generate run continues (ADR-0003).
-      try {
-        auto images = renderCase(*test, c);
-        if (images.size() != test->channels.size()) {
-          summary.failed++;
-          continue;
+  }
+
+  std::vector<RunSummary> tallies(cases.size());
+  // Declared before the publishers, so worlds are released after the last
+  // publication and before the caller releases the devices.
+  std::vector<WorldCache> worlds(m_devices.size());
+
+  if (rendersSerially()) {
+    for (size_t i = 0; i < cases.size(); ++i) {
+      auto rendered = render(
+          m_device, worlds[0], *cases[i].first, cases[i].second, tallies[i]);
+      if (rendered)
+        publish(*rendered, tallies[i]);
+    }
+  } else {
+    const uint32_t publishThreads = publishThreadCount();
+    std::vector<std::unique_ptr<helium::tasking::TaskQueue>> publishers;
+    for (uint32_t i = 0; i < publishThreads; ++i)
+      publishers.push_back(std::make_unique<helium::tasking::TaskQueue>(64));
+
+    // A render waiting to be published holds its images in memory, so a
+    // render thread waits while this many are queued rather than letting
+    // renders pile up behind slower publishers.
+    const size_t maxPending = 2 * size_t(publishThreads) + m_devices.size();
+    size_t pending = 0;
+    std::mutex pendingMutex;
+    std::condition_variable pendingDone;
+
+    std::atomic<size_t> nextGroup{0};
+    auto renderGroups = [&](anari::Device d, WorldCache &deviceWorlds) {
+      for (size_t g; (g = nextGroup.fetch_add(1)) < groups.size();) {
+        auto rendered =
+            std::make_shared<std::vector<std::pair<size_t, RenderedCase>>>();
+        for (size_t i : groups[g]) {
+          auto r = render(
+              d, deviceWorlds, *cases[i].first, cases[i].second, tallies[i]);
+          if (r)
+            rendered->emplace_back(i, std::move(*r));
         }
-        std::vector<ImageArtifact> artifacts;
-        artifacts.reserve(test->channels.size());
-        for (size_t i = 0; i < test->channels.size(); ++i) {
-          artifacts.push_back(
-              {m_workdir.groundTruthImagePath(c, test->channels[i]),
-                  std::move(images[i])});
+        if (rendered->empty())
+          continue;
+        {
+          std::unique_lock<std::mutex> lock(pendingMutex);
+          pendingDone.wait(lock, [&]() { return pending < maxPending; });
+          ++pending;
         }
-        if (m_artifacts.publishGroundTruth(artifacts))
-          summary.passed++;
-        else
-          summary.failed++;
-      } catch (...) {
-        summary.failed++;
+        publishers[g % publishers.size()]->enqueue([&, rendered]() {
+          for (auto &[i, r] : *rendered)
+            publish(r, tallies[i]);
+          {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            --pending;
+          }
+          pendingDone.notify_all();
+        });
       }
-    }
+    };
+
+    std::vector<std::thread> renderThreads;
+    for (size_t i = 0; i < m_devices.size(); ++i)
+      renderThreads.emplace_back(
+          renderGroups, m_devices[i], std::ref(worlds[i]));
+    for (auto &t : renderThreads)
+      t.join();
+    // TaskQueue drains its remaining tasks before its thread exits
+    publishers.clear();
   }
+
+  RunSummary summary;
+  for (const auto &t : tallies) {
+    summary.total += t.total;
+    summary.passed += t.passed;
+    summary.failed += t.failed;
+    summary.skipped += t.skipped;
+    summary.unchanged += t.unchanged;
+    summary.timingRegressions += t.timingRegressions;
+  }
+  for (const auto &w : worlds)
+    summary.worldsReused += w.reused;
   return summary;
 }
 
-RunSummary Runner::run(const Catalog &catalog,
+std::optional<Runner::RenderedCase> Runner::renderGroundTruth(anari::Device d,
+    WorldCache &worlds,
+    const TestDef &test,
+    const Case &c,
+    const std::set<std::string> &referenceFeatures,
+    RunSummary &summary)
+{
+  summary.total++;
+  // Behavioral and scaling tests have no ground truth.
+  if (test.behaviorCheck || test.scaling
+      || !isSupported(test, referenceFeatures)) {
+    summary.skipped++;
+    return std::nullopt;
+  }
+  // A throwing build helper (or fatal) loses only this Case's ground truth;
+  // the rest of the generate run continues (ADR-0003).
+  try {
+    RenderedCase rendered;
+    rendered.test = &test;
+    rendered.c = &c;
+    rendered.images = renderCase(d, &worlds, test, c, nullptr, &rendered.raws);
+    if (rendered.images.size() != test.channels.size()) {
+      summary.failed++;
+      return std::nullopt;
+    }
+    return rendered;
+  } catch (...) {
+    summary.failed++;
+    return std::nullopt;
+  }
+}
+
+void Runner::publishGroundTruth(RenderedCase &rendered, RunSummary &summary)
+{
+  try {
+    const TestDef &test = *rendered.test;
+    std::vector<ImageArtifact> artifacts;
+    artifacts.reserve(test.channels.size());
+    for (size_t i = 0; i < test.channels.size(); ++i) {
+      const Channel ch = test.channels[i];
+      artifacts.push_back({m_workdir.groundTruthImagePath(*rendered.c, ch),
+          std::move(rendered.images[i])});
+      // The raw buffer is the compared ground truth; the PNG is for viewing.
+      if (hasRawGroundTruth(ch)) {
+        artifacts.push_back({m_workdir.groundTruthRawPath(*rendered.c, ch),
+            {},
+            std::move(rendered.raws[i])});
+      }
+    }
+    if (m_artifacts.publishGroundTruth(artifacts))
+      summary.passed++;
+    else
+      summary.failed++;
+  } catch (...) {
+    summary.failed++;
+  }
+}
+
+RunSummary Runner::generate(const Catalog &catalog,
     const Filter &filter,
-    const std::set<std::string> &candidateFeatures)
+    const std::set<std::string> &referenceFeatures)
 {
-  resolveCapabilities(candidateFeatures);
+  resolveCapabilities(referenceFeatures);
   if (!m_workdir.writeGitignore())
     return workdirFailureSummary(catalog, filter);
-  RunSummary summary;
-  for (const TestDef *test : catalog.filter(filter)) {
-    if (test->behaviorCheck) {
-      runBehaviorTest(*test, candidateFeatures, summary);
-      continue;
+  return runCases(
+      catalog,
+      filter,
+      [&](anari::Device d,
+          WorldCache &worlds,
+          const TestDef &test,
+          const Case &c,
+          RunSummary &summary) {
+        return renderGroundTruth(
+            d, worlds, test, c, referenceFeatures, summary);
+      },
+      [&](RenderedCase &rendered, RunSummary &summary) {
+        publishGroundTruth(rendered, summary);
+      });
+}
+
+std::optional<Runner::RenderedCase> Runner::renderResult(anari::Device d,
+    WorldCache &worlds,
+    const TestDef &test,
+    const Case &c,
+    const std::set<std::string> &candidateFeatures,
+    RunSummary &summary)
+{
+  summary.total++;
+  if (test.behaviorCheck) {
+    runBehaviorCase(d, test, c, candidateFeatures, summary);
+    return std::nullopt;
+  }
+  if (test.scaling) {
+    runScalingCase(d, test, c, candidateFeatures, summary);
+    return std::nullopt;
+  }
+
+  // Per-case crash isolation (ADR-0003): a throwing build helper or fatal
+  // becomes a failed sidecar for this Case and the run continues. Handles
+  // built mid-case are released by buildScene/renderCase as they unwind.
+  try {
+    if (!isSupported(test, candidateFeatures)) {
+      writeFeatureSkip(test, c, summary);
+      return std::nullopt;
     }
-    for (const Case &c : expand(*test)) {
-      summary.total++;
-
-      // Per-case crash isolation (ADR-0003): a throwing build helper or fatal
-      // becomes a failed sidecar for this Case and the run continues. Handles
-      // built mid-case are released by buildScene/renderCase as they unwind.
-      try {
-        if (!isSupported(*test, candidateFeatures)) {
-          writeFeatureSkip(*test, c, summary);
-          continue;
-        }
 
-        CaseResult result = baseResult(*test, c, m_options.device);
+    RenderedCase rendered;
+    rendered.test = &test;
+    rendered.c = &c;
+    rendered.result = baseResult(test, c, m_options.device);
+    CaseResult &result = rendered.result;
 
-        // Need ground truth for every channel before we can compare.
-        bool haveGroundTruth = true;
-        std::vector<Image> groundTruth;
-        for (Channel ch : test->channels) {
-          auto gt = loadPNG(m_workdir.groundTruthImagePath(c, ch).string());
-          if (!gt.valid()) {
-            haveGroundTruth = false;
-            break;
-          }
-          groundTruth.push_back(std::move(gt));
-        }
-        if (!haveGroundTruth) {
-          result.verdict = Verdict::Skipped;
-          result.skipReason = "no ground truth (run generate first)";
-          recordResult(c, result, summary);
-          continue;
-        }
+    // Need ground truth for every channel before we can compare: the raw
+    // buffer for depth and id channels, else the image.
+    for (Channel ch : test.channels) {
+      Image gt;
+      RawImage gtRaw;
+      if (hasRawGroundTruth(ch))
+        gtRaw = loadRaw(m_workdir.groundTruthRawPath(c, ch).string());
+      else
+        gt = loadPNG(m_workdir.groundTruthImagePath(c, ch).string());
+      if (!gt.valid() && !gtRaw.valid()) {
+        result.verdict = Verdict::Skipped;
+        result.skipReason = "no ground truth (run generate first)";
+        recordResult(c, result, summary);
+        return std::nullopt;
+      }
+      rendered.groundTruth.push_back(std::move(gt));
+      rendered.groundTruthRaw.push_back(std::move(gtRaw));
+    }
 
-        const auto start = std::chrono::steady_clock::now();
-        auto images = renderCase(*test, c);
-        const auto end = std::chrono::steady_clock::now();
-        result.durationMs =
-            std::chrono::duration<double, std::milli>(end - start).count();
+    // A performance run measures every Case, so keeps no earlier result.
+    result.fingerprint = caseFingerprint(
+        test, c, rendered.groundTruth, rendered.groundTruthRaw);
+    if (m_options.incremental && !m_options.perf.enabled
+        && keepUnchanged(c, result.fingerprint, summary))
+      return std::nullopt;
 
-        if (images.size() != test->channels.size()) {
-          result.verdict = Verdict::Failed;
-          result.detail = "render produced no image";
-          recordResult(c, result, summary);
-          continue;
-        }
+    if (m_options.perf.enabled)
+      result.timing.emplace();
+    const auto start = std::chrono::steady_clock::now();
+    rendered.images = renderCase(d,
+        &worlds,
+        test,
+        c,
+        result.timing ? &*result.timing : nullptr,
+        &rendered.raws);
+    const auto end = std::chrono::steady_clock::now();
+    result.durationMs =
+        std::chrono::duration<double, std::milli>(end - start).count();
 
-        bool allPassed = true;
-        std::vector<ImageArtifact> artifacts;
-        artifacts.reserve(test->channels.size() * 3);
-        for (size_t i = 0; i < test->channels.size(); ++i) {
-          const Channel ch = test->channels[i];
-          artifacts.push_back({m_workdir.resultImagePath(c, ch), images[i]});
-
-          ChannelResult cr;
-          cr.channel = ch;
-          const double ssimThreshold =
-              test->thresholdFor(ch, "ssim", m_options.ssimThreshold);
-          const double psnrThreshold =
-              test->thresholdFor(ch, "psnr", m_options.psnrThreshold);
-          const double ssimScore = ssim(groundTruth[i], images[i]);
-          const double psnrScore = psnr(groundTruth[i], images[i]);
-          cr.metrics = {{"ssim", ssimScore}, {"psnr", psnrScore}};
-          cr.thresholds = {{"ssim", ssimThreshold}, {"psnr", psnrThreshold}};
-          cr.passed = metricPassed(ssimScore, ssimThreshold)
-              && metricPassed(psnrScore, psnrThreshold);
-          cr.resultImage =
-              m_workdir.relativeToRoot(m_workdir.resultImagePath(c, ch));
-          cr.groundTruthImage =
-              m_workdir.relativeToRoot(m_workdir.groundTruthImagePath(c, ch));
-
-          // Debug images alongside the result: the absolute per-pixel
-          // difference and a thresholded mask of it, to localize a mismatch.
-          const Image diffImg = makeDiffImage(groundTruth[i], images[i]);
-          if (diffImg.valid()) {
-            artifacts.push_back({m_workdir.diffImagePath(c, ch), diffImg});
-            artifacts.push_back({m_workdir.thresholdImagePath(c, ch),
-                makeThresholdImage(diffImg, kDiffThreshold8)});
-            cr.diffImage =
-                m_workdir.relativeToRoot(m_workdir.diffImagePath(c, ch));
-            cr.thresholdImage =
-                m_workdir.relativeToRoot(m_workdir.thresholdImagePath(c, ch));
-          }
+    if (rendered.images.size() != test.channels.size()) {
+      result.verdict = Verdict::Failed;
+      result.detail = "render produced no image";
+      recordResult(c, result, summary);
+      return std::nullopt;
+    }
+    return rendered;
+  } catch (const std::exception &e) {
+    writeCaseFailure(
+        test, c, std::string("exception during run: ") + e.what(), summary);
+  } catch (...) {
+    writeCaseFailure(test, c, "unknown exception during run", summary);
+  }
+  return std::nullopt;
+}
 
-          allPassed = allPassed && cr.passed;
-          result.channels.push_back(std::move(cr));
-        }
+void Runner::scoreResult(RenderedCase &rendered, RunSummary &summary)
+{
+  const TestDef &test = *rendered.test;
+  const Case &c = *rendered.c;
+  try {
+    CaseResult &result = rendered.result;
+    const auto &images = rendered.images;
+    const auto &groundTruth = rendered.groundTruth;
+    const auto &raws = rendered.raws;
+    const auto &groundTruthRaw = rendered.groundTruthRaw;
 
-        // Record the effective render settings additively in the existing
-        // detail field (no schema bump). generate writes no sidecars
-        // (ADR-0005), so this note is run-only; it makes a mixed-capability
-        // diff (e.g. an accumulating candidate vs. a single-render ground
-        // truth) interpretable.
-        std::string note =
-            "accumulation=" + std::to_string(m_effectiveAccumulationFrames)
-            + ", denoise=" + (m_denoiseEnabled ? "on" : "off");
-        result.detail =
-            result.detail.empty() ? note : result.detail + "; " + note;
-
-        result.verdict = allPassed ? Verdict::Passed : Verdict::Failed;
-        recordResult(c, result, summary, artifacts);
-      } catch (const std::exception &e) {
-        writeCaseFailure(*test,
-            c,
-            std::string("exception during run: ") + e.what(),
-            summary);
-      } catch (...) {
-        writeCaseFailure(*test, c, "unknown exception during run", summary);
+    bool allPassed = true;
+    std::vector<ImageArtifact> artifacts;
+    artifacts.reserve(test.channels.size() * 3);
+    for (size_t i = 0; i < test.channels.size(); ++i) {
+      const Channel ch = test.channels[i];
+      artifacts.push_back({m_workdir.resultImagePath(c, ch), images[i]});
+
+      ChannelResult cr;
+      cr.channel = ch;
+      cr.resultImage =
+          m_workdir.relativeToRoot(m_workdir.resultImagePath(c, ch));
+      Image diffImg;
+      if (hasRawGroundTruth(ch)) {
+        // Compared value for value; the ground-truth PNG is referenced only
+        // for viewing, when generate wrote one.
+        const double threshold =
+            test.thresholdFor(ch, "match", m_options.matchThreshold);
+        const double matchScore = rawMatch(groundTruthRaw[i], raws[i]);
+        cr.metrics = {{"match", matchScore}};
+        cr.thresholds = {{"match", threshold}};
+        cr.passed = metricPassed(matchScore, threshold);
+        const auto gtImage = m_workdir.groundTruthImagePath(c, ch);
+        std::error_code ec;
+        if (std::filesystem::is_regular_file(gtImage, ec))
+          cr.groundTruthImage = m_workdir.relativeToRoot(gtImage);
+        diffImg = makeRawDiffImage(groundTruthRaw[i], raws[i]);
+      } else {
+        const double ssimThreshold =
+            test.thresholdFor(ch, "ssim", m_options.ssimThreshold);
+        const double psnrThreshold =
+            test.thresholdFor(ch, "psnr", m_options.psnrThreshold);
+        // With a single publisher, SSIM may use every core; otherwise the
+        // publish threads already score in parallel.
+        const double ssimScore = ssim(
+            groundTruth[i], images[i], publishThreadCount() == 1 ? 0 : 1);
+        const double psnrScore = psnr(groundTruth[i], images[i]);
+        cr.metrics = {{"ssim", ssimScore}, {"psnr", psnrScore}};
+        cr.thresholds = {{"ssim", ssimThreshold}, {"psnr", psnrThreshold}};
+        cr.passed = metricPassed(ssimScore, ssimThreshold)
+            && metricPassed(psnrScore, psnrThreshold);
+        cr.groundTruthImage =
+            m_workdir.relativeToRoot(m_workdir.groundTruthImagePath(c, ch));
+        diffImg = makeDiffImage(groundTruth[i], images[i]);
+      }
+
+      // Debug images alongside the result: the per-pixel difference and a
+      // thresholded mask of it, to localize a mismatch.
+      if (diffImg.valid()) {
+        artifacts.push_back({m_workdir.diffImagePath(c, ch), diffImg});
+        artifacts.push_back({m_workdir.thresholdImagePath(c, ch),
+            makeThresholdImage(diffImg, kDiffThreshold8)});
+        cr.diffImage = m_workdir.relativeToRoot(m_workdir.diffImagePath(c, ch));
+        cr.thresholdImage =
+            m_workdir.relativeToRoot(m_workdir.thresholdImagePath(c, ch));
       }
+
+      allPassed = allPassed && cr.passed;
+      result.channels.push_back(std::move(cr));
+    }
+
+    // Record the effective render settings additively in the existing
+    // detail field (no schema bump). generate writes no sidecars
+    // (ADR-0005), so this note is run-only; it makes a mixed-capability
+    // diff (e.g. an accumulating candidate vs. a single-render ground
+    // truth) interpretable.
+    std::string note =
+        "accumulation=" + std::to_string(m_effectiveAccumulationFrames)
+        + ", denoise=" + (m_denoiseEnabled ? "on" : "off");
+    result.detail = result.detail.empty() ? note : result.detail + "; " + note;
+
+    result.verdict = allPassed ? Verdict::Passed : Verdict::Failed;
+    if (compareWithBaseline(c, result)) {
+      result.verdict = Verdict::Failed;
+      summary.timingRegressions++;
     }
+    recordResult(c, result, summary, artifacts);
+  } catch (const std::exception &e) {
+    writeCaseFailure(
+        test, c, std::string("exception during run: ") + e.what(), summary);
+  } catch (...) {
+    writeCaseFailure(test, c, "unknown exception during run", summary);
   }
-  return summary;
 }
 
-void Runner::runBehaviorTest(const TestDef &test,
+bool Runner::compareWithBaseline(const Case &c, CaseResult &result) const
+{
+  if (!result.timing || m_options.perf.baseline.empty())
+    return false;
+
+  TimingResult &timing = *result.timing;
+  timing.baseline = m_options.perf.baseline.string();
+  CaseResult baseline;
+  if (!readSidecar(Workdir(m_options.perf.baseline).sidecarPath(c), baseline)
+      || !baseline.timing) {
+    result.detail += "; no baseline timing";
+    return false;
+  }
+
+  timing.comparisons =
+      compareTiming(*baseline.timing, timing, m_options.perf.thresholds);
+  const auto regressions = timingRegressions(result);
+  for (const auto &r : regressions)
+    result.detail += "; timing regressed: " + describeTiming(r);
+  return !regressions.empty();
+}
+
+bool Runner::rendersSerially() const
+{
+  // Performance and scaling runs render one Case at a time so that
+  // concurrent renders and publication do not skew their timings.
+  return m_options.perf.enabled || m_options.scaling.enabled;
+}
+
+uint32_t Runner::publishThreadCount() const
+{
+  if (rendersSerially() || m_devices.size() == 1)
+    return 1;
+  return m_options.publishThreads != 0
+      ? m_options.publishThreads
+      : std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::string Runner::caseFingerprint(const TestDef &test,
+    const Case &c,
+    const std::vector<Image> &groundTruth,
+    const std::vector<RawImage> &groundTruthRaw) const
+{
+  Fingerprint fp;
+  fp.add(kFingerprintVersion);
+
+  fp.add(test.id()).add(test.description).add(uint64_t(test.revision));
+  fp.add(uint64_t(bool(test.behaviorCheck)));
+  for (const auto &feature : test.requiredFeatures)
+    fp.add(feature);
+  fp.add(test.boundsTolerance);
+  for (Channel ch : test.channels) {
+    fp.add(channelName(ch));
+    if (hasRawGroundTruth(ch)) {
+      fp.add(test.thresholdFor(ch, "match", m_options.matchThreshold));
+    } else {
+      fp.add(test.thresholdFor(ch, "ssim", m_options.ssimThreshold));
+      fp.add(test.thresholdFor(ch, "psnr", m_options.psnrThreshold));
+    }
+  }
+
+  fp.add(c.id());
+  for (const auto &cv : c.values) {
+    fp.add(cv.axisName).add(anyToString(cv.value));
+    fp.add(uint64_t(cv.kind));
+  }
+
+  const DeviceSpec &device = m_options.device;
+  fp.add(device.library).add(device.device).add(device.renderer);
+  fp.add(device.build);
+  fp.add(uint64_t(m_options.width)).add(uint64_t(m_options.height));
+  fp.add(double(m_options.ambientRadiance));
+  fp.add(uint64_t(m_effectiveAccumulationFrames));
+  fp.add(uint64_t(m_denoiseEnabled));
+  for (const auto &param : m_options.rendererParams)
+    fp.add(param.name).add(param.value);
+
+  for (const Image &gt : groundTruth) {
+    fp.add(uint64_t(gt.width)).add(uint64_t(gt.height));
+    fp.add(gt.rgba.data(), gt.rgba.size());
+  }
+  for (const RawImage &gt : groundTruthRaw) {
+    fp.add(uint64_t(gt.format));
+    fp.add(uint64_t(gt.width)).add(uint64_t(gt.height));
+    fp.add(gt.values.data(), gt.values.size() * sizeof(uint32_t));
+  }
+  return fp.hex();
+}
+
+bool Runner::keepUnchanged(
+    const Case &c, const std::string &fingerprint, RunSummary &summary)
+{
+  CaseResult previous;
+  if (!readSidecar(m_workdir.sidecarPath(c), previous)
+      || previous.fingerprint != fingerprint
+      || previous.verdict == Verdict::Skipped
+      || m_options.changedSince.count(previous.device.build))
+    return false;
+
+  std::error_code ec;
+  for (const auto &ch : previous.channels) {
+    for (const std::string *image :
+        {&ch.resultImage, &ch.diffImage, &ch.thresholdImage}) {
+      if (!image->empty()
+          && !std::filesystem::is_regular_file(m_workdir.root() / *image, ec))
+        return false;
+    }
+  }
+
+  if (previous.verdict == Verdict::Passed)
+    summary.passed++;
+  else
+    summary.failed++;
+  summary.unchanged++;
+  return true;
+}
+
+RunSummary Runner::run(const Catalog &catalog,
+    const Filter &filter,
+    const std::set<std::string> &candidateFeatures)
+{
+  resolveCapabilities(candidateFeatures);
+  if (!m_workdir.writeGitignore())
+    return workdirFailureSummary(catalog, filter);
+  return runCases(
+      catalog,
+      filter,
+      [&](anari::Device d,
+          WorldCache &worlds,
+          const TestDef &test,
+          const Case &c,
+          RunSummary &summary) {
+        return renderResult(d, worlds, test, c, candidateFeatures, summary);
+      },
+      [&](RenderedCase &rendered, RunSummary &summary) {
+        scoreResult(rendered, summary);
+      });
+}
+
+void Runner::runBehaviorCase(anari::Device d,
+    const TestDef &test,
+    const Case &c,
     const std::set<std::string> &candidateFeatures,
     RunSummary &summary)
 {
-  for (const Case &c : expand(test)) {
-    summary.total++;
+  if (!isSupported(test, candidateFeatures)) {
+    writeFeatureSkip(test, c, summary);
+    return;
+  }
 
-    if (!isSupported(test, candidateFeatures)) {
-      writeFeatureSkip(test, c, summary);
-      continue;
+  // Per-case crash isolation (ADR-0003): a throwing build hook or behavior
+  // check becomes a failed sidecar and the run continues; SceneObjects owns
+  // every handle and releases partial or complete builds on scope exit.
+  try {
+    CaseResult result = baseResult(test, c, m_options.device);
+    result.fingerprint = caseFingerprint(test, c, {}, {});
+    if (m_options.incremental
+        && keepUnchanged(c, result.fingerprint, summary))
+      return;
+
+    SceneObjects scene = buildScene(d, test, c);
+    if (!scene.valid()) {
+      result.verdict = Verdict::Failed;
+      result.detail = "world/camera/renderer build failed";
+      recordResult(c, result, summary);
+      return;
     }
 
-    // Per-case crash isolation (ADR-0003): a throwing build hook or behavior
-    // check becomes a failed sidecar and the run continues; SceneObjects owns
-    // every handle and releases partial or complete builds on scope exit.
-    try {
-      CaseResult result = baseResult(test, c, m_options.device);
+    const auto start = std::chrono::steady_clock::now();
+    const BehaviorResult br = test.behaviorCheck(d,
+        scene.world.get(),
+        scene.camera.get(),
+        scene.renderer.get(),
+        m_options.width,
+        m_options.height);
+    const auto end = std::chrono::steady_clock::now();
+    result.durationMs =
+        std::chrono::duration<double, std::milli>(end - start).count();
+    result.verdict = br.passed ? Verdict::Passed : Verdict::Failed;
+    result.detail = br.detail;
+    recordResult(c, result, summary);
+  } catch (const std::exception &e) {
+    writeCaseFailure(test,
+        c,
+        std::string("exception during behavior test: ") + e.what(),
+        summary);
+  } catch (...) {
+    writeCaseFailure(
+        test, c, "unknown exception during behavior test", summary);
+  }
+}
 
-      SceneObjects scene = buildScene(test, c);
-      if (!scene.valid()) {
-        result.verdict = Verdict::Failed;
-        result.detail = "world/camera/renderer build failed";
-        recordResult(c, result, summary);
-        continue;
-      }
+void Runner::runScalingCase(anari::Device d,
+    const TestDef &test,
+    const Case &c,
+    const std::set<std::string> &candidateFeatures,
+    RunSummary &summary)
+{
+  if (!isSupported(test, candidateFeatures)) {
+    writeFeatureSkip(test, c, summary);
+    return;
+  }
+
+  // Per-case crash isolation (ADR-0003), as for the other kinds of Test; a
+  // workload too large for the device fails only its own Case.
+  try {
+    CaseResult result = baseResult(test, c, m_options.device);
+    BuildContext ctx(d);
+    for (const auto &cv : c.values)
+      ctx.set(cv.axisName, cv.value);
+    const ScalingWork work = test.scaling(ctx);
+    ScalingResult &scaling = result.scaling.emplace();
+    scaling.unit = work.unit;
+    scaling.elements = work.elements;
+    scaling.width = work.width ? work.width : m_options.width;
+    scaling.height = work.height ? work.height : m_options.height;
 
-      const auto start = std::chrono::steady_clock::now();
-      const BehaviorResult br = test.behaviorCheck(m_device,
-          scene.world.get(),
-          scene.camera.get(),
-          scene.renderer.get(),
-          m_options.width,
-          m_options.height);
-      const auto end = std::chrono::steady_clock::now();
-      result.durationMs =
-          std::chrono::duration<double, std::milli>(end - start).count();
-      result.verdict = br.passed ? Verdict::Passed : Verdict::Failed;
-      result.detail = br.detail;
+    const auto memoryBefore =
+        deviceMemory(d, m_options.scaling.memoryProperty);
+    TimingResult &timing = result.timing.emplace();
+    const auto start = std::chrono::steady_clock::now();
+    SceneObjects scene =
+        buildScene(d, test, c, nullptr, scaling.width, scaling.height);
+    if (!scene.valid()) {
+      result.verdict = Verdict::Failed;
+      result.detail = "world/camera/renderer build failed";
+      result.timing.reset();
       recordResult(c, result, summary);
-    } catch (const std::exception &e) {
-      writeCaseFailure(test,
-          c,
-          std::string("exception during behavior test: ") + e.what(),
-          summary);
-    } catch (...) {
-      writeCaseFailure(
-          test, c, "unknown exception during behavior test", summary);
+      return;
+    }
+    timing.buildMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start)
+                         .count();
+    timeFrames(d,
+        scene.world.get(),
+        scene.camera.get(),
+        scene.renderer.get(),
+        scaling.width,
+        scaling.height,
+        caseChannelFormat(c, Channel::Color),
+        m_options.perf.warmupFrames,
+        m_options.perf.frames,
+        timing);
+    result.durationMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start)
+                            .count();
+    const auto memoryAfter = deviceMemory(d, m_options.scaling.memoryProperty);
+    if (memoryBefore && memoryAfter)
+      scaling.memoryBytes = *memoryAfter - *memoryBefore;
+
+    const Throughput t = throughput(result);
+    char detail[160];
+    std::snprintf(detail,
+        sizeof(detail),
+        "%llu %s: %.3g %s/s built, %.3g Mrays/s",
+        (unsigned long long)scaling.elements,
+        scaling.unit.c_str(),
+        t.elementsPerSecond,
+        scaling.unit.c_str(),
+        t.mraysPerSecond);
+    result.detail = detail;
+    result.verdict = Verdict::Passed;
+    if (compareWithBaseline(c, result)) {
+      result.verdict = Verdict::Failed;
+      summary.timingRegressions++;
+    }
+
+    if (!writeScalingCsv(m_workdir.measurementsPath(c), {{c.id(), result}})) {
+      result.verdict = Verdict::Failed;
+      result.detail += "; could not write the measurements";
     }
+    recordResult(c, result, summary);
+  } catch (const std::exception &e) {
+    writeCaseFailure(test,
+        c,
+        std::string("exception during scaling test: ") + e.what(),
+        summary);
+  } catch (...) {
+    writeCaseFailure(test, c, "unknown exception during scaling test", summary);
   }
 }
 
@@ -10,12 +10,15 @@
 #include "RendererParams.h"
 #include "Sidecar.h"
 #include "TestDef.h"
+#include "Timing.h"
 #include "Workdir.h"
 // anari
 #include "anari/anari_cpp.hpp"
 // std
 #include <map>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -23,12 +26,46 @@
 namespace anari {
 namespace cts {
 
+// Performance mode for `run`. Before its channels are rendered for scoring,
+// each image Case renders `warmupFrames` untimed and then `frames` timed color
+// frames, and its sidecar records them with the scene build and first-frame
+// times (CaseResult::timing). Given a `baseline` workdir from an earlier
+// performance run, each Case's frame times are compared with that run's
+// result for the same Case; a regression by `thresholds` fails the Case.
+// Cases render one at a time on the first device, each with a world of its
+// own, and an incremental run renders them all again.
+struct PerfOptions
+{
+  bool enabled{false};
+  uint32_t warmupFrames{3};
+  uint32_t frames{10};
+  std::filesystem::path baseline;
+  TimingThresholds thresholds;
+};
+
+// Scaling run (`run --scaling`): runs only the Tests that declare a workload
+// (TestDef::scaling), instead of every other Test. Each Case is built and
+// timed like a performance run, with PerfOptions::warmupFrames and frames,
+// and its sidecar records the workload beside the timings. A CSV of its
+// measurements is written next to the sidecar (Workdir::measurementsPath).
+// ANARI defines no memory query, so `memoryProperty` names a device-specific
+// UINT64 property of the device object reporting its memory use in bytes;
+// empty skips the query.
+struct ScalingOptions
+{
+  bool enabled{false};
+  std::string memoryProperty;
+};
+
 struct RunOptions
 {
   uint32_t width{256};
   uint32_t height{256};
   double ssimThreshold{0.70}; // ctsUtility defaults; overridden per-test
   double psnrThreshold{20.0};
+  // Fraction of pixels whose raw depth or id value must match the raw ground
+  // truth (see rawMatch); overridden per-test with the "match" metric.
+  double matchThreshold{0.98};
   // Color-channel renders per frame when accumulation is supported.
   uint32_t accumulationFrames{1};
   // Baseline renderer ambient light. A renderer Test may override this.
@@ -40,6 +77,20 @@ struct RunOptions
   // resolve against the device's declared parameter metadata.
   std::vector<RendererParam> rendererParams;
   DeviceSpec device;
+  // Threads scoring Cases and publishing their images while a Runner drives
+  // several devices; 0 uses one per hardware thread. A single device renders
+  // ahead of one publish thread.
+  uint32_t publishThreads{0};
+  // `run` keeps a Case's existing result, instead of rendering it again, when
+  // the sidecar's fingerprint matches the Case's inputs and every image it
+  // references is present.
+  bool incremental{false};
+  // Device builds (DeviceSpec::build) whose results an incremental run always
+  // renders again, for changes a fingerprint cannot see (e.g. to a library
+  // the device loads).
+  std::set<std::string> changedSince;
+  PerfOptions perf;
+  ScalingOptions scaling;
 };
 
 struct RunSummary
@@ -48,12 +99,28 @@ struct RunSummary
   int passed{0}; // generated, or passed comparison
   int failed{0};
   int skipped{0};
+  // Cases rendered with a world built for an earlier Case of their Test
+  int worldsReused{0};
+  // Results an incremental run kept; also counted as passed or failed
+  int unchanged{0};
+  // Cases of a performance run slower than their baseline; also counted as
+  // failed
+  int timingRegressions{0};
 };
 
 // Build, render, and score Cases against ground truth, writing images and
-// per-case sidecars under a Workdir (ADR-0001/0003). One Runner wraps one
-// device: `generate` is driven with the reference device, `run` with a
-// candidate. Cameras are framed from world bounds.
+// per-case sidecars under a Workdir (ADR-0001/0003). `generate` is driven with
+// the reference device, `run` with a candidate. Cameras are framed from world
+// bounds.
+//
+// A Runner given several independent instances of the same device renders on
+// all of them at once, each taking the next group of Cases sharing a ground
+// truth key, while a pool of RunOptions::publishThreads threads scores the
+// renders and writes the images and sidecars. A single device likewise
+// renders the next group while one background thread encodes the last. Every
+// file gets the same content and the summary counts the same, whatever the
+// scheduling; the ArtifactWriter must be safe to call concurrently unless the
+// run renders serially (performance and scaling runs).
 struct Runner
 {
   Runner(anari::Device device, Workdir workdir, RunOptions options = {});
@@ -61,6 +128,10 @@ struct Runner
       Workdir workdir,
       RunOptions options,
       std::shared_ptr<ArtifactWriter> artifactWriter);
+  Runner(std::vector<anari::Device> devices,
+      Workdir workdir,
+      RunOptions options,
+      std::shared_ptr<ArtifactWriter> artifactWriter = nullptr);
 
   // Render every selected Case and save its channels under ground_truth/.
   // Does not score or write sidecars (ADR-0005).
@@ -70,16 +141,127 @@ struct Runner
 
   // Render every selected Case, compare each channel against ground truth, and
   // write result images plus a sidecar. Cases whose required features are
-  // absent, or that have no ground truth yet, are recorded as skipped.
+  // absent, or that have no ground truth yet, are recorded as skipped. With
+  // RunOptions::incremental, Cases whose inputs are unchanged since their last
+  // result keep it and are not rendered. With RunOptions::scaling, only the
+  // scaling Tests run, and are measured instead.
   RunSummary run(const Catalog &catalog,
       const Filter &filter,
       const std::set<std::string> &candidateFeatures);
 
-  // Render a single Case's channels (in TestDef::channels order). Empty if the
-  // world could not be built. Public for testing and reuse.
+  // Render a single Case's channels (in TestDef::channels order) on the first
+  // device. Empty if the world could not be built. Public for testing and
+  // reuse.
   std::vector<Image> renderCase(const TestDef &test, const Case &c);
 
  private:
+  // The worlds one device built for the Cases of one Test. A later Case for
+  // which the build would read the same axis values (the names recorded by
+  // its BuildContext) gets the same world, so only its camera and renderer
+  // are created again. Behavioral tests always build their own world, since
+  // their checks may change it.
+  struct WorldCache
+  {
+    struct Entry
+    {
+      // axis name -> value in the Case, for every name the build read
+      std::map<std::string, std::string> reads;
+      UniqueAnariObject<anari::World> world;
+      anari::scenes::Bounds bounds{};
+    };
+
+    const TestDef *test{nullptr};
+    std::vector<Entry> entries;
+    int reused{0};
+  };
+
+  // A Case whose device work is done: its rendered channels, plus for `run`
+  // the ground truth they are scored against and the result being filled in.
+  struct RenderedCase
+  {
+    const TestDef *test{nullptr};
+    const Case *c{nullptr};
+    std::vector<Image> images;
+    std::vector<Image> groundTruth;
+    // Per channel; valid only for channels with raw ground truth
+    // (hasRawGroundTruth).
+    std::vector<RawImage> raws;
+    std::vector<RawImage> groundTruthRaw;
+    CaseResult result;
+  };
+
+  // The device side of one Case. Tallies the Case into `summary`, and either
+  // completes it (skips, failures, behavioral tests) or returns the render
+  // left to publish.
+  using RenderStage = std::function<std::optional<RenderedCase>(anari::Device,
+      WorldCache &,
+      const TestDef &,
+      const Case &,
+      RunSummary &)>;
+  // Scores and/or publishes a render, tallying its verdict into `summary`.
+  using PublishStage = std::function<void(RenderedCase &, RunSummary &)>;
+
+  // Drive every selected Case through both stages: in catalog order on the
+  // first device when rendering serially, otherwise concurrently as described
+  // above. Each Case is tallied
+  // into its own summary, which are added up in catalog order. Every device
+  // keeps its own WorldCache for the duration of the call.
+  RunSummary runCases(const Catalog &catalog,
+      const Filter &filter,
+      const RenderStage &render,
+      const PublishStage &publish);
+
+  std::optional<RenderedCase> renderGroundTruth(anari::Device d,
+      WorldCache &worlds,
+      const TestDef &test,
+      const Case &c,
+      const std::set<std::string> &referenceFeatures,
+      RunSummary &summary);
+  void publishGroundTruth(RenderedCase &rendered, RunSummary &summary);
+
+  std::optional<RenderedCase> renderResult(anari::Device d,
+      WorldCache &worlds,
+      const TestDef &test,
+      const Case &c,
+      const std::set<std::string> &candidateFeatures,
+      RunSummary &summary);
+  void scoreResult(RenderedCase &rendered, RunSummary &summary);
+
+  // The fingerprint of everything a Case's verdict depends on: the Test's
+  // definition and revision, the Case's axis values, the device (with its
+  // build), the render options, and the ground truth it is scored against.
+  std::string caseFingerprint(const TestDef &test,
+      const Case &c,
+      const std::vector<Image> &groundTruth,
+      const std::vector<RawImage> &groundTruthRaw) const;
+
+  // For an incremental run: if the Case's sidecar has this fingerprint, a
+  // verdict, an unlisted device build and all of its images, tally that
+  // result and return true.
+  bool keepUnchanged(
+      const Case &c, const std::string &fingerprint, RunSummary &summary);
+
+  // Render a Case's channels. With `timing`, the Case is first timed as
+  // PerfOptions describes and `worlds` is not used. With `raws`, each
+  // channel's raw values are appended to it. Throws if a channel cannot be
+  // read back.
+  std::vector<Image> renderCase(anari::Device d,
+      WorldCache *worlds,
+      const TestDef &test,
+      const Case &c,
+      TimingResult *timing = nullptr,
+      std::vector<RawImage> *raws = nullptr);
+
+  // Compare a timed result with the baseline workdir's result for the same
+  // Case, recording the comparisons in result.timing. True if it regressed.
+  bool compareWithBaseline(const Case &c, CaseResult &result) const;
+
+  // Whether Cases render and publish one at a time on the first device
+  bool rendersSerially() const;
+  // The threads publishing renders: 1 when rendering serially or with a
+  // single device, else RunOptions::publishThreads resolved.
+  uint32_t publishThreadCount() const;
+
   // The committed render objects for one Case: the world plus the camera and
   // renderer (with the Test's optional camera build / renderer configuration
   // hooks applied). `world` is null when the Test has no build function or
@@ -99,9 +281,16 @@ struct Runner
     }
   };
 
-  // Build a Case's world and camera, then configure its renderer. SceneObjects
-  // owns every handle and releases partial or complete builds on scope exit.
-  SceneObjects buildScene(const TestDef &test, const Case &c);
+  // Build a Case's world (or take it from `worlds`, when given) and camera,
+  // then configure its renderer. The default camera is framed for the given
+  // resolution, 0 meaning the runner's. SceneObjects owns every handle and
+  // releases partial or complete builds on scope exit.
+  SceneObjects buildScene(anari::Device d,
+      const TestDef &test,
+      const Case &c,
+      WorldCache *worlds = nullptr,
+      uint32_t width = 0,
+      uint32_t height = 0);
 
   // Resolve the requested accumulation/denoise options against one device's
   // advertised feature set. Accumulation is gated off when
@@ -119,7 +308,7 @@ struct Runner
   // Each value parses into its device-declared type, falling back to inference
   // when the device does not report the parameter; a value that cannot be
   // parsed is skipped with a warning.
-  void applyRendererParams(anari::Renderer renderer);
+  void applyRendererParams(anari::Device d, anari::Renderer renderer);
 
   // Write a "missing required feature" skip sidecar for a Case and tally it.
   void writeFeatureSkip(
@@ -140,13 +329,26 @@ struct Runner
       const std::string &detail,
       RunSummary &summary);
 
-  // Run a behavioral Test (TestDef::behaviorCheck set): one Case at a time,
+  // Run one Case of a behavioral Test (TestDef::behaviorCheck set):
   // feature-gating then invoking the check and writing its verdict + detail.
-  void runBehaviorTest(const TestDef &test,
+  void runBehaviorCase(anari::Device d,
+      const TestDef &test,
+      const Case &c,
+      const std::set<std::string> &candidateFeatures,
+      RunSummary &summary);
+
+  // Run one Case of a scaling Test (TestDef::scaling set): feature-gating,
+  // then building and timing it over its workload and writing its sidecar and
+  // measurements.
+  void runScalingCase(anari::Device d,
+      const TestDef &test,
+      const Case &c,
       const std::set<std::string> &candidateFeatures,
       RunSummary &summary);
 
+  // m_device is the first of m_devices; it also answers introspection queries
   anari::Device m_device{nullptr};
+  std::vector<anari::Device> m_devices;
   Workdir m_workdir;
   ArtifactPublisher m_artifacts;
   RunOptions m_options;
@@ -0,0 +1,141 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Scaling.h"
+#include "Timing.h"
+// std
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+namespace anari {
+namespace cts {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// A CSV cell: empty for a missing value
+std::string cell(double v, const char *format = "%.6g")
+{
+  if (!std::isfinite(v))
+    return {};
+  char text[64];
+  std::snprintf(text, sizeof(text), format, v);
+  return text;
+}
+
+// Quote a text cell if it holds a separator, quote or newline
+std::string textCell(const std::string &s)
+{
+  if (s.find_first_of(",\"\n") == std::string::npos)
+    return s;
+  std::string out = "\"";
+  for (char c : s)
+    out += c == '"' ? std::string("\"\"") : std::string(1, c);
+  return out + "\"";
+}
+
+} // namespace
+
+Throughput throughput(const CaseResult &result)
+{
+  Throughput t{kNaN, kNaN, kNaN};
+  if (!result.scaling)
+    return t;
+  const ScalingResult &sc = *result.scaling;
+  if (result.timing) {
+    const double buildSeconds =
+        (result.timing->buildMs + result.timing->commitMs) / 1e3;
+    if (buildSeconds > 0.0)
+      t.elementsPerSecond = sc.elements / buildSeconds;
+    const double frameMs = median(result.timing->frameMs);
+    if (frameMs > 0.0)
+      t.mraysPerSecond = double(sc.width) * sc.height / (frameMs * 1e3);
+  }
+  if (sc.memoryBytes && sc.elements > 0)
+    t.bytesPerElement = double(*sc.memoryBytes) / sc.elements;
+  return t;
+}
+
+std::string scalingCsvHeader()
+{
+  return "category,test,case,unit,elements,width,height,build_ms,commit_ms,"
+         "frame_median_ms,frame_p95_ms,device_median_ms,elements_per_s,"
+         "mrays_per_s,memory_bytes,bytes_per_element";
+}
+
+std::string scalingCsvRow(const CaseResult &r)
+{
+  const ScalingResult sc = r.scaling.value_or(ScalingResult{});
+  const TimingResult timing = r.timing.value_or(TimingResult{});
+  const Throughput t = throughput(r);
+  std::string row;
+  for (const std::string &field : {textCell(r.category),
+           textCell(r.test),
+           textCell(r.caseId),
+           textCell(sc.unit),
+           std::to_string(sc.elements),
+           std::to_string(sc.width),
+           std::to_string(sc.height),
+           cell(r.timing ? timing.buildMs : kNaN, "%.3f"),
+           cell(r.timing ? timing.commitMs : kNaN, "%.3f"),
+           cell(median(timing.frameMs), "%.3f"),
+           cell(percentile(timing.frameMs, 95.0), "%.3f"),
+           cell(median(timing.deviceMs), "%.3f"),
+           cell(t.elementsPerSecond),
+           cell(t.mraysPerSecond),
+           sc.memoryBytes ? std::to_string(*sc.memoryBytes) : std::string(),
+           cell(t.bytesPerElement)}) {
+    if (!row.empty())
+      row += ',';
+    row += field;
+  }
+  return row;
+}
+
+bool writeScalingCsv(const std::filesystem::path &path,
+    const std::map<std::string, CaseResult> &results)
+{
+  std::vector<const CaseResult *> rows;
+  for (const auto &[key, r] : results)
+    if (r.scaling)
+      rows.push_back(&r);
+  std::stable_sort(rows.begin(), rows.end(), [](auto *a, auto *b) {
+    const uint64_t pixelsA = uint64_t(a->scaling->width) * a->scaling->height;
+    const uint64_t pixelsB = uint64_t(b->scaling->width) * b->scaling->height;
+    return std::tie(a->category, a->test, a->scaling->elements, pixelsA)
+        < std::tie(b->category, b->test, b->scaling->elements, pixelsB);
+  });
+
+  std::error_code ec;
+  if (path.has_parent_path())
+    std::filesystem::create_directories(path.parent_path(), ec);
+  std::filesystem::path tmp = path;
+  tmp += ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::out | std::ios::trunc);
+    if (!out)
+      return false;
+    out << scalingCsvHeader() << '\n';
+    for (const CaseResult *r : rows)
+      out << scalingCsvRow(*r) << '\n';
+    if (!out)
+      return false;
+  }
+  std::filesystem::rename(tmp, path, ec);
+  if (ec) {
+    std::error_code ignored;
+    std::filesystem::remove(tmp, ignored);
+    return false;
+  }
+  return true;
+}
+
+} // namespace cts
+} // namespace anari
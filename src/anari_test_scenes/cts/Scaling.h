@@ -0,0 +1,41 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "Sidecar.h"
+// std
+#include <filesystem>
+#include <map>
+#include <string>
+
+namespace anari {
+namespace cts {
+
+// The throughput of one scaling Case, derived from its workload and timings.
+// NaN where a measurement is missing.
+struct Throughput
+{
+  // Elements built per second: the workload over the scene build plus the
+  // first frame, during which the device builds its acceleration structures
+  double elementsPerSecond;
+  // Millions of primary rays per second: one per pixel over the median frame
+  double mraysPerSecond;
+  double bytesPerElement;
+};
+
+Throughput throughput(const CaseResult &result);
+
+// The measurements of scaling results as CSV: a header line, then one row per
+// result with its workload, times and throughput.
+std::string scalingCsvHeader();
+std::string scalingCsvRow(const CaseResult &result);
+
+// Write the scaling results among `results` as one CSV, ordered by Test and
+// then by workload, so that each Test's rows form a throughput curve. Writes
+// through a temporary sibling renamed into place; false on failure.
+bool writeScalingCsv(const std::filesystem::path &path,
+    const std::map<std::string, CaseResult> &results);
+
+} // namespace cts
+} // namespace anari
@@ -64,11 +64,13 @@ std::string toJson(const CaseResult &result)
   // by this identity instead of by workdir name.
   j["device"] = {{"library", result.device.library},
       {"device", result.device.device},
-      {"renderer", result.device.renderer}};
+      {"renderer", result.device.renderer},
+      {"build", result.device.build}};
   j["verdict"] = verdictName(result.verdict);
   j["skipReason"] = result.skipReason;
   j["detail"] = result.detail;
   j["durationMs"] = result.durationMs;
+  j["fingerprint"] = result.fingerprint;
 
   // Ordered array so axis declaration order survives the round-trip.
   j["axes"] = json::array();
@@ -95,6 +97,39 @@ std::string toJson(const CaseResult &result)
     j["channels"].push_back(std::move(c));
   }
 
+  if (result.timing) {
+    const TimingResult &t = *result.timing;
+    json timing;
+    timing["warmupFrames"] = t.warmupFrames;
+    timing["buildMs"] = t.buildMs;
+    timing["commitMs"] = t.commitMs;
+    timing["frameMs"] = t.frameMs;
+    timing["deviceMs"] = t.deviceMs;
+    timing["baseline"] = t.baseline;
+    timing["comparisons"] = json::array();
+    for (const auto &c : t.comparisons) {
+      // An untested measure's NaN p-value serializes as null.
+      timing["comparisons"].push_back({{"measure", c.measure},
+          {"baselineMedian", c.baselineMedian},
+          {"median", c.median},
+          {"baselineP95", c.baselineP95},
+          {"p95", c.p95},
+          {"pValue", c.pValue},
+          {"regressed", c.regressed}});
+    }
+    j["timing"] = std::move(timing);
+  }
+
+  if (result.scaling) {
+    const ScalingResult &sc = *result.scaling;
+    j["scaling"] = {{"unit", sc.unit},
+        {"elements", sc.elements},
+        {"width", sc.width},
+        {"height", sc.height},
+        {"memoryBytes",
+            sc.memoryBytes ? json(*sc.memoryBytes) : json(nullptr)}};
+  }
+
   return j.dump(2);
 }
 
@@ -118,6 +153,40 @@ void readMetricMap(const json &obj, std::map<std::string, double> &out)
     out[name] = numberOrNan(value);
 }
 
+void readSamples(const json &arr, std::vector<double> &out)
+{
+  if (!arr.is_array())
+    return;
+  for (const auto &v : arr)
+    if (v.is_number())
+      out.push_back(v.get<double>());
+}
+
+TimingResult readTiming(const json &j)
+{
+  TimingResult t;
+  t.warmupFrames = j.value("warmupFrames", 0u);
+  t.buildMs = j.value("buildMs", 0.0);
+  t.commitMs = j.value("commitMs", 0.0);
+  readSamples(j.value("frameMs", json::array()), t.frameMs);
+  readSamples(j.value("deviceMs", json::array()), t.deviceMs);
+  t.baseline = j.value("baseline", "");
+  if (const auto cs = j.find("comparisons"); cs != j.end() && cs->is_array()) {
+    for (const auto &c : *cs) {
+      TimingComparison cmp;
+      cmp.measure = c.value("measure", "");
+      cmp.baselineMedian = numberOrNan(c.value("baselineMedian", json()));
+      cmp.median = numberOrNan(c.value("median", json()));
+      cmp.baselineP95 = numberOrNan(c.value("baselineP95", json()));
+      cmp.p95 = numberOrNan(c.value("p95", json()));
+      cmp.pValue = numberOrNan(c.value("pValue", json()));
+      cmp.regressed = c.value("regressed", false);
+      t.comparisons.push_back(std::move(cmp));
+    }
+  }
+  return t;
+}
+
 } // namespace
 
 bool fromJson(const std::string &text, CaseResult &out, bool *schemaMismatch)
@@ -139,11 +208,13 @@ bool fromJson(const std::string &text, CaseResult &out, bool *schemaMismatch)
     out.device.library = d->value("library", "");
     out.device.device = d->value("device", "default");
     out.device.renderer = d->value("renderer", "default");
+    out.device.build = d->value("build", "");
   }
   out.verdict = verdictFromName(j.value("verdict", "skipped"));
   out.skipReason = j.value("skipReason", "");
   out.detail = j.value("detail", "");
   out.durationMs = j.value("durationMs", 0.0);
+  out.fingerprint = j.value("fingerprint", "");
 
   if (const auto axes = j.find("axes"); axes != j.end() && axes->is_array())
     for (const auto &ax : *axes)
@@ -164,6 +235,21 @@ bool fromJson(const std::string &text, CaseResult &out, bool *schemaMismatch)
     }
   }
 
+  if (const auto t = j.find("timing"); t != j.end() && t->is_object())
+    out.timing = readTiming(*t);
+
+  if (const auto sc = j.find("scaling"); sc != j.end() && sc->is_object()) {
+    ScalingResult scaling;
+    scaling.unit = sc->value("unit", "");
+    scaling.elements = sc->value("elements", uint64_t(0));
+    scaling.width = sc->value("width", 0u);
+    scaling.height = sc->value("height", 0u);
+    if (const auto m = sc->find("memoryBytes");
+        m != sc->end() && m->is_number_integer())
+      scaling.memoryBytes = m->get<int64_t>();
+    out.scaling = std::move(scaling);
+  }
+
   return true;
 }
 
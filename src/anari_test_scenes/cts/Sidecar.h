@@ -5,8 +5,10 @@
 
 #include "Channel.h"
 // std
+#include <cstdint>
 #include <filesystem>
 #include <map>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -24,7 +26,9 @@ namespace cts {
 // v2 adds the `device` object identifying which device produced the run, so a
 // two-device diff can label runs by device rather than by workdir name.
 // `description` is additive optional catalog metadata; readers treat its
-// absence in older v2 workdirs as an empty description.
+// absence in older v2 workdirs as an empty description. So are `fingerprint`
+// and the device's `build`, which only incremental runs read, and `timing` and
+// `scaling`, which only performance and scaling runs write.
 constexpr int kSidecarSchemaVersion = 2;
 
 // A Case's pass/fail outcome.
@@ -49,6 +53,9 @@ struct DeviceSpec
   std::string library;
   std::string device{"default"};
   std::string renderer{"default"};
+  // Identifies the build of the library, e.g. a fingerprint of its file;
+  // empty when unknown
+  std::string build{};
 };
 
 // One channel's comparison against ground truth.
@@ -67,6 +74,51 @@ struct ChannelResult
   std::string thresholdImage;
 };
 
+// One timing measure of a Case compared against the same Case in a baseline
+// run. Times are in milliseconds.
+struct TimingComparison
+{
+  std::string measure; // "frame", "device", "build" or "commit"
+  double baselineMedian{0.0};
+  double median{0.0};
+  double baselineP95{0.0};
+  double p95{0.0};
+  // One-sided p-value that this run is slower than the baseline; NaN when the
+  // measure is a single sample or has too few samples to test
+  double pValue{0.0};
+  bool regressed{false};
+};
+
+// What a performance run (anariCts run --perf) measured for one Case, in
+// milliseconds of wall time unless noted.
+struct TimingResult
+{
+  uint32_t warmupFrames{0};
+  double buildMs{0.0}; // building the world, camera and renderer
+  // Committing the frame and rendering the first one, during which the device
+  // processes every commit made while building the scene
+  double commitMs{0.0};
+  std::vector<double> frameMs; // each timed frame
+  // Each timed frame's "duration" property as the device reports it; empty
+  // when the device does not report one
+  std::vector<double> deviceMs;
+  std::string baseline; // workdir compared against; empty if none
+  std::vector<TimingComparison> comparisons;
+};
+
+// The workload one Case of a scaling Test was measured over (see ScalingWork)
+// and the device memory it took. The measured times are in CaseResult::timing.
+struct ScalingResult
+{
+  std::string unit;
+  uint64_t elements{0};
+  uint32_t width{0};
+  uint32_t height{0};
+  // How much the device's memory property grew while the scene was built and
+  // its frames rendered; absent when not queried or not reported
+  std::optional<int64_t> memoryBytes;
+};
+
 // The full per-Case result.
 struct CaseResult
 {
@@ -82,6 +134,14 @@ struct CaseResult
   std::string detail; // human-readable note (e.g. a behavioral check's outcome)
   double durationMs{0.0};
   std::vector<ChannelResult> channels;
+  // Fingerprint of every input the verdict depends on (see Runner); an
+  // incremental run keeps a result whose inputs have not changed. Empty when
+  // the Case was not rendered or checked.
+  std::string fingerprint;
+  // Present only for results of a performance run
+  std::optional<TimingResult> timing;
+  // Present only for results of a scaling Test
+  std::optional<ScalingResult> scaling;
 };
 
 // Serialize a CaseResult to its sidecar JSON text (pretty-printed).
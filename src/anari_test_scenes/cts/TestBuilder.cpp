@@ -42,6 +42,12 @@ TestBuilder &TestBuilder::behavior(BehaviorFn fn)
   return *this;
 }
 
+TestBuilder &TestBuilder::scaling(ScalingFn fn)
+{
+  m_def.scaling = std::move(fn);
+  return *this;
+}
+
 TestBuilder &TestBuilder::permute(std::string axis, std::vector<Any> values)
 {
   m_def.axes.push_back(
@@ -62,6 +68,12 @@ TestBuilder &TestBuilder::simplified(bool on)
   return *this;
 }
 
+TestBuilder &TestBuilder::revision(uint32_t value)
+{
+  m_def.revision = value;
+  return *this;
+}
+
 TestBuilder &TestBuilder::requireFeatures(std::vector<std::string> features)
 {
   for (auto &f : features)
@@ -35,6 +35,10 @@ struct TestBuilder
   // with a behavior check generates no ground truth.
   TestBuilder &behavior(BehaviorFn fn);
 
+  // Measure throughput over the Case's workload instead of comparing images
+  // (see ScalingFn). The Test runs only in a scaling run.
+  TestBuilder &scaling(ScalingFn fn);
+
   // Permutation axis: values produce different output (distinct ground truth).
   TestBuilder &permute(std::string axis, std::vector<Any> values);
   template <typename T>
@@ -52,6 +56,8 @@ struct TestBuilder
   }
 
   TestBuilder &simplified(bool on = true);
+  // See TestDef::revision.
+  TestBuilder &revision(uint32_t value);
   TestBuilder &requireFeatures(std::vector<std::string> features);
   TestBuilder &requireFeature(std::string feature);
   // Test-wide metric threshold (applies to every channel).
@@ -59,6 +59,24 @@ using BehaviorFn = std::function<BehaviorResult(anari::Device,
     uint32_t width,
     uint32_t height)>;
 
+// The workload of one Case of a scaling Test: how many elements its world
+// holds (spheres, triangles, instances, voxels, ...), named by `unit`, and the
+// resolution to render it at (0 keeps the runner's).
+struct ScalingWork
+{
+  std::string unit;
+  uint64_t elements{0};
+  uint32_t width{0};
+  uint32_t height{0};
+};
+
+// Optional per-Case workload, for Tests that measure how a device scales rather
+// than whether it renders correctly. When a Test sets one, `run --scaling`
+// builds and times each Case (see RunOptions::scaling) and records throughput
+// against this workload instead of comparing images. Such Tests run only in a
+// scaling run and generate no ground truth.
+using ScalingFn = std::function<ScalingWork(BuildContext &)>;
+
 // A single registered definition in the Catalog: a human-readable description,
 // world-build function, axes, required features, thresholds, and bounds
 // tolerance. A Test expands into one or more Cases.
@@ -71,6 +89,7 @@ struct TestDef
   CameraFn cameraBuild; // empty -> runner frames camera from world bounds
   RendererFn rendererConfig; // empty -> runner keeps its renderer baseline
   BehaviorFn behaviorCheck; // set -> verify behavior instead of render+compare
+  ScalingFn scaling; // set -> measure throughput instead of render+compare
   std::vector<Axis> axes;
   std::vector<std::string> requiredFeatures;
   std::map<std::string, double>
@@ -85,6 +104,10 @@ struct TestDef
   // product: a baseline of every axis's first value, plus one Case per
   // additional value of each axis.
   bool simplified{false};
+  // Bumped by the Test's author whenever a change to its functions changes
+  // what they render or check, since code cannot be fingerprinted. Part of
+  // every Case's fingerprint, so incremental runs render the Test again.
+  uint32_t revision{0};
 
   std::string id() const
   {
@@ -0,0 +1,110 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Timing.h"
+// std
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <utility>
+
+namespace anari {
+namespace cts {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+TimingComparison compareSamples(const char *measure,
+    const std::vector<double> &baseline,
+    const std::vector<double> &candidate,
+    const TimingThresholds &thresholds)
+{
+  TimingComparison c;
+  c.measure = measure;
+  c.baselineMedian = median(baseline);
+  c.median = median(candidate);
+  c.baselineP95 = percentile(baseline, 95.0);
+  c.p95 = percentile(candidate, 95.0);
+  c.pValue = mannWhitneyGreater(baseline, candidate);
+  const bool slower = c.median > c.baselineMedian * (1.0 + thresholds.median)
+      || c.p95 > c.baselineP95 * (1.0 + thresholds.p95);
+  c.regressed = c.pValue < thresholds.significance && slower;
+  return c;
+}
+
+TimingComparison compareSingle(const char *measure, double baseline, double v)
+{
+  TimingComparison c;
+  c.measure = measure;
+  c.baselineMedian = c.baselineP95 = baseline;
+  c.median = c.p95 = v;
+  c.pValue = kNaN;
+  return c;
+}
+
+} // namespace
+
+double median(std::vector<double> samples)
+{
+  return percentile(std::move(samples), 50.0);
+}
+
+std::vector<TimingComparison> compareTiming(const TimingResult &baseline,
+    const TimingResult &candidate,
+    const TimingThresholds &thresholds)
+{
+  std::vector<TimingComparison> out;
+  if (!baseline.frameMs.empty() && !candidate.frameMs.empty()) {
+    out.push_back(compareSamples(
+        "frame", baseline.frameMs, candidate.frameMs, thresholds));
+  }
+  if (!baseline.deviceMs.empty() && !candidate.deviceMs.empty()) {
+    out.push_back(compareSamples(
+        "device", baseline.deviceMs, candidate.deviceMs, thresholds));
+  }
+  out.push_back(compareSingle("build", baseline.buildMs, candidate.buildMs));
+  out.push_back(compareSingle("commit", baseline.commitMs, candidate.commitMs));
+  return out;
+}
+
+std::string describeTiming(const TimingComparison &c)
+{
+  char text[160];
+  const double change = c.baselineMedian > 0.0
+      ? (c.median / c.baselineMedian - 1.0) * 100.0
+      : 0.0;
+  int n = std::snprintf(text,
+      sizeof(text),
+      "%s median %.2f -> %.2f ms (%+.1f%%)",
+      c.measure.c_str(),
+      c.baselineMedian,
+      c.median,
+      change);
+  std::string out(text, std::min<size_t>(n, sizeof(text) - 1));
+  if (std::isfinite(c.pValue)) {
+    std::snprintf(text,
+        sizeof(text),
+        ", p95 %.2f -> %.2f ms, p=%.3g",
+        c.baselineP95,
+        c.p95,
+        c.pValue);
+    out += text;
+  }
+  return out;
+}
+
+std::vector<TimingComparison> timingRegressions(const CaseResult &result)
+{
+  std::vector<TimingComparison> out;
+  if (result.timing) {
+    for (const auto &c : result.timing->comparisons)
+      if (c.regressed)
+        out.push_back(c);
+  }
+  return out;
+}
+
+} // namespace cts
+} // namespace anari
@@ -0,0 +1,49 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "Sidecar.h"
+#include "scenes/Statistics.h"
+// std
+#include <string>
+#include <vector>
+
+namespace anari {
+namespace cts {
+
+// When a timed Case counts as slower than its baseline: its frame times must
+// be significantly larger (Mann-Whitney U below `significance`) and either
+// their median or their 95th percentile must have grown by more than the
+// given fraction.
+struct TimingThresholds
+{
+  double median{0.10};
+  double p95{0.25};
+  double significance{0.05};
+};
+
+// The median of the samples (NaN when empty).
+double median(std::vector<double> samples);
+
+// percentile() and mannWhitneyGreater() of the scene library's statistics
+using scenes::mannWhitneyGreater;
+using scenes::percentile;
+
+// Compare a Case's timings with the same Case's timings from a baseline run.
+// Frame wall times and device durations are tested and may regress; the single
+// build and commit samples are reported for reference only.
+std::vector<TimingComparison> compareTiming(const TimingResult &baseline,
+    const TimingResult &candidate,
+    const TimingThresholds &thresholds);
+
+// One line describing a comparison, e.g.
+// "frame median 10.20 -> 12.90 ms (+26.5%), p95 11.00 -> 14.10 ms, p=0.003".
+std::string describeTiming(const TimingComparison &comparison);
+
+// The comparisons of a result that regressed; empty when it was not timed or
+// compared.
+std::vector<TimingComparison> timingRegressions(const CaseResult &result);
+
+} // namespace cts
+} // namespace anari
@@ -30,11 +30,21 @@ std::filesystem::path Workdir::assetsDir() const
   return m_root / "assets";
 }
 
+std::filesystem::path Workdir::thumbnailsDir() const
+{
+  return m_root / "thumbnails";
+}
+
 std::filesystem::path Workdir::sidecarPath(const Case &c) const
 {
   return resultsDir() / c.category / c.testName / (c.id() + ".json");
 }
 
+std::filesystem::path Workdir::measurementsPath(const Case &c) const
+{
+  return resultsDir() / c.category / c.testName / (c.id() + ".csv");
+}
+
 std::filesystem::path Workdir::resultImagePath(
     const Case &c, Channel channel) const
 {
@@ -63,6 +73,13 @@ std::filesystem::path Workdir::groundTruthImagePath(
       / (c.groundTruthKey() + "." + channelName(channel) + ".png");
 }
 
+std::filesystem::path Workdir::groundTruthRawPath(
+    const Case &c, Channel channel) const
+{
+  return groundTruthDir() / c.category / c.testName
+      / (c.groundTruthKey() + "." + channelName(channel) + ".raw");
+}
+
 std::string Workdir::relativeToRoot(const std::filesystem::path &p) const
 {
   std::error_code ec;
@@ -13,7 +13,7 @@ namespace anari {
 namespace cts {
 
 // The single root directory a run operates under, with the conventional
-// subdirs results/, ground_truth/, and assets/. Files mirror the catalog
+// subdirs results/, ground_truth/, assets/, and thumbnails/. Files mirror the catalog
 // hierarchy: <sub>/<category>/<test>/<leaf>. Result files are keyed by the
 // Case id (unique); ground-truth files by the Case's ground-truth key (shared
 // by variants). All accessors return absolute paths and create no directories.
@@ -25,9 +25,15 @@ struct Workdir
   std::filesystem::path resultsDir() const;
   std::filesystem::path groundTruthDir() const;
   std::filesystem::path assetsDir() const;
+  // Downscaled copies of result images, cached by the HTML report and keyed by
+  // the thumbnail edge and the source's workdir-relative path:
+  // thumbnails/<edge>/<category>/<test>/<leaf>.
+  std::filesystem::path thumbnailsDir() const;
 
   // results/<category>/<test>/<caseId>.json
   std::filesystem::path sidecarPath(const Case &c) const;
+  // results/<category>/<test>/<caseId>.csv (scaling measurements)
+  std::filesystem::path measurementsPath(const Case &c) const;
   // results/<category>/<test>/<caseId>.<channel>.png
   std::filesystem::path resultImagePath(const Case &c, Channel channel) const;
   // results/<category>/<test>/<caseId>.<channel>.diff.png (debug image)
@@ -37,6 +43,10 @@ struct Workdir
   // ground_truth/<category>/<test>/<gtKey>.<channel>.png
   std::filesystem::path groundTruthImagePath(
       const Case &c, Channel channel) const;
+  // ground_truth/<category>/<test>/<gtKey>.<channel>.raw (the compared ground
+  // truth of a channel with hasRawGroundTruth(); the PNG is for viewing)
+  std::filesystem::path groundTruthRawPath(
+      const Case &c, Channel channel) const;
 
   // A path expressed relative to the workdir root (for storing in sidecars).
   std::string relativeToRoot(const std::filesystem::path &p) const;
@@ -22,6 +22,10 @@ void registerRendererTests(Catalog &catalog);
 void registerInstanceTests(Catalog &catalog);
 void registerVolumeTests(Catalog &catalog);
 
+// Throughput sweeps (TestDef::scaling) over primitive, instance and voxel
+// counts and image resolution; they run only in a scaling run.
+void registerScalingTests(Catalog &catalog);
+
 // glTF asset-scan factory: registers one Test per asset found under the
 // gltf-Sample-Assets tree. A no-op unless the build enabled glTF (ENABLE_GLTF).
 void registerGltfTests(Catalog &catalog);
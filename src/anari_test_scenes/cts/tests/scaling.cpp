@@ -0,0 +1,232 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../BuildContext.h"
+#include "../GeometryBuilder.h"
+#include "../GeometryLayout.h"
+#include "../InstanceBuilder.h"
+#include "../LightBuilder.h"
+#include "../SurfaceBuilder.h"
+#include "../TestBuilder.h"
+#include "../TestDef.h"
+#include "../VolumeBuilder.h"
+#include "../WorldBuilder.h"
+#include "Categories.h"
+// std
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace anari {
+namespace cts {
+
+namespace {
+
+using anari::math::float3;
+
+const char *kMatte = "ANARI_KHR_MATERIAL_MATTE";
+
+// Primitive counts swept by the geometry Tests, 1e3 to 1e8
+const std::initializer_list<int> kPrimitiveCounts = {
+    1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+// A world of one matte surface over `geom`, lit from above; releases `geom`.
+anari::World surfaceWorld(anari::Device d, anari::Geometry geom)
+{
+  auto mat = makeMatteMaterial(d, float3(0.7f, 0.7f, 0.7f));
+  auto surface = makeSurface(d, geom, mat);
+  auto light = makeDirectionalLight(d, float3(0.f, -1.f, -1.f));
+  WorldContents wc;
+  wc.surfaces = {surface};
+  wc.lights = {light};
+  auto world = assembleWorld(d, wc);
+  anari::release(d, geom);
+  anari::release(d, mat);
+  anari::release(d, surface);
+  anari::release(d, light);
+  return world;
+}
+
+anari::World sphereWorld(anari::Device d, int count)
+{
+  SphereSpec spec;
+  spec.primitiveCount = count;
+  spec.globalRadius = 0.25f;
+  return surfaceWorld(d, buildSphereGeometry(d, spec));
+}
+
+ScalingWork primitiveWork(BuildContext &ctx, const char *unit)
+{
+  ScalingWork work;
+  work.unit = unit;
+  work.elements = uint64_t(ctx.get<int>("primitiveCount", 1));
+  return work;
+}
+
+// Instances of one group of kInstancedTriangles triangles, on a grid
+constexpr int kInstancedTriangles = 1000;
+
+anari::World instanceWorld(anari::Device d, int count)
+{
+  const auto verts = layoutTriangleSoup(kInstancedTriangles);
+  float3 lo = verts.front();
+  float3 hi = verts.front();
+  for (const auto &v : verts) {
+    lo = anari::math::min(lo, v);
+    hi = anari::math::max(hi, v);
+  }
+  const float3 pitch = (hi - lo) * 1.1f;
+
+  auto geom = anari::newObject<anari::Geometry>(d, "triangle");
+  anari::setAndReleaseParameter(d,
+      geom,
+      "vertex.position",
+      anari::newArray1D(d, verts.data(), verts.size()));
+  anari::commitParameters(d, geom);
+  auto mat = makeMatteMaterial(d, float3(0.7f, 0.5f, 0.3f));
+  auto surface = makeSurface(d, geom, mat);
+
+  const int columns = int(std::ceil(std::sqrt(double(count))));
+  std::vector<anari::Instance> instances;
+  instances.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    const float3 offset(
+        (i % columns) * pitch.x, -(i / columns) * pitch.y, 0.f);
+    instances.push_back(
+        makeInstance(d, {surface}, anari::math::translation_matrix(offset)));
+  }
+
+  auto light = makeDirectionalLight(d, float3(0.f, -1.f, -1.f));
+  WorldContents wc;
+  wc.instances = instances;
+  wc.lights = {light};
+  auto world = assembleWorld(d, wc);
+  for (auto inst : instances)
+    anari::release(d, inst);
+  anari::release(d, geom);
+  anari::release(d, mat);
+  anari::release(d, surface);
+  anari::release(d, light);
+  return world;
+}
+
+// Sphere count of the resolution sweep's fixed scene
+constexpr int kResolutionSpheres = 100000;
+
+} // namespace
+
+void registerScalingTests(Catalog &catalog)
+{
+  makeTest("scaling", "spheres")
+      .description("Measures build and render throughput over sphere counts.")
+      .build([](BuildContext &ctx) {
+        return sphereWorld(ctx.device(), ctx.get<int>("primitiveCount", 1));
+      })
+      .scaling([](BuildContext &ctx) { return primitiveWork(ctx, "spheres"); })
+      .permute("primitiveCount", kPrimitiveCounts)
+      .requireFeatures({"ANARI_KHR_GEOMETRY_SPHERE", kMatte})
+      .registerInto(catalog);
+
+  makeTest("scaling", "triangles")
+      .description(
+          "Measures build and render throughput over triangle counts.")
+      .build([](BuildContext &ctx) {
+        auto d = ctx.device();
+        TriangleSpec spec;
+        spec.mode = PrimitiveMode::Indexed;
+        spec.primitiveCount = ctx.get<int>("primitiveCount", 1);
+        return surfaceWorld(d, buildTriangleGeometry(d, spec));
+      })
+      .scaling(
+          [](BuildContext &ctx) { return primitiveWork(ctx, "triangles"); })
+      .permute("primitiveCount", kPrimitiveCounts)
+      .requireFeatures({"ANARI_KHR_GEOMETRY_TRIANGLE", kMatte})
+      .registerInto(catalog);
+
+  makeTest("scaling", "curves")
+      .description("Measures build and render throughput over curve counts.")
+      .build([](BuildContext &ctx) {
+        auto d = ctx.device();
+        CurveSpec spec;
+        spec.primitiveCount = ctx.get<int>("primitiveCount", 1);
+        spec.globalRadius = 0.05f;
+        return surfaceWorld(d, buildCurveGeometry(d, spec));
+      })
+      .scaling([](BuildContext &ctx) { return primitiveWork(ctx, "curves"); })
+      .permute("primitiveCount", kPrimitiveCounts)
+      .requireFeatures({"ANARI_KHR_GEOMETRY_CURVE", kMatte})
+      .registerInto(catalog);
+
+  makeTest("scaling", "instances")
+      .description("Measures build and render throughput over instance counts "
+                   "of one 1000-triangle group.")
+      .build([](BuildContext &ctx) {
+        return instanceWorld(ctx.device(), ctx.get<int>("instanceCount", 1));
+      })
+      .scaling([](BuildContext &ctx) {
+        ScalingWork work;
+        work.unit = "instances";
+        work.elements = uint64_t(ctx.get<int>("instanceCount", 1));
+        return work;
+      })
+      .permute("instanceCount", {1, 10, 100, 1000, 10000, 100000})
+      .requireFeatures({"ANARI_KHR_GEOMETRY_TRIANGLE",
+          "ANARI_KHR_INSTANCE_TRANSFORM",
+          kMatte})
+      .registerInto(catalog);
+
+  makeTest("scaling", "volume")
+      .description("Measures build and render throughput over structured "
+                   "volume sizes.")
+      .build([](BuildContext &ctx) {
+        auto d = ctx.device();
+        const uint32_t n = uint32_t(ctx.get<int>("dimension", 2));
+        auto field = makeStructuredRegularField(d, {n, n, n});
+        auto vol = makeVolume(d, field);
+        WorldContents wc;
+        wc.volumes = {vol};
+        auto world = assembleWorld(d, wc);
+        anari::release(d, field);
+        anari::release(d, vol);
+        return world;
+      })
+      .scaling([](BuildContext &ctx) {
+        const uint64_t n = uint64_t(ctx.get<int>("dimension", 2));
+        ScalingWork work;
+        work.unit = "voxels";
+        work.elements = n * n * n;
+        return work;
+      })
+      .permute("dimension", {32, 64, 128, 256, 512})
+      .requireFeatures({"ANARI_KHR_SPATIAL_FIELD_STRUCTURED_REGULAR",
+          "ANARI_KHR_VOLUME_TRANSFER_FUNCTION1D"})
+      .registerInto(catalog);
+
+  makeTest("scaling", "resolution")
+      .description("Measures render throughput over image resolutions of a "
+                   "fixed sphere scene.")
+      .build([](BuildContext &ctx) {
+        // The resolution is read by the workload, not the world, so every
+        // Case renders the same scene.
+        return sphereWorld(ctx.device(), kResolutionSpheres);
+      })
+      .scaling([](BuildContext &ctx) {
+        ScalingWork work;
+        work.unit = "spheres";
+        work.elements = kResolutionSpheres;
+        const std::string res = ctx.getString("resolution", "256x256");
+        if (std::sscanf(res.c_str(), "%ux%u", &work.width, &work.height) != 2)
+          work.width = work.height = 0;
+        return work;
+      })
+      .permute("resolution",
+          {"256x256", "512x512", "1024x1024", "1920x1080", "3840x2160"})
+      .requireFeatures({"ANARI_KHR_GEOMETRY_SPHERE", kMatte})
+      .registerInto(catalog);
+}
+
+} // namespace cts
+} // namespace anari
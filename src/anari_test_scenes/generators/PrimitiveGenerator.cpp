@@ -3,16 +3,98 @@
 
 #include "PrimitiveGenerator.h"
 
+#include "helium/ParallelFor.h"
+
+#include <algorithm>
 #include <iterator>
+#include <thread>
 #include <vector>
 
 namespace anari::scenes {
 
+namespace {
+
+// splitmix64 finalizer, a bijective mixing function of good avalanche quality
+uint64_t mix64(uint64_t x)
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ull;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebull;
+  x ^= x >> 31;
+  return x;
+}
+
+// Random numbers of one primitive: the n-th draw hashes (key, n), so a
+// primitive's values never depend on how many were drawn for other ones
+struct CounterStream
+{
+  CounterStream(uint64_t seedKey, uint64_t primitive)
+      : key(mix64(seedKey + primitive * 0x9e3779b97f4a7c15ull))
+  {}
+
+  float getRandomFloat(float min, float max)
+  {
+    const uint64_t bits = mix64(key + counter++ * 0xd1b54a32d192ed03ull);
+    // top 24 bits give every float in [0, 1) the same spacing
+    return min + (max - min) * (float(bits >> 40) * (1.f / 16777216.f));
+  }
+
+  anari::math::float3 getRandomVector3(float min, float max)
+  {
+    const float x = getRandomFloat(min, max);
+    const float y = getRandomFloat(min, max);
+    const float z = getRandomFloat(min, max);
+    return {x, y, z};
+  }
+
+  // parallel counterpart of randomTranslate() for one primitive
+  void translate(anari::math::float3 *vertices, size_t count)
+  {
+    const anari::math::float3 translation(getRandomVector3(0.0f, 0.6f));
+    for (size_t i = 0; i < count; ++i) {
+      vertices[i] = (vertices[i] * 0.4f) + translation;
+    }
+  }
+
+  uint64_t key;
+  uint64_t counter{0};
+};
+
+// primitives handed to a thread at a time, large enough to amortize the
+// per-item dispatch and small enough to balance uneven thread speeds
+constexpr size_t parallelChunkSize = 1 << 16;
+
+} // namespace
+
 PrimitiveGenerator::PrimitiveGenerator(int seed)
+    : m_key(mix64(uint64_t(uint32_t(seed))))
 {
   m_rng.seed(seed);
 }
 
+void PrimitiveGenerator::setThreadCount(unsigned threadCount)
+{
+  m_threadCount = threadCount;
+}
+
+unsigned PrimitiveGenerator::threadCount() const
+{
+  if (m_threadCount != 0)
+    return m_threadCount;
+  return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+void PrimitiveGenerator::parallelFor(
+    size_t count, const std::function<void(size_t, size_t)> &func) const
+{
+  const size_t chunks = (count + parallelChunkSize - 1) / parallelChunkSize;
+  helium::tasking::parallelFor(chunks, threadCount(), [&](size_t c) {
+    const size_t begin = c * parallelChunkSize;
+    func(begin, std::min(begin + parallelChunkSize, count));
+  });
+}
+
 // helper function to get random float in range min..max
 float PrimitiveGenerator::getRandomFloat(float min, float max)
 {
@@ -574,4 +656,142 @@ PrimitiveGenerator::generateCylinders(
 
   return std::make_tuple(vertices, radii, caps);
 }
+
+// Parallel generation ////////////////////////////////////////////////////////
+
+std::vector<anari::math::float3> PrimitiveGenerator::generateTrianglesParallel(
+    size_t primitiveCount)
+{
+  std::vector<anari::math::float3> vertices(primitiveCount * 3);
+
+  parallelFor(primitiveCount, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      CounterStream rng(m_key, i);
+      anari::math::float3 *triangle = vertices.data() + i * 3;
+      for (size_t k = 0; k < 3; ++k) {
+        triangle[k] = rng.getRandomVector3(0.0f, 1.0f);
+      }
+      rng.translate(triangle, 3);
+    }
+  });
+
+  return vertices;
+}
+
+std::vector<anari::math::float3> PrimitiveGenerator::generateQuadsParallel(
+    size_t primitiveCount)
+{
+  std::vector<anari::math::float3> vertices(primitiveCount * 4);
+
+  parallelFor(primitiveCount, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      CounterStream rng(m_key, i);
+      const anari::math::float3 vertex0 = rng.getRandomVector3(0.0f, 1.0f);
+      const anari::math::float3 vertex1 = rng.getRandomVector3(0.0f, 1.0f);
+      const anari::math::float3 vertex2 = rng.getRandomVector3(0.0f, 1.0f);
+
+      anari::math::float3 *quad = vertices.data() + i * 4;
+      quad[0] = vertex0;
+      quad[1] = vertex1;
+      quad[2] = vertex2 + (vertex1 - vertex0);
+      quad[3] = vertex2;
+      rng.translate(quad, 4);
+    }
+  });
+
+  return vertices;
+}
+
+std::tuple<std::vector<anari::math::float3>, std::vector<float>>
+PrimitiveGenerator::generateSpheresParallel(size_t primitiveCount)
+{
+  std::vector<anari::math::float3> vertices(primitiveCount);
+  std::vector<float> radii(primitiveCount);
+
+  parallelFor(primitiveCount, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      CounterStream rng(m_key, i);
+      vertices[i] = rng.getRandomVector3(0.0f, 1.0f);
+      radii[i] = rng.getRandomFloat(0.0f, 0.4f);
+    }
+  });
+
+  return std::make_tuple(std::move(vertices), std::move(radii));
+}
+
+std::tuple<std::vector<anari::math::float3>, std::vector<float>>
+PrimitiveGenerator::generateCurvesParallel(size_t primitiveCount)
+{
+  std::vector<anari::math::float3> vertices(primitiveCount * 2);
+  std::vector<float> radii(primitiveCount * 2);
+
+  parallelFor(primitiveCount, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      CounterStream rng(m_key, i);
+      for (size_t k = i * 2; k < i * 2 + 2; ++k) {
+        vertices[k] = rng.getRandomVector3(0.0f, 1.0f);
+        radii[k] = rng.getRandomFloat(0.001f, 0.05f);
+      }
+      rng.translate(vertices.data() + i * 2, 2);
+    }
+  });
+
+  return std::make_tuple(std::move(vertices), std::move(radii));
+}
+
+std::tuple<std::vector<anari::math::float3>,
+    std::vector<float>,
+    std::vector<uint8_t>>
+PrimitiveGenerator::generateConesParallel(
+    size_t primitiveCount, std::optional<int32_t> vertexCaps)
+{
+  std::vector<anari::math::float3> vertices(primitiveCount * 2);
+  std::vector<float> radii(primitiveCount * 2);
+  std::vector<uint8_t> caps;
+  if (vertexCaps.has_value()) {
+    caps.resize(primitiveCount * 2, vertexCaps.value() == 0 ? 0u : 1u);
+  }
+
+  parallelFor(primitiveCount, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      CounterStream rng(m_key, i);
+      for (size_t k = i * 2; k < i * 2 + 2; ++k) {
+        vertices[k] = rng.getRandomVector3(0.0f, 1.0f);
+        radii[k] = rng.getRandomFloat(0.0f, 0.4f);
+      }
+      rng.translate(vertices.data() + i * 2, 2);
+    }
+  });
+
+  return std::make_tuple(
+      std::move(vertices), std::move(radii), std::move(caps));
+}
+
+std::tuple<std::vector<anari::math::float3>,
+    std::vector<float>,
+    std::vector<uint8_t>>
+PrimitiveGenerator::generateCylindersParallel(
+    size_t primitiveCount, std::optional<int32_t> vertexCaps)
+{
+  std::vector<anari::math::float3> vertices(primitiveCount * 2);
+  std::vector<float> radii(primitiveCount);
+  std::vector<uint8_t> caps;
+  if (vertexCaps.has_value()) {
+    caps.resize(primitiveCount, vertexCaps.value() == 0 ? 0u : 1u);
+  }
+
+  parallelFor(primitiveCount, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      CounterStream rng(m_key, i);
+      vertices[i * 2] = rng.getRandomVector3(0.0f, 1.0f);
+      vertices[i * 2 + 1] = rng.getRandomVector3(0.0f, 1.0f);
+      radii[i] = rng.getRandomFloat(0.0f, 0.4f);
+      rng.translate(vertices.data() + i * 2, 2);
+    }
+  });
+
+  return std::make_tuple(
+      std::move(vertices), std::move(radii), std::move(caps));
+}
+
 } // namespace anari::scenes
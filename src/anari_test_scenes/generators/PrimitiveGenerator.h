@@ -8,6 +8,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <functional>
 #include <optional>
 #include <random>
 #include <tuple>
@@ -76,6 +78,42 @@ class PrimitiveGenerator
     std::shuffle(vector.begin(), vector.end(), m_rng);
   }
 
+  // parallel generation, the *Parallel() variants produce the same kind of
+  // primitives as their serial counterparts but draw from counter based
+  // streams keyed by (seed, primitive index). Their output therefore only
+  // depends on the seed and the count, not on the number of threads, and
+  // differs from the output of the serial mt19937 based functions.
+  ANARI_TEST_SCENES_INTERFACE std::vector<anari::math::float3>
+  generateTrianglesParallel(size_t primitiveCount);
+  ANARI_TEST_SCENES_INTERFACE std::vector<anari::math::float3>
+  generateQuadsParallel(size_t primitiveCount);
+  ANARI_TEST_SCENES_INTERFACE
+  std::tuple<std::vector<anari::math::float3>, std::vector<float>>
+  generateSpheresParallel(size_t primitiveCount);
+  ANARI_TEST_SCENES_INTERFACE
+  std::tuple<std::vector<anari::math::float3>, std::vector<float>>
+  generateCurvesParallel(size_t primitiveCount);
+  ANARI_TEST_SCENES_INTERFACE std::tuple<std::vector<anari::math::float3>,
+      std::vector<float>,
+      std::vector<uint8_t>>
+  generateConesParallel(
+      size_t primitiveCount, std::optional<int32_t> hasVertexCap);
+  ANARI_TEST_SCENES_INTERFACE std::tuple<std::vector<anari::math::float3>,
+      std::vector<float>,
+      std::vector<uint8_t>>
+  generateCylindersParallel(
+      size_t primitiveCount, std::optional<int32_t> hasVertexCap);
+
+  // number of threads used by the *Parallel() functions, 0 (the default)
+  // uses all hardware threads
+  ANARI_TEST_SCENES_INTERFACE void setThreadCount(unsigned threadCount);
+  ANARI_TEST_SCENES_INTERFACE unsigned threadCount() const;
+
+  // calls func(begin, end) on fixed size ranges covering 0..count, spread
+  // over the worker threads
+  ANARI_TEST_SCENES_INTERFACE void parallelFor(
+      size_t count, const std::function<void(size_t, size_t)> &func) const;
+
   ANARI_TEST_SCENES_INTERFACE float getRandomFloat(float min, float max);
   ANARI_TEST_SCENES_INTERFACE anari::math::float2 getRandomVector2(
       float min, float max);
@@ -90,6 +128,8 @@ class PrimitiveGenerator
 
  private:
   std::mt19937 m_rng;
+  uint64_t m_key{0};
+  unsigned m_threadCount{0};
 };
 
 } // namespace scenes
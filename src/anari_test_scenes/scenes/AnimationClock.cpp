@@ -0,0 +1,54 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "AnimationClock.h"
+
+namespace anari {
+namespace scenes {
+
+void AnimationClock::reset(float timeStep, std::uint32_t seed)
+{
+  m_timeStep = timeStep > 0.f ? timeStep : 0.f;
+  m_time = 0.f;
+  m_frame = 0;
+  m_last = std::chrono::steady_clock::now();
+  m_rng.seed(seed);
+}
+
+float AnimationClock::advance()
+{
+  const float before = m_time;
+  ++m_frame;
+  if (fixedStep()) {
+    // Multiply rather than accumulate so that long runs do not drift.
+    m_time = static_cast<float>(double(m_timeStep) * m_frame);
+  } else {
+    const auto now = std::chrono::steady_clock::now();
+    m_time += std::chrono::duration<float>(now - m_last).count();
+    m_last = now;
+  }
+  return m_time - before;
+}
+
+float AnimationClock::time() const
+{
+  return m_time;
+}
+
+std::uint64_t AnimationClock::frame() const
+{
+  return m_frame;
+}
+
+bool AnimationClock::fixedStep() const
+{
+  return m_timeStep > 0.f;
+}
+
+std::mt19937 &AnimationClock::rng()
+{
+  return m_rng;
+}
+
+} // namespace scenes
+} // namespace anari
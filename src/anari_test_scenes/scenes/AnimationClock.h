@@ -0,0 +1,46 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "anari_test_scenes_export.h"
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+namespace anari {
+namespace scenes {
+
+// Time base of an animated scene. With a time step of 0 each frame advances
+// the clock by the wall-clock time since the previous frame. With a positive
+// step every frame advances it by exactly that step, so the n-th frame after a
+// reset always sees the same time and, drawing from rng(), the same random
+// numbers.
+class AnimationClock
+{
+ public:
+  // Restart at time 0 with the given step (seconds) and reseed rng().
+  ANARI_TEST_SCENES_INTERFACE void reset(float timeStep, std::uint32_t seed);
+
+  // Advance by one frame and return the seconds it added.
+  ANARI_TEST_SCENES_INTERFACE float advance();
+
+  // Seconds since the last reset.
+  ANARI_TEST_SCENES_INTERFACE float time() const;
+  // Frames advanced since the last reset.
+  ANARI_TEST_SCENES_INTERFACE std::uint64_t frame() const;
+  ANARI_TEST_SCENES_INTERFACE bool fixedStep() const;
+
+  ANARI_TEST_SCENES_INTERFACE std::mt19937 &rng();
+
+ private:
+  float m_timeStep{0.f};
+  float m_time{0.f};
+  std::uint64_t m_frame{0};
+  std::chrono::steady_clock::time_point m_last{std::chrono::steady_clock::now()};
+  std::mt19937 m_rng;
+};
+
+} // namespace scenes
+} // namespace anari
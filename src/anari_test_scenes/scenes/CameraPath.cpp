@@ -0,0 +1,64 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "anari_test_scenes.h"
+// std
+#include <cmath>
+
+namespace anari {
+namespace scenes {
+
+namespace {
+
+constexpr float kTwoPi = 6.283185307f;
+// Highest elevation of the "flyover" path
+constexpr float kFlyoverElevation = 0.5235988f; // 30 degrees
+
+Camera lookAtCenter(const math::float3 &center, const math::float3 &eye)
+{
+  Camera cam;
+  cam.position = eye;
+  cam.direction = math::normalize(center - eye);
+  cam.at = center;
+  cam.up = math::float3(0, 1, 0);
+  return cam;
+}
+
+} // namespace
+
+std::vector<std::string> getAvailableCameraPaths()
+{
+  return {"orbit", "dolly", "flyover"};
+}
+
+Camera getCameraPathPose(
+    const Bounds &bounds, const std::string &path, float phase)
+{
+  const math::float3 center = 0.5f * (bounds[0] + bounds[1]);
+  // Same distance as the scenes' default camera
+  const float distance = math::length(bounds[1] - bounds[0]);
+  const float angle = kTwoPi * (phase - std::floor(phase));
+
+  float azimuth = 0.f;
+  float elevation = 0.f;
+  float radius = distance;
+  if (path == "orbit") {
+    // Circle the center at the height of the center
+    azimuth = angle;
+  } else if (path == "dolly") {
+    // Move straight in to half the distance and back out
+    radius = distance * (0.75f + 0.25f * std::cos(angle));
+  } else if (path == "flyover") {
+    // Circle the center while rising over it and dipping below it
+    azimuth = angle;
+    elevation = kFlyoverElevation * std::sin(angle);
+  }
+
+  const math::float3 offset(radius * std::cos(elevation) * std::sin(azimuth),
+      radius * std::sin(elevation),
+      radius * std::cos(elevation) * std::cos(azimuth));
+  return lookAtCenter(center, center + offset);
+}
+
+} // namespace scenes
+} // namespace anari
@@ -0,0 +1,77 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Statistics.h"
+// std
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace anari {
+namespace scenes {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+double sortedPercentile(const std::vector<double> &sorted, double p)
+{
+  if (sorted.empty())
+    return kNaN;
+  const double rank = std::clamp(p, 0.0, 100.0) / 100.0 * (sorted.size() - 1);
+  const size_t lo = static_cast<size_t>(std::floor(rank));
+  const size_t hi = std::min(lo + 1, sorted.size() - 1);
+  return sorted[lo] + (sorted[hi] - sorted[lo]) * (rank - lo);
+}
+
+double percentile(std::vector<double> samples, double p)
+{
+  std::sort(samples.begin(), samples.end());
+  return sortedPercentile(samples, p);
+}
+
+double mannWhitneyGreater(
+    const std::vector<double> &baseline, const std::vector<double> &candidate)
+{
+  const size_t n1 = candidate.size();
+  const size_t n2 = baseline.size();
+  if (n1 < 3 || n2 < 3)
+    return kNaN;
+
+  // Rank the pooled samples, averaging the ranks of ties
+  std::vector<std::pair<double, bool>> pooled; // value, from candidate
+  pooled.reserve(n1 + n2);
+  for (double v : candidate)
+    pooled.emplace_back(v, true);
+  for (double v : baseline)
+    pooled.emplace_back(v, false);
+  std::sort(pooled.begin(), pooled.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+
+  const double n = static_cast<double>(n1 + n2);
+  double candidateRanks = 0.0;
+  double tieTerm = 0.0;
+  for (size_t i = 0; i < pooled.size();) {
+    size_t j = i;
+    while (j < pooled.size() && pooled[j].first == pooled[i].first)
+      ++j;
+    const double rank = (i + 1 + j) / 2.0; // mean of ranks i+1 .. j
+    for (size_t k = i; k < j; ++k)
+      candidateRanks += pooled[k].second ? rank : 0.0;
+    const double t = static_cast<double>(j - i);
+    tieTerm += t * t * t - t;
+    i = j;
+  }
+
+  const double u = candidateRanks - n1 * (n1 + 1) / 2.0;
+  const double mean = n1 * n2 / 2.0;
+  const double variance =
+      n1 * n2 / 12.0 * ((n + 1.0) - tieTerm / (n * (n - 1.0)));
+  if (variance <= 0.0)
+    return 1.0; // every sample equal: no evidence either way
+  const double z = (u - mean - 0.5) / std::sqrt(variance);
+  return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+} // namespace scenes
+} // namespace anari
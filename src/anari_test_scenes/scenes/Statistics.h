@@ -0,0 +1,33 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "anari_test_scenes_export.h"
+
+#include <vector>
+
+namespace anari {
+namespace scenes {
+
+// Sample statistics shared by the CTS timing comparison and the anariCat
+// benchmark.
+
+// The p-th percentile (0..100) of samples sorted in ascending order,
+// interpolating linearly between neighbours (NaN when empty).
+ANARI_TEST_SCENES_INTERFACE double sortedPercentile(
+    const std::vector<double> &sorted, double p);
+
+// The same for samples in any order.
+ANARI_TEST_SCENES_INTERFACE double percentile(
+    std::vector<double> samples, double p);
+
+// One-sided Mann-Whitney U test: the p-value for the hypothesis that
+// `candidate` samples tend to be larger than `baseline` samples. Uses the
+// normal approximation with tie and continuity corrections; NaN when either
+// side has fewer than 3 samples.
+ANARI_TEST_SCENES_INTERFACE double mannWhitneyGreater(
+    const std::vector<double> &baseline, const std::vector<double> &candidate);
+
+} // namespace scenes
+} // namespace anari
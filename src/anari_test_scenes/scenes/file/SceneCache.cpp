@@ -0,0 +1,418 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "SceneCache.h"
+// std
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace anari {
+namespace scenes {
+
+namespace fs = std::filesystem;
+
+// File layout: FileHeader, one FileEntry per blob, the source path, one
+// FileDependency per dependency followed by its path, then the blobs, each
+// starting at a multiple of blobAlignment
+namespace {
+
+constexpr char cacheMagic[8] = {'A', 'N', 'A', 'R', 'I', 'S', 'C', 0};
+constexpr uint32_t cacheFormatVersion = 2;
+constexpr uint64_t blobAlignment = 64;
+
+struct FileHeader
+{
+  char magic[8];
+  uint32_t formatVersion;
+  uint32_t loaderVersion;
+  char loader[16];
+  uint64_t sourceSize;
+  int64_t sourceTime;
+  uint64_t blobCount;
+  uint64_t pathBytes;
+  uint64_t dependencyCount;
+};
+
+struct FileEntry
+{
+  char name[64];
+  uint32_t type;
+  uint32_t pad;
+  uint64_t size[2];
+  uint64_t offset;
+  uint64_t bytes;
+};
+
+// size and modification time of a file that is read next to the source
+struct FileDependency
+{
+  uint64_t size;
+  int64_t time;
+  uint64_t pathBytes;
+};
+
+// Size of a missing dependency, which has to stay missing
+constexpr uint64_t missingFile = ~uint64_t(0);
+
+uint64_t alignUp(uint64_t offset)
+{
+  return (offset + blobAlignment - 1) / blobAlignment * blobAlignment;
+}
+
+uint64_t fnv1a(const std::string &s)
+{
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (unsigned char c : s) {
+    hash ^= c;
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+// Returns false if the file does not exist
+bool fileStamp(const fs::path &file, uint64_t &size, int64_t &time)
+{
+  std::error_code ec;
+  const auto fileSize = fs::file_size(file, ec);
+  if (ec)
+    return false;
+  const auto fileTime = fs::last_write_time(file, ec);
+  if (ec)
+    return false;
+  size = fileSize;
+  time = int64_t(fileTime.time_since_epoch().count());
+  return true;
+}
+
+void releaseBlob(const void *userPtr, const void *)
+{
+  delete static_cast<const std::shared_ptr<const void> *>(userPtr);
+}
+
+} // namespace
+
+std::shared_ptr<const char> mapFile(const std::string &filename, size_t &size)
+{
+  size = 0;
+#ifndef _WIN32
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return nullptr;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return nullptr;
+  }
+  const size_t length = size_t(st.st_size);
+  void *mem = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mem == MAP_FAILED)
+    return nullptr;
+  size = length;
+  return std::shared_ptr<const char>((const char *)mem,
+      [length](const char *p) { munmap((void *)p, length); });
+#else
+  std::ifstream in(filename, std::ios::in | std::ios::binary | std::ios::ate);
+  if (!in)
+    return nullptr;
+  auto bytes = std::make_shared<std::vector<char>>(size_t(in.tellg()));
+  in.seekg(0);
+  in.read(bytes->data(), bytes->size());
+  size = bytes->size();
+  return std::shared_ptr<const char>(bytes, bytes->data());
+#endif
+}
+
+SceneCache::SceneCache(const std::string &sourceFile,
+    const char *loader,
+    uint32_t loaderVersion)
+    : m_loader(loader), m_loaderVersion(loaderVersion)
+{
+  const char *dir = std::getenv("ANARI_SCENE_CACHE_DIR");
+  if (!dir || !*dir)
+    return;
+
+  std::error_code ec;
+  fs::path source = fs::absolute(sourceFile, ec);
+  if (ec || !fileStamp(source, m_sourceSize, m_sourceTime))
+    return;
+  m_sourceFile = source.string();
+
+  char key[17];
+  std::snprintf(key,
+      sizeof(key),
+      "%016llx",
+      (unsigned long long)fnv1a(m_sourceFile));
+  m_cacheFile =
+      (fs::path(dir) / (m_loader + "-" + key + ".anaricache")).string();
+}
+
+bool SceneCache::enabled() const
+{
+  return !m_cacheFile.empty();
+}
+
+bool SceneCache::load()
+{
+  m_blobs.clear();
+  m_dependencies.clear();
+  if (!enabled())
+    return false;
+
+  size_t fileSize = 0;
+  std::shared_ptr<const char> file = mapFile(m_cacheFile, fileSize);
+  if (!file || fileSize < sizeof(FileHeader))
+    return false;
+
+  FileHeader header;
+  std::memcpy(&header, file.get(), sizeof(header));
+  if (std::memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) != 0
+      || header.formatVersion != cacheFormatVersion
+      || header.loaderVersion != m_loaderVersion
+      || std::strncmp(header.loader, m_loader.c_str(), sizeof(header.loader))
+          != 0
+      || header.sourceSize != m_sourceSize
+      || header.sourceTime != m_sourceTime)
+    return false;
+
+  const uint64_t entriesEnd =
+      sizeof(FileHeader) + header.blobCount * sizeof(FileEntry);
+  if (header.blobCount > fileSize / sizeof(FileEntry)
+      || entriesEnd + header.pathBytes > fileSize
+      || std::string(file.get() + entriesEnd, header.pathBytes)
+          != m_sourceFile)
+    return false;
+
+  std::vector<Dependency> dependencies;
+  uint64_t offset = entriesEnd + header.pathBytes;
+  for (uint64_t i = 0; i < header.dependencyCount; i++) {
+    FileDependency recorded;
+    if (sizeof(recorded) > fileSize - offset)
+      return false;
+    std::memcpy(&recorded, file.get() + offset, sizeof(recorded));
+    offset += sizeof(recorded);
+    if (recorded.pathBytes > fileSize - offset)
+      return false;
+
+    Dependency dependency;
+    dependency.file.assign(file.get() + offset, recorded.pathBytes);
+    offset += recorded.pathBytes;
+    if (!fileStamp(dependency.file, dependency.size, dependency.time))
+      dependency.size = missingFile;
+    if (dependency.size != recorded.size || dependency.time != recorded.time)
+      return false;
+    dependencies.push_back(std::move(dependency));
+  }
+
+  std::map<std::string, SceneBlob> blobs;
+  for (uint64_t i = 0; i < header.blobCount; i++) {
+    FileEntry entry;
+    std::memcpy(&entry,
+        file.get() + sizeof(FileHeader) + i * sizeof(FileEntry),
+        sizeof(entry));
+    if (entry.offset > fileSize || entry.bytes > fileSize - entry.offset)
+      return false;
+    // too few bytes for the array the entry describes
+    const uint64_t element = elementBytes(ANARIDataType(entry.type));
+    const uint64_t rows = std::max<uint64_t>(entry.size[1], 1);
+    if (element == 0 || entry.size[0] > entry.bytes / element / rows)
+      return false;
+
+    SceneBlob blob;
+    blob.data = std::shared_ptr<const void>(file, file.get() + entry.offset);
+    blob.bytes = entry.bytes;
+    blob.type = ANARIDataType(entry.type);
+    blob.size[0] = entry.size[0];
+    blob.size[1] = entry.size[1];
+    entry.name[sizeof(entry.name) - 1] = '\0';
+    blobs[entry.name] = std::move(blob);
+  }
+
+  m_blobs = std::move(blobs);
+  m_dependencies = std::move(dependencies);
+  return true;
+}
+
+bool SceneCache::save() const
+{
+  if (!enabled())
+    return false;
+
+  FileHeader header{};
+  std::memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+  header.formatVersion = cacheFormatVersion;
+  header.loaderVersion = m_loaderVersion;
+  std::strncpy(header.loader, m_loader.c_str(), sizeof(header.loader) - 1);
+  header.sourceSize = m_sourceSize;
+  header.sourceTime = m_sourceTime;
+  header.blobCount = m_blobs.size();
+  header.pathBytes = m_sourceFile.size();
+  header.dependencyCount = m_dependencies.size();
+
+  uint64_t dependencyBytes = 0;
+  for (const auto &dependency : m_dependencies)
+    dependencyBytes += sizeof(FileDependency) + dependency.file.size();
+
+  std::vector<FileEntry> entries;
+  uint64_t offset = alignUp(sizeof(FileHeader)
+      + m_blobs.size() * sizeof(FileEntry) + m_sourceFile.size()
+      + dependencyBytes);
+  for (const auto &[name, blob] : m_blobs) {
+    FileEntry entry{};
+    if (name.size() >= sizeof(entry.name))
+      return false;
+    std::memcpy(entry.name, name.c_str(), name.size());
+    entry.type = uint32_t(blob.type);
+    entry.size[0] = blob.size[0];
+    entry.size[1] = blob.size[1];
+    entry.offset = offset;
+    entry.bytes = blob.bytes;
+    entries.push_back(entry);
+    offset = alignUp(offset + blob.bytes);
+  }
+
+  std::error_code ec;
+  fs::create_directories(fs::path(m_cacheFile).parent_path(), ec);
+
+  // written aside and renamed, so concurrent loads never map a partial file
+  const std::string tmpFile =
+      m_cacheFile + ".tmp" + std::to_string(std::random_device{}());
+  bool written = false;
+  {
+    std::ofstream out(tmpFile, std::ios::out | std::ios::binary);
+    out.write((const char *)&header, sizeof(header));
+    out.write((const char *)entries.data(), entries.size() * sizeof(FileEntry));
+    out.write(m_sourceFile.data(), m_sourceFile.size());
+    for (const auto &dependency : m_dependencies) {
+      FileDependency recorded{};
+      recorded.size = dependency.size;
+      recorded.time = dependency.time;
+      recorded.pathBytes = dependency.file.size();
+      out.write((const char *)&recorded, sizeof(recorded));
+      out.write(dependency.file.data(), dependency.file.size());
+    }
+
+    const char padding[blobAlignment] = {};
+    uint64_t end = sizeof(header) + entries.size() * sizeof(FileEntry)
+        + m_sourceFile.size() + dependencyBytes;
+    size_t i = 0;
+    for (const auto &[name, blob] : m_blobs) {
+      out.write(padding, entries[i].offset - end);
+      out.write((const char *)blob.data.get(), blob.bytes);
+      end = entries[i].offset + blob.bytes;
+      i++;
+    }
+    written = bool(out);
+  }
+
+  if (written)
+    fs::rename(tmpFile, m_cacheFile, ec);
+  if (!written || ec) {
+    fs::remove(tmpFile, ec);
+    return false;
+  }
+  return true;
+}
+
+void SceneCache::add(const std::string &name,
+    ANARIDataType type,
+    uint64_t size0,
+    uint64_t size1,
+    std::shared_ptr<const void> data,
+    uint64_t bytes)
+{
+  SceneBlob blob;
+  blob.data = std::move(data);
+  blob.bytes = bytes;
+  blob.type = type;
+  blob.size[0] = size0;
+  blob.size[1] = size1;
+  m_blobs[name] = std::move(blob);
+}
+
+void SceneCache::addString(const std::string &name, const std::string &value)
+{
+  add(name, ANARI_STRING, std::vector<char>(value.begin(), value.end()));
+}
+
+void SceneCache::addDependency(const std::string &file)
+{
+  std::error_code ec;
+  fs::path path = fs::absolute(file, ec);
+  if (ec)
+    path = file;
+
+  Dependency dependency;
+  dependency.file = path.string();
+  if (!fileStamp(path, dependency.size, dependency.time))
+    dependency.size = missingFile;
+  m_dependencies.push_back(std::move(dependency));
+}
+
+const SceneBlob *SceneCache::get(const std::string &name) const
+{
+  auto it = m_blobs.find(name);
+  return it == m_blobs.end() ? nullptr : &it->second;
+}
+
+std::string SceneCache::getString(const std::string &name) const
+{
+  uint64_t length = 0;
+  const char *chars = getData<char>(name, &length);
+  return chars ? std::string(chars, length) : std::string();
+}
+
+anari::Array1D SceneCache::newArray1D(
+    anari::Device d, const std::string &name) const
+{
+  const SceneBlob *blob = get(name);
+  if (!blob)
+    return nullptr;
+  return anari::newArray1D(d,
+      blob->data.get(),
+      releaseBlob,
+      new std::shared_ptr<const void>(blob->data),
+      blob->type,
+      blob->size[0]);
+}
+
+anari::Array2D SceneCache::newArray2D(anari::Device d,
+    const std::string &name,
+    ANARIDataType elementType) const
+{
+  const SceneBlob *blob = get(name);
+  return blob ? newArray2D(d, *blob, elementType) : nullptr;
+}
+
+anari::Array2D SceneCache::newArray2D(
+    anari::Device d, const SceneBlob &blob, ANARIDataType elementType)
+{
+  return anari::newArray2D(d,
+      blob.data.get(),
+      releaseBlob,
+      new std::shared_ptr<const void>(blob.data),
+      elementType,
+      blob.size[0],
+      blob.size[1]);
+}
+
+const std::string &SceneCache::cacheFile() const
+{
+  return m_cacheFile;
+}
+
+} // namespace scenes
+} // namespace anari
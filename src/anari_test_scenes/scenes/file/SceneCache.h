@@ -0,0 +1,148 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "anari/anari_cpp.hpp"
+#include "anari_test_scenes_export.h"
+// std
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace anari {
+namespace scenes {
+
+// One named array of a SceneCache. 'data' shares ownership of its storage,
+// which is either loader output or a view into the mapped cache file. It holds
+// at least size[0] * max(size[1], 1) elements of 'type', string blobs hold
+// characters.
+struct SceneBlob
+{
+  std::shared_ptr<const void> data;
+  uint64_t bytes{0};
+  ANARIDataType type{ANARI_UNKNOWN};
+  uint64_t size[2]{0, 0};
+};
+
+// Maps a whole file read-only, nullptr if it cannot be opened or is empty.
+// The mapping lives as long as any pointer sharing its ownership. Platforms
+// without mmap read the file instead.
+ANARI_TEST_SCENES_INTERFACE std::shared_ptr<const char> mapFile(
+    const std::string &filename, size_t &size);
+
+// On-disk cache of what a file loader produced, so the next load of an
+// unchanged file maps the arrays instead of parsing and decoding again.
+//
+// Loaders add their flattened, device ready arrays (positions, attributes,
+// decoded images...) as named blobs and build ANARI objects from the blobs
+// whether they came from the parser or from the cache file. Blobs are
+// aligned in the file so arrays are handed to the device without a copy.
+//
+// A cache file is valid for one source path, its size and modification time,
+// the same of every dependency the loader added, and the loader name and
+// version. Caching is off unless the environment variable
+// ANARI_SCENE_CACHE_DIR names the directory to keep the files in.
+class SceneCache
+{
+ public:
+  ANARI_TEST_SCENES_INTERFACE SceneCache(const std::string &sourceFile,
+      const char *loader,
+      uint32_t loaderVersion);
+
+  ANARI_TEST_SCENES_INTERFACE bool enabled() const;
+
+  // Maps the cache file, returns false if caching is off or the file is
+  // missing, stale or malformed (which leaves the cache empty)
+  ANARI_TEST_SCENES_INTERFACE bool load();
+  // Writes all blobs to the cache file, returns false if caching is off or
+  // the file cannot be written
+  ANARI_TEST_SCENES_INTERFACE bool save() const;
+
+  ANARI_TEST_SCENES_INTERFACE void add(const std::string &name,
+      ANARIDataType type,
+      uint64_t size0,
+      uint64_t size1,
+      std::shared_ptr<const void> data,
+      uint64_t bytes);
+  // One dimensional blob of as many elements of 'type' as 'v' holds bytes for
+  template <typename T>
+  void add(const std::string &name, ANARIDataType type, std::vector<T> &&v);
+  ANARI_TEST_SCENES_INTERFACE void addString(
+      const std::string &name, const std::string &value);
+  // Another file the blobs were made from (a material library, a texture...),
+  // the cache file is stale once it changes, appears or disappears
+  ANARI_TEST_SCENES_INTERFACE void addDependency(const std::string &file);
+
+  // nullptr if there is no such blob
+  ANARI_TEST_SCENES_INTERFACE const SceneBlob *get(
+      const std::string &name) const;
+  ANARI_TEST_SCENES_INTERFACE std::string getString(
+      const std::string &name) const;
+  template <typename T>
+  const T *getData(const std::string &name, uint64_t *count = nullptr) const;
+
+  // Captured arrays on top of a blob, which stays alive until the device
+  // releases the array. Return nullptr if there is no such blob.
+  ANARI_TEST_SCENES_INTERFACE anari::Array1D newArray1D(
+      anari::Device d, const std::string &name) const;
+  ANARI_TEST_SCENES_INTERFACE anari::Array2D newArray2D(anari::Device d,
+      const std::string &name,
+      ANARIDataType elementType) const;
+  ANARI_TEST_SCENES_INTERFACE static anari::Array2D newArray2D(
+      anari::Device d, const SceneBlob &blob, ANARIDataType elementType);
+
+  ANARI_TEST_SCENES_INTERFACE const std::string &cacheFile() const;
+
+ private:
+  static uint64_t elementBytes(ANARIDataType type);
+
+  struct Dependency
+  {
+    std::string file;
+    uint64_t size{0};
+    int64_t time{0};
+  };
+
+  std::string m_sourceFile;
+  std::string m_cacheFile;
+  std::string m_loader;
+  uint32_t m_loaderVersion{0};
+  uint64_t m_sourceSize{0};
+  int64_t m_sourceTime{0};
+  std::vector<Dependency> m_dependencies;
+  std::map<std::string, SceneBlob> m_blobs;
+};
+
+// Inlined definitions ////////////////////////////////////////////////////////
+
+template <typename T>
+inline void SceneCache::add(
+    const std::string &name, ANARIDataType type, std::vector<T> &&v)
+{
+  auto owned = std::make_shared<std::vector<T>>(std::move(v));
+  const uint64_t bytes = owned->size() * sizeof(T);
+  const uint64_t element = elementBytes(type);
+  std::shared_ptr<const void> data(owned, owned->data());
+  add(name, type, element ? bytes / element : 0, 1, std::move(data), bytes);
+}
+
+inline uint64_t SceneCache::elementBytes(ANARIDataType type)
+{
+  return type == ANARI_STRING ? 1 : anari::sizeOf(type);
+}
+
+template <typename T>
+inline const T *SceneCache::getData(
+    const std::string &name, uint64_t *count) const
+{
+  const SceneBlob *blob = get(name);
+  if (count)
+    *count = blob ? blob->bytes / sizeof(T) : 0;
+  return blob ? static_cast<const T *>(blob->data.get()) : nullptr;
+}
+
+} // namespace scenes
+} // namespace anari
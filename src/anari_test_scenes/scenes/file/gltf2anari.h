@@ -18,9 +18,14 @@ using json = nlohmann::json;
 #include "anari/anari_cpp.hpp"
 #include "anari/anari_cpp/ext/linalg.h"
 #include "mikktspace.h"
+#include "SceneCache.h"
+#include "helium/ParallelFor.h"
 
 #include <fstream>
 #include "stb_image.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
 #include <set>
 #include <iostream>
 #include <tuple>
@@ -417,15 +422,79 @@ static void srt2mat(float *A, const S &s, const R &r, const T &t)
   A[15] = 1.0f;
 }
 
+// The bytes of one glTF buffer, either owned (decoded data uris) or a view of
+// a memory mapped file. Ownership is shared, so arrays handed to the device
+// without copying can keep the bytes alive after the gltf_data is gone.
+struct gltf_buffer
+{
+  std::shared_ptr<const char> storage;
+  size_t length = 0;
+
+  gltf_buffer() = default;
+
+  gltf_buffer(std::shared_ptr<const char> storage, size_t length)
+      : storage(std::move(storage)), length(length)
+  {}
+
+  explicit gltf_buffer(std::vector<char> &&bytes)
+  {
+    auto owned = std::make_shared<std::vector<char>>(std::move(bytes));
+    length = owned->size();
+    storage = std::shared_ptr<const char>(owned, owned->data());
+  }
+
+  const char *data() const
+  {
+    return storage.get();
+  }
+
+  size_t size() const
+  {
+    return length;
+  }
+
+  // A view of bytes [offset, offset + n) sharing ownership of this buffer. If
+  // fewer bytes are available, the view is a zero padded copy instead.
+  gltf_buffer slice(size_t offset, size_t n) const
+  {
+    const size_t available = offset < length ? length - offset : 0;
+    if (available >= n) {
+      return gltf_buffer(
+          std::shared_ptr<const char>(storage, data() + offset), n);
+    }
+    std::vector<char> padded(n, 0);
+    if (available) {
+      std::memcpy(padded.data(), data() + offset, available);
+    }
+    return gltf_buffer(std::move(padded));
+  }
+};
+
+// Maps a whole file read-only, returns an empty buffer if it cannot be opened
+static gltf_buffer map_file(const std::string &filename)
+{
+  size_t length = 0;
+  std::shared_ptr<const char> file = anari::scenes::mapFile(filename, length);
+  if (!file) {
+    return {};
+  }
+  return gltf_buffer(std::move(file), length);
+}
+
+// Version of the decoded images kept in the scene cache
+constexpr uint32_t gltfCacheVersion = 1;
+
 struct gltf_data
 {
   json gltf;
   std::string path;
   std::string ext;
+  // file given to open_file(), empty for glTF parsed from memory
+  std::string sourceFile;
 
   ANARIDevice device;
   ANARILibrary library;
-  std::vector<std::vector<char>> buffers;
+  std::vector<gltf_buffer> buffers;
   std::vector<anari::Array2D> images;
   std::vector<anari::Material> materials;
   std::vector<anari::Group> groups;
@@ -434,8 +503,11 @@ struct gltf_data
   std::vector<anari::Light> lights;
   std::vector<std::vector<anari::Instance>> instances;
 
-  const char *unpack_accessor(
-      int index, anari::DataType &dataType, size_t &count, size_t &stride)
+  const char *unpack_accessor(int index,
+      anari::DataType &dataType,
+      size_t &count,
+      size_t &stride,
+      const gltf_buffer **owner = nullptr)
   {
     const auto &accessor = gltf["accessors"][index];
     size_t accessorOffset = accessor.value("byteOffset", 0);
@@ -446,13 +518,45 @@ struct gltf_data
     size_t dataSize = anari::sizeOf(dataType);
 
     const auto &bufferView = gltf["bufferViews"][int(accessor["bufferView"])];
-    const std::vector<char> &buffer = buffers.at(bufferView["buffer"]);
+    const gltf_buffer &buffer = buffers.at(bufferView["buffer"]);
     size_t viewOffset = bufferView.value("byteOffset", 0);
     stride = bufferView.value("byteStride", dataSize);
 
+    if (owner) {
+      *owner = &buffer;
+    }
     return buffer.data() + viewOffset + accessorOffset;
   }
 
+  // Array holding the elements of an accessor. Tightly packed accessors are
+  // handed to the device without a copy, the array keeps a reference to the
+  // buffer until the device is done with it. Interleaved ones are copied.
+  anari::Array1D accessor_array(int index)
+  {
+    size_t stride;
+    size_t count;
+    anari::DataType dataType = ANARI_UNKNOWN;
+    const gltf_buffer *buffer = nullptr;
+    const char *src = unpack_accessor(index, dataType, count, stride, &buffer);
+    const size_t dataSize = anari::sizeOf(dataType);
+
+    if (stride == dataSize) {
+      auto *owner = new std::shared_ptr<const char>(buffer->storage);
+      ANARIMemoryDeleter release = [](const void *userPtr, const void *) {
+        delete static_cast<const std::shared_ptr<const char> *>(userPtr);
+      };
+      return anari::newArray1D(device, src, release, owner, dataType, count);
+    }
+
+    auto array = anari::newArray1D(device, dataType, count);
+    auto *dst = static_cast<char *>(anariMapArray(device, array));
+    for (size_t i = 0; i < count; ++i) {
+      std::memcpy(dst + i * dataSize, src + i * stride, dataSize);
+    }
+    anariUnmapArray(device, array);
+    return array;
+  }
+
   template <typename T>
   inline std::vector<T> getAccessorData(const char *buffer, size_t dataSize, size_t count)
   {
@@ -608,7 +712,7 @@ struct gltf_data
   }
 
   template <typename T>
-  std::vector<char> decode_buffer(const T &buf)
+  gltf_buffer decode_buffer(const T &buf)
   {
     std::vector<char> data;
 
@@ -623,15 +727,11 @@ struct gltf_data
           debase64(uri.c_str() + comma, uri.size() - comma, data);
         }
       } else {
-        // bin file
-        data.resize(length);
-        std::ifstream buf_in(path + uri, std::ios::in | std::ios::binary);
-        if (buf_in) {
-          buf_in.read(data.data(), length);
-        }
+        // bin file, zero filled where it is missing or short
+        return map_file(path + uri).slice(0, length);
       }
     }
-    return data;
+    return gltf_buffer(std::move(data));
   }
 
   template <typename T, typename F>
@@ -673,8 +773,10 @@ struct gltf_data
         }
       }
     } else if (img.contains("bufferView")) {
-      const auto &bufferView = gltf["bufferViews"][int(img["bufferView"])];
-      const std::vector<char> &buffer = buffers.at(bufferView["buffer"]);
+      // const access only, images are decoded concurrently
+      const json &bufferView =
+          gltf.at("bufferViews").at(int(img["bufferView"]));
+      const gltf_buffer &buffer = buffers.at(bufferView["buffer"]);
       size_t offset = bufferView.value("byteOffset", 0);
       length = bufferView["byteLength"];
       ptr = buffer.data() + offset;
@@ -876,12 +978,68 @@ struct gltf_data
     return texture.value("source", -1);
   }
 
+  template <typename T>
+  bool is_ktx2(const T &img)
+  {
+    return mimeType(img) == "image/ktx2" || extension(img) == ".ktx2";
+  }
+
+  // decode_image() into a blob owning the pixels, sized {width, height}
+  bool decode_pixels(const json &img,
+      size_t imgIndex,
+      std::vector<char> *imageData,
+      anari::scenes::SceneBlob &blob,
+      int &n)
+  {
+    int width = 0, height = 0;
+    void *data = nullptr;
+    ANARIMemoryDeleter deleter = nullptr;
+    void *usrPtr = nullptr;
+    std::tie(data, deleter, usrPtr) =
+        decode_image(img, imgIndex, imageData, &width, &height, &n);
+    if (!data) {
+      return false;
+    }
+    blob.data = std::shared_ptr<const void>(data, [deleter, usrPtr](const void *p) {
+      if (deleter) {
+        deleter(usrPtr, p);
+      }
+    });
+    blob.bytes = uint64_t(width) * uint64_t(height) * uint64_t(n);
+    blob.type = ANARI_UINT8;
+    blob.size[0] = uint64_t(width);
+    blob.size[1] = uint64_t(height);
+    return true;
+  }
+
+  // Whether an image lives in the glTF file itself (a data uri, or a buffer
+  // view of the embedded binary chunk or of a data uri buffer)
+  bool is_embedded(const json &img)
+  {
+    if (img.contains("uri")) {
+      return std::string(img["uri"]).substr(0, 5) == "data:";
+    }
+    if (!img.contains("bufferView")) {
+      return false;
+    }
+    const json &bufferView = gltf.at("bufferViews").at(int(img["bufferView"]));
+    const json &buffer = gltf.at("buffers").at(int(bufferView["buffer"]));
+    return !buffer.contains("uri")
+        || std::string(buffer["uri"]).substr(0, 5) == "data:";
+  }
+
   void load_assets(std::vector<std::vector<char>>& byteImages)
   {
-    if (buffers.empty()) {    
-        for (const auto &buf : gltf["buffers"]) {
-          buffers.emplace_back(decode_buffer(buf));
-        }
+    // external buffers are mapped and data uris decoded concurrently
+    if (buffers.empty()) {
+      std::vector<const json *> bufferSpecs;
+      for (const auto &buf : gltf["buffers"]) {
+        bufferSpecs.push_back(&buf);
+      }
+      buffers.resize(bufferSpecs.size());
+      helium::tasking::parallelFor(bufferSpecs.size(), 0, [&](size_t i) {
+        buffers[i] = decode_buffer(*bufferSpecs[i]);
+      });
     }
 
     const std::vector<nlohmann::json_pointer<std::string>> sRGBTexturePointers =
@@ -912,25 +1070,108 @@ struct gltf_data
       }
     }
 
+    struct DecodedImage
+    {
+      const json *spec = nullptr;
+      std::vector<char> *imageData = nullptr;
+      anari::scenes::SceneBlob pixels;
+      int n = 0;
+      bool embedded = false;
+      bool decoded = false;
+    };
+
+    std::vector<DecodedImage> decoded;
     size_t imageFilesIndex = 0;
-    size_t imageIndex = 0;
     for (const auto &img : gltf["images"]) {
-      int width, height, n;
-
-      std::vector<char> *imageData = nullptr;
+      DecodedImage image;
+      image.spec = &img;
       if (img.contains("uri")) {
         if (imageFilesIndex < byteImages.size()) {
-          imageData = &byteImages[imageFilesIndex];
+          image.imageData = &byteImages[imageFilesIndex];
           }
         ++imageFilesIndex;      
       }
+      image.embedded = !image.imageData && is_embedded(img);
+      decoded.push_back(image);
+    }
+
+    // Decoded pixels are kept in the scene cache: embedded images in the one
+    // of the glTF file, external ones in the one of their image file. KTX2
+    // images are transcoded for the device at hand instead.
+    anari::scenes::SceneCache cache(sourceFile, "gltf", gltfCacheVersion);
+    const bool cached = cache.load();
+
+    auto decode = [&](size_t imageIndex) {
+      auto &image = decoded[imageIndex];
+      const json &spec = *image.spec;
+      const std::string name = "image." + std::to_string(imageIndex);
+      const anari::scenes::SceneBlob *blob = cached ? cache.get(name) : nullptr;
+      if (image.embedded && blob) {
+        image.pixels = *blob;
+      } else if (!image.embedded && !image.imageData && spec.contains("uri")) {
+        anari::scenes::SceneCache fileCache(
+            path + std::string(spec["uri"]), "image", gltfCacheVersion);
+        // a cache file without the entry is decoded again like a missing one
+        const anari::scenes::SceneBlob *filePixels =
+            fileCache.load() ? fileCache.get("image") : nullptr;
+        if (filePixels) {
+          image.pixels = *filePixels;
+        } else {
+          int n = 0;
+          if (!decode_pixels(spec, imageIndex, nullptr, image.pixels, n)) {
+            return;
+          }
+          fileCache.add("image", image.pixels.type, image.pixels.size[0], image.pixels.size[1], image.pixels.data, image.pixels.bytes);
+          fileCache.save();
+        }
+      } else if (decode_pixels(spec, imageIndex, image.imageData, image.pixels, image.n)) {
+        image.decoded = true;
+        return;
+      }
+      if (image.pixels.data) {
+        image.n = int(image.pixels.bytes / (image.pixels.size[0] * image.pixels.size[1]));
+      }
+    };
+
+    // KTX2 decoding queries the device and annotates the glTF textures, so it
+    // stays on this thread; the other formats decode in parallel
+    helium::tasking::parallelFor(decoded.size(), 0, [&](size_t i) {
+      if (!is_ktx2(*decoded[i].spec)) {
+        decode(i);
+      }
+    });
+    for (size_t i = 0; i < decoded.size(); ++i) {
+      if (is_ktx2(*decoded[i].spec)) {
+        anari::scenes::SceneBlob &pixels = decoded[i].pixels;
+        decode_pixels(*decoded[i].spec, i, decoded[i].imageData, pixels, decoded[i].n);
+      }
+    }
+
+    bool newEmbeddedImages = false;
+    for (size_t i = 0; i < decoded.size(); ++i) {
+      const auto &image = decoded[i];
+      if (image.embedded && image.decoded && !is_ktx2(*image.spec)) {
+        cache.add("image." + std::to_string(i),
+            image.pixels.type,
+            image.pixels.size[0],
+            image.pixels.size[1],
+            image.pixels.data,
+            image.pixels.bytes);
+        newEmbeddedImages = true;
+      }
+    }
+    if (newEmbeddedImages) {
+      cache.save();
+    }
+
+    for (size_t imageIndex = 0; imageIndex < decoded.size(); ++imageIndex) {
+      const auto &image = decoded[imageIndex];
+      const int n = image.n;
 
       bool isSRGB = sRGBImages.find(static_cast<int>(imageIndex)) != sRGBImages.end();
       bool isNormalMap = normalMaps.find(static_cast<int>(imageIndex)) != normalMaps.end();
 
-      auto [data, func, usrptr] = decode_image(img, imageIndex, imageData, &width, &height, &n);
-
-      if (data) {
+      if (image.pixels.data) {
         int texelType = ANARI_UNKNOWN;
         if (!isSRGB) {
           texelType = isNormalMap ? ANARI_FIXED8_VEC4 : ANARI_UFIXED8_VEC4;
@@ -951,20 +1192,12 @@ struct gltf_data
             texelType = ANARI_UFIXED8_R_SRGB;
         }
 
-        auto array = anari::newArray2D(
-            device,
-            data,
-            func,
-            usrptr,
-            texelType,
-            width,
-            height);
-        images.emplace_back(array);
+        images.emplace_back(anari::scenes::SceneCache::newArray2D(
+            device, image.pixels, ANARIDataType(texelType)));
       } else {
         printf("Could not decode image at index %zu", imageIndex);
         images.emplace_back(nullptr);
       }
-      ++imageIndex;
     }
   }
 
@@ -1547,7 +1780,7 @@ struct gltf_data
           if (draco.contains("bufferView")) {
             const auto &bufferView =
                 gltf["bufferViews"][int(draco["bufferView"])];
-            const std::vector<char> &buffer = buffers.at(bufferView["buffer"]);
+            const gltf_buffer &buffer = buffers.at(bufferView["buffer"]);
             size_t offset = bufferView.value("byteOffset", 0);
             size_t length = bufferView["byteLength"];
             draco::DecoderBuffer decoder_buffer;
@@ -1607,15 +1840,8 @@ struct gltf_data
               continue;
             }
 
-            size_t stride;
-            size_t count;
-            anari::DataType dataType = ANARI_UNKNOWN;
-            const char *src =
-                unpack_accessor(attr.value(), dataType, count, stride);
-            size_t dataSize = anari::sizeOf(dataType);
-
-            anari::setParameterArray1DStrided(
-                device, geometry, paramname, dataType, src, count, stride);
+            anari::setAndReleaseParameter(
+                device, geometry, paramname, accessor_array(attr.value()));
           }
 
           if (!prim["attributes"].contains("TANGENT")
@@ -1987,13 +2213,49 @@ struct gltf_data
       bool parseLights = true)
   {
     gltf = json::parse(jsonText);
-    buffers = std::move(sortedBuffers);
+    buffers.clear();
+    for (auto &buffer : sortedBuffers) {
+      buffers.emplace_back(std::move(buffer));
+    }
+    sortedBuffers.clear();
     load_assets(sortedImages);
     load_materials();
     load_surfaces(generateTangents);
     load_nodes(parseLights);
   }
 
+  static uint32_t read_u32(const gltf_buffer &file, size_t offset)
+  {
+    uint32_t value = 0;
+    if (offset + sizeof(value) <= file.size()) {
+      std::memcpy(&value, file.data() + offset, sizeof(value));
+    }
+    return value;
+  }
+
+  // Parses the binary glTF container at 'offset': a 12 byte header, the JSON
+  // chunk and an optional BIN chunk, which becomes buffer 0 as a view of the
+  // mapped file rather than a copy
+  void load_glb(const gltf_buffer &file, size_t offset)
+  {
+    if (read_u32(file, offset) != 0x46546C67u) {
+      throw std::runtime_error("invalid gltf magic");
+    }
+
+    size_t chunk = offset + 12;
+    const size_t jsonLength = read_u32(file, chunk);
+    if (chunk + 8 + jsonLength > file.size()) {
+      throw std::runtime_error("truncated gltf json chunk");
+    }
+    const char *json_begin = file.data() + chunk + 8;
+    gltf = json::parse(json_begin, json_begin + jsonLength);
+
+    chunk += 8 + jsonLength;
+    if (chunk + 8 <= file.size()) {
+      buffers.push_back(file.slice(chunk + 8, read_u32(file, chunk)));
+    }
+  }
+
   void open_file(const std::string &filename)
   {
     auto pos = filename.find_last_of('/');
@@ -2005,87 +2267,21 @@ struct gltf_data
       ext = filename.substr(pos);
     }
 
+    sourceFile = filename;
     if (ext == ".gltf") {
       std::ifstream gltf_in(filename.c_str());
       gltf = json::parse(gltf_in);
     } else if (ext == ".glb") {
-      std::ifstream gltf_in(filename.c_str(), std::ios::in | std::ios::binary);
-      uint32_t magic;
-      uint32_t version;
-      uint32_t length;
-      gltf_in.read(reinterpret_cast<char *>(&magic), sizeof(magic));
-      if (magic != 0x46546C67u) {
-        throw std::runtime_error("invalid gltf magic");
-      }
-      gltf_in.read(reinterpret_cast<char *>(&version), sizeof(version));
-      gltf_in.read(reinterpret_cast<char *>(&length), sizeof(length));
-
-      uint32_t chunkLength;
-      uint32_t chunkType;
-      gltf_in.read(reinterpret_cast<char *>(&chunkLength), sizeof(chunkLength));
-      gltf_in.read(reinterpret_cast<char *>(&chunkType), sizeof(chunkType));
-      std::vector<uint8_t> json_buf(chunkLength);
-      gltf_in.read(reinterpret_cast<char *>(json_buf.data()), chunkLength);
-      gltf = json::parse(json_buf);
-
-      if (gltf_in.read(
-              reinterpret_cast<char *>(&chunkLength), sizeof(chunkLength))) {
-        gltf_in.read(reinterpret_cast<char *>(&chunkType), sizeof(chunkType));
-        buffers.emplace_back(chunkLength);
-        gltf_in.read(
-            reinterpret_cast<char *>(buffers.back().data()), chunkLength);
-      }
+      load_glb(map_file(filename), 0);
     } else if (ext == ".b3dm") {
-      std::ifstream gltf_in(filename.c_str(), std::ios::in | std::ios::binary);
-      uint32_t magic;
-      uint32_t version;
-      uint32_t length;
-
-      gltf_in.read(reinterpret_cast<char *>(&magic), sizeof(magic));
-      gltf_in.read(reinterpret_cast<char *>(&version), sizeof(version));
-      gltf_in.read(reinterpret_cast<char *>(&length), sizeof(length));
-
-      uint32_t featureTableJSONByteLength;
-      uint32_t featureTableBinaryByteLength;
-
-      uint32_t batchTableJSONByteLength;
-      uint32_t batchTableBinaryByteLength;
-
-      gltf_in.read(reinterpret_cast<char *>(&featureTableJSONByteLength),
-          sizeof(featureTableJSONByteLength));
-      gltf_in.read(reinterpret_cast<char *>(&featureTableBinaryByteLength),
-          sizeof(featureTableBinaryByteLength));
-      gltf_in.read(reinterpret_cast<char *>(&batchTableJSONByteLength),
-          sizeof(batchTableJSONByteLength));
-      gltf_in.read(reinterpret_cast<char *>(&batchTableBinaryByteLength),
-          sizeof(batchTableBinaryByteLength));
-      gltf_in.ignore(featureTableJSONByteLength);
-      gltf_in.ignore(featureTableBinaryByteLength);
-      gltf_in.ignore(batchTableJSONByteLength);
-      gltf_in.ignore(batchTableBinaryByteLength);
-
-      gltf_in.read(reinterpret_cast<char *>(&magic), sizeof(magic));
-      if (magic != 0x46546C67u) {
-        throw std::runtime_error("invalid gltf magic");
-      }
-      gltf_in.read(reinterpret_cast<char *>(&version), sizeof(version));
-      gltf_in.read(reinterpret_cast<char *>(&length), sizeof(length));
-
-      uint32_t chunkLength;
-      uint32_t chunkType;
-      gltf_in.read(reinterpret_cast<char *>(&chunkLength), sizeof(chunkLength));
-      gltf_in.read(reinterpret_cast<char *>(&chunkType), sizeof(chunkType));
-      std::vector<uint8_t> json_buf(chunkLength);
-      gltf_in.read(reinterpret_cast<char *>(json_buf.data()), chunkLength);
-      gltf = json::parse(json_buf);
-
-      if (gltf_in.read(
-              reinterpret_cast<char *>(&chunkLength), sizeof(chunkLength))) {
-        gltf_in.read(reinterpret_cast<char *>(&chunkType), sizeof(chunkType));
-        buffers.emplace_back(chunkLength);
-        gltf_in.read(
-            reinterpret_cast<char *>(buffers.back().data()), chunkLength);
+      // the glTF follows a 28 byte header and the feature and batch tables,
+      // whose four byte lengths end the header
+      gltf_buffer file = map_file(filename);
+      size_t offset = 28;
+      for (size_t at = 12; at < 28; at += 4) {
+        offset += read_u32(file, at);
       }
+      load_glb(file, offset);
     }
 
     if (gltf.contains("extensionsUsed")) {
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "obj.h"
+#include "SceneCache.h"
 // tiny_obj_loader
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "tiny_obj_loader.h"
@@ -12,12 +13,19 @@
 #include <ktx.h>
 #endif
 // std
+#include <algorithm>
+#include <cctype>
+#include <fstream>
 #include <sstream>
 #include <unordered_map>
 
 namespace anari {
 namespace scenes {
 
+// Version of the arrays parseObj() stores in the scene cache, bump it when
+// they change so stale cache files are ignored
+constexpr uint32_t objCacheVersion = 1;
+
 static std::string pathOf(const std::string &filename)
 {
 #ifdef _WIN32
@@ -32,6 +40,94 @@ static std::string pathOf(const std::string &filename)
   return filename.substr(0, pos + 1);
 }
 
+static std::string normalizedPath(std::string filename)
+{
+  std::transform(
+      filename.begin(), filename.end(), filename.begin(), [](char c) {
+        return c == '\\' ? '/' : c;
+      });
+  return filename;
+}
+
+// Material libraries named by the 'mtllib' lines of the .obj file, found
+// relative to basePath as tinyobj does
+static std::vector<std::string> materialLibraries(
+    const std::string &fileName, const std::string &basePath)
+{
+  std::vector<std::string> libraries;
+  std::ifstream in(fileName);
+  std::string line;
+  while (std::getline(in, line)) {
+    const size_t start = line.find_first_not_of(" \t");
+    if (start == std::string::npos || line.compare(start, 6, "mtllib") != 0
+        || start + 6 >= line.size()
+        || !std::isspace((unsigned char)line[start + 6]))
+      continue;
+    std::istringstream names(line.substr(start + 7));
+    std::string name;
+    while (names >> name)
+      libraries.push_back(basePath + name);
+  }
+  return libraries;
+}
+
+static int texelTypeOf(int components)
+{
+  if (components == 3)
+    return ANARI_UFIXED8_VEC3;
+  else if (components == 2)
+    return ANARI_UFIXED8_VEC2;
+  else if (components == 1)
+    return ANARI_UFIXED8;
+  return ANARI_UFIXED8_VEC4;
+}
+
+static anari::Sampler newImageSampler(anari::Device d, anari::Array2D image)
+{
+  auto colorTex = anari::newObject<anari::Sampler>(d, "image2D");
+  anari::setAndReleaseParameter(d, colorTex, "image", image);
+  anari::setParameter(d, colorTex, "inAttribute", "attribute0");
+  anari::setParameter(d, colorTex, "wrapMode1", "repeat");
+  anari::setParameter(d, colorTex, "wrapMode2", "repeat");
+  anari::setParameter(d, colorTex, "filter", "linear");
+  anari::commitParameters(d, colorTex);
+  return colorTex;
+}
+
+// Decodes an 8 bit image into an ANARI_UINT8 blob of 'scene' sized
+// {width, height}, the number of components follows from its byte count
+static bool decodeImage(
+    const std::string &filename, SceneCache &scene, const std::string &name)
+{
+  int width, height, n;
+  auto *data = stbi_load(filename.c_str(), &width, &height, &n, 0);
+  if (!data)
+    return false;
+  if (n < 1) {
+    stbi_image_free(data);
+    return false;
+  }
+
+  // Textures are addressed bottom row first. The rows are flipped here rather
+  // than through stb's global flip flag, which would leak into other loaders
+  // and race with images decoded on other threads.
+  const size_t stride = size_t(width) * n;
+  for (int y = 0; y < height / 2; y++) {
+    auto *row = data + stride * y;
+    std::swap_ranges(row, row + stride, data + stride * (height - 1 - y));
+  }
+
+  std::shared_ptr<const void> pixels(
+      data, [](const void *p) { stbi_image_free(const_cast<void *>(p)); });
+  scene.add(name,
+      ANARI_UINT8,
+      uint64_t(width),
+      uint64_t(height),
+      std::move(pixels),
+      uint64_t(width) * height * n);
+  return true;
+}
+
 using TextureCache = std::unordered_map<std::string, anari::Sampler>;
 
 static void loadTexture(anari::Device d,
@@ -39,10 +135,7 @@ static void loadTexture(anari::Device d,
     std::string filename,
     TextureCache &cache)
 {
-  std::transform(
-      filename.begin(), filename.end(), filename.begin(), [](char c) {
-        return c == '\\' ? '/' : c;
-      });
+  filename = normalizedPath(filename);
 
   anari::Sampler colorTex = cache[filename];
 
@@ -185,38 +278,9 @@ static void loadTexture(anari::Device d,
     } else
 #endif
     {
-      int width, height, n;
-      stbi_set_flip_vertically_on_load(1);
-      void *data = stbi_load(filename.c_str(), &width, &height, &n, 0);
-
-      if (!data || n < 1) {
-        if (!data)
-          printf("failed to load texture '%s'\n", filename.c_str());
-        else
-          printf("texture '%s' with %i channels not loaded\n",
-              filename.c_str(),
-              n);
-        return;
-      }
-
-      colorTex = anari::newObject<anari::Sampler>(d, "image2D");
-
-      int texelType = ANARI_UFIXED8_VEC4;
-      if (n == 3)
-        texelType = ANARI_UFIXED8_VEC3;
-      else if (n == 2)
-        texelType = ANARI_UFIXED8_VEC2;
-      else if (n == 1)
-        texelType = ANARI_UFIXED8;
-
-      anari::setParameterArray2D(
-          d, colorTex, "image", texelType, data, width, height);
-
-      anari::setParameter(d, colorTex, "inAttribute", "attribute0");
-      anari::setParameter(d, colorTex, "wrapMode1", "repeat");
-      anari::setParameter(d, colorTex, "wrapMode2", "repeat");
-      anari::setParameter(d, colorTex, "filter", "linear");
-      anari::commitParameters(d, colorTex);
+      // anything stb_image decodes was decoded by parseObj() already
+      printf("failed to load texture '%s'\n", filename.c_str());
+      return;
     }
   }
 
@@ -231,13 +295,17 @@ struct OBJData
   std::vector<tinyobj::material_t> materials;
 };
 
-static void loadObj(
-    anari::Device d, const std::string &fileName, anari::World *_world)
+// Parses the .obj file into the device ready arrays buildObj() consumes:
+//   "materials"             float4 per material: diffuse color, opacity
+//   "materialTextures"      int2 per material: diffuse, alpha texture or -1
+//   "texture.<i>.file"      path of texture i
+//   "texture.<i>"           its decoded pixels, unless the device decodes it
+//   "shapeMaterials"        int per shape: material or -1
+//   "shape.<i>.position"    float3 per triangle corner
+//   "shape.<i>.attribute0"  float2 per triangle corner, if all are valid
+// The material libraries and decoded textures become cache dependencies.
+static void parseObj(const std::string &fileName, SceneCache &scene)
 {
-  auto &world = *_world;
-
-  /////////////////////////////////////////////////////////////////////////////
-
   OBJData objdata;
   std::string warn;
   std::string err;
@@ -258,51 +326,60 @@ static void loadObj(
     throw std::runtime_error(ss.str());
   }
 
-  /////////////////////////////////////////////////////////////////////////////
+  for (const auto &library : materialLibraries(fileName, basePath))
+    scene.addDependency(library);
 
-  std::vector<ANARIMaterial> materials;
+  /////////////////////////////////////////////////////////////////////////////
 
-  auto defaultMaterial = anari::newObject<anari::Material>(d, "matte");
-  anari::setParameter(d, defaultMaterial, "color", math::float3(0.f, 1.f, 0.f));
-  anari::commitParameters(d, defaultMaterial);
+  std::vector<std::string> textures;
+  std::unordered_map<std::string, int> textureIndices;
+  auto textureIndex = [&](const std::string &texname) {
+    if (texname.empty())
+      return -1;
+    auto filename = normalizedPath(basePath + texname);
+    auto [it, added] =
+        textureIndices.emplace(filename, int(textureIndices.size()));
+    if (added)
+      textures.push_back(filename);
+    return it->second;
+  };
 
-  TextureCache cache;
+  std::vector<math::float4> materials;
+  std::vector<math::int2> materialTextures;
 
   for (auto &mat : objdata.materials) {
-    auto m = anari::newObject<anari::Material>(d, "matte");
-
-    anari::setParameter(d, m, "color", ANARI_FLOAT32_VEC3, &mat.diffuse[0]);
-    anari::setParameter(d, m, "opacity", ANARI_FLOAT32, &mat.dissolve);
-    anari::setParameter(d, m, "alphaMode", "blend");
+    materials.emplace_back(
+        mat.diffuse[0], mat.diffuse[1], mat.diffuse[2], mat.dissolve);
+    materialTextures.emplace_back(textureIndex(mat.diffuse_texname),
+        textureIndex(mat.alpha_texname));
+  }
 
-    if (!mat.diffuse_texname.empty())
-      loadTexture(d, m, basePath + mat.diffuse_texname, cache);
+  scene.add("materials", ANARI_FLOAT32_VEC4, std::move(materials));
+  scene.add("materialTextures", ANARI_INT32_VEC2, std::move(materialTextures));
 
-#if 1
-    if (!mat.alpha_texname.empty())
-      loadTexture(d, m, basePath + mat.alpha_texname, cache);
+  for (size_t i = 0; i < textures.size(); ++i) {
+    const std::string name = "texture." + std::to_string(i);
+    scene.addString(name + ".file", textures[i]);
+#ifdef USE_KTX
+    // transcoded by loadTexture() for what the device supports
+    if (textures[i].substr(textures[i].find_last_of('.')) == ".ktx")
+      continue;
 #endif
-
-    anari::commitParameters(d, m);
-    materials.push_back(m);
+    scene.addDependency(textures[i]);
+    decodeImage(textures[i], scene, name);
   }
 
-  for (auto &t : cache)
-    anari::release(d, t.second);
-
   /////////////////////////////////////////////////////////////////////////////
 
-  std::vector<anari::Surface> meshes;
-
   auto *vertices = objdata.attrib.vertices.data();
   auto *texcoords = objdata.attrib.texcoords.data();
 
-  std::vector<math::float3> v;
-  std::vector<math::float2> vt;
+  std::vector<int> shapeMaterials;
 
-  for (auto &shape : objdata.shapes) {
-    v.clear();
-    vt.clear();
+  for (size_t s = 0; s < objdata.shapes.size(); ++s) {
+    const auto &shape = objdata.shapes[s];
+    std::vector<math::float3> v;
+    std::vector<math::float2> vt;
 
     size_t numIndices = shape.mesh.indices.size();
 
@@ -337,21 +414,99 @@ static void loadObj(
       }
     }
 
-    auto geom = anari::newObject<anari::Geometry>(d, "triangle");
+    const std::string name = "shape." + std::to_string(s);
+    bool allTexCoordsValid = vt.size() == v.size();
+    scene.add(name + ".position", ANARI_FLOAT32_VEC3, std::move(v));
+    if (allTexCoordsValid)
+      scene.add(name + ".attribute0", ANARI_FLOAT32_VEC2, std::move(vt));
 
-    anari::setParameterArray1D(d, geom, "vertex.position", v.data(), v.size());
+    shapeMaterials.push_back(
+        shape.mesh.material_ids.empty() ? -1 : shape.mesh.material_ids[0]);
+  }
 
-    bool allTexCoordsValid = vt.size() == v.size();
-    if (allTexCoordsValid) {
-      anari::setParameterArray1D(
-          d, geom, "vertex.attribute0", vt.data(), vt.size());
+  scene.add("shapeMaterials", ANARI_INT32, std::move(shapeMaterials));
+}
+
+// Creates the world from the arrays of parseObj(), which are passed to the
+// device without copying them
+static void buildObj(
+    anari::Device d, const SceneCache &scene, anari::World world)
+{
+  std::vector<ANARIMaterial> materials;
+
+  auto defaultMaterial = anari::newObject<anari::Material>(d, "matte");
+  anari::setParameter(d, defaultMaterial, "color", math::float3(0.f, 1.f, 0.f));
+  anari::commitParameters(d, defaultMaterial);
+
+  TextureCache cache;
+  std::vector<std::string> textures;
+
+  for (size_t i = 0;; ++i) {
+    const std::string name = "texture." + std::to_string(i);
+    if (!scene.get(name + ".file"))
+      break;
+    textures.push_back(scene.getString(name + ".file"));
+    if (const SceneBlob *image = scene.get(name)) {
+      const int n = int(image->bytes / (image->size[0] * image->size[1]));
+      cache[textures.back()] = newImageSampler(
+          d, scene.newArray2D(d, name, ANARIDataType(texelTypeOf(n))));
+    }
+  }
+
+  uint64_t numMaterials = 0;
+  const auto *matValues =
+      scene.getData<math::float4>("materials", &numMaterials);
+  const auto *matTextures = scene.getData<math::int2>("materialTextures");
+
+  for (uint64_t i = 0; i < numMaterials; ++i) {
+    auto m = anari::newObject<anari::Material>(d, "matte");
+
+    const math::float4 &mat = matValues[i];
+    anari::setParameter(d, m, "color", math::float3(mat.x, mat.y, mat.z));
+    anari::setParameter(d, m, "opacity", mat.w);
+    anari::setParameter(d, m, "alphaMode", "blend");
+
+    if (matTextures[i].x >= 0)
+      loadTexture(d, m, textures[size_t(matTextures[i].x)], cache);
+
+#if 1
+    if (matTextures[i].y >= 0)
+      loadTexture(d, m, textures[size_t(matTextures[i].y)], cache);
+#endif
+
+    anari::commitParameters(d, m);
+    materials.push_back(m);
+  }
+
+  for (auto &t : cache)
+    anari::release(d, t.second);
+
+  /////////////////////////////////////////////////////////////////////////////
+
+  std::vector<anari::Surface> meshes;
+
+  uint64_t numShapes = 0;
+  const auto *shapeMaterials = scene.getData<int>("shapeMaterials", &numShapes);
+
+  for (uint64_t i = 0; i < numShapes; ++i) {
+    const std::string name = "shape." + std::to_string(i);
+
+    auto geom = anari::newObject<anari::Geometry>(d, "triangle");
+
+    anari::setAndReleaseParameter(
+        d, geom, "vertex.position", scene.newArray1D(d, name + ".position"));
+    if (scene.get(name + ".attribute0")) {
+      anari::setAndReleaseParameter(d,
+          geom,
+          "vertex.attribute0",
+          scene.newArray1D(d, name + ".attribute0"));
     }
 
     anari::commitParameters(d, geom);
 
     auto surface = anari::newObject<anari::Surface>(d);
 
-    int matID = shape.mesh.material_ids[0];
+    int matID = shapeMaterials[i];
     auto mat = matID < 0 ? defaultMaterial : materials[size_t(matID)];
     anari::setParameter(d, surface, "material", mat);
     anari::setParameter(d, surface, "geometry", geom);
@@ -388,6 +543,17 @@ static void loadObj(
   anari::release(d, defaultMaterial);
 }
 
+static void loadObj(
+    anari::Device d, const std::string &fileName, anari::World *_world)
+{
+  SceneCache scene(fileName, "obj", objCacheVersion);
+  if (!scene.load()) {
+    parseObj(fileName, scene);
+    scene.save();
+  }
+  buildObj(d, scene, *_world);
+}
+
 // FileObj definitions ////////////////////////////////////////////////////////
 
 FileObj::FileObj(anari::Device d) : TestScene(d)
@@ -6,7 +6,6 @@
 #include "anari/anari_cpp.hpp"
 #include "primitives.h"
 
-#include <chrono>
 #include <random>
 
 namespace {
@@ -1006,6 +1005,9 @@ void Materials::commit()
 {
   auto &d = m_device;
 
+  m_timestamp = 0.f;
+  m_elapsed_time = 0.f;
+
   // Generate lights
   std::array<math::float3, 6> directions;
   directions[0] = {-1, 0, 0};
@@ -1175,14 +1177,11 @@ void Materials::updateGeometryAttributes(std::uint32_t materialIdx)
 
 void Materials::computeNextFrame()
 {
-  const auto intervalMS =
-      getParam<float>("intervalSeconds", defaultInterval) * 1e3f;
-  auto timestamp = std::chrono::duration<float, std::milli>(
-      std::chrono::steady_clock::now().time_since_epoch())
-                       .count();
+  const auto interval = getParam<float>("intervalSeconds", defaultInterval);
+  const auto timestamp = m_animation.time();
   m_elapsed_time += (timestamp - m_timestamp);
 
-  if (m_elapsed_time >= intervalMS) {
+  if (m_elapsed_time >= interval) {
     const auto materialIdx =
         getParam<std::uint32_t>("materialIdx", defaultMaterialIndex);
     const std::uint32_t newMaterialIdx = (materialIdx + 1) % m_materials.size();
@@ -40,6 +40,8 @@ struct Materials : public TestScene
   std::vector<math::float3> m_f32_vec3_array;
   std::vector<math::float4> m_f32_vec4_array;
 
+  // Animation clock time (seconds) of the previous frame, and since the last
+  // material change
   float m_timestamp = 0;
   float m_elapsed_time = 0;
 
@@ -8,6 +8,9 @@ namespace {
 constexpr std::uint32_t defaultNumObjects = 1024;
 const char *defaultGeometrySubtype = "cone";
 constexpr bool defaultCapping = false;
+constexpr std::uint32_t defaultPrimitiveScale = 1;
+// The parallel generators lay primitives out differently, so they are opt-in
+constexpr bool defaultParallelGeneration = false;
 std::vector<std::string> geometrySubtypes(
     {"cone", "curve", "cylinder", "quad", "sphere", "triangle"});
 } // namespace
@@ -37,6 +40,8 @@ std::vector<ParameterInfo> Primitives::parameters()
       {makeParameterInfo("geometry", "Geometry", defaultGeometrySubtype, geometrySubtypes)},
       {makeParameterInfo("numObjects", "Number of objects", defaultNumObjects, 8u, 1u << 20)},
       {makeParameterInfo("enableCapping", "Capping", defaultCapping)},
+      {makeParameterInfo("primitiveScale", "Multiplier of the number of objects", defaultPrimitiveScale, 1u, 1u << 10)},
+      {makeParameterInfo("parallelGeneration", "Generate on all threads", defaultParallelGeneration)},
       // clang-format on
   };
 }
@@ -88,16 +93,18 @@ void Primitives::commit()
 }
 
 anari::Geometry Primitives::generateGeometry(anari::Device d,
-    std::uint32_t numObjects,
+    size_t numObjects,
     const char *subtype,
-    bool enableCapping)
+    bool enableCapping,
+    bool parallel)
 {
   auto geometry = anari::newObject<anari::Geometry>(d, subtype);
 
   anari::scenes::PrimitiveGenerator generator(0);
   if (!strcmp(subtype, "cone")) {
-    auto [positions, radii, caps] =
-        generator.generateCones(numObjects, enableCapping ? 1 : 0);
+    auto [positions, radii, caps] = parallel
+        ? generator.generateConesParallel(numObjects, enableCapping ? 1 : 0)
+        : generator.generateCones(numObjects, enableCapping ? 1 : 0);
     anari::setAndReleaseParameter(d,
         geometry,
         "vertex.position",
@@ -111,7 +118,9 @@ anari::Geometry Primitives::generateGeometry(anari::Device d,
         "vertex.cap",
         anari::newArray1D(d, caps.data(), caps.size()));
   } else if (!strcmp(subtype, "curve")) {
-    auto [positions, radii] = generator.generateCurves(numObjects);
+    auto [positions, radii] = parallel
+        ? generator.generateCurvesParallel(numObjects)
+        : generator.generateCurves(numObjects);
     anari::setAndReleaseParameter(d,
         geometry,
         "vertex.position",
@@ -121,8 +130,10 @@ anari::Geometry Primitives::generateGeometry(anari::Device d,
         "vertex.radius",
         anari::newArray1D(d, radii.data(), radii.size()));
   } else if (!strcmp(subtype, "cylinder")) {
-    auto [positions, radii, caps] =
-        generator.generateCylinders(numObjects, enableCapping ? 1 : 0);
+    auto [positions, radii, caps] = parallel
+        ? generator.generateCylindersParallel(
+            numObjects, enableCapping ? 1 : 0)
+        : generator.generateCylinders(numObjects, enableCapping ? 1 : 0);
     anari::setAndReleaseParameter(d,
         geometry,
         "vertex.position",
@@ -136,13 +147,16 @@ anari::Geometry Primitives::generateGeometry(anari::Device d,
         "vertex.cap",
         anari::newArray1D(d, caps.data(), caps.size()));
   } else if (!strcmp(subtype, "quad")) {
-    auto positions = generator.generateQuads(numObjects);
+    auto positions = parallel ? generator.generateQuadsParallel(numObjects)
+                              : generator.generateQuads(numObjects);
     anari::setAndReleaseParameter(d,
         geometry,
         "vertex.position",
         anari::newArray1D(d, positions.data(), positions.size()));
   } else if (!strcmp(subtype, "sphere")) {
-    auto [positions, radii] = generator.generateSpheres(numObjects);
+    auto [positions, radii] = parallel
+        ? generator.generateSpheresParallel(numObjects)
+        : generator.generateSpheres(numObjects);
     anari::setAndReleaseParameter(d,
         geometry,
         "vertex.position",
@@ -152,7 +166,8 @@ anari::Geometry Primitives::generateGeometry(anari::Device d,
         "vertex.radius",
         anari::newArray1D(d, radii.data(), radii.size()));
   } else if (!strcmp(subtype, "triangle")) {
-    auto positions = generator.generateTriangles(numObjects);
+    auto positions = parallel ? generator.generateTrianglesParallel(numObjects)
+                              : generator.generateTriangles(numObjects);
     anari::setAndReleaseParameter(d,
         geometry,
         "vertex.position",
@@ -166,17 +181,22 @@ anari::Geometry Primitives::generateGeometry(anari::Device d,
 void Primitives::generateGeometry()
 {
   auto &d = m_device;
-  const int numObjects =
-      getParam<std::uint32_t>("numObjects", defaultNumObjects);
+  // scaled counts reach into the hundreds of millions, so the build time of
+  // the device rather than the generator dominates
+  const size_t numObjects =
+      size_t(getParam<std::uint32_t>("numObjects", defaultNumObjects))
+      * getParam<std::uint32_t>("primitiveScale", defaultPrimitiveScale);
   const auto geometrySubType =
       getParamString("geometry", defaultGeometrySubtype);
   const bool enableCapping = getParam<bool>("enableCapping", defaultCapping);
+  const bool parallel =
+      getParam<bool>("parallelGeneration", defaultParallelGeneration);
 
   if (m_geometry) {
     anari::release(d, m_geometry);
   }
-  m_geometry =
-      generateGeometry(d, numObjects, geometrySubType.c_str(), enableCapping);
+  m_geometry = generateGeometry(
+      d, numObjects, geometrySubType.c_str(), enableCapping, parallel);
 }
 
 void Primitives::generateMaterial()
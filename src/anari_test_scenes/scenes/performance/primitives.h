@@ -20,10 +20,13 @@ struct Primitives : public TestScene
 
   void commit() override;
 
+  // 'parallel' selects PrimitiveGenerator's counter based *Parallel()
+  // functions, which yield a different (but equally deterministic) layout
   static anari::Geometry generateGeometry(anari::Device d,
-      std::uint32_t numObjects,
+      size_t numObjects,
       const char *subtype,
-      bool enableCapping);
+      bool enableCapping,
+      bool parallel = false);
 
  private:
   anari::World m_world{nullptr};
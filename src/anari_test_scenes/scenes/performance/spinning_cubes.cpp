@@ -2,7 +2,6 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "spinning_cubes.h"
-#include <chrono>
 #include <random>
 
 namespace {
@@ -153,9 +152,7 @@ void SpinningCubes::generateInstances(std::uint32_t numInstances)
   auto &d = m_device;
   std::vector<anari::Instance> instances;
   instances.reserve(static_cast<std::size_t>(numInstances));
-  const auto now = std::chrono::duration_cast<std::chrono::duration<float>>(
-      std::chrono::steady_clock::now().time_since_epoch())
-                       .count();
+  const auto now = m_animation.time();
   std::mt19937 rng;
   std::uniform_real_distribution<float> position_dist(0.0f, 50.0f);
   for (std::uint32_t i = 0; i < numInstances; ++i) {
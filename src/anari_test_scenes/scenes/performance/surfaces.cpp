@@ -4,7 +4,6 @@
 #include "surfaces.h"
 
 #include <array>
-#include <chrono>
 #include <random>
 
 #include "anari/anari_cpp.hpp"
@@ -417,7 +416,7 @@ void Surfaces::computeNextFrame()
   std::uniform_real_distribution<float> offset_dist(
       m_minDimension, m_maxDimension);
   std::normal_distribution<float> vel_dist(0.01f, 0.2f * m_maxDimension);
-  std::mt19937 rng;
+  auto &rng = m_animation.rng();
   std::vector<anari::Surface> surfaces(numObjects);
 
   for (std::size_t i = 0; i < numObjects; ++i) {
@@ -426,9 +425,6 @@ void Surfaces::computeNextFrame()
 
     auto geometry = anari::newObject<anari::Geometry>(d, "triangle");
 
-    rng.seed(static_cast<unsigned int>(
-        std::chrono::steady_clock::now().time_since_epoch().count()));
-
     auto &pi = object.m_position;
     auto &vi = object.m_velocity;
 
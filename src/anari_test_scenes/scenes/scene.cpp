@@ -10,6 +10,11 @@ namespace scenes {
 
 constexpr float cameraDistanceFactor = 1.0f;
 
+namespace {
+const char *kAnimationTimeStepName = "animationTimeStep";
+const char *kAnimationSeedName = "animationSeed";
+} // namespace
+
 TestScene::TestScene(anari::Device device) : m_device(device)
 {
   anari::retain(m_device, m_device);
@@ -66,6 +71,27 @@ void TestScene::computeNextFrame()
   // no-op
 }
 
+void TestScene::resetAnimation()
+{
+  m_animation.reset(getParam<float>(kAnimationTimeStepName, 0.f),
+      getParam<std::uint32_t>(kAnimationSeedName, 0u));
+}
+
+void TestScene::advanceAnimation()
+{
+  m_animation.advance();
+}
+
+std::vector<ParameterInfo> TestScene::animationParameters()
+{
+  return {
+      // clang-format off
+    {makeParameterInfo(kAnimationTimeStepName, "Seconds per animation frame (0: wall clock)", 0.f, 0.f, 1.f)},
+    {makeParameterInfo(kAnimationSeedName, "Seed of random animation updates", 0u, 0u, 1u << 16)},
+      // clang-format on
+  };
+}
+
 void TestScene::setDefaultLight(anari::World w)
 {
   auto light = anari::newObject<anari::Light>(m_device, "directional");
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../anari_test_scenes.h"
+#include "AnimationClock.h"
 // anari
 #include "anari/anari_cpp/ext/std.h"
 // helium
@@ -29,6 +30,15 @@ struct ANARI_TEST_SCENES_INTERFACE TestScene
   virtual bool animated() const;
   virtual void computeNextFrame();
 
+  // Restart the animation clock from the "animationTimeStep" and
+  // "animationSeed" parameters; done on every commit, before commit().
+  void resetAnimation();
+  // Advance the animation clock by one frame, before computeNextFrame().
+  void advanceAnimation();
+
+  // The parameters of the animation clock, offered by every animated scene.
+  static std::vector<ParameterInfo> animationParameters();
+
   virtual ~TestScene();
 
  protected:
@@ -38,6 +48,9 @@ struct ANARI_TEST_SCENES_INTERFACE TestScene
   void setDefaultLight(anari::World);
 
   anari::Device m_device{nullptr};
+  // Animated scenes take their time, and any randomness in their updates,
+  // from this clock so that a fixed time step replays the same frames.
+  AnimationClock m_animation;
 };
 
 // Inlined helper functions ///////////////////////////////////////////////////
@@ -0,0 +1,419 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "anari/anari_cpp.hpp"
+#include "DebugDevice.h"
+#include "BinarySerializer.h"
+#include "BinaryTrace.h"
+
+#include <cstring>
+#include <vector>
+
+namespace anari {
+namespace debug_device {
+
+using namespace trace;
+
+// pointers and callbacks are meaningless in another process
+static bool isReplayable(ANARIDataType type) {
+   return type == ANARI_DATA_TYPE || type == ANARI_STRING || type == ANARI_BOOL
+      || isObject(type) || int(type) >= int(ANARI_INT8);
+}
+
+BinarySerializer::BinarySerializer(DebugDevice *dd) : dd(dd), warnedQueueFull(false) {
+   std::string dir = dd->traceDir;
+   if(!dir.empty()) {
+      dir+='/';
+   }
+
+   TraceWriter::Policy policy = TraceWriter::POLICY_BLOCK;
+   if(dd->traceQueuePolicy == "drop") {
+      policy = TraceWriter::POLICY_DROP;
+   } else if(dd->traceQueuePolicy != "block") {
+      dd->reportStatus(dd->this_device(),
+         ANARI_DEVICE,
+         ANARI_SEVERITY_WARNING,
+         ANARI_STATUS_INVALID_ARGUMENT,
+         "unknown traceQueuePolicy '%s', using 'block'", dd->traceQueuePolicy.c_str());
+   }
+
+   dd->reportStatus(dd->this_device(),
+      ANARI_DEVICE,
+      ANARI_SEVERITY_INFO,
+      ANARI_STATUS_UNKNOWN_ERROR,
+      "binary tracing enabled");
+   if(!out.open(dir+"trace.bin", dd->traceQueueSize, policy)) {
+      dd->reportStatus(dd->this_device(),
+         ANARI_DEVICE,
+         ANARI_SEVERITY_INFO,
+         ANARI_STATUS_UNKNOWN_ERROR,
+         "could not open %strace.bin", dir.c_str());
+   }
+   out.write(traceMagic, sizeof(traceMagic));
+   last = std::chrono::steady_clock::now();
+}
+
+SerializerInterface* BinarySerializer::create(DebugDevice *dd) {
+   return new BinarySerializer(dd);
+}
+
+void BinarySerializer::writeVarint(uint64_t value) {
+   out.writeVarint(value);
+}
+
+void BinarySerializer::writeCall(uint32_t opcode) {
+   std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+   writeVarint(opcode);
+   writeVarint(std::chrono::duration_cast<std::chrono::nanoseconds>(now-last).count());
+   last = now;
+}
+
+void BinarySerializer::writeHandle(ANARIObject object) {
+   if(object == dd->this_device()) {
+      writeVarint(0);
+   } else if(dd->getObjectInfo(object)) {
+      writeVarint(reinterpret_cast<uintptr_t>(object) + 1);
+   } else {
+      // unknown handles are replayed as null
+      writeVarint(1);
+   }
+}
+
+void BinarySerializer::writeString(const char *str) {
+   auto iter = strings.find(str);
+   if(iter != strings.end()) {
+      writeVarint(iter->second);
+   } else {
+      uint64_t length = std::strlen(str);
+      writeVarint(0);
+      writeVarint(length);
+      out.write(str, length);
+      uint64_t id = strings.size() + 1;
+      strings[str] = id;
+   }
+}
+
+void BinarySerializer::reportQueue(ANARIStatusSeverity severity, const char *prefix) {
+   const TraceWriter::Stats &stats = out.stats();
+   dd->reportStatus(dd->this_device(),
+      ANARI_DEVICE,
+      severity,
+      ANARI_STATUS_NO_ERROR,
+      "%s: %llu bytes queued in %llu chunks, peak queue %llu bytes, "
+      "%llu stalls (%.3f ms), %llu array payloads dropped (%llu bytes)",
+      prefix,
+      (unsigned long long)stats.bytesQueued,
+      (unsigned long long)stats.chunksQueued,
+      (unsigned long long)stats.peakQueuedBytes,
+      (unsigned long long)stats.stalls,
+      stats.stallSeconds*1e3,
+      (unsigned long long)stats.droppedPayloads,
+      (unsigned long long)stats.droppedBytes);
+}
+
+void BinarySerializer::writeContents(ANARIDataType dataType, const void *mem, uint64_t count) {
+   if(mem == nullptr) {
+      writeVarint(CONTENTS_NONE);
+   } else if(isObject(dataType)) {
+      const ANARIObject *handles = (const ANARIObject*)mem;
+      writeVarint(CONTENTS_HANDLES);
+      for(uint64_t i = 0;i<count;++i) {
+         writeHandle(handles[i]);
+      }
+   } else {
+      uint64_t size = anari::sizeOf(dataType)*count;
+      if(out.acceptBlob(size)) {
+         writeVarint(CONTENTS_BLOB);
+         out.writeBlob(mem, size);
+      } else {
+         writeVarint(CONTENTS_NONE);
+      }
+   }
+}
+
+void BinarySerializer::writeValue(ANARIDataType dataType, const void *mem) {
+   if(isObject(dataType)) {
+      writeHandle(*(const ANARIObject*)mem);
+   } else if(dataType == ANARI_STRING) {
+      writeString((const char*)mem);
+   } else {
+      out.write((const char*)mem, anari::sizeOf(dataType));
+   }
+}
+
+void BinarySerializer::writeNewObject(ANARIDataType dataType, const char *subtype, ANARIObject result) {
+   writeCall(OP_NEW_OBJECT);
+   writeHandle(result);
+   writeVarint(dataType);
+   writeString(subtype ? subtype : "");
+}
+
+void BinarySerializer::insertStatus(ANARIObject source, ANARIDataType sourceType, ANARIStatusSeverity severity, ANARIStatusCode code, const char *status) {
+   // status messages are not part of the trace
+}
+
+void BinarySerializer::anariNewArray1D(ANARIDevice device, const void* appMemory, ANARIMemoryDeleter deleter, const void* userData, ANARIDataType dataType, uint64_t numItems1, ANARIArray1D result) {
+   writeCall(OP_NEW_ARRAY_1D);
+   writeHandle(result);
+   writeVarint(dataType);
+   writeVarint(numItems1);
+   writeContents(dataType, appMemory, numItems1);
+}
+
+void BinarySerializer::anariNewArray2D(ANARIDevice device, const void* appMemory, ANARIMemoryDeleter deleter, const void* userData, ANARIDataType dataType, uint64_t numItems1, uint64_t numItems2, ANARIArray2D result) {
+   writeCall(OP_NEW_ARRAY_2D);
+   writeHandle(result);
+   writeVarint(dataType);
+   writeVarint(numItems1);
+   writeVarint(numItems2);
+   writeContents(dataType, appMemory, numItems1*numItems2);
+}
+
+void BinarySerializer::anariNewArray3D(ANARIDevice device, const void* appMemory, ANARIMemoryDeleter deleter, const void* userData, ANARIDataType dataType, uint64_t numItems1, uint64_t numItems2, uint64_t numItems3, ANARIArray3D result) {
+   writeCall(OP_NEW_ARRAY_3D);
+   writeHandle(result);
+   writeVarint(dataType);
+   writeVarint(numItems1);
+   writeVarint(numItems2);
+   writeVarint(numItems3);
+   writeContents(dataType, appMemory, numItems1*numItems2*numItems3);
+}
+
+void BinarySerializer::anariMapArray(ANARIDevice device, ANARIArray array, void *result) {
+   writeCall(OP_MAP_ARRAY);
+   writeHandle(array);
+}
+
+void BinarySerializer::anariUnmapArray(ANARIDevice device, ANARIArray array) {
+   writeCall(OP_UNMAP_ARRAY);
+   writeHandle(array);
+
+   auto info = dd->getDynamicObjectInfo<GenericArrayDebugObject>(array);
+   if(info == nullptr || info->mapping == nullptr) {
+      writeVarint(CONTENTS_NONE);
+      return;
+   }
+
+   uint64_t count = info->numItems1*info->numItems2*info->numItems3;
+   if(isObject(info->arrayType)) {
+      writeContents(info->arrayType, info->handles, count);
+      return;
+   }
+
+   uint64_t element_size = anari::sizeOf(info->arrayType);
+   bool compact =
+      (info->byteStride1 == 0 || info->byteStride1 == element_size) &&
+      (info->byteStride2 == 0 || info->byteStride2 == element_size*info->numItems1) &&
+      (info->byteStride3 == 0 || info->byteStride3 == element_size*info->numItems1*info->numItems2);
+
+   if(compact) {
+      writeContents(info->arrayType, info->mapping, count);
+   } else {
+      // destride the data
+      std::vector<char> compacted(count*element_size);
+      const char *charMapping = (const char*)info->mapping;
+      char *dst = compacted.data();
+      for(uint64_t i3 = 0;i3<info->numItems3;++i3) {
+         for(uint64_t i2 = 0;i2<info->numItems2;++i2) {
+            for(uint64_t i1 = 0;i1<info->numItems1;++i1) {
+               std::memcpy(dst, charMapping + i1*info->byteStride1 + i2*info->byteStride2 + i3*info->byteStride3, element_size);
+               dst += element_size;
+            }
+         }
+      }
+      writeContents(info->arrayType, compacted.data(), count);
+   }
+}
+
+void BinarySerializer::anariNewLight(ANARIDevice device, const char* type, ANARILight result) {
+   writeNewObject(ANARI_LIGHT, type, result);
+}
+
+void BinarySerializer::anariNewCamera(ANARIDevice device, const char* type, ANARICamera result) {
+   writeNewObject(ANARI_CAMERA, type, result);
+}
+
+void BinarySerializer::anariNewGeometry(ANARIDevice device, const char* type, ANARIGeometry result) {
+   writeNewObject(ANARI_GEOMETRY, type, result);
+}
+
+void BinarySerializer::anariNewSpatialField(ANARIDevice device, const char* type, ANARISpatialField result) {
+   writeNewObject(ANARI_SPATIAL_FIELD, type, result);
+}
+
+void BinarySerializer::anariNewVolume(ANARIDevice device, const char* type, ANARIVolume result) {
+   writeNewObject(ANARI_VOLUME, type, result);
+}
+
+void BinarySerializer::anariNewSurface(ANARIDevice device, ANARISurface result) {
+   writeNewObject(ANARI_SURFACE, nullptr, result);
+}
+
+void BinarySerializer::anariNewMaterial(ANARIDevice device, const char* type, ANARIMaterial result) {
+   writeNewObject(ANARI_MATERIAL, type, result);
+}
+
+void BinarySerializer::anariNewSampler(ANARIDevice device, const char* type, ANARISampler result) {
+   writeNewObject(ANARI_SAMPLER, type, result);
+}
+
+void BinarySerializer::anariNewGroup(ANARIDevice device, ANARIGroup result) {
+   writeNewObject(ANARI_GROUP, nullptr, result);
+}
+
+void BinarySerializer::anariNewInstance(ANARIDevice device, const char *type, ANARIInstance result) {
+   writeNewObject(ANARI_INSTANCE, type, result);
+}
+
+void BinarySerializer::anariNewWorld(ANARIDevice device, ANARIWorld result) {
+   writeNewObject(ANARI_WORLD, nullptr, result);
+}
+
+void BinarySerializer::anariNewObject(ANARIDevice device, const char* objectType, const char* type, ANARIObject result) {
+   writeNewObject(ANARI_OBJECT, type, result);
+   writeString(objectType);
+}
+
+void BinarySerializer::anariSetParameter(ANARIDevice device, ANARIObject object, const char* name, ANARIDataType dataType, const void *mem) {
+   if(!isReplayable(dataType)) {
+      return;
+   }
+   writeCall(OP_SET_PARAMETER);
+   writeHandle(object);
+   writeString(name);
+   writeVarint(dataType);
+   writeValue(dataType, mem);
+}
+
+void BinarySerializer::anariUnsetParameter(ANARIDevice device, ANARIObject object, const char* name) {
+   writeCall(OP_UNSET_PARAMETER);
+   writeHandle(object);
+   writeString(name);
+}
+
+void BinarySerializer::anariUnsetAllParameters(ANARIDevice device, ANARIObject object) {
+   writeCall(OP_UNSET_ALL_PARAMETERS);
+   writeHandle(object);
+}
+
+void BinarySerializer::anariMapParameterArray1D(ANARIDevice device, ANARIObject object, const char* name, ANARIDataType dataType, uint64_t numElements1, uint64_t *elementStride, void *result) {
+   writeCall(OP_MAP_PARAMETER_ARRAY);
+   writeHandle(object);
+   writeString(name);
+   writeVarint(dataType);
+   writeVarint(1);
+   writeVarint(numElements1);
+}
+
+void BinarySerializer::anariMapParameterArray2D(ANARIDevice device, ANARIObject object, const char* name, ANARIDataType dataType, uint64_t numElements1, uint64_t numElements2, uint64_t *elementStride, void *result) {
+   writeCall(OP_MAP_PARAMETER_ARRAY);
+   writeHandle(object);
+   writeString(name);
+   writeVarint(dataType);
+   writeVarint(2);
+   writeVarint(numElements1);
+   writeVarint(numElements2);
+}
+
+void BinarySerializer::anariMapParameterArray3D(ANARIDevice device, ANARIObject object, const char* name, ANARIDataType dataType, uint64_t numElements1, uint64_t numElements2, uint64_t numElements3, uint64_t *elementStride, void *result) {
+   writeCall(OP_MAP_PARAMETER_ARRAY);
+   writeHandle(object);
+   writeString(name);
+   writeVarint(dataType);
+   writeVarint(3);
+   writeVarint(numElements1);
+   writeVarint(numElements2);
+   writeVarint(numElements3);
+}
+
+void BinarySerializer::anariUnmapParameterArray(ANARIDevice device, ANARIObject object, const char* name) {
+   writeCall(OP_UNMAP_PARAMETER_ARRAY);
+   writeHandle(object);
+   writeString(name);
+
+   ANARIDataType dataType = ANARI_UNKNOWN;
+   uint64_t elements = 0;
+   void *mem = nullptr;
+   if(auto info = dd->getDynamicObjectInfo<GenericDebugObject>(object)) {
+      mem = info->getParameterMapping(name, dataType, elements);
+   }
+   writeContents(dataType, mem, elements);
+}
+
+void BinarySerializer::anariCommitParameters(ANARIDevice device, ANARIObject object) {
+   writeCall(OP_COMMIT_PARAMETERS);
+   writeHandle(object);
+}
+
+void BinarySerializer::anariRelease(ANARIDevice device, ANARIObject object) {
+   writeCall(OP_RELEASE);
+   writeHandle(object);
+}
+
+void BinarySerializer::anariRetain(ANARIDevice device, ANARIObject object) {
+   writeCall(OP_RETAIN);
+   writeHandle(object);
+}
+
+void BinarySerializer::anariGetProperty(ANARIDevice device, ANARIObject object, const char* name, ANARIDataType type, void* mem, uint64_t size, ANARIWaitMask mask, int result) {
+   writeCall(OP_GET_PROPERTY);
+   writeHandle(object);
+   writeString(name);
+   writeVarint(type);
+   writeVarint(size);
+   writeVarint(mask);
+}
+
+void BinarySerializer::anariNewFrame(ANARIDevice device, ANARIFrame result) {
+   writeNewObject(ANARI_FRAME, nullptr, result);
+}
+
+void BinarySerializer::anariMapFrame(ANARIDevice device, ANARIFrame frame, const char* channel, uint32_t *width, uint32_t *height, ANARIDataType *pixelType, const void *mapped) {
+   writeCall(OP_MAP_FRAME);
+   writeHandle(frame);
+   writeString(channel);
+}
+
+void BinarySerializer::anariUnmapFrame(ANARIDevice device, ANARIFrame frame, const char* channel) {
+   writeCall(OP_UNMAP_FRAME);
+   writeHandle(frame);
+   writeString(channel);
+}
+
+void BinarySerializer::anariNewRenderer(ANARIDevice device, const char* type, ANARIRenderer result) {
+   writeNewObject(ANARI_RENDERER, type, result);
+}
+
+void BinarySerializer::anariRenderFrame(ANARIDevice device, ANARIFrame frame) {
+   writeCall(OP_RENDER_FRAME);
+   writeHandle(frame);
+   // let the writer catch up once per frame, which also keeps the trace
+   // usable if the application doesn't shut down cleanly
+   out.flush();
+
+   const TraceWriter::Stats &stats = out.stats();
+   if(!warnedQueueFull && (stats.stalls > 0 || stats.droppedPayloads > 0)) {
+      warnedQueueFull = true;
+      reportQueue(ANARI_SEVERITY_PERFORMANCE_WARNING, "trace queue full");
+   }
+}
+
+void BinarySerializer::anariFrameReady(ANARIDevice device, ANARIFrame frame, ANARIWaitMask mask, int result) {
+   writeCall(OP_FRAME_READY);
+   writeHandle(frame);
+   writeVarint(mask);
+}
+
+void BinarySerializer::anariDiscardFrame(ANARIDevice device, ANARIFrame frame) {
+   writeCall(OP_DISCARD_FRAME);
+   writeHandle(frame);
+}
+
+void BinarySerializer::anariReleaseDevice(ANARIDevice device) {
+   out.close();
+   reportQueue(ANARI_SEVERITY_INFO, "trace written");
+}
+
+
+}
+}
@@ -0,0 +1,85 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+
+// Binary trace format written by the "binary" trace mode of the debug device
+// and read by anariReplay.
+//
+// The file starts with traceMagic followed by one record per API call:
+//
+//    varint opcode, varint nanoseconds since the previous record, arguments
+//
+// Arguments are encoded as:
+//  - integers, enums and data types: unsigned LEB128 varints
+//  - object handles: varint, 0 is the device, n > 0 the debug device handle n-1
+//  - strings: varint reference; 0 defines a new string that is followed by
+//    its varint length and bytes and gets the next id, counting from 1
+//  - array contents: varint ArrayContents kind, followed by one handle per
+//    element for object arrays or a blob reference for all other types
+//  - blobs: like strings, but identical contents are only stored once
+//  - parameter values: handle for objects, string for ANARI_STRING and the
+//    raw bytes of the value for everything else
+
+namespace anari {
+namespace debug_device {
+namespace trace {
+
+static const char traceMagic[8] = {'A', 'N', 'R', 'I', 'T', 'R', 'C', '1'};
+
+enum Opcode : uint32_t
+{
+  // result, type, subtype [, object type for ANARI_OBJECT]
+  OP_NEW_OBJECT = 1,
+  // result, type, numItems1, contents
+  OP_NEW_ARRAY_1D,
+  // result, type, numItems1, numItems2, contents
+  OP_NEW_ARRAY_2D,
+  // result, type, numItems1, numItems2, numItems3, contents
+  OP_NEW_ARRAY_3D,
+  // array
+  OP_MAP_ARRAY,
+  // array, contents
+  OP_UNMAP_ARRAY,
+  // object, name, type, value
+  OP_SET_PARAMETER,
+  // object, name
+  OP_UNSET_PARAMETER,
+  // object
+  OP_UNSET_ALL_PARAMETERS,
+  // object, name, type, dimensions, numElements1 .. numElementsN
+  OP_MAP_PARAMETER_ARRAY,
+  // object, name, contents
+  OP_UNMAP_PARAMETER_ARRAY,
+  // object
+  OP_COMMIT_PARAMETERS,
+  // object
+  OP_RELEASE,
+  // object
+  OP_RETAIN,
+  // object, name, type, size, wait mask
+  OP_GET_PROPERTY,
+  // frame, channel
+  OP_MAP_FRAME,
+  // frame, channel
+  OP_UNMAP_FRAME,
+  // frame
+  OP_RENDER_FRAME,
+  // frame, wait mask
+  OP_FRAME_READY,
+  // frame
+  OP_DISCARD_FRAME,
+};
+
+enum ArrayContents : uint32_t
+{
+  CONTENTS_NONE = 0,
+  CONTENTS_HANDLES,
+  CONTENTS_BLOB,
+};
+
+} // namespace trace
+} // namespace debug_device
+} // namespace anari
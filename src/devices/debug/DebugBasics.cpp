@@ -407,15 +407,15 @@ void DebugBasics::anariReleaseDevice(ANARIDevice device) {
     (void)device;
 
     for(size_t i = 1;i<td->objects.size();++i) {
-        auto &info = td->objects[i];
-        if(info->getRefCount() > 0) {
+        auto info = td->objects.get(ANARIObject(i));
+        if(info && info->getRefCount() > 0) {
             DEBUG_REPORT(ANARI_SEVERITY_WARNING, ANARI_STATUS_NO_ERROR,
                 "%s: Leaked object (%s).", DEBUG_FUNCTION_NAME, info->getName());
         }
     }
     for(size_t i = 1;i<td->objects.size();++i) {
-        auto &info = td->objects[i];
-        if(info->getReferences() == 0) {
+        auto info = td->objects.get(ANARIObject(i));
+        if(info && info->getReferences() == 0) {
             DEBUG_REPORT(ANARI_SEVERITY_WARNING, ANARI_STATUS_NO_ERROR,
                 "%s: Unused object (%s).", DEBUG_FUNCTION_NAME, info->getName());
         }
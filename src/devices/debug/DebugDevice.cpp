@@ -5,6 +5,7 @@
 
 #include "anari/anari.h"
 
+#include "BinarySerializer.h"
 #include "CodeSerializer.h"
 #include "DebugBasics.h"
 #include "EmptySerializer.h"
@@ -12,7 +13,9 @@
 
 // std
 #include <cstdarg>
+#include <cstdint>
 #include <cstdlib>
+#include <fstream>
 
 namespace anari {
 namespace debug_device {
@@ -135,17 +138,21 @@ ANARIArray1D DebugDevice::newArray1D(const void *appMemory,
       forward = handles;
     }
 
-    debug->anariNewArray1D(
-        this_device(), appMemory, deleter, userData, type, numItems);
+    if (validate(this_device(), "anariNewArray1D")) {
+      debug->anariNewArray1D(
+          this_device(), appMemory, deleter, userData, type, numItems);
+    }
 
     DeleterWrapperData *deleterData =
         new DeleterWrapperData(userData, appMemory, deleter);
+    uint64_t start = profileBegin();
     handle = anariNewArray1D(wrapped,
         forward,
         deleterWrapper,
         (const void *)deleterData,
         type,
         numItems);
+    profileEnd(start, PROFILE_NEW_ARRAY_1D, ANARI_ARRAY1D, toString(type));
     handle = newHandle(handle);
 
     if (auto info = getDynamicObjectInfo<DebugObject<ANARI_ARRAY1D>>(handle)) {
@@ -159,10 +166,14 @@ ANARIArray1D DebugDevice::newArray1D(const void *appMemory,
       }
     }
   } else {
-    debug->anariNewArray1D(
-        this_device(), appMemory, deleter, userData, type, numItems);
+    if (validate(this_device(), "anariNewArray1D")) {
+      debug->anariNewArray1D(
+          this_device(), appMemory, deleter, userData, type, numItems);
+    }
+    uint64_t start = profileBegin();
     handle =
         anariNewArray1D(wrapped, appMemory, deleter, userData, type, numItems);
+    profileEnd(start, PROFILE_NEW_ARRAY_1D, ANARI_ARRAY1D, toString(type));
     handle = newHandle(handle);
   }
 
@@ -185,10 +196,19 @@ ANARIArray2D DebugDevice::newArray2D(const void *appMemory,
     uint64_t numItems1,
     uint64_t numItems2)
 {
-  debug->anariNewArray2D(
-      this_device(), appMemory, deleter, userData, type, numItems1, numItems2);
+  if (validate(this_device(), "anariNewArray2D")) {
+    debug->anariNewArray2D(this_device(),
+        appMemory,
+        deleter,
+        userData,
+        type,
+        numItems1,
+        numItems2);
+  }
+  uint64_t start = profileBegin();
   ANARIArray2D handle = anariNewArray2D(
       wrapped, appMemory, deleter, userData, type, numItems1, numItems2);
+  profileEnd(start, PROFILE_NEW_ARRAY_2D, ANARI_ARRAY2D, toString(type));
   handle = newHandle(handle);
 
   if (auto info = getDynamicObjectInfo<DebugObject<ANARI_ARRAY2D>>(handle)) {
@@ -217,14 +237,17 @@ ANARIArray3D DebugDevice::newArray3D(const void *appMemory,
     uint64_t numItems2,
     uint64_t numItems3)
 {
-  debug->anariNewArray3D(this_device(),
-      appMemory,
-      deleter,
-      userData,
-      type,
-      numItems1,
-      numItems2,
-      numItems3);
+  if (validate(this_device(), "anariNewArray3D")) {
+    debug->anariNewArray3D(this_device(),
+        appMemory,
+        deleter,
+        userData,
+        type,
+        numItems1,
+        numItems2,
+        numItems3);
+  }
+  uint64_t start = profileBegin();
   ANARIArray3D handle = anariNewArray3D(wrapped,
       appMemory,
       deleter,
@@ -233,6 +256,7 @@ ANARIArray3D DebugDevice::newArray3D(const void *appMemory,
       numItems1,
       numItems2,
       numItems3);
+  profileEnd(start, PROFILE_NEW_ARRAY_3D, ANARI_ARRAY3D, toString(type));
   handle = newHandle(handle);
 
   if (auto info = getDynamicObjectInfo<DebugObject<ANARI_ARRAY3D>>(handle)) {
@@ -257,8 +281,12 @@ ANARIArray3D DebugDevice::newArray3D(const void *appMemory,
 
 void *DebugDevice::mapArray(ANARIArray a)
 {
-  debug->anariMapArray(this_device(), a);
+  if (validate(a, "anariMapArray")) {
+    debug->anariMapArray(this_device(), a);
+  }
+  uint64_t start = profileBegin();
   void *ptr = anariMapArray(wrapped, unwrapHandle(a));
+  profileEnd(start, PROFILE_MAP_ARRAY, a);
 
   void *result = nullptr;
   if (auto info = getDynamicObjectInfo<GenericArrayDebugObject>(a)) {
@@ -293,8 +321,12 @@ void DebugDevice::unmapArray(ANARIArray a)
     }
   }
 
-  debug->anariUnmapArray(this_device(), a);
+  if (validate(a, "anariUnmapArray")) {
+    debug->anariUnmapArray(this_device(), a);
+  }
+  uint64_t start = profileBegin();
   anariUnmapArray(wrapped, unwrapHandle(a));
+  profileEnd(start, PROFILE_UNMAP_ARRAY, a);
 
   if (serializer) {
     serializer->anariUnmapArray(this_device(), a);
@@ -309,8 +341,12 @@ void DebugDevice::unmapArray(ANARIArray a)
 
 ANARILight DebugDevice::newLight(const char *type)
 {
-  debug->anariNewLight(this_device(), type);
+  if (validate(this_device(), "anariNewLight")) {
+    debug->anariNewLight(this_device(), type);
+  }
+  uint64_t start = profileBegin();
   ANARILight handle = anariNewLight(wrapped, type);
+  profileEnd(start, PROFILE_NEW_LIGHT, ANARI_LIGHT, type);
   ANARILight result = newHandle(handle, type);
 
   if (serializer) {
@@ -322,8 +358,12 @@ ANARILight DebugDevice::newLight(const char *type)
 
 ANARICamera DebugDevice::newCamera(const char *type)
 {
-  debug->anariNewCamera(this_device(), type);
+  if (validate(this_device(), "anariNewCamera")) {
+    debug->anariNewCamera(this_device(), type);
+  }
+  uint64_t start = profileBegin();
   ANARICamera handle = anariNewCamera(wrapped, type);
+  profileEnd(start, PROFILE_NEW_CAMERA, ANARI_CAMERA, type);
   ANARICamera result = newHandle(handle, type);
 
   if (serializer) {
@@ -335,8 +375,12 @@ ANARICamera DebugDevice::newCamera(const char *type)
 
 ANARIGeometry DebugDevice::newGeometry(const char *type)
 {
-  debug->anariNewGeometry(this_device(), type);
+  if (validate(this_device(), "anariNewGeometry")) {
+    debug->anariNewGeometry(this_device(), type);
+  }
+  uint64_t start = profileBegin();
   ANARIGeometry handle = anariNewGeometry(wrapped, type);
+  profileEnd(start, PROFILE_NEW_GEOMETRY, ANARI_GEOMETRY, type);
   ANARIGeometry result = newHandle(handle, type);
 
   if (serializer) {
@@ -348,8 +392,12 @@ ANARIGeometry DebugDevice::newGeometry(const char *type)
 
 ANARISpatialField DebugDevice::newSpatialField(const char *type)
 {
-  debug->anariNewSpatialField(this_device(), type);
+  if (validate(this_device(), "anariNewSpatialField")) {
+    debug->anariNewSpatialField(this_device(), type);
+  }
+  uint64_t start = profileBegin();
   ANARISpatialField handle = anariNewSpatialField(wrapped, type);
+  profileEnd(start, PROFILE_NEW_SPATIAL_FIELD, ANARI_SPATIAL_FIELD, type);
   ANARISpatialField result = newHandle(handle, type);
 
   if (serializer) {
@@ -361,8 +409,12 @@ ANARISpatialField DebugDevice::newSpatialField(const char *type)
 
 ANARISurface DebugDevice::newSurface()
 {
-  debug->anariNewSurface(this_device());
+  if (validate(this_device(), "anariNewSurface")) {
+    debug->anariNewSurface(this_device());
+  }
+  uint64_t start = profileBegin();
   ANARISurface handle = anariNewSurface(wrapped);
+  profileEnd(start, PROFILE_NEW_SURFACE, ANARI_SURFACE, nullptr);
   ANARISurface result = newHandle(handle);
 
   if (serializer) {
@@ -374,8 +426,12 @@ ANARISurface DebugDevice::newSurface()
 
 ANARIVolume DebugDevice::newVolume(const char *type)
 {
-  debug->anariNewVolume(this_device(), type);
+  if (validate(this_device(), "anariNewVolume")) {
+    debug->anariNewVolume(this_device(), type);
+  }
+  uint64_t start = profileBegin();
   ANARIVolume handle = anariNewVolume(wrapped, type);
+  profileEnd(start, PROFILE_NEW_VOLUME, ANARI_VOLUME, type);
   ANARIVolume result = newHandle(handle, type);
 
   if (serializer) {
@@ -389,8 +445,12 @@ ANARIVolume DebugDevice::newVolume(const char *type)
 
 ANARIMaterial DebugDevice::newMaterial(const char *type)
 {
-  debug->anariNewMaterial(this_device(), type);
+  if (validate(this_device(), "anariNewMaterial")) {
+    debug->anariNewMaterial(this_device(), type);
+  }
+  uint64_t start = profileBegin();
   ANARIMaterial handle = anariNewMaterial(wrapped, type);
+  profileEnd(start, PROFILE_NEW_MATERIAL, ANARI_MATERIAL, type);
   ANARIMaterial result = newHandle(handle, type);
 
   if (serializer) {
@@ -402,8 +462,12 @@ ANARIMaterial DebugDevice::newMaterial(const char *type)
 
 ANARISampler DebugDevice::newSampler(const char *type)
 {
-  debug->anariNewSampler(this_device(), type);
+  if (validate(this_device(), "anariNewSampler")) {
+    debug->anariNewSampler(this_device(), type);
+  }
+  uint64_t start = profileBegin();
   ANARISampler handle = anariNewSampler(wrapped, type);
+  profileEnd(start, PROFILE_NEW_SAMPLER, ANARI_SAMPLER, type);
   ANARISampler result = newHandle(handle, type);
 
   if (serializer) {
@@ -417,8 +481,12 @@ ANARISampler DebugDevice::newSampler(const char *type)
 
 ANARIGroup DebugDevice::newGroup()
 {
-  debug->anariNewGroup(this_device());
+  if (validate(this_device(), "anariNewGroup")) {
+    debug->anariNewGroup(this_device());
+  }
+  uint64_t start = profileBegin();
   ANARIGroup handle = anariNewGroup(wrapped);
+  profileEnd(start, PROFILE_NEW_GROUP, ANARI_GROUP, nullptr);
   ANARIGroup result = newHandle(handle);
 
   if (serializer) {
@@ -430,8 +498,12 @@ ANARIGroup DebugDevice::newGroup()
 
 ANARIInstance DebugDevice::newInstance(const char *type)
 {
-  debug->anariNewInstance(this_device(), type);
+  if (validate(this_device(), "anariNewInstance")) {
+    debug->anariNewInstance(this_device(), type);
+  }
+  uint64_t start = profileBegin();
   ANARIInstance handle = anariNewInstance(wrapped, type);
+  profileEnd(start, PROFILE_NEW_INSTANCE, ANARI_INSTANCE, type);
   ANARIInstance result = newHandle(handle);
 
   if (serializer) {
@@ -445,8 +517,12 @@ ANARIInstance DebugDevice::newInstance(const char *type)
 
 ANARIWorld DebugDevice::newWorld()
 {
-  debug->anariNewWorld(this_device());
+  if (validate(this_device(), "anariNewWorld")) {
+    debug->anariNewWorld(this_device());
+  }
+  uint64_t start = profileBegin();
   ANARIWorld handle = anariNewWorld(wrapped);
+  profileEnd(start, PROFILE_NEW_WORLD, ANARI_WORLD, nullptr);
   ANARIWorld result = newHandle(handle);
 
   if (serializer) {
@@ -494,10 +570,28 @@ int DebugDevice::getProperty(ANARIObject object,
     uint64_t size,
     ANARIWaitMask mask)
 {
-  debug->anariGetProperty(this_device(), object, name, type, mem, size, mask);
+  if (validate(object, "anariGetProperty")) {
+    debug->anariGetProperty(this_device(), object, name, type, mem, size, mask);
+  }
+
+  if (handleIsDevice(object) && std::strcmp(name, "debug.profile") == 0
+      && type == ANARI_STRING && size >= sizeof(const char *)) {
+    if (!profiler) {
+      return 0;
+    }
+    // each thread gets its own copy, so concurrent queries don't free the
+    // string another thread is still reading
+    thread_local std::string profileJson;
+    profileJson = profiler->json();
+    const char *json = profileJson.c_str();
+    std::memcpy(mem, &json, sizeof(json));
+    return 1;
+  }
 
+  uint64_t start = profileBegin();
   int result = anariGetProperty(
       wrapped, unwrapHandle(object), name, type, mem, size, mask);
+  profileEnd(start, PROFILE_GET_PROPERTY, object);
 
   if (serializer) {
     serializer->anariGetProperty(
@@ -542,8 +636,17 @@ void DebugDevice::setParameter(
     unwrapped = &obj;
   }
 
-  debug->anariSetParameter(this_device(), object, name, type, mem);
+  bool checked = validate(object, "anariSetParameter");
+  if (checked) {
+    debug->anariSetParameter(this_device(), object, name, type, mem);
+  } else if (validation != VALIDATION_OFF && isObject(type)) {
+    ANARIObject handle = *static_cast<const ANARIObject *>(mem);
+    if (handle) {
+      checkHandle(handle, "anariSetParameter (value)");
+    }
+  }
 
+  uint64_t start = profileBegin();
   // frame completion callbacks require special treatment
   if (type == ANARI_FRAME_COMPLETION_CALLBACK
       && std::strncmp(name, "frameCompletionCallback", 23) == 0) {
@@ -564,6 +667,7 @@ void DebugDevice::setParameter(
   } else {
     anariSetParameter(wrapped, unwrapHandle(object), name, type, unwrapped);
   }
+  profileEnd(start, PROFILE_SET_PARAMETER, object);
 
   if (serializer) {
     serializer->anariSetParameter(this_device(), object, name, type, mem);
@@ -571,7 +675,9 @@ void DebugDevice::setParameter(
 
   if (auto info = getObjectInfo(object)) {
     info->setParameter(name, type, mem);
-    reportParameterUse(info->getType(), info->getSubtype(), name, type);
+    if (checked) {
+      reportParameterUse(info->getType(), info->getSubtype(), name, type);
+    }
   }
 }
 
@@ -580,8 +686,12 @@ void DebugDevice::unsetParameter(ANARIObject object, const char *name)
   if (handleIsDevice(object))
     deviceUnsetParameter(name);
   else {
-    debug->anariUnsetParameter(this_device(), object, name);
+    if (validate(object, "anariUnsetParameter")) {
+      debug->anariUnsetParameter(this_device(), object, name);
+    }
+    uint64_t start = profileBegin();
     anariUnsetParameter(wrapped, unwrapHandle(object), name);
+    profileEnd(start, PROFILE_UNSET_PARAMETER, object);
 
     if (serializer) {
       serializer->anariUnsetParameter(this_device(), object, name);
@@ -597,8 +707,12 @@ void DebugDevice::unsetAllParameters(ANARIObject object)
   if (handleIsDevice(object))
     deviceCommit();
   else {
-    debug->anariUnsetAllParameters(this_device(), object);
+    if (validate(object, "anariUnsetAllParameters")) {
+      debug->anariUnsetAllParameters(this_device(), object);
+    }
+    uint64_t start = profileBegin();
     anariUnsetAllParameters(wrapped, unwrapHandle(object));
+    profileEnd(start, PROFILE_UNSET_ALL_PARAMETERS, object);
 
     if (auto info = getObjectInfo(object))
       info->unsetAllParameters();
@@ -620,20 +734,27 @@ void *DebugDevice::mapParameterArray1D(ANARIObject object,
     //??
   }
   */
-  debug->anariMapParameterArray1D(
-      this_device(), object, name, dataType, numElements1, elementStride);
+  bool checked = validate(object, "anariMapParameterArray1D");
+  if (checked) {
+    debug->anariMapParameterArray1D(
+        this_device(), object, name, dataType, numElements1, elementStride);
+  }
 
+  uint64_t start = profileBegin();
   void *result = anariMapParameterArray1D(wrapped,
       unwrapHandle(object),
       name,
       dataType,
       numElements1,
       elementStride);
+  profileEnd(start, PROFILE_MAP_PARAMETER_ARRAY_1D, object);
 
   if (auto info = getDynamicObjectInfo<GenericDebugObject>(object)) {
     info->mapParameter(name, dataType, numElements1, elementStride, result);
-    reportParameterUse(
-        info->getType(), info->getSubtype(), name, ANARI_ARRAY1D);
+    if (checked) {
+      reportParameterUse(
+          info->getType(), info->getSubtype(), name, ANARI_ARRAY1D);
+    }
 
     if (serializer) {
       serializer->anariMapParameterArray1D(this_device(),
@@ -656,14 +777,18 @@ void *DebugDevice::mapParameterArray2D(ANARIObject object,
     uint64_t numElements2,
     uint64_t *elementStride)
 {
-  debug->anariMapParameterArray2D(this_device(),
-      object,
-      name,
-      dataType,
-      numElements1,
-      numElements2,
-      elementStride);
+  bool checked = validate(object, "anariMapParameterArray2D");
+  if (checked) {
+    debug->anariMapParameterArray2D(this_device(),
+        object,
+        name,
+        dataType,
+        numElements1,
+        numElements2,
+        elementStride);
+  }
 
+  uint64_t start = profileBegin();
   void *result = anariMapParameterArray2D(wrapped,
       unwrapHandle(object),
       name,
@@ -671,12 +796,15 @@ void *DebugDevice::mapParameterArray2D(ANARIObject object,
       numElements1,
       numElements2,
       elementStride);
+  profileEnd(start, PROFILE_MAP_PARAMETER_ARRAY_2D, object);
 
   if (auto info = getDynamicObjectInfo<GenericDebugObject>(object)) {
     info->mapParameter(
         name, dataType, numElements1 * numElements2, elementStride, result);
-    reportParameterUse(
-        info->getType(), info->getSubtype(), name, ANARI_ARRAY2D);
+    if (checked) {
+      reportParameterUse(
+          info->getType(), info->getSubtype(), name, ANARI_ARRAY2D);
+    }
 
     if (serializer) {
       serializer->anariMapParameterArray2D(this_device(),
@@ -684,7 +812,7 @@ void *DebugDevice::mapParameterArray2D(ANARIObject object,
           name,
           dataType,
           numElements1,
-          numElements1,
+          numElements2,
           elementStride,
           result);
     }
@@ -701,15 +829,19 @@ void *DebugDevice::mapParameterArray3D(ANARIObject object,
     uint64_t numElements3,
     uint64_t *elementStride)
 {
-  debug->anariMapParameterArray3D(this_device(),
-      object,
-      name,
-      dataType,
-      numElements1,
-      numElements2,
-      numElements3,
-      elementStride);
+  bool checked = validate(object, "anariMapParameterArray3D");
+  if (checked) {
+    debug->anariMapParameterArray3D(this_device(),
+        object,
+        name,
+        dataType,
+        numElements1,
+        numElements2,
+        numElements3,
+        elementStride);
+  }
 
+  uint64_t start = profileBegin();
   void *result = anariMapParameterArray3D(wrapped,
       unwrapHandle(object),
       name,
@@ -718,6 +850,7 @@ void *DebugDevice::mapParameterArray3D(ANARIObject object,
       numElements2,
       numElements3,
       elementStride);
+  profileEnd(start, PROFILE_MAP_PARAMETER_ARRAY_3D, object);
 
   if (auto info = getDynamicObjectInfo<GenericDebugObject>(object)) {
     info->mapParameter(name,
@@ -725,8 +858,10 @@ void *DebugDevice::mapParameterArray3D(ANARIObject object,
         numElements1 * numElements2 * numElements3,
         elementStride,
         result);
-    reportParameterUse(
-        info->getType(), info->getSubtype(), name, ANARI_ARRAY3D);
+    if (checked) {
+      reportParameterUse(
+          info->getType(), info->getSubtype(), name, ANARI_ARRAY3D);
+    }
 
     if (serializer) {
       serializer->anariMapParameterArray3D(this_device(),
@@ -746,7 +881,9 @@ void *DebugDevice::mapParameterArray3D(ANARIObject object,
 
 void DebugDevice::unmapParameterArray(ANARIObject object, const char *name)
 {
-  debug->anariUnmapParameterArray(this_device(), object, name);
+  if (validate(object, "anariUnmapParameterArray")) {
+    debug->anariUnmapParameterArray(this_device(), object, name);
+  }
 
   if (serializer) {
     serializer->anariUnmapParameterArray(this_device(), object, name);
@@ -771,7 +908,9 @@ void DebugDevice::unmapParameterArray(ANARIObject object, const char *name)
     }
   }
 
+  uint64_t start = profileBegin();
   anariUnmapParameterArray(wrapped, unwrapHandle(object), name);
+  profileEnd(start, PROFILE_UNMAP_PARAMETER_ARRAY, object);
 }
 
 void DebugDevice::commitParameters(ANARIObject object)
@@ -779,8 +918,12 @@ void DebugDevice::commitParameters(ANARIObject object)
   if (handleIsDevice(object))
     deviceCommit();
   else {
-    debug->anariCommitParameters(this_device(), object);
+    if (validate(object, "anariCommitParameters")) {
+      debug->anariCommitParameters(this_device(), object);
+    }
+    uint64_t start = profileBegin();
     anariCommitParameters(wrapped, unwrapHandle(object));
+    profileEnd(start, PROFILE_COMMIT_PARAMETERS, object);
 
     if (auto info = getObjectInfo(object))
       info->commit();
@@ -798,8 +941,12 @@ void DebugDevice::release(ANARIObject object)
   } else if (handleIsDevice(object)) {
     this->refDec(helium::RefType::PUBLIC);
   } else {
-    debug->anariRelease(this_device(), object);
+    if (validate(object, "anariRelease")) {
+      debug->anariRelease(this_device(), object);
+    }
+    uint64_t start = profileBegin();
     anariRelease(wrapped, unwrapHandle(object));
+    profileEnd(start, PROFILE_RELEASE, object);
 
     if (serializer) {
       serializer->anariRelease(this_device(), object);
@@ -817,8 +964,12 @@ void DebugDevice::retain(ANARIObject object)
   } else if (handleIsDevice(object)) {
     this->refInc(helium::RefType::PUBLIC);
   } else {
-    debug->anariRetain(this_device(), object);
+    if (validate(object, "anariRetain")) {
+      debug->anariRetain(this_device(), object);
+    }
+    uint64_t start = profileBegin();
     anariRetain(wrapped, unwrapHandle(object));
+    profileEnd(start, PROFILE_RETAIN, object);
 
     if (serializer) {
       serializer->anariRetain(this_device(), object);
@@ -833,8 +984,12 @@ void DebugDevice::retain(ANARIObject object)
 
 ANARIFrame DebugDevice::newFrame()
 {
-  debug->anariNewFrame(this_device());
+  if (validate(this_device(), "anariNewFrame")) {
+    debug->anariNewFrame(this_device());
+  }
+  uint64_t start = profileBegin();
   ANARIFrame handle = anariNewFrame(wrapped);
+  profileEnd(start, PROFILE_NEW_FRAME, ANARI_FRAME, nullptr);
   ANARIFrame result = newHandle(handle);
 
   if (serializer) {
@@ -850,9 +1005,13 @@ const void *DebugDevice::frameBufferMap(ANARIFrame fb,
     uint32_t *height,
     ANARIDataType *pixelType)
 {
-  debug->anariMapFrame(this_device(), fb, channel, width, height, pixelType);
+  if (validate(fb, "anariMapFrame")) {
+    debug->anariMapFrame(this_device(), fb, channel, width, height, pixelType);
+  }
+  uint64_t start = profileBegin();
   const void *mapped = anariMapFrame(
       wrapped, unwrapHandle(fb), channel, width, height, pixelType);
+  profileEnd(start, PROFILE_MAP_FRAME, fb);
 
   if (serializer) {
     serializer->anariMapFrame(
@@ -864,8 +1023,12 @@ const void *DebugDevice::frameBufferMap(ANARIFrame fb,
 
 void DebugDevice::frameBufferUnmap(ANARIFrame fb, const char *channel)
 {
-  debug->anariUnmapFrame(this_device(), fb, channel);
+  if (validate(fb, "anariUnmapFrame")) {
+    debug->anariUnmapFrame(this_device(), fb, channel);
+  }
+  uint64_t start = profileBegin();
   anariUnmapFrame(wrapped, unwrapHandle(fb), channel);
+  profileEnd(start, PROFILE_UNMAP_FRAME, fb);
   if (serializer) {
     serializer->anariUnmapFrame(this_device(), fb, channel);
   }
@@ -875,8 +1038,12 @@ void DebugDevice::frameBufferUnmap(ANARIFrame fb, const char *channel)
 
 ANARIRenderer DebugDevice::newRenderer(const char *type)
 {
-  debug->anariNewRenderer(this_device(), type);
+  if (validate(this_device(), "anariNewRenderer")) {
+    debug->anariNewRenderer(this_device(), type);
+  }
+  uint64_t start = profileBegin();
   ANARIRenderer handle = anariNewRenderer(wrapped, type);
+  profileEnd(start, PROFILE_NEW_RENDERER, ANARI_RENDERER, type);
   ANARIRenderer result = newHandle(handle, type);
 
   if (serializer) {
@@ -888,8 +1055,12 @@ ANARIRenderer DebugDevice::newRenderer(const char *type)
 
 void DebugDevice::renderFrame(ANARIFrame frame)
 {
-  debug->anariRenderFrame(this_device(), frame);
+  if (validate(frame, "anariRenderFrame")) {
+    debug->anariRenderFrame(this_device(), frame);
+  }
+  uint64_t start = profileBegin();
   anariRenderFrame(wrapped, unwrapHandle(frame));
+  profileEnd(start, PROFILE_RENDER_FRAME, frame);
 
   if (serializer) {
     serializer->anariRenderFrame(this_device(), frame);
@@ -902,8 +1073,12 @@ void DebugDevice::renderFrame(ANARIFrame frame)
 
 int DebugDevice::frameReady(ANARIFrame frame, ANARIWaitMask m)
 {
-  debug->anariFrameReady(this_device(), frame, m);
+  if (validate(frame, "anariFrameReady")) {
+    debug->anariFrameReady(this_device(), frame, m);
+  }
+  uint64_t start = profileBegin();
   int result = anariFrameReady(wrapped, unwrapHandle(frame), m);
+  profileEnd(start, PROFILE_FRAME_READY, frame);
 
   if (serializer) {
     serializer->anariFrameReady(this_device(), frame, m, result);
@@ -914,8 +1089,12 @@ int DebugDevice::frameReady(ANARIFrame frame, ANARIWaitMask m)
 
 void DebugDevice::discardFrame(ANARIFrame frame)
 {
-  debug->anariDiscardFrame(this_device(), frame);
+  if (validate(frame, "anariDiscardFrame")) {
+    debug->anariDiscardFrame(this_device(), frame);
+  }
+  uint64_t start = profileBegin();
   anariDiscardFrame(wrapped, unwrapHandle(frame));
+  profileEnd(start, PROFILE_DISCARD_FRAME, frame);
 
   if (serializer) {
     serializer->anariDiscardFrame(this_device(), frame);
@@ -941,9 +1120,40 @@ void DebugDevice::deviceSetParameter(
     std::string mode((const char *)mem);
     if (mode == "code") {
       createSerializer = CodeSerializer::create;
+    } else if (mode == "binary") {
+      createSerializer = BinarySerializer::create;
     }
   } else if (id == "traceDir" && type == ANARI_STRING) {
     traceDir = (const char *)mem;
+  } else if (id == "traceQueueSize" && type == ANARI_UINT64) {
+    traceQueueSize = *(const uint64_t *)mem;
+  } else if (id == "traceQueuePolicy" && type == ANARI_STRING) {
+    traceQueuePolicy = (const char *)mem;
+  } else if (id == "profile" && type == ANARI_BOOL) {
+    profiling = *(const int32_t *)mem != 0;
+  } else if (id == "profileFile" && type == ANARI_STRING) {
+    profileFile = (const char *)mem;
+  } else if (id == "validation" && type == ANARI_STRING) {
+    std::string level((const char *)mem);
+    if (level == "off") {
+      validation = VALIDATION_OFF;
+    } else if (level == "handles") {
+      validation = VALIDATION_HANDLES;
+    } else if (level == "sampled") {
+      validation = VALIDATION_SAMPLED;
+    } else if (level == "full") {
+      validation = VALIDATION_FULL;
+    } else {
+      reportStatus(this_device(),
+          ANARI_DEVICE,
+          ANARI_SEVERITY_WARNING,
+          ANARI_STATUS_INVALID_ARGUMENT,
+          "unknown validation level \"%s\", expected off, handles, "
+          "sampled or full",
+          level.c_str());
+    }
+  } else if (id == "validationSampleRate" && type == ANARI_UINT32) {
+    validationSampleRate = *(const uint32_t *)mem;
   }
 }
 
@@ -974,6 +1184,9 @@ void DebugDevice::deviceCommit()
     serializer.reset(createSerializer(this));
     createSerializer = nullptr;
   }
+  if (profiling && !profiler) {
+    profiler.reset(new Profiler);
+  }
 }
 
 DebugDevice::DebugDevice(ANARILibrary library)
@@ -984,9 +1197,9 @@ DebugDevice::DebugDevice(ANARILibrary library)
       debugObjectFactory(nullptr)
 {
   // insert the null handle explicitly as that always translates to null
-  objectMap[nullptr] = nullptr;
-  objects.emplace_back(new GenericDebugObject{});
-  objects[0]->setName("Null Object");
+  ANARIObject nullHandle = objects.reserve();
+  objects.insert(nullHandle, nullptr, new GenericDebugObject{});
+  objects.get(nullHandle)->setName("Null Object");
 
   debug.reset(new DebugBasics(this));
 
@@ -1006,6 +1219,56 @@ DebugDevice::DebugDevice(ANARILibrary library)
 
   const char *traceModeFromEnv = getenv("ANARI_DEBUG_TRACE_MODE");
   const char *traceDirFromEnv = getenv("ANARI_DEBUG_TRACE_DIR");
+  const char *queueSizeFromEnv = getenv("ANARI_DEBUG_TRACE_QUEUE_SIZE");
+  const char *queuePolicyFromEnv = getenv("ANARI_DEBUG_TRACE_QUEUE_POLICY");
+  if (queueSizeFromEnv) {
+    uint64_t queueSize = std::strtoull(queueSizeFromEnv, nullptr, 10);
+    anariSetParameter(this_device(),
+        this_device(),
+        "traceQueueSize",
+        ANARI_UINT64,
+        &queueSize);
+  }
+  if (queuePolicyFromEnv) {
+    anariSetParameter(this_device(),
+        this_device(),
+        "traceQueuePolicy",
+        ANARI_STRING,
+        queuePolicyFromEnv);
+  }
+  const char *validationFromEnv = getenv("ANARI_DEBUG_VALIDATION");
+  const char *sampleRateFromEnv = getenv("ANARI_DEBUG_VALIDATION_SAMPLE_RATE");
+  if (validationFromEnv) {
+    anariSetParameter(this_device(),
+        this_device(),
+        "validation",
+        ANARI_STRING,
+        validationFromEnv);
+  }
+  if (sampleRateFromEnv) {
+    uint32_t sampleRate =
+        uint32_t(std::strtoul(sampleRateFromEnv, nullptr, 10));
+    anariSetParameter(this_device(),
+        this_device(),
+        "validationSampleRate",
+        ANARI_UINT32,
+        &sampleRate);
+  }
+  const char *profileFromEnv = getenv("ANARI_DEBUG_PROFILE");
+  const char *profileFileFromEnv = getenv("ANARI_DEBUG_PROFILE_FILE");
+  if (profileFileFromEnv) {
+    anariSetParameter(this_device(),
+        this_device(),
+        "profileFile",
+        ANARI_STRING,
+        profileFileFromEnv);
+  }
+  if (profileFromEnv && std::string(profileFromEnv) != "0") {
+    int32_t enable = 1;
+    anariSetParameter(
+        this_device(), this_device(), "profile", ANARI_BOOL, &enable);
+    anariCommitParameters(this_device(), this_device());
+  }
   if (traceModeFromEnv && traceDirFromEnv) {
     anariSetParameter(this_device(),
         this_device(),
@@ -1042,7 +1305,13 @@ DebugDevice::~DebugDevice()
   }
 
   debugObjectFactory->print_summary(this);
-  if (debug) {
+  if (profiler) {
+    writeProfile();
+  }
+  if (serializer) {
+    serializer->anariReleaseDevice(this_device());
+  }
+  if (debug && reportsUsage()) {
     debug->anariReleaseDevice(this_device());
   }
   if (wrapped) {
@@ -1053,19 +1322,21 @@ DebugDevice::~DebugDevice()
 ANARIObject DebugDevice::newObjectHandle(
     ANARIObject h, ANARIDataType type, const char *name)
 {
-  reportObjectUse(type, name);
-  ANARIObject idx = (ANARIObject)objects.size();
-  objects.emplace_back(
-      debugObjectFactory->new_by_subtype(type, name, this, idx, h));
-  objectMap[h] = idx;
+  if (reportsUsage()) {
+    reportObjectUse(type, name);
+  }
+  ANARIObject idx = objects.reserve();
+  objects.insert(
+      idx, h, debugObjectFactory->new_by_subtype(type, name, this, idx, h));
   return idx;
 }
 ANARIObject DebugDevice::newObjectHandle(ANARIObject h, ANARIDataType type)
 {
-  reportObjectUse(type, "");
-  ANARIObject idx = (ANARIObject)objects.size();
-  objects.emplace_back(debugObjectFactory->new_by_type(type, this, idx, h));
-  objectMap[h] = idx;
+  if (reportsUsage()) {
+    reportObjectUse(type, "");
+  }
+  ANARIObject idx = objects.reserve();
+  objects.insert(idx, h, debugObjectFactory->new_by_type(type, this, idx, h));
   return idx;
 }
 ANARIObject DebugDevice::wrapObjectHandle(ANARIObject h, ANARIDataType type)
@@ -1074,12 +1345,7 @@ ANARIObject DebugDevice::wrapObjectHandle(ANARIObject h, ANARIDataType type)
   if (h == wrapped) {
     return this_device();
   } else {
-    auto iter = objectMap.find(h);
-    if (iter != objectMap.end()) {
-      return iter->second;
-    } else {
-      return 0;
-    }
+    return objects.find(h);
   }
 }
 ANARIObject DebugDevice::unwrapObjectHandle(ANARIObject h, ANARIDataType type)
@@ -1087,8 +1353,8 @@ ANARIObject DebugDevice::unwrapObjectHandle(ANARIObject h, ANARIDataType type)
   (void)type;
   if (h == this_device()) {
     return wrapped;
-  } else if ((uintptr_t)h < objects.size()) {
-    return objects[(uintptr_t)h]->getHandle();
+  } else if (DebugObjectBase *info = objects.get(h)) {
+    return info->getHandle();
   } else {
     return nullptr;
   }
@@ -1097,10 +1363,56 @@ DebugObjectBase *DebugDevice::getObjectInfo(ANARIObject h)
 {
   if (h == this_device()) {
     return &deviceInfo;
-  } else if ((uintptr_t)h < objects.size()) {
-    return objects[(uintptr_t)h].get();
   } else {
-    return nullptr;
+    return objects.get(h);
+  }
+}
+
+bool DebugDevice::checkCall(ANARIObject object, const char *function)
+{
+  bool sampled = validation == VALIDATION_SAMPLED;
+  DebugObjectBase *info = objects.get(object);
+  if (info == nullptr && handleIsDevice(object)) {
+    if (!sampled) {
+      return false;
+    }
+    uint32_t count = deviceCalls.fetch_add(1, std::memory_order_relaxed);
+    return validationSampleRate <= 1 || count % validationSampleRate == 0;
+  } else if (info == nullptr) {
+    // the full checks report unknown handles in more detail
+    if (!sampled) {
+      checkHandle(object, function);
+    }
+    return sampled;
+  } else if (sampled && objects.sample(object, validationSampleRate)) {
+    return true;
+  } else if (info->getRefCount() <= 0) {
+    checkHandle(object, function);
+  }
+  return false;
+}
+
+void DebugDevice::checkHandle(ANARIObject object, const char *function)
+{
+  if (handleIsDevice(object)) {
+    return;
+  }
+  DebugObjectBase *info = objects.get(object);
+  if (info == nullptr) {
+    reportStatus(nullptr,
+        ANARI_OBJECT,
+        ANARI_SEVERITY_ERROR,
+        ANARI_STATUS_INVALID_ARGUMENT,
+        "%s: Unknown object.",
+        function);
+  } else if (info->getRefCount() <= 0) {
+    reportStatus(object,
+        info->getType(),
+        ANARI_SEVERITY_ERROR,
+        ANARI_STATUS_INVALID_ARGUMENT,
+        "%s: Object (%s) has been released",
+        function,
+        info->getName());
   }
 }
 
@@ -1133,5 +1445,77 @@ void DebugDevice::reportObjectUse(ANARIDataType objtype, const char *objsubtype)
   }
 }
 
+uint64_t DebugDevice::profileBegin() const
+{
+  return profiler && profiling ? Profiler::now() : 0;
+}
+
+void DebugDevice::profileEnd(
+    uint64_t start, ProfileCall call, ANARIDataType type, const char *subtype)
+{
+  if (start == 0) {
+    return;
+  }
+  uint64_t ns = Profiler::now() - start;
+  profiler->record(call, type, profiler->subtypeId(subtype), ns);
+}
+
+void DebugDevice::profileEnd(
+    uint64_t start, ProfileCall call, ANARIObject object)
+{
+  if (start == 0) {
+    return;
+  }
+  uint64_t ns = Profiler::now() - start;
+
+  ANARIDataType type = ANARI_UNKNOWN;
+  uint32_t subtype = 0;
+  if (handleIsDevice(object)) {
+    type = ANARI_DEVICE;
+  } else if (auto info = objects.get(object)) {
+    type = info->getType();
+    subtype = objects.profileSubtype(object);
+    if (subtype == UINT32_MAX) {
+      // arrays are told apart by their element type; threads racing here
+      // store the same id
+      auto array = dynamic_cast<GenericArrayDebugObject *>(info);
+      subtype = profiler->subtypeId(
+          array ? toString(array->arrayType) : info->getSubtype());
+      objects.setProfileSubtype(object, subtype);
+    }
+  }
+  profiler->record(call, type, subtype, ns);
+}
+
+void DebugDevice::writeProfile()
+{
+  std::ofstream out(profileFile);
+  if (out) {
+    out << profiler->json();
+    reportStatus(this_device(),
+        ANARI_DEVICE,
+        ANARI_SEVERITY_INFO,
+        ANARI_STATUS_NO_ERROR,
+        "call profile written to %s, calls with the highest total time:",
+        profileFile.c_str());
+  } else {
+    reportStatus(this_device(),
+        ANARI_DEVICE,
+        ANARI_SEVERITY_WARNING,
+        ANARI_STATUS_UNKNOWN_ERROR,
+        "could not write call profile to %s",
+        profileFile.c_str());
+  }
+
+  for (const std::string &line : profiler->summary(10)) {
+    reportStatus(this_device(),
+        ANARI_DEVICE,
+        ANARI_SEVERITY_INFO,
+        ANARI_STATUS_NO_ERROR,
+        "   %s",
+        line.c_str());
+  }
+}
+
 } // namespace debug_device
 } // namespace anari
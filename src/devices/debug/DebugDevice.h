@@ -11,6 +11,7 @@
 #include "anari/anari_cpp.hpp"
 
 // std
+#include <atomic>
 #include <cstring>
 #include <memory>
 #include <string>
@@ -19,6 +20,8 @@
 
 #include "DebugInterface.h"
 #include "DebugSerializerInterface.h"
+#include "HandleTable.h"
+#include "Profiler.h"
 
 #include "anari/ext/debug/DebugObject.h"
 
@@ -232,7 +235,7 @@ struct DEBUG_DEVICE_INTERFACE DebugDevice : public DeviceImpl, public helium::Re
       ANARIDataType paramtype);
   void reportObjectUse(ANARIDataType objtype, const char *objSubtype);
 
-  std::vector<std::unique_ptr<DebugObjectBase>> objects;
+  HandleTable objects;
 
   ANARIDevice getWrapped() const { return wrapped; }
 
@@ -243,17 +246,72 @@ struct DEBUG_DEVICE_INTERFACE DebugDevice : public DeviceImpl, public helium::Re
 
   DebugObject<ANARI_DEVICE> deviceInfo;
 
-  std::unordered_map<ANARIObject, ANARIObject> objectMap;
   std::vector<char> last_status_message;
 
+  enum ValidationLevel
+  {
+    // forward calls without checks or bookkeeping
+    VALIDATION_OFF,
+    // report unknown and released handles
+    VALIDATION_HANDLES,
+    // handle checks on every call, full checks on 1 in N calls per object
+    VALIDATION_SAMPLED,
+    // full checks on every call
+    VALIDATION_FULL
+  };
+
+  // Returns true if the DebugInterface checks are to run for this call,
+  // otherwise only checks the handle as far as the validation level asks for
+  bool validate(ANARIObject object, const char *function)
+  {
+    if (validation == VALIDATION_FULL) {
+      return true;
+    } else if (validation == VALIDATION_OFF) {
+      return false;
+    } else {
+      return checkCall(object, function);
+    }
+  }
+  // Handle check and sampling of the handles and sampled levels
+  bool checkCall(ANARIObject object, const char *function);
+  void checkHandle(ANARIObject object, const char *function);
+  // feature use and leaked objects are reported from the sampled level on
+  bool reportsUsage() const
+  {
+    return validation >= VALIDATION_SAMPLED;
+  }
+
+  ValidationLevel validation{VALIDATION_FULL};
+  uint32_t validationSampleRate{16};
+  std::atomic<uint32_t> deviceCalls{0};
+
   std::unique_ptr<DebugInterface> debug;
   ObjectFactory *debugObjectFactory{nullptr};
 
   std::unique_ptr<SerializerInterface> serializer;
   SerializerInterface *(*createSerializer)(DebugDevice *) = nullptr;
 
+  // Times a call forwarded to the wrapped device: profileBegin() returns 0
+  // if profiling is off, which makes profileEnd() a no-op
+  uint64_t profileBegin() const;
+  void profileEnd(uint64_t start,
+      ProfileCall call,
+      ANARIDataType type,
+      const char *subtype);
+  void profileEnd(uint64_t start, ProfileCall call, ANARIObject object);
+  void writeProfile();
+
+  std::unique_ptr<Profiler> profiler;
+  bool profiling{false};
+  std::string profileFile{"anari_profile.json"};
+
  public:
   std::string traceDir;
+  // bytes of calls and array contents the binary trace may hold in memory
+  // while they are written in the background, 0 writes synchronously
+  uint64_t traceQueueSize{64ull << 20};
+  // "block" or "drop" array contents when the trace queue is full
+  std::string traceQueuePolicy{"block"};
 };
 
 } // namespace debug_device
@@ -0,0 +1,81 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "HandleTable.h"
+
+#include "anari/ext/debug/DebugObject.h"
+
+namespace anari {
+namespace debug_device {
+
+const uint64_t HandleTable::pageBits;
+const uint64_t HandleTable::pageMask;
+const uint64_t HandleTable::pageCount;
+const uint64_t HandleTable::capacity;
+const int HandleTable::shardCount;
+
+HandleTable::HandleTable() {
+   for(uint64_t i = 0;i<pageCount;++i) {
+      pages[i].store(nullptr, std::memory_order_relaxed);
+   }
+}
+
+HandleTable::~HandleTable() {
+   for(uint64_t i = 0;i<pageCount;++i) {
+      Slot *page = pages[i].load(std::memory_order_relaxed);
+      if(page == nullptr) {
+         continue;
+      }
+      for(uint64_t j = 0;j<=pageMask;++j) {
+         delete page[j].info.load(std::memory_order_relaxed);
+      }
+      delete[] page;
+   }
+}
+
+ANARIObject HandleTable::reserve() {
+   uint64_t index = next.fetch_add(1);
+   if(index >= capacity) {
+      next.store(capacity);
+      return nullptr;
+   }
+   return ANARIObject(uintptr_t(index));
+}
+
+void HandleTable::insert(ANARIObject handle, ANARIObject wrapped, DebugObjectBase *info) {
+   uint64_t index = uint64_t(uintptr_t(handle));
+   std::atomic<Slot*> &page = pages[index >> pageBits];
+   if(page.load(std::memory_order_acquire) == nullptr) {
+      std::lock_guard<std::mutex> lock(pageMutex);
+      if(page.load(std::memory_order_relaxed) == nullptr) {
+         Slot *slots = new Slot[pageMask + 1];
+         for(uint64_t j = 0;j<=pageMask;++j) {
+            slots[j].info.store(nullptr, std::memory_order_relaxed);
+            slots[j].calls.store(0, std::memory_order_relaxed);
+            slots[j].profileSubtype.store(UINT32_MAX, std::memory_order_relaxed);
+         }
+         page.store(slots, std::memory_order_release);
+      }
+   }
+   slot(index)->info.store(info, std::memory_order_release);
+
+   Shard &shard = shardOf(wrapped);
+   std::lock_guard<std::mutex> lock(shard.mutex);
+   shard.handles[wrapped] = handle;
+}
+
+HandleTable::Shard &HandleTable::shardOf(ANARIObject wrapped) const {
+   // handles are usually aligned pointers, mix the bits before picking one
+   uint64_t h = uint64_t(uintptr_t(wrapped)) * 0x9e3779b97f4a7c15ull;
+   return shards[h >> 58];
+}
+
+ANARIObject HandleTable::find(ANARIObject wrapped) const {
+   Shard &shard = shardOf(wrapped);
+   std::lock_guard<std::mutex> lock(shard.mutex);
+   auto iter = shard.handles.find(wrapped);
+   return iter != shard.handles.end() ? iter->second : nullptr;
+}
+
+}
+}
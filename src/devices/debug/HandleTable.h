@@ -0,0 +1,99 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "anari/anari.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace anari {
+namespace debug_device {
+
+struct DebugObjectBase;
+
+// Object info of the debug device handles, which are indices into the table.
+// The table is made of fixed size pages that never move, so looking up a
+// handle reads two atomic pointers and never locks, even while other threads
+// add objects. Wrapped handles are mapped back to debug device handles in a
+// map split into shards that are locked separately.
+class HandleTable {
+public:
+   HandleTable();
+   ~HandleTable();
+
+   HandleTable(const HandleTable&) = delete;
+   HandleTable& operator=(const HandleTable&) = delete;
+
+   // Returns the next free handle, nullptr if the table is full
+   ANARIObject reserve();
+   // Stores the info of a reserved handle and takes ownership of it
+   void insert(ANARIObject handle, ANARIObject wrapped, DebugObjectBase *info);
+
+   DebugObjectBase *get(ANARIObject handle) const {
+      uint64_t index = uint64_t(uintptr_t(handle));
+      if(index >= capacity) {
+         return nullptr;
+      }
+      Slot *page = pages[index >> pageBits].load(std::memory_order_acquire);
+      return page ? page[index & pageMask].info.load(std::memory_order_acquire) : nullptr;
+   }
+
+   // Debug device handle of a wrapped handle, nullptr if unknown
+   ANARIObject find(ANARIObject wrapped) const;
+
+   // Handles reserved so far, some may not be inserted yet
+   uint64_t size() const { return next.load(std::memory_order_acquire); }
+
+   // Counts a call on a handle known to the table and returns true for 1 of
+   // every rate calls, starting with the first one
+   bool sample(ANARIObject handle, uint32_t rate) {
+      std::atomic<uint32_t> &calls = slot(uint64_t(uintptr_t(handle)))->calls;
+      uint32_t count = calls.fetch_add(1, std::memory_order_relaxed);
+      return rate <= 1 || count % rate == 0;
+   }
+
+   // Profiler subtype id cached for a handle known to the table, UINT32_MAX
+   // if not known yet
+   uint32_t profileSubtype(ANARIObject handle) const {
+      return slot(uint64_t(uintptr_t(handle)))->profileSubtype.load(std::memory_order_relaxed);
+   }
+   void setProfileSubtype(ANARIObject handle, uint32_t id) {
+      slot(uint64_t(uintptr_t(handle)))->profileSubtype.store(id, std::memory_order_relaxed);
+   }
+
+private:
+   struct Slot {
+      std::atomic<DebugObjectBase*> info;
+      // approximate under concurrent calls on the same object
+      std::atomic<uint32_t> calls;
+      std::atomic<uint32_t> profileSubtype;
+   };
+
+   struct alignas(64) Shard {
+      mutable std::mutex mutex;
+      std::unordered_map<ANARIObject, ANARIObject> handles;
+   };
+
+   static const uint64_t pageBits = 12;
+   static const uint64_t pageMask = (uint64_t(1) << pageBits) - 1;
+   static const uint64_t pageCount = uint64_t(1) << 14;
+   static const uint64_t capacity = pageCount << pageBits;
+   static const int shardCount = 64;
+
+   Slot *slot(uint64_t index) const {
+      return &pages[index >> pageBits].load(std::memory_order_acquire)[index & pageMask];
+   }
+   Shard &shardOf(ANARIObject wrapped) const;
+
+   std::atomic<uint64_t> next{0};
+   std::atomic<Slot*> pages[pageCount];
+   std::mutex pageMutex;
+   mutable Shard shards[shardCount];
+};
+
+}
+}
@@ -0,0 +1,299 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Profiler.h"
+
+#include "anari/anari_cpp.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <sstream>
+
+namespace anari {
+namespace debug_device {
+
+const int Profiler::bucketCount;
+
+static const char *callNames[PROFILE_CALL_COUNT] = {
+   "anariNewArray1D",
+   "anariNewArray2D",
+   "anariNewArray3D",
+   "anariMapArray",
+   "anariUnmapArray",
+   "anariNewLight",
+   "anariNewCamera",
+   "anariNewGeometry",
+   "anariNewSpatialField",
+   "anariNewSurface",
+   "anariNewVolume",
+   "anariNewMaterial",
+   "anariNewSampler",
+   "anariNewGroup",
+   "anariNewInstance",
+   "anariNewWorld",
+   "anariGetProperty",
+   "anariSetParameter",
+   "anariUnsetParameter",
+   "anariUnsetAllParameters",
+   "anariMapParameterArray1D",
+   "anariMapParameterArray2D",
+   "anariMapParameterArray3D",
+   "anariUnmapParameterArray",
+   "anariCommitParameters",
+   "anariRelease",
+   "anariRetain",
+   "anariNewFrame",
+   "anariMapFrame",
+   "anariUnmapFrame",
+   "anariNewRenderer",
+   "anariRenderFrame",
+   "anariFrameReady",
+   "anariDiscardFrame",
+};
+
+const char *profileCallName(ProfileCall call) {
+   return call < PROFILE_CALL_COUNT ? callNames[call] : "unknown";
+}
+
+static uint64_t makeKey(ProfileCall call, ANARIDataType type, uint32_t subtype) {
+   return (uint64_t(call) << 56) | (uint64_t(type & 0xffff) << 40) | subtype;
+}
+
+static ProfileCall keyCall(uint64_t key) {
+   return ProfileCall(key >> 56);
+}
+
+static ANARIDataType keyType(uint64_t key) {
+   return ANARIDataType((key >> 40) & 0xffff);
+}
+
+static uint32_t keySubtype(uint64_t key) {
+   return uint32_t(key & 0xffffffffffull);
+}
+
+static int bucketOf(uint64_t ns) {
+   int b = 0;
+   while(ns != 0 && b < Profiler::bucketCount - 1) {
+      ns >>= 1;
+      b += 1;
+   }
+   return b;
+}
+
+static std::string jsonString(const std::string &str) {
+   std::string result = "\"";
+   for(char c : str) {
+      if(c == '"' || c == '\\') {
+         result += '\\';
+         result += c;
+      } else if((unsigned char)c < 0x20) {
+         char buffer[8];
+         std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+         result += buffer;
+      } else {
+         result += c;
+      }
+   }
+   result += '"';
+   return result;
+}
+
+Profiler::Entry::Entry(uint64_t key) : key(key), count(0), totalNs(0), maxNs(0) {
+   for(int i = 0;i<bucketCount;++i) {
+      buckets[i].store(0, std::memory_order_relaxed);
+   }
+}
+
+Profiler::Profiler() {
+   static std::atomic<uint64_t> profilers(0);
+   id = ++profilers;
+   subtypes.push_back("");
+   subtypeIds[""] = 0;
+}
+
+uint32_t Profiler::subtypeId(const char *subtype) {
+   if(subtype == nullptr || subtype[0] == 0) {
+      return 0;
+   }
+   std::lock_guard<std::mutex> lock(mutex);
+   auto iter = subtypeIds.find(subtype);
+   if(iter != subtypeIds.end()) {
+      return iter->second;
+   }
+   uint32_t result = uint32_t(subtypes.size());
+   subtypes.push_back(subtype);
+   subtypeIds[subtype] = result;
+   return result;
+}
+
+Profiler::ThreadBuffer *Profiler::threadBuffer() {
+   // the profiler id rather than its address tells profilers apart, as a
+   // new profiler may be allocated where a released one was
+   struct Cache {
+      uint64_t owner;
+      ThreadBuffer *buffer;
+   };
+   static thread_local Cache cache = {0, nullptr};
+   if(cache.owner == id) {
+      return cache.buffer;
+   }
+
+   std::lock_guard<std::mutex> lock(mutex);
+   std::thread::id self = std::this_thread::get_id();
+   ThreadBuffer *buffer = nullptr;
+   for(auto &t : threads) {
+      if(t->thread == self) {
+         buffer = t.get();
+      }
+   }
+   if(buffer == nullptr) {
+      threads.emplace_back(new ThreadBuffer);
+      buffer = threads.back().get();
+      buffer->thread = self;
+   }
+   cache.owner = id;
+   cache.buffer = buffer;
+   return buffer;
+}
+
+void Profiler::record(ProfileCall call, ANARIDataType type, uint32_t subtype, uint64_t ns) {
+   ThreadBuffer *buffer = threadBuffer();
+   uint64_t key = makeKey(call, type, subtype);
+
+   Entry *entry;
+   auto iter = buffer->lookup.find(key);
+   if(iter != buffer->lookup.end()) {
+      entry = iter->second;
+   } else {
+      std::lock_guard<std::mutex> lock(buffer->mutex);
+      buffer->entries.emplace_back(key);
+      entry = &buffer->entries.back();
+      buffer->lookup[key] = entry;
+   }
+
+   // single writer: plain loads and stores are enough
+   const std::memory_order relaxed = std::memory_order_relaxed;
+   entry->count.store(entry->count.load(relaxed) + 1, relaxed);
+   entry->totalNs.store(entry->totalNs.load(relaxed) + ns, relaxed);
+   if(ns > entry->maxNs.load(relaxed)) {
+      entry->maxNs.store(ns, relaxed);
+   }
+   std::atomic<uint64_t> &bucket = entry->buckets[bucketOf(ns)];
+   bucket.store(bucket.load(relaxed) + 1, relaxed);
+}
+
+std::vector<Profiler::Result> Profiler::collect() {
+   std::map<uint64_t, Result> merged;
+
+   std::lock_guard<std::mutex> lock(mutex);
+   for(auto &t : threads) {
+      std::lock_guard<std::mutex> threadLock(t->mutex);
+      for(const Entry &entry : t->entries) {
+         auto iter = merged.find(entry.key);
+         if(iter == merged.end()) {
+            Result empty = {};
+            empty.key = entry.key;
+            iter = merged.insert(std::make_pair(entry.key, empty)).first;
+         }
+         Result &r = iter->second;
+         r.count += entry.count.load(std::memory_order_relaxed);
+         r.totalNs += entry.totalNs.load(std::memory_order_relaxed);
+         r.maxNs = std::max(r.maxNs, entry.maxNs.load(std::memory_order_relaxed));
+         for(int b = 0;b<bucketCount;++b) {
+            r.buckets[b] += entry.buckets[b].load(std::memory_order_relaxed);
+         }
+      }
+   }
+
+   std::vector<Result> results;
+   for(auto &m : merged) {
+      results.push_back(m.second);
+   }
+   std::sort(results.begin(), results.end(), [](const Result &a, const Result &b) {
+      return a.totalNs > b.totalNs;
+   });
+   return results;
+}
+
+std::string Profiler::describe(uint64_t key) {
+   std::string result = profileCallName(keyCall(key));
+   result += " ";
+   result += anari::toString(keyType(key));
+   uint32_t subtype = keySubtype(key);
+   if(subtype != 0 && subtype < subtypes.size()) {
+      result += " " + subtypes[subtype];
+   }
+   return result;
+}
+
+// upper bound of the bucket that holds the given fraction of the calls
+static uint64_t percentile(const uint64_t *buckets, uint64_t count, double fraction) {
+   uint64_t target = uint64_t(fraction*count + 0.5);
+   uint64_t sum = 0;
+   for(int b = 0;b<Profiler::bucketCount;++b) {
+      sum += buckets[b];
+      if(sum >= target && sum > 0) {
+         return uint64_t(1) << b;
+      }
+   }
+   return 0;
+}
+
+std::string Profiler::json() {
+   std::vector<Result> results = collect();
+
+   std::lock_guard<std::mutex> lock(mutex);
+   std::ostringstream out;
+   out << "{\n  \"threads\": " << threads.size() << ",\n";
+   out << "  \"calls\": [";
+   for(size_t i = 0;i<results.size();++i) {
+      const Result &r = results[i];
+      uint32_t subtype = keySubtype(r.key);
+      out << (i == 0 ? "\n" : ",\n");
+      out << "    {\"call\": " << jsonString(profileCallName(keyCall(r.key)));
+      out << ", \"objectType\": " << jsonString(anari::toString(keyType(r.key)));
+      out << ", \"subtype\": " << jsonString(subtype < subtypes.size() ? subtypes[subtype] : "");
+      out << ", \"count\": " << r.count;
+      out << ", \"totalNs\": " << r.totalNs;
+      out << ", \"meanNs\": " << (r.count ? r.totalNs/r.count : 0);
+      out << ", \"p50Ns\": " << percentile(r.buckets, r.count, 0.5);
+      out << ", \"p99Ns\": " << percentile(r.buckets, r.count, 0.99);
+      out << ", \"maxNs\": " << r.maxNs;
+      // [upper bound in ns, count] of each non-empty log2 bucket
+      out << ", \"histogram\": [";
+      bool first = true;
+      for(int b = 0;b<bucketCount;++b) {
+         if(r.buckets[b] != 0) {
+            out << (first ? "" : ", ") << "[" << (uint64_t(1) << b) << ", " << r.buckets[b] << "]";
+            first = false;
+         }
+      }
+      out << "]}";
+   }
+   out << "\n  ]\n}\n";
+   return out.str();
+}
+
+std::vector<std::string> Profiler::summary(size_t lines) {
+   std::vector<Result> results = collect();
+
+   std::lock_guard<std::mutex> lock(mutex);
+   std::vector<std::string> result;
+   for(size_t i = 0;i<results.size() && i<lines;++i) {
+      const Result &r = results[i];
+      char buffer[256];
+      std::snprintf(buffer, sizeof(buffer),
+         "%-40s %8llu calls, total %10.3f ms, mean %9.3f us, max %10.3f us",
+         describe(r.key).c_str(),
+         (unsigned long long)r.count,
+         r.totalNs*1e-6,
+         r.count ? r.totalNs*1e-3/r.count : 0.0,
+         r.maxNs*1e-3);
+      result.push_back(buffer);
+   }
+   return result;
+}
+
+}
+}
@@ -0,0 +1,130 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "anari/anari.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace anari {
+namespace debug_device {
+
+// API calls forwarded to the wrapped device that are timed by the profiler
+enum ProfileCall : uint32_t {
+   PROFILE_NEW_ARRAY_1D,
+   PROFILE_NEW_ARRAY_2D,
+   PROFILE_NEW_ARRAY_3D,
+   PROFILE_MAP_ARRAY,
+   PROFILE_UNMAP_ARRAY,
+   PROFILE_NEW_LIGHT,
+   PROFILE_NEW_CAMERA,
+   PROFILE_NEW_GEOMETRY,
+   PROFILE_NEW_SPATIAL_FIELD,
+   PROFILE_NEW_SURFACE,
+   PROFILE_NEW_VOLUME,
+   PROFILE_NEW_MATERIAL,
+   PROFILE_NEW_SAMPLER,
+   PROFILE_NEW_GROUP,
+   PROFILE_NEW_INSTANCE,
+   PROFILE_NEW_WORLD,
+   PROFILE_GET_PROPERTY,
+   PROFILE_SET_PARAMETER,
+   PROFILE_UNSET_PARAMETER,
+   PROFILE_UNSET_ALL_PARAMETERS,
+   PROFILE_MAP_PARAMETER_ARRAY_1D,
+   PROFILE_MAP_PARAMETER_ARRAY_2D,
+   PROFILE_MAP_PARAMETER_ARRAY_3D,
+   PROFILE_UNMAP_PARAMETER_ARRAY,
+   PROFILE_COMMIT_PARAMETERS,
+   PROFILE_RELEASE,
+   PROFILE_RETAIN,
+   PROFILE_NEW_FRAME,
+   PROFILE_MAP_FRAME,
+   PROFILE_UNMAP_FRAME,
+   PROFILE_NEW_RENDERER,
+   PROFILE_RENDER_FRAME,
+   PROFILE_FRAME_READY,
+   PROFILE_DISCARD_FRAME,
+   PROFILE_CALL_COUNT
+};
+
+const char *profileCallName(ProfileCall call);
+
+// Call latency histograms per API call, object type and object subtype.
+// Every thread records into its own buffer: the recording thread is the only
+// writer of its entries, so the hot path neither locks nor uses atomic
+// read-modify-write operations. Buffers are only locked to add an entry and
+// when the results are collected.
+class Profiler {
+public:
+   // log2 nanosecond buckets, bucket b counts durations in [2^(b-1), 2^b)
+   static const int bucketCount = 48;
+
+   Profiler();
+
+   static uint64_t now() {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now().time_since_epoch()).count();
+   }
+
+   // Returns a small id for an object subtype, 0 for none
+   uint32_t subtypeId(const char *subtype);
+
+   void record(ProfileCall call, ANARIDataType type, uint32_t subtype, uint64_t nanoseconds);
+
+   // All results as JSON, sorted by total time spent in the call
+   std::string json();
+
+   // One line per call type/subtype with the highest total time
+   std::vector<std::string> summary(size_t lines);
+
+private:
+   struct Entry {
+      explicit Entry(uint64_t key);
+      uint64_t key;
+      std::atomic<uint64_t> count;
+      std::atomic<uint64_t> totalNs;
+      std::atomic<uint64_t> maxNs;
+      std::atomic<uint64_t> buckets[bucketCount];
+   };
+
+   struct ThreadBuffer {
+      std::thread::id thread;
+      // owning thread only
+      std::unordered_map<uint64_t, Entry*> lookup;
+      // appended to by the owning thread under the mutex
+      std::deque<Entry> entries;
+      std::mutex mutex;
+   };
+
+   struct Result {
+      uint64_t key;
+      uint64_t count;
+      uint64_t totalNs;
+      uint64_t maxNs;
+      uint64_t buckets[bucketCount];
+   };
+
+   ThreadBuffer *threadBuffer();
+   std::vector<Result> collect();
+   std::string describe(uint64_t key);
+
+   uint64_t id;
+   std::mutex mutex;
+   std::vector<std::unique_ptr<ThreadBuffer>> threads;
+   std::vector<std::string> subtypes;
+   std::unordered_map<std::string, uint32_t> subtypeIds;
+};
+
+}
+}
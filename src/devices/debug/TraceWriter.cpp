@@ -0,0 +1,246 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TraceWriter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace anari {
+namespace debug_device {
+
+const uint64_t TraceWriter::slotCount;
+const uint64_t TraceWriter::chunkSize;
+
+// 64 bit multiply-xorshift hash over 8 byte words, used to recognize array
+// contents that were written before
+static uint64_t hashBytes(const void *mem, uint64_t size) {
+   const uint64_t m = 0xc6a4a7935bd1e995ull;
+   const char *bytes = (const char*)mem;
+   uint64_t h = 0x8445d61a4e774912ull ^ (size*m);
+   uint64_t i = 0;
+   for(;i+8<=size;i+=8) {
+      uint64_t k;
+      std::memcpy(&k, bytes+i, 8);
+      k *= m;
+      k ^= k >> 47;
+      k *= m;
+      h ^= k;
+      h *= m;
+   }
+   if(i < size) {
+      uint64_t k = 0;
+      std::memcpy(&k, bytes+i, size-i);
+      h ^= k;
+      h *= m;
+   }
+   h ^= h >> 47;
+   h *= m;
+   h ^= h >> 47;
+   return h;
+}
+
+static void appendVarint(std::vector<char> &buffer, uint64_t value) {
+   do {
+      char byte = value & 0x7f;
+      value >>= 7;
+      buffer.push_back(value ? (byte | 0x80) : byte);
+   } while(value);
+}
+
+TraceWriter::~TraceWriter() {
+   close();
+}
+
+bool TraceWriter::open(const std::string &name, uint64_t queueSize, Policy p) {
+   fileName = name;
+   out.open(fileName, std::ios::binary);
+   if(!out) {
+      return false;
+   }
+   capacity = queueSize;
+   policy = p;
+   async = queueSize > 0;
+   if(async) {
+      slots.resize(slotCount);
+      thread = std::thread(&TraceWriter::run, this);
+   }
+   return true;
+}
+
+void TraceWriter::close() {
+   if(!out.is_open()) {
+      return;
+   }
+   flush();
+   if(thread.joinable()) {
+      done.store(true);
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+      }
+      wakeWriter.notify_one();
+      thread.join();
+   }
+   out.close();
+   in.close();
+}
+
+void TraceWriter::write(const void *data, uint64_t size) {
+   const char *bytes = (const char*)data;
+   pending.insert(pending.end(), bytes, bytes+size);
+   if(pending.size() >= chunkSize) {
+      flush();
+   }
+}
+
+void TraceWriter::writeVarint(uint64_t value) {
+   appendVarint(pending, value);
+}
+
+bool TraceWriter::acceptBlob(uint64_t size) {
+   if(async && policy == POLICY_DROP && full(pending.size() + size)) {
+      statistics.droppedPayloads += 1;
+      statistics.droppedBytes += size;
+      return false;
+   }
+   return true;
+}
+
+void TraceWriter::writeBlob(const void *data, uint64_t size) {
+   flush();
+   Chunk chunk;
+   chunk.blob = true;
+   chunk.data.assign((const char*)data, (const char*)data + size);
+   push(chunk);
+}
+
+void TraceWriter::flush() {
+   if(pending.empty()) {
+      return;
+   }
+   Chunk chunk;
+   chunk.data.swap(pending);
+   push(chunk);
+   pending.reserve(chunkSize);
+}
+
+bool TraceWriter::full(uint64_t size) const {
+   uint64_t queued = queuedBytes.load();
+   // a chunk that exceeds the capacity on its own still goes into an
+   // empty queue
+   return head.load(std::memory_order_relaxed) - tail.load(std::memory_order_acquire) >= slotCount
+      || (queued > 0 && queued + size > capacity);
+}
+
+void TraceWriter::push(Chunk &chunk) {
+   uint64_t size = chunk.data.size();
+   statistics.bytesQueued += size;
+   statistics.chunksQueued += 1;
+
+   if(!async) {
+      process(chunk);
+      return;
+   }
+
+   if(full(size)) {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         wakeProducer.wait(lock, [&]() { return !full(size); });
+      }
+      statistics.stalls += 1;
+      statistics.stallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   }
+
+   uint64_t h = head.load(std::memory_order_relaxed);
+   slots[h % slotCount] = std::move(chunk);
+   uint64_t queued = queuedBytes.fetch_add(size) + size;
+   head.store(h + 1, std::memory_order_release);
+   if(queued > statistics.peakQueuedBytes) {
+      statistics.peakQueuedBytes = queued;
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+   }
+   wakeWriter.notify_one();
+}
+
+bool TraceWriter::matches(const Blob &blob, const char *data, uint64_t size) {
+   out.flush();
+   if(!in.is_open()) {
+      in.open(fileName, std::ios::binary);
+   }
+   in.clear();
+   in.seekg(blob.offset);
+   char buffer[4096];
+   for(uint64_t i = 0; i < size; i += sizeof(buffer)) {
+      uint64_t n = std::min<uint64_t>(sizeof(buffer), size - i);
+      if(!in.read(buffer, n) || std::memcmp(buffer, data + i, n) != 0) {
+         return false;
+      }
+   }
+   return true;
+}
+
+void TraceWriter::process(Chunk &chunk) {
+   if(!chunk.blob) {
+      out.write(chunk.data.data(), chunk.data.size());
+      return;
+   }
+
+   std::vector<char> header;
+   uint64_t size = chunk.data.size();
+   std::vector<Blob> &candidates =
+      blobs[std::make_pair(hashBytes(chunk.data.data(), size), size)];
+   for(const Blob &blob : candidates) {
+      if(matches(blob, chunk.data.data(), size)) {
+         appendVarint(header, blob.id);
+         out.write(header.data(), header.size());
+         return;
+      }
+   }
+
+   appendVarint(header, 0);
+   appendVarint(header, size);
+   out.write(header.data(), header.size());
+   Blob blob;
+   blob.id = ++blobCount;
+   blob.offset = uint64_t(out.tellp());
+   out.write(chunk.data.data(), size);
+   candidates.push_back(blob);
+}
+
+void TraceWriter::run() {
+   for(;;) {
+      uint64_t t = tail.load(std::memory_order_relaxed);
+      if(t == head.load(std::memory_order_acquire)) {
+         if(done.load()) {
+            break;
+         }
+         // idle: make what was written so far visible in the file
+         out.flush();
+         std::unique_lock<std::mutex> lock(mutex);
+         wakeWriter.wait(lock, [&]() {
+            return head.load(std::memory_order_acquire) != t || done.load();
+         });
+         continue;
+      }
+
+      Chunk chunk = std::move(slots[t % slotCount]);
+      slots[t % slotCount] = Chunk();
+      process(chunk);
+
+      queuedBytes.fetch_sub(chunk.data.size());
+      tail.store(t + 1, std::memory_order_release);
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+      }
+      wakeProducer.notify_one();
+   }
+   out.flush();
+}
+
+}
+}
@@ -0,0 +1,116 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace anari {
+namespace debug_device {
+
+// Output stream of the binary trace. Encoded calls are collected in chunks on
+// the application thread and handed to a writer thread through a bounded
+// single-producer/single-consumer ring, so hashing array contents and file
+// I/O stay off the API calls. With a queue size of 0 everything is written
+// synchronously instead.
+class TraceWriter {
+public:
+   enum Policy {
+      // wait for the writer thread when the queue is full
+      POLICY_BLOCK,
+      // leave out array contents that don't fit into the queue
+      POLICY_DROP,
+   };
+
+   struct Stats {
+      uint64_t bytesQueued = 0;
+      uint64_t chunksQueued = 0;
+      uint64_t peakQueuedBytes = 0;
+      uint64_t stalls = 0;
+      double stallSeconds = 0.0;
+      uint64_t droppedPayloads = 0;
+      uint64_t droppedBytes = 0;
+   };
+
+   TraceWriter() = default;
+   ~TraceWriter();
+
+   bool open(const std::string &fileName, uint64_t queueSize, Policy policy);
+   // Writes everything still queued and stops the writer thread
+   void close();
+
+   void write(const void *data, uint64_t size);
+   void writeVarint(uint64_t value);
+
+   // Returns false if array contents of this size are to be dropped
+   bool acceptBlob(uint64_t size);
+   // Copies the contents; the writer thread stores them as a blob reference,
+   // or as a new blob if they were not seen before
+   void writeBlob(const void *data, uint64_t size);
+
+   // Hands the encoded calls to the writer thread
+   void flush();
+
+   const Stats &stats() const { return statistics; }
+
+private:
+   struct Chunk {
+      bool blob = false;
+      std::vector<char> data;
+   };
+
+   static const uint64_t slotCount = 1024;
+   static const uint64_t chunkSize = 64*1024;
+
+   bool full(uint64_t size) const;
+   void push(Chunk &chunk);
+   void process(Chunk &chunk);
+   void run();
+
+   std::ofstream out;
+   bool async = false;
+   uint64_t capacity = 0;
+   Policy policy = POLICY_BLOCK;
+   Stats statistics;
+
+   // application thread
+   std::vector<char> pending;
+
+   // ring between application and writer thread
+   std::vector<Chunk> slots;
+   std::atomic<uint64_t> head{0};
+   std::atomic<uint64_t> tail{0};
+   std::atomic<uint64_t> queuedBytes{0};
+   std::atomic<bool> done{false};
+   std::mutex mutex;
+   std::condition_variable wakeWriter;
+   std::condition_variable wakeProducer;
+   std::thread thread;
+
+   // writer thread: the blobs written so far by (hash, size). Contents are
+   // compared against the copy in the file before an id is reused, so a hash
+   // collision stores a new blob rather than referencing the wrong one.
+   struct Blob {
+      uint64_t id;
+      // file offset of the contents
+      uint64_t offset;
+   };
+   bool matches(const Blob &blob, const char *data, uint64_t size);
+
+   std::string fileName;
+   std::ifstream in;
+   std::map<std::pair<uint64_t, uint64_t>, std::vector<Blob>> blobs;
+   uint64_t blobCount = 0;
+};
+
+}
+}
@@ -0,0 +1,714 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+// Plays back a binary trace written by the debug device (traceMode "binary")
+// against any device library and reports per-frame timings.
+
+#include "anari/anari_cpp.hpp"
+
+#include "BinaryTrace.h"
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace anari::debug_device::trace;
+
+using Clock = std::chrono::steady_clock;
+
+// Global variables
+static std::string g_traceFile;
+static std::string g_libraryName = "helide";
+static std::string g_deviceName = "default";
+static bool g_maxSpeed = false;
+static bool g_quiet = false;
+static bool g_verbose = false;
+
+static void statusFunc(const void *,
+    ANARIDevice,
+    ANARIObject,
+    ANARIDataType,
+    ANARIStatusSeverity severity,
+    ANARIStatusCode,
+    const char *message)
+{
+  if (severity == ANARI_SEVERITY_FATAL_ERROR)
+    fprintf(stderr, "[FATAL] %s\n", message);
+  else if (severity == ANARI_SEVERITY_ERROR)
+    fprintf(stderr, "[ERROR] %s\n", message);
+  else if (severity == ANARI_SEVERITY_WARNING && g_verbose)
+    fprintf(stderr, "[WARN ] %s\n", message);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct TraceReader
+{
+  const char *pos{nullptr};
+  const char *end{nullptr};
+  bool failed{false};
+
+  bool atEnd() const
+  {
+    return pos >= end;
+  }
+
+  uint64_t varint()
+  {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (pos >= end) {
+        failed = true;
+        return 0;
+      }
+      uint8_t byte = uint8_t(*pos++);
+      value |= uint64_t(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return value;
+    }
+    failed = true;
+    return 0;
+  }
+
+  const char *bytes(uint64_t size)
+  {
+    if (uint64_t(end - pos) < size) {
+      failed = true;
+      pos = end;
+      return nullptr;
+    }
+    const char *result = pos;
+    pos += size;
+    return result;
+  }
+};
+
+struct Blob
+{
+  const char *data;
+  uint64_t size;
+};
+
+struct FrameTiming
+{
+  // Time from anariRenderFrame() to the frame being ready, in the trace and
+  // in the replay
+  double traced;
+  double replayed;
+  // Time spent in the anariRenderFrame() call itself
+  double renderCall;
+};
+
+class Replay
+{
+ public:
+  bool load(const std::string &fileName);
+  bool run();
+  void printTimings() const;
+
+ private:
+  ANARIObject handle(uint64_t ref) const;
+  ANARIObject readHandle();
+  const char *readString();
+  Blob readBlob();
+  // Reads array contents into dst, which holds count elements of type with
+  // the given stride; returns false if the trace holds no contents
+  bool readContents(
+      ANARIDataType type, void *dst, uint64_t count, uint64_t stride = 0);
+  const void *readAppMemory(ANARIDataType type, uint64_t count);
+  bool execute(uint32_t opcode);
+  void frameDone(ANARIFrame frame);
+
+  std::vector<char> file;
+  TraceReader in;
+
+  ANARILibrary library{nullptr};
+  ANARIDevice device{nullptr};
+
+  // Replayed objects, indexed by debug device handle
+  std::vector<ANARIObject> objects;
+  // Deque, as returned strings must stay valid while more are read
+  std::deque<std::string> strings;
+  std::vector<Blob> blobs;
+  // Translated object arrays passed as application memory
+  std::deque<std::vector<ANARIObject>> handleArrays;
+  // Copies of the blobs passed as application memory. Blobs are shared by
+  // every call that traced the same contents, and the device writes to a
+  // shared array's memory when it is mapped, so each array gets its own.
+  std::deque<std::vector<char>> blobArrays;
+
+  struct ArrayInfo
+  {
+    ANARIDataType type;
+    uint64_t count;
+    void *mapped;
+  };
+  std::map<ANARIObject, ArrayInfo> arrays;
+
+  struct ParameterMapping
+  {
+    ANARIDataType type;
+    uint64_t count;
+    uint64_t stride;
+    void *mapped;
+  };
+  std::map<std::pair<ANARIObject, std::string>, ParameterMapping>
+      parameterMappings;
+
+  // Frames rendered but not yet completed: trace time, replay start and
+  // duration of the render call
+  struct PendingFrame
+  {
+    double traced;
+    Clock::time_point start;
+    double renderCall;
+  };
+  std::map<ANARIObject, PendingFrame> pendingFrames;
+  std::vector<FrameTiming> timings;
+
+  double traceTime{0.0};
+  uint64_t calls{0};
+  double replayDuration{0.0};
+};
+
+bool Replay::load(const std::string &fileName)
+{
+  std::ifstream stream(fileName, std::ios::binary | std::ios::ate);
+  if (!stream)
+    return false;
+
+  file.resize(size_t(stream.tellg()));
+  stream.seekg(0);
+  if (!stream.read(file.data(), file.size()))
+    return false;
+
+  if (file.size() < sizeof(traceMagic)
+      || std::memcmp(file.data(), traceMagic, sizeof(traceMagic)) != 0)
+    return false;
+
+  in.pos = file.data() + sizeof(traceMagic);
+  in.end = file.data() + file.size();
+  return true;
+}
+
+ANARIObject Replay::handle(uint64_t ref) const
+{
+  if (ref == 0)
+    return device;
+  return ref - 1 < objects.size() ? objects[ref - 1] : nullptr;
+}
+
+ANARIObject Replay::readHandle()
+{
+  return handle(in.varint());
+}
+
+const char *Replay::readString()
+{
+  uint64_t ref = in.varint();
+  if (ref == 0) {
+    uint64_t length = in.varint();
+    const char *str = in.bytes(length);
+    strings.push_back(str ? std::string(str, length) : std::string());
+    return strings.back().c_str();
+  }
+  if (ref > strings.size()) {
+    in.failed = true;
+    return "";
+  }
+  return strings[ref - 1].c_str();
+}
+
+Blob Replay::readBlob()
+{
+  uint64_t ref = in.varint();
+  if (ref == 0) {
+    Blob blob;
+    blob.size = in.varint();
+    blob.data = in.bytes(blob.size);
+    blobs.push_back(blob);
+    return blob;
+  }
+  if (ref > blobs.size()) {
+    in.failed = true;
+    return Blob{nullptr, 0};
+  }
+  return blobs[ref - 1];
+}
+
+bool Replay::readContents(
+    ANARIDataType type, void *dst, uint64_t count, uint64_t stride)
+{
+  uint64_t elementSize = anari::sizeOf(type);
+  if (stride == 0)
+    stride = elementSize;
+
+  uint32_t kind = uint32_t(in.varint());
+  if (kind == CONTENTS_HANDLES) {
+    for (uint64_t i = 0; i < count; ++i) {
+      ANARIObject h = readHandle();
+      if (dst)
+        std::memcpy((char *)dst + i * stride, &h, sizeof(h));
+    }
+    return true;
+  } else if (kind == CONTENTS_BLOB) {
+    Blob blob = readBlob();
+    if (!dst || !blob.data)
+      return true;
+    uint64_t n =
+        std::min(count, blob.size / std::max(elementSize, uint64_t(1)));
+    if (stride == elementSize) {
+      std::memcpy(dst, blob.data, n * elementSize);
+    } else {
+      for (uint64_t i = 0; i < n; ++i) {
+        std::memcpy((char *)dst + i * stride,
+            blob.data + i * elementSize,
+            elementSize);
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+const void *Replay::readAppMemory(ANARIDataType type, uint64_t count)
+{
+  uint32_t kind = uint32_t(in.varint());
+  if (kind == CONTENTS_HANDLES) {
+    handleArrays.emplace_back(count);
+    std::vector<ANARIObject> &handles = handleArrays.back();
+    for (uint64_t i = 0; i < count; ++i)
+      handles[i] = readHandle();
+    return handles.data();
+  } else if (kind == CONTENTS_BLOB) {
+    Blob blob = readBlob();
+    if (!blob.data)
+      return nullptr;
+    // Zero-filled beyond the blob, should the trace hold fewer elements
+    blobArrays.emplace_back(
+        std::max(blob.size, count * anari::sizeOf(type)), char(0));
+    std::vector<char> &memory = blobArrays.back();
+    std::memcpy(memory.data(), blob.data, blob.size);
+    return memory.data();
+  }
+  return nullptr;
+}
+
+void Replay::frameDone(ANARIFrame frame)
+{
+  auto it = pendingFrames.find(frame);
+  if (it == pendingFrames.end())
+    return;
+
+  FrameTiming timing;
+  timing.traced = traceTime - it->second.traced;
+  timing.replayed =
+      std::chrono::duration<double>(Clock::now() - it->second.start).count();
+  timing.renderCall = it->second.renderCall;
+  timings.push_back(timing);
+  pendingFrames.erase(it);
+
+  if (!g_quiet) {
+    printf("frame %4zu: traced %9.3f ms, replayed %9.3f ms"
+           " (render call %7.3f ms)\n",
+        timings.size() - 1,
+        timing.traced * 1e3,
+        timing.replayed * 1e3,
+        timing.renderCall * 1e3);
+  }
+}
+
+bool Replay::execute(uint32_t opcode)
+{
+  switch (opcode) {
+  case OP_NEW_OBJECT: {
+    uint64_t ref = in.varint();
+    ANARIDataType type = ANARIDataType(in.varint());
+    const char *subtype = readString();
+    ANARIObject result = nullptr;
+    switch (type) {
+    case ANARI_LIGHT:
+      result = anariNewLight(device, subtype);
+      break;
+    case ANARI_CAMERA:
+      result = anariNewCamera(device, subtype);
+      break;
+    case ANARI_GEOMETRY:
+      result = anariNewGeometry(device, subtype);
+      break;
+    case ANARI_SPATIAL_FIELD:
+      result = anariNewSpatialField(device, subtype);
+      break;
+    case ANARI_VOLUME:
+      result = anariNewVolume(device, subtype);
+      break;
+    case ANARI_SURFACE:
+      result = anariNewSurface(device);
+      break;
+    case ANARI_MATERIAL:
+      result = anariNewMaterial(device, subtype);
+      break;
+    case ANARI_SAMPLER:
+      result = anariNewSampler(device, subtype);
+      break;
+    case ANARI_GROUP:
+      result = anariNewGroup(device);
+      break;
+    case ANARI_INSTANCE:
+      result = anariNewInstance(device, subtype);
+      break;
+    case ANARI_WORLD:
+      result = anariNewWorld(device);
+      break;
+    case ANARI_RENDERER:
+      result = anariNewRenderer(device, subtype);
+      break;
+    case ANARI_FRAME:
+      result = anariNewFrame(device);
+      break;
+    case ANARI_OBJECT: {
+      result = anariNewObject(device, readString(), subtype);
+      break;
+    }
+    default:
+      return false;
+    }
+    if (ref == 0)
+      return false;
+    if (objects.size() < ref)
+      objects.resize(ref, nullptr);
+    objects[ref - 1] = result;
+    return true;
+  }
+  case OP_NEW_ARRAY_1D:
+  case OP_NEW_ARRAY_2D:
+  case OP_NEW_ARRAY_3D: {
+    uint64_t ref = in.varint();
+    ANARIDataType type = ANARIDataType(in.varint());
+    uint64_t n[3] = {1, 1, 1};
+    int dims = int(opcode - OP_NEW_ARRAY_1D) + 1;
+    for (int i = 0; i < dims; ++i)
+      n[i] = in.varint();
+    const void *appMemory = readAppMemory(type, n[0] * n[1] * n[2]);
+    ANARIArray result = nullptr;
+    if (dims == 1) {
+      result = anariNewArray1D(device, appMemory, nullptr, nullptr, type, n[0]);
+    } else if (dims == 2) {
+      result = anariNewArray2D(
+          device, appMemory, nullptr, nullptr, type, n[0], n[1]);
+    } else {
+      result = anariNewArray3D(
+          device, appMemory, nullptr, nullptr, type, n[0], n[1], n[2]);
+    }
+    if (ref == 0)
+      return false;
+    if (objects.size() < ref)
+      objects.resize(ref, nullptr);
+    objects[ref - 1] = result;
+    arrays[result] = ArrayInfo{type, n[0] * n[1] * n[2], nullptr};
+    return true;
+  }
+  case OP_MAP_ARRAY: {
+    ANARIArray array = (ANARIArray)readHandle();
+    void *mapped = anariMapArray(device, array);
+    auto it = arrays.find(array);
+    if (it != arrays.end())
+      it->second.mapped = mapped;
+    return true;
+  }
+  case OP_UNMAP_ARRAY: {
+    ANARIArray array = (ANARIArray)readHandle();
+    auto it = arrays.find(array);
+    if (it != arrays.end()) {
+      readContents(it->second.type, it->second.mapped, it->second.count);
+      it->second.mapped = nullptr;
+    } else {
+      readContents(ANARI_UNKNOWN, nullptr, 0);
+    }
+    anariUnmapArray(device, array);
+    return true;
+  }
+  case OP_SET_PARAMETER: {
+    ANARIObject object = readHandle();
+    const char *name = readString();
+    ANARIDataType type = ANARIDataType(in.varint());
+    if (anari::isObject(type)) {
+      ANARIObject value = readHandle();
+      anariSetParameter(device, object, name, type, &value);
+    } else if (type == ANARI_STRING) {
+      anariSetParameter(device, object, name, type, readString());
+    } else {
+      const char *value = in.bytes(anari::sizeOf(type));
+      if (value)
+        anariSetParameter(device, object, name, type, value);
+    }
+    return true;
+  }
+  case OP_UNSET_PARAMETER: {
+    ANARIObject object = readHandle();
+    anariUnsetParameter(device, object, readString());
+    return true;
+  }
+  case OP_UNSET_ALL_PARAMETERS:
+    anariUnsetAllParameters(device, readHandle());
+    return true;
+  case OP_MAP_PARAMETER_ARRAY: {
+    ANARIObject object = readHandle();
+    std::string name = readString();
+    ANARIDataType type = ANARIDataType(in.varint());
+    uint64_t dims = in.varint();
+    uint64_t n[3] = {1, 1, 1};
+    for (uint64_t i = 0; i < dims && i < 3; ++i)
+      n[i] = in.varint();
+    uint64_t stride = 0;
+    void *mapped = nullptr;
+    if (dims == 1) {
+      mapped = anariMapParameterArray1D(
+          device, object, name.c_str(), type, n[0], &stride);
+    } else if (dims == 2) {
+      mapped = anariMapParameterArray2D(
+          device, object, name.c_str(), type, n[0], n[1], &stride);
+    } else if (dims == 3) {
+      mapped = anariMapParameterArray3D(
+          device, object, name.c_str(), type, n[0], n[1], n[2], &stride);
+    } else {
+      return false;
+    }
+    parameterMappings[std::make_pair(object, name)] =
+        ParameterMapping{type, n[0] * n[1] * n[2], stride, mapped};
+    return true;
+  }
+  case OP_UNMAP_PARAMETER_ARRAY: {
+    ANARIObject object = readHandle();
+    std::string name = readString();
+    auto it = parameterMappings.find(std::make_pair(object, name));
+    if (it != parameterMappings.end()) {
+      const ParameterMapping &m = it->second;
+      readContents(m.type, m.mapped, m.count, m.stride);
+      parameterMappings.erase(it);
+    } else {
+      readContents(ANARI_UNKNOWN, nullptr, 0);
+    }
+    anariUnmapParameterArray(device, object, name.c_str());
+    return true;
+  }
+  case OP_COMMIT_PARAMETERS:
+    anariCommitParameters(device, readHandle());
+    return true;
+  case OP_RELEASE:
+    anariRelease(device, readHandle());
+    return true;
+  case OP_RETAIN:
+    anariRetain(device, readHandle());
+    return true;
+  case OP_GET_PROPERTY: {
+    ANARIObject object = readHandle();
+    const char *name = readString();
+    ANARIDataType type = ANARIDataType(in.varint());
+    uint64_t size = in.varint();
+    ANARIWaitMask mask = ANARIWaitMask(in.varint());
+    std::vector<char> mem(size_t(std::max(size, uint64_t(1))));
+    anariGetProperty(device, object, name, type, mem.data(), size, mask);
+    return true;
+  }
+  case OP_MAP_FRAME: {
+    ANARIFrame frame = (ANARIFrame)readHandle();
+    const char *channel = readString();
+    uint32_t width = 0, height = 0;
+    ANARIDataType type = ANARI_UNKNOWN;
+    // mapping waits for the frame to complete
+    anariMapFrame(device, frame, channel, &width, &height, &type);
+    frameDone(frame);
+    return true;
+  }
+  case OP_UNMAP_FRAME: {
+    ANARIFrame frame = (ANARIFrame)readHandle();
+    anariUnmapFrame(device, frame, readString());
+    return true;
+  }
+  case OP_RENDER_FRAME: {
+    ANARIFrame frame = (ANARIFrame)readHandle();
+    Clock::time_point start = Clock::now();
+    anariRenderFrame(device, frame);
+    double renderCall =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    PendingFrame pending = {traceTime, start, renderCall};
+    pendingFrames[frame] = pending;
+    return true;
+  }
+  case OP_FRAME_READY: {
+    ANARIFrame frame = (ANARIFrame)readHandle();
+    ANARIWaitMask mask = ANARIWaitMask(in.varint());
+    if (anariFrameReady(device, frame, mask))
+      frameDone(frame);
+    return true;
+  }
+  case OP_DISCARD_FRAME: {
+    ANARIFrame frame = (ANARIFrame)readHandle();
+    anariDiscardFrame(device, frame);
+    pendingFrames.erase(frame);
+    return true;
+  }
+  default:
+    return false;
+  }
+}
+
+bool Replay::run()
+{
+  library = anariLoadLibrary(g_libraryName.c_str(), statusFunc);
+  if (!library) {
+    fprintf(stderr, "failed to load library '%s'\n", g_libraryName.c_str());
+    return false;
+  }
+
+  device = anariNewDevice(library, g_deviceName.c_str());
+  if (!device) {
+    fprintf(stderr, "failed to create device '%s'\n", g_deviceName.c_str());
+    anariUnloadLibrary(library);
+    return false;
+  }
+  anariCommitParameters(device, device);
+
+  Clock::time_point start = Clock::now();
+  bool ok = true;
+  while (!in.atEnd()) {
+    uint32_t opcode = uint32_t(in.varint());
+    traceTime += in.varint() * 1e-9;
+    if (in.failed)
+      break;
+
+    if (!g_maxSpeed) {
+      std::this_thread::sleep_until(start
+          + std::chrono::duration_cast<Clock::duration>(
+              std::chrono::duration<double>(traceTime)));
+    }
+
+    if (!execute(opcode) || in.failed) {
+      fprintf(stderr,
+          "invalid record (opcode %u) at offset %zu\n",
+          opcode,
+          size_t(in.pos - file.data()));
+      ok = false;
+      break;
+    }
+    calls++;
+  }
+
+  if (in.failed)
+    fprintf(stderr,
+        "trace is truncated, stopped after %zu calls\n",
+        size_t(calls));
+
+  replayDuration = std::chrono::duration<double>(Clock::now() - start).count();
+
+  anariRelease(device, device);
+  anariUnloadLibrary(library);
+  return ok;
+}
+
+void Replay::printTimings() const
+{
+  printf("replayed %zu calls in %.3f s, trace took %.3f s\n",
+      size_t(calls),
+      replayDuration,
+      traceTime);
+
+  if (timings.empty())
+    return;
+
+  std::vector<double> traced, replayed;
+  for (const FrameTiming &t : timings) {
+    traced.push_back(t.traced);
+    replayed.push_back(t.replayed);
+  }
+  std::sort(traced.begin(), traced.end());
+  std::sort(replayed.begin(), replayed.end());
+
+  auto print = [](const char *name, const std::vector<double> &v) {
+    double sum = 0.0;
+    for (double x : v)
+      sum += x;
+    printf("%-9s frame time (ms): mean %.3f, min %.3f, p50 %.3f,"
+           " p90 %.3f, max %.3f\n",
+        name,
+        sum / v.size() * 1e3,
+        v.front() * 1e3,
+        v[v.size() / 2] * 1e3,
+        v[std::min(v.size() - 1, v.size() * 9 / 10)] * 1e3,
+        v.back() * 1e3);
+  };
+
+  printf("%zu frames\n", timings.size());
+  print("traced", traced);
+  print("replayed", replayed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void printUsage()
+{
+  std::cout << "./anariReplay [{--help|-h}]\n"
+            << "   [{--library|-l} <ANARI library>]\n"
+            << "   [{--device|-d} <device subtype>]\n"
+            << "   [{--max-speed|-x}]\n"
+            << "   [{--quiet|-q}]\n"
+            << "   [{--verbose|-v}]\n"
+            << "   <trace.bin>\n";
+}
+
+static void parseCommandLine(int argc, char *argv[])
+{
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      printUsage();
+      std::exit(0);
+    } else if ((arg == "-l" || arg == "--library") && i + 1 < argc)
+      g_libraryName = argv[++i];
+    else if ((arg == "-d" || arg == "--device") && i + 1 < argc)
+      g_deviceName = argv[++i];
+    else if (arg == "-x" || arg == "--max-speed")
+      g_maxSpeed = true;
+    else if (arg == "-q" || arg == "--quiet")
+      g_quiet = true;
+    else if (arg == "-v" || arg == "--verbose")
+      g_verbose = true;
+    else
+      g_traceFile = arg;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  if (const char *library = getenv("ANARI_LIBRARY"))
+    g_libraryName = library;
+
+  parseCommandLine(argc, argv);
+
+  if (g_traceFile.empty()) {
+    printUsage();
+    return 1;
+  }
+
+  Replay replay;
+  if (!replay.load(g_traceFile)) {
+    fprintf(stderr, "cannot read trace file: %s\n", g_traceFile.c_str());
+    return 1;
+  }
+
+  bool ok = replay.run();
+  replay.printTimings();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,247 @@
+// Copyright 2023-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Capture.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <numeric>
+#include "common.h"
+
+namespace remote {
+
+static const char captureMagic[8] = {'A', 'N', 'R', 'I', 'C', 'A', 'P', '1'};
+
+// ==================================================================
+// ProtocolStats
+// ==================================================================
+
+void ProtocolStats::add(CaptureRecord::Direction direction,
+    uint32_t type,
+    uint64_t size,
+    double seconds)
+{
+  if (firstTime < 0.0)
+    firstTime = seconds;
+  lastTime = seconds;
+
+  traffic[direction].messages++;
+  traffic[direction].bytes += size;
+
+  if (direction == CaptureRecord::ClientToServer) {
+    endRequest();
+    requestType = type;
+    requestTime = seconds;
+    replied = false;
+  } else if (requestTime >= 0.0) {
+    if (!replied)
+      latencies[requestType].values.push_back(seconds - requestTime);
+    replied = true;
+    lastReplyTime = seconds;
+  }
+}
+
+void ProtocolStats::finish()
+{
+  endRequest();
+  requestTime = -1.0;
+}
+
+void ProtocolStats::endRequest()
+{
+  // A frame is complete with the last reply before the next request
+  if (requestType == MessageType::RenderFrame && requestTime >= 0.0
+      && replied) {
+    frameRoundTrips.values.push_back(lastReplyTime - requestTime);
+  }
+}
+
+void ProtocolStats::Samples::print(std::ostream &out, const char *name) const
+{
+  if (values.empty())
+    return;
+
+  std::vector<double> sorted(values);
+  std::sort(sorted.begin(), sorted.end());
+
+  auto percentile = [&](double p) {
+    return sorted[std::min(
+        sorted.size() - 1, size_t(p * (sorted.size() - 1) + 0.5))];
+  };
+
+  double mean =
+      std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+
+  out << "  " << std::left << std::setw(18) << name << std::right
+      << std::setw(8) << sorted.size() << std::fixed << std::setprecision(3)
+      << std::setw(10) << mean * 1e3 << std::setw(10)
+      << percentile(0.5) * 1e3 << std::setw(10) << percentile(0.9) * 1e3
+      << std::setw(10) << percentile(0.99) * 1e3 << std::setw(10)
+      << sorted.back() * 1e3 << '\n';
+
+  // Power-of-two buckets in microseconds
+  std::map<int, size_t> buckets;
+  for (double v : sorted) {
+    double us = v * 1e6;
+    buckets[us < 1.0 ? 0 : int(std::log2(us)) + 1]++;
+  }
+
+  out << "    us:";
+  for (auto &b : buckets) {
+    uint64_t lo = b.first == 0 ? 0 : uint64_t(1) << (b.first - 1);
+    uint64_t hi = uint64_t(1) << b.first;
+    out << " [" << lo << "," << hi << "):" << b.second;
+  }
+  out << '\n';
+  out.unsetf(std::ios_base::floatfield);
+}
+
+void ProtocolStats::print(std::ostream &out) const
+{
+  double seconds = std::max(lastTime - std::max(firstTime, 0.0), 1e-9);
+
+  const char *names[2] = {"client -> server", "server -> client"};
+  for (int i = 0; i < 2; ++i) {
+    out << names[i] << ": " << traffic[i].messages << " messages ("
+        << prettyBytes(traffic[i].bytes) << "), "
+        << traffic[i].messages / seconds << " messages/sec, "
+        << prettyBytes(size_t(traffic[i].bytes / seconds)) << "/sec\n";
+  }
+  out << "duration: " << seconds << " sec.\n";
+
+  if (latencies.empty() && frameRoundTrips.values.empty())
+    return;
+
+  out << "latency until first reply (ms):\n";
+  out << "  " << std::left << std::setw(18) << "request" << std::right
+      << std::setw(8) << "count" << std::setw(10) << "mean" << std::setw(10)
+      << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99"
+      << std::setw(10) << "max" << '\n';
+  for (auto &l : latencies)
+    l.second.print(out, toString(l.first));
+
+  if (!frameRoundTrips.values.empty()) {
+    out << "frame round trip (ms):\n";
+    frameRoundTrips.print(out, "RenderFrame");
+  }
+}
+
+// ==================================================================
+// CaptureWriter
+// ==================================================================
+
+CaptureWriter::~CaptureWriter()
+{
+  close();
+}
+
+bool CaptureWriter::open(const std::string &fn)
+{
+  std::unique_lock<std::mutex> l(mutex);
+
+  file = fopen(fn.c_str(), "wb");
+  if (!file)
+    return false;
+
+  fwrite(captureMagic, sizeof(captureMagic), 1, file);
+  fileName = fn;
+  start = Clock::now();
+  protocolStats = ProtocolStats{};
+  return true;
+}
+
+bool CaptureWriter::close(ProtocolStats *finalStats)
+{
+  std::unique_lock<std::mutex> l(mutex);
+
+  if (!file)
+    return false;
+
+  fclose(file);
+  file = nullptr;
+  protocolStats.finish();
+  if (finalStats)
+    *finalStats = protocolStats;
+  return true;
+}
+
+bool CaptureWriter::isOpen() const
+{
+  std::unique_lock<std::mutex> l(mutex);
+  return file != nullptr;
+}
+
+void CaptureWriter::write(CaptureRecord::Direction direction,
+    uint32_t type,
+    const char *data,
+    uint64_t size)
+{
+  std::unique_lock<std::mutex> l(mutex);
+
+  if (!file)
+    return;
+
+  CaptureRecord record;
+  record.direction = direction;
+  record.type = type;
+  record.time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      Clock::now() - start)
+                    .count();
+  record.size = size;
+
+  fwrite(&record, sizeof(record), 1, file);
+  if (size > 0)
+    fwrite(data, size, 1, file);
+
+  protocolStats.add(direction, type, size, record.time * 1e-9);
+}
+
+ProtocolStats CaptureWriter::stats() const
+{
+  std::unique_lock<std::mutex> l(mutex);
+  return protocolStats;
+}
+
+// ==================================================================
+// CaptureReader
+// ==================================================================
+
+CaptureReader::~CaptureReader()
+{
+  close();
+}
+
+bool CaptureReader::open(const std::string &fileName)
+{
+  file = fopen(fileName.c_str(), "rb");
+  if (!file)
+    return false;
+
+  char magic[sizeof(captureMagic)];
+  if (fread(magic, sizeof(magic), 1, file) != 1
+      || memcmp(magic, captureMagic, sizeof(magic)) != 0) {
+    close();
+    return false;
+  }
+
+  return true;
+}
+
+void CaptureReader::close()
+{
+  if (file)
+    fclose(file);
+  file = nullptr;
+}
+
+bool CaptureReader::next(CaptureRecord &record, std::vector<char> &data)
+{
+  if (!file || fread(&record, sizeof(record), 1, file) != 1)
+    return false;
+
+  data.resize(record.size);
+  return record.size == 0 || fread(data.data(), record.size, 1, file) == 1;
+}
+
+} // namespace remote
@@ -0,0 +1,125 @@
+// Copyright 2023-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace remote {
+
+// Header of a single message in a capture file; followed by size bytes
+// of message data as it went over the wire
+struct CaptureRecord
+{
+  enum Direction : uint32_t
+  {
+    ClientToServer,
+    ServerToClient,
+  };
+
+  uint32_t direction{ClientToServer};
+  uint32_t type{0};
+  // Nanoseconds since the capture was started
+  uint64_t time{0};
+  uint64_t size{0};
+};
+
+// Message counts, throughput, latencies and frame round-trip times of a
+// message stream, as seen from one end of the connection. Each message
+// the server sends is attributed to the last message the client sent
+// before it; its latency is the time until the first of these replies.
+class ProtocolStats
+{
+ public:
+  void add(CaptureRecord::Direction direction,
+      uint32_t type,
+      uint64_t size,
+      double seconds);
+
+  // Finish pending round trips; call once after the last message
+  void finish();
+
+  void print(std::ostream &out) const;
+
+ private:
+  struct Samples
+  {
+    std::vector<double> values;
+    void print(std::ostream &out, const char *name) const;
+  };
+
+  struct Traffic
+  {
+    uint64_t messages{0};
+    uint64_t bytes{0};
+  };
+
+  void endRequest();
+
+  Traffic traffic[2];
+  double firstTime{-1.0};
+  double lastTime{0.0};
+  std::map<uint32_t, Samples> latencies;
+  Samples frameRoundTrips;
+
+  // The last request and its replies
+  uint32_t requestType{0};
+  double requestTime{-1.0};
+  double lastReplyTime{-1.0};
+  bool replied{false};
+};
+
+// Writes the message stream of a connection to a file. Thread-safe.
+class CaptureWriter
+{
+ public:
+  ~CaptureWriter();
+
+  bool open(const std::string &fileName);
+  // Returns true if this call closed the file, and then stores the final
+  // stats in finalStats, if given
+  bool close(ProtocolStats *finalStats = nullptr);
+  bool isOpen() const;
+
+  void write(CaptureRecord::Direction direction,
+      uint32_t type,
+      const char *data,
+      uint64_t size);
+
+  // A snapshot of the stats of the messages written so far
+  ProtocolStats stats() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  FILE *file{nullptr};
+  std::string fileName;
+  Clock::time_point start;
+  ProtocolStats protocolStats;
+  mutable std::mutex mutex;
+};
+
+// Reads the records written by a CaptureWriter
+class CaptureReader
+{
+ public:
+  ~CaptureReader();
+
+  bool open(const std::string &fileName);
+  void close();
+
+  // Returns false at the end of the file or if it's truncated
+  bool next(CaptureRecord &record, std::vector<char> &data);
+
+ private:
+  FILE *file{nullptr};
+};
+
+} // namespace remote
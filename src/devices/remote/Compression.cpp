@@ -49,6 +49,13 @@ static std::map<TurboJPEGOptions::PixelFormat, TJPF> MapPixelFormatTurboJPEG = {
     {TurboJPEGOptions::PixelFormat::ARGB, TJPF_ARGB},
 };
 
+static std::map<TurboJPEGOptions::Subsampling, TJSAMP>
+    MapSubsamplingTurboJPEG = {
+        {TurboJPEGOptions::Subsampling::S444, TJSAMP_444},
+        {TurboJPEGOptions::Subsampling::S422, TJSAMP_422},
+        {TurboJPEGOptions::Subsampling::S420, TJSAMP_420},
+};
+
 size_t getMaxCompressedBufferSizeTurboJPEG(TurboJPEGOptions options)
 {
   return tjBufSize(options.width, options.height, TJSAMP_444);
@@ -78,7 +85,7 @@ bool compressTurboJPEG(const uint8_t *dataIN,
       pixelFormat,
       &compressedImage,
       &jpegSize,
-      TJSAMP_444,
+      MapSubsamplingTurboJPEG[options.subsampling],
       options.quality,
       TJFLAG_FASTDCT);
   if (tj_err != 0) {
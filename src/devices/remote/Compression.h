@@ -37,10 +37,19 @@ struct TurboJPEGOptions
     ARGB,
   };
 
+  // Chroma subsampling
+  enum class Subsampling
+  {
+    S444,
+    S422,
+    S420,
+  };
+
   int width;
   int height;
   PixelFormat pixelFormat;
   int quality = 80;
+  Subsampling subsampling = Subsampling::S444;
 };
 
 size_t getMaxCompressedBufferSizeTurboJPEG(TurboJPEGOptions options);
@@ -12,6 +12,7 @@
 #include "ArrayInfo.h"
 #include "Compression.h"
 #include "Frame.h"
+#include "FrameEncoding.h"
 #include "Logging.h"
 #include "ObjectDesc.h"
 #include "async/connection.h"
@@ -359,6 +360,10 @@ void Device::release(ANARIObject object)
   buf->write(makeObjectDesc(object));
   write(MessageType::Release, buf);
 
+  // Once the message is sent, the capture of this device is complete
+  if (object == this_device())
+    queue.post(std::bind(&Device::closeCapture, this));
+
   LOG(logging::Level::Info) << "Object released: " << object;
 }
 
@@ -390,6 +395,10 @@ int Device::getProperty(ANARIObject object,
     return 0;
   }
 
+  // Remote connection properties of frames are answered locally
+  if (strncmp(name, "remote.", 7) == 0 && frames.find(object) != frames.end())
+    return getFrameProperty(frames[object], name, type, mem, size);
+
   auto buf = std::make_shared<Buffer>();
   buf->write(makeObjectDesc(object));
   buf->write(std::string(name));
@@ -422,6 +431,50 @@ int Device::getProperty(ANARIObject object,
   return result;
 }
 
+int Device::getFrameProperty(const Frame &frm,
+    const char *name,
+    ANARIDataType type,
+    void *mem,
+    uint64_t size)
+{
+  const FrameEncoding &enc = frm.colorEncoding;
+  std::string prop(name);
+
+  if (prop == "remote.codec" && type == ANARI_STRING) {
+    writeToVoidP(mem, toString((FrameEncoding::Codec)enc.codec));
+    return 1;
+  } else if (prop == "remote.quality" && type == ANARI_INT32
+      && size >= sizeof(int32_t)) {
+    writeToVoidP(mem, enc.quality);
+    return 1;
+  } else if (prop == "remote.subsampling" && type == ANARI_STRING) {
+    writeToVoidP(
+        mem, toString((TurboJPEGOptions::Subsampling)enc.subsampling));
+    return 1;
+  } else if (prop == "remote.downscale" && type == ANARI_UINT32
+      && size >= sizeof(uint32_t)) {
+    writeToVoidP(mem, enc.downscale);
+    return 1;
+  } else if (prop == "remote.interactive" && type == ANARI_BOOL
+      && size >= sizeof(int32_t)) {
+    writeToVoidP(mem, int32_t(enc.interactive));
+    return 1;
+  } else if (prop == "remote.bandwidth" && type == ANARI_FLOAT64
+      && size >= sizeof(double)) {
+    writeToVoidP(mem, frm.linkStats.bandwidth);
+    return 1;
+  } else if (prop == "remote.latency" && type == ANARI_FLOAT64
+      && size >= sizeof(double)) {
+    writeToVoidP(mem, frm.linkStats.latency);
+    return 1;  } else if (prop == "remote.changedTiles" && type == ANARI_UINT32
+      && size >= sizeof(uint32_t)) {
+    writeToVoidP(mem, frm.colorTiles);
+    return 1;
+  }
+
+  return 0;
+}
+
 const char **Device::getObjectSubtypes(ANARIDataType objectType)
 {
   auto it = std::find_if(objectSubtypes.begin(),
@@ -718,10 +771,37 @@ Device::Device(std::string subtype) : manager(async::make_connection_manager())
     }
   }
 
+  char *captureFile = getenv("ANARI_REMOTE_CAPTURE");
+  if (captureFile) {
+    if (capture.open(captureFile)) {
+      LOG(logging::Level::Info)
+          << "Capturing message stream to: " << captureFile;
+    } else {
+      LOG(logging::Level::Warning)
+          << "Cannot open capture file: " << captureFile;
+    }
+  }
+
   remoteSubtype = subtype;
 }
 
-Device::~Device() {}
+Device::~Device()
+{
+  closeCapture();
+}
+
+void Device::closeCapture()
+{
+  // Both the queue (on release) and the destructor get here; only the call
+  // that actually closes the file reports
+  ProtocolStats stats;
+  if (!capture.close(&stats))
+    return;
+
+  std::stringstream out;
+  stats.print(out);
+  LOG(logging::Level::Stats) << "Captured message stream:\n" << out.str();
+}
 
 ANARIObject Device::registerNewObject(ANARIDataType type, std::string subtype)
 {
@@ -895,6 +975,11 @@ void Device::handleMessage(async::connection::reason reason,
   }
 
   if (reason == async::connection::Read) {
+    capture.write(CaptureRecord::ServerToClient,
+        message->type(),
+        message->data(),
+        message->size());
+
     if (message->type() == MessageType::DeviceHandle) {
       std::unique_lock l(sync[SyncPoints::DeviceHandleRemote].mtx);
 
@@ -1091,6 +1176,30 @@ void Device::handleMessage(async::connection::reason reason,
 
       Frame &frm = frames[hnd];
 
+      // Tiles that changed since the last image; if there's no
+      // mask, the full image was sent
+      TileMask mask;
+      mask.resize(width, height);
+
+      uint32_t maskSize = *(uint32_t *)(message->data() + off);
+      off += sizeof(maskSize);
+
+      bool delta = maskSize != 0;
+      if (delta) {
+        if (maskSize != mask.bits.size()) {
+          LOG(logging::Level::Error) << "Tile mask size mismatch";
+          return;
+        }
+        memcpy(mask.bits.data(), message->data() + off, maskSize);
+        off += maskSize;
+      }
+
+      size_t pixelSize = anari::sizeOf(type);
+      uint32_t numTiles = delta ? mask.count() : mask.numTiles();
+      std::vector<uint8_t> strip;
+      if (delta)
+        strip.resize(size_t(numTiles) * tileSize * tileSize * pixelSize);
+
       timing.beforeFrameDecoded = getCurrentTime();
 
       double t = timing.beforeFrameDecoded - timing.beforeRenderFrame;
@@ -1119,29 +1228,57 @@ void Device::handleMessage(async::connection::reason reason,
                 << "Performance: neither client nor server support TurboJPEG compression for colors";
         }
 
-        if (compressionTurboJPEG
-            && type == ANARI_UFIXED8_RGBA_SRGB) { // TODO: more formats..
-          uint32_t jpegSize = *(uint32_t *)(message->data() + off);
-          off += sizeof(jpegSize);
-
-          TurboJPEGOptions options;
-          options.width = width;
-          options.height = height;
-          options.pixelFormat = TurboJPEGOptions::PixelFormat::RGBX;
-
-          if (uncompressTurboJPEG((const uint8_t *)message->data() + off,
-                  frm.color.data(),
-                  jpegSize,
-                  options)) {
-            LOG(logging::Level::Stats)
-                << "TurboJPEG: raw " << prettyBytes(frm.color.size())
-                << ", compressed: " << prettyBytes(jpegSize)
-                << ", rate: " << double(frm.color.size()) / jpegSize;
+        unpackFrameEncoding(
+            (const uint8_t *)message->data() + off, frm.colorEncoding);
+        off += frameEncodingWireSize;
+
+        memcpy(&frm.linkStats, message->data() + off, sizeof(LinkStats));
+        off += sizeof(LinkStats);
+
+        uint32_t payloadSize = *(uint32_t *)(message->data() + off);
+        off += sizeof(payloadSize);
+
+        bool ok = true;
+        if (!delta) {
+          ok = decodeColor((const uint8_t *)message->data() + off,
+              payloadSize,
+              frm.colorEncoding,
+              width,
+              height,
+              type,
+              frm.color.data());
+        } else if (numTiles > 0) {
+          ok = decodeColor((const uint8_t *)message->data() + off,
+              payloadSize,
+              frm.colorEncoding,
+              tileSize,
+              tileSize * numTiles,
+              type,
+              strip.data());
+          if (ok) {
+            scatterTiles(
+                strip.data(), width, height, pixelSize, mask, frm.color.data());
           }
+        }
+
+        if (ok) {
+          frm.colorTiles = numTiles;
+          LOG(logging::Level::Stats)
+              << toString((FrameEncoding::Codec)frm.colorEncoding.codec)
+              << ": raw " << prettyBytes(frm.color.size())
+              << ", encoded: " << prettyBytes(payloadSize)
+              << ", rate: " << double(frm.color.size()) / payloadSize
+              << ", downscale: " << frm.colorEncoding.downscale
+              << ", tiles: " << numTiles << "/" << mask.numTiles();
         } else {
-          size_t numBytes = width * height * anari::sizeOf(type);
-          memcpy(frm.color.data(), message->data() + off, numBytes);
+          LOG(logging::Level::Warning) << "Failed to decode color channel";
         }
+
+        // Let the server know when the frame arrived
+        auto buf = std::make_shared<Buffer>();
+        buf->write(ObjectDesc(remoteDevice, hnd));
+        buf->write(frm.colorEncoding.frameSeq);
+        write(MessageType::FrameAck, buf);
       } else {
         frm.resizeDepth(width, height, type);
 
@@ -1159,25 +1296,33 @@ void Device::handleMessage(async::connection::reason reason,
                 << "Performance: neither client nor server support SNAPPY compression for depths";
         }
 
+        uint8_t *dst = delta ? strip.data() : frm.depth.data();
+        size_t numBytes = delta ? strip.size() : frm.depth.size();
+
         if (compressionSNAPPY && type == ANARI_FLOAT32) {
           uint32_t snappySize = *(uint32_t *)(message->data() + off);
           off += sizeof(snappySize);
 
-          if (uncompressSNAPPY((const uint8_t *)message->data() + off,
-                  frm.depth.data(),
-                  snappySize,
-                  SNAPPYOptions{})) {
+          if (numBytes == 0) {
+            // No tiles changed
+          } else if (uncompressSNAPPY((const uint8_t *)message->data() + off,
+                         dst,
+                         snappySize,
+                         SNAPPYOptions{})) {
             LOG(logging::Level::Stats)
-                << "SNAPPY: raw " << prettyBytes(frm.depth.size())
+                << "SNAPPY: raw " << prettyBytes(numBytes)
                 << ", compressed: " << prettyBytes(snappySize)
-                << ", rate: " << double(frm.depth.size()) / snappySize;
+                << ", rate: " << double(numBytes) / snappySize
+                << ", tiles: " << numTiles << "/" << mask.numTiles();
           } else {
             LOG(logging::Level::Warning) << "snappy::RawUncompress failed";
           }
         } else {
-          size_t numBytes = width * height * anari::sizeOf(type);
-          memcpy(frm.depth.data(), message->data() + off, numBytes);
+          memcpy(dst, message->data() + off, numBytes);
         }
+
+        if (delta)
+          scatterTiles(dst, width, height, pixelSize, mask, frm.depth.data());
       }
 
       timing.afterFrameDecoded = getCurrentTime();
@@ -1197,7 +1342,10 @@ void Device::handleMessage(async::connection::reason reason,
 
 void Device::writeImpl(unsigned type, std::shared_ptr<Buffer> buf)
 {
-  conn->write(type, *buf);
+  capture.write(CaptureRecord::ClientToServer, type, buf->data(), buf->size());
+
+  // The buffer isn't used after this, hand it over without a copy
+  conn->write(async::make_message(type, std::move(*buf)));
 }
 
 void Device::writeImpl2(unsigned type, const void *begin, const void *end)
@@ -9,6 +9,7 @@
 #include <mutex>
 #include <vector>
 #include "Buffer.h"
+#include "Capture.h"
 #include "Compression.h"
 #include "Frame.h"
 #include "ParameterList.h"
@@ -167,6 +168,7 @@ struct Device : anari::DeviceImpl, helium::ParameterizedObject
 
  private:
   void initClient();
+  void closeCapture();
   uint64_t nextObjectID = 1;
 
   struct
@@ -176,6 +178,10 @@ struct Device : anari::DeviceImpl, helium::ParameterizedObject
     CompressionFeatures compression;
   } server;
 
+  // Message stream written to ANARI_REMOTE_CAPTURE, if set. Declared before
+  // the queue so it outlives a closeCapture() still pending on it.
+  CaptureWriter capture;
+
   async::connection_manager_pointer manager;
   async::connection_pointer conn;
   async::work_queue queue;
@@ -314,6 +320,12 @@ struct Device : anari::DeviceImpl, helium::ParameterizedObject
 
   ObjectDesc makeObjectDesc(ANARIObject object) const;
 
+  int getFrameProperty(const Frame &frm,
+      const char *name,
+      ANARIDataType type,
+      void *mem,
+      uint64_t size);
+
   //--- Net ---------------------------------------------
   void connect(std::string host, unsigned short port);
 
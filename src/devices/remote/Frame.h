@@ -5,6 +5,8 @@
 
 #include <anari/anari_cpp.hpp>
 #include <vector>
+#include "FrameEncoding.h"
+#include "TileDiff.h"
 
 namespace remote {
 
@@ -30,6 +32,13 @@ struct Frame
 
   std::vector<uint8_t> color;
   std::vector<uint8_t> depth;
+
+  // How the server encoded the last color image, and
+  // the link stats it measured at the time
+  FrameEncoding colorEncoding;
+  LinkStats linkStats;
+  // Number of color tiles transmitted with the last image
+  uint32_t colorTiles{0};
 };
 
 } // namespace remote
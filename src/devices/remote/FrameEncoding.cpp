@@ -0,0 +1,430 @@
+// Copyright 2023-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "FrameEncoding.h"
+#include <anari/anari_cpp.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace remote {
+
+void packFrameEncoding(const FrameEncoding &enc, uint8_t *out)
+{
+  auto put = [&out](const auto &field) {
+    std::memcpy(out, &field, sizeof(field));
+    out += sizeof(field);
+  };
+  put(enc.codec);
+  put(enc.quality);
+  put(enc.subsampling);
+  put(enc.downscale);
+  put(enc.interactive);
+  put(enc.frameSeq);
+}
+
+void unpackFrameEncoding(const uint8_t *in, FrameEncoding &enc)
+{
+  auto get = [&in](auto &field) {
+    std::memcpy(&field, in, sizeof(field));
+    in += sizeof(field);
+  };
+  get(enc.codec);
+  get(enc.quality);
+  get(enc.subsampling);
+  get(enc.downscale);
+  get(enc.interactive);
+  get(enc.frameSeq);
+}
+
+bool sameQuality(const FrameEncoding &a, const FrameEncoding &b)
+{
+  return a.codec == b.codec && a.quality == b.quality
+      && a.subsampling == b.subsampling && a.downscale == b.downscale;
+}
+
+const char *toString(FrameEncoding::Codec codec)
+{
+  switch (codec) {
+  case FrameEncoding::Raw:
+    return "raw";
+  case FrameEncoding::TurboJPEG:
+    return "jpeg";
+  case FrameEncoding::SNAPPY:
+    return "snappy";
+  default:
+    return "unknown";
+  }
+}
+
+const char *toString(TurboJPEGOptions::Subsampling subsampling)
+{
+  switch (subsampling) {
+  case TurboJPEGOptions::Subsampling::S444:
+    return "444";
+  case TurboJPEGOptions::Subsampling::S422:
+    return "422";
+  case TurboJPEGOptions::Subsampling::S420:
+    return "420";
+  default:
+    return "unknown";
+  }
+}
+
+// ==================================================================
+// Downscaling
+// ==================================================================
+
+static bool isRGBA8(ANARIDataType type)
+{
+  return type == ANARI_UFIXED8_VEC4 || type == ANARI_UFIXED8_RGBA_SRGB;
+}
+
+static bool canDownscale(ANARIDataType type)
+{
+  return isRGBA8(type) || type == ANARI_FLOAT32_VEC4;
+}
+
+static uint32_t scaledSize(uint32_t size, uint32_t factor)
+{
+  return (size + factor - 1) / factor;
+}
+
+// Box filter, each output pixel averages the factor x factor
+// input pixels it covers (fewer at the right and bottom border)
+template <typename T, typename Accum>
+static void downscaleImpl(const T *in,
+    uint32_t width,
+    uint32_t height,
+    uint32_t factor,
+    T *out)
+{
+  uint32_t outWidth = scaledSize(width, factor);
+  uint32_t outHeight = scaledSize(height, factor);
+
+  for (uint32_t y = 0; y < outHeight; ++y) {
+    for (uint32_t x = 0; x < outWidth; ++x) {
+      Accum sum[4] = {0, 0, 0, 0};
+      uint32_t count = 0;
+      for (uint32_t yy = y * factor; yy < std::min(height, (y + 1) * factor);
+           ++yy) {
+        for (uint32_t xx = x * factor; xx < std::min(width, (x + 1) * factor);
+             ++xx) {
+          const T *p = in + (size_t(yy) * width + xx) * 4;
+          for (int c = 0; c < 4; ++c)
+            sum[c] += p[c];
+          count++;
+        }
+      }
+      T *p = out + (size_t(y) * outWidth + x) * 4;
+      for (int c = 0; c < 4; ++c)
+        p[c] = T(sum[c] / count);
+    }
+  }
+}
+
+static void downscale(const uint8_t *in,
+    uint32_t width,
+    uint32_t height,
+    ANARIDataType type,
+    uint32_t factor,
+    std::vector<uint8_t> &out)
+{
+  out.resize(size_t(scaledSize(width, factor)) * scaledSize(height, factor)
+      * anari::sizeOf(type));
+
+  if (isRGBA8(type)) {
+    downscaleImpl<uint8_t, uint32_t>(in, width, height, factor, out.data());
+  } else {
+    downscaleImpl<float, float>((const float *)in,
+        width,
+        height,
+        factor,
+        (float *)out.data());
+  }
+}
+
+// Nearest-neighbor, works for any pixel type
+static void upscale(const uint8_t *in,
+    uint32_t width,
+    uint32_t height,
+    size_t pixelSize,
+    uint32_t factor,
+    uint8_t *out)
+{
+  uint32_t inWidth = scaledSize(width, factor);
+
+  for (uint32_t y = 0; y < height; ++y) {
+    const uint8_t *row = in + size_t(y / factor) * inWidth * pixelSize;
+    for (uint32_t x = 0; x < width; ++x) {
+      memcpy(out + (size_t(y) * width + x) * pixelSize,
+          row + size_t(x / factor) * pixelSize,
+          pixelSize);
+    }
+  }
+}
+
+// ==================================================================
+// Encode/decode
+// ==================================================================
+
+bool encodeColor(const uint8_t *color,
+    uint32_t width,
+    uint32_t height,
+    ANARIDataType type,
+    FrameEncoding &enc,
+    std::vector<uint8_t> &out)
+{
+  const uint8_t *src = color;
+  uint32_t encodedWidth = width;
+  uint32_t encodedHeight = height;
+
+  std::vector<uint8_t> scaled;
+  if (enc.downscale > 1 && canDownscale(type)) {
+    downscale(color, width, height, type, enc.downscale, scaled);
+    src = scaled.data();
+    encodedWidth = scaledSize(width, enc.downscale);
+    encodedHeight = scaledSize(height, enc.downscale);
+  } else {
+    enc.downscale = 1;
+  }
+
+  size_t numBytes = size_t(encodedWidth) * encodedHeight * anari::sizeOf(type);
+
+  if (enc.codec == FrameEncoding::TurboJPEG && isRGBA8(type)) {
+    TurboJPEGOptions options;
+    options.width = encodedWidth;
+    options.height = encodedHeight;
+    options.pixelFormat = TurboJPEGOptions::PixelFormat::RGBX;
+    options.quality = enc.quality;
+    options.subsampling = (TurboJPEGOptions::Subsampling)enc.subsampling;
+
+    out.resize(getMaxCompressedBufferSizeTurboJPEG(options));
+
+    size_t compressedSize = 0;
+    if (!out.empty()
+        && compressTurboJPEG(src, out.data(), compressedSize, options)) {
+      out.resize(compressedSize);
+      return true;
+    }
+  } else if (enc.codec == FrameEncoding::SNAPPY) {
+    SNAPPYOptions options;
+    options.inputSize = numBytes;
+
+    out.resize(getMaxCompressedBufferSizeSNAPPY(options));
+
+    size_t compressedSize = 0;
+    if (!out.empty()
+        && compressSNAPPY(src, out.data(), compressedSize, options)) {
+      out.resize(compressedSize);
+      return true;
+    }
+  }
+
+  // Codec not applicable to this pixel type (or not available)
+  enc.codec = FrameEncoding::Raw;
+  out.assign(src, src + numBytes);
+  return true;
+}
+
+bool decodeColor(const uint8_t *payload,
+    size_t payloadSize,
+    const FrameEncoding &enc,
+    uint32_t width,
+    uint32_t height,
+    ANARIDataType type,
+    uint8_t *color)
+{
+  uint32_t factor = std::max(1u, enc.downscale);
+  uint32_t encodedWidth = scaledSize(width, factor);
+  uint32_t encodedHeight = scaledSize(height, factor);
+  size_t pixelSize = anari::sizeOf(type);
+  size_t numBytes = size_t(encodedWidth) * encodedHeight * pixelSize;
+
+  std::vector<uint8_t> scaled;
+  uint8_t *dst = color;
+  if (factor > 1) {
+    scaled.resize(numBytes);
+    dst = scaled.data();
+  }
+
+  bool ok = false;
+  if (enc.codec == FrameEncoding::TurboJPEG) {
+    TurboJPEGOptions options;
+    options.width = encodedWidth;
+    options.height = encodedHeight;
+    options.pixelFormat = TurboJPEGOptions::PixelFormat::RGBX;
+    ok = uncompressTurboJPEG(payload, dst, payloadSize, options);
+  } else if (enc.codec == FrameEncoding::SNAPPY) {
+    ok = uncompressSNAPPY(payload, dst, payloadSize, SNAPPYOptions{});
+  } else if (payloadSize == numBytes) {
+    memcpy(dst, payload, numBytes);
+    ok = true;
+  }
+
+  if (ok && factor > 1)
+    upscale(dst, width, height, pixelSize, factor, color);
+
+  return ok;
+}
+
+// ==================================================================
+// AdaptiveEncoder
+// ==================================================================
+
+namespace {
+
+struct Level
+{
+  int quality;
+  TurboJPEGOptions::Subsampling subsampling;
+  uint32_t downscale;
+};
+
+using Sub = TurboJPEGOptions::Subsampling;
+
+// Ordered from best quality to smallest frames
+const Level jpegLevels[] = {
+    {90, Sub::S444, 1},
+    {80, Sub::S444, 1},
+    {70, Sub::S422, 1},
+    {60, Sub::S420, 1},
+    {50, Sub::S420, 1},
+    {40, Sub::S420, 2},
+    {30, Sub::S420, 2},
+    {30, Sub::S420, 4},
+};
+
+const Level losslessLevels[] = {
+    {100, Sub::S444, 1},
+    {100, Sub::S444, 2},
+    {100, Sub::S444, 4},
+};
+
+// Only sizable writes that took measurable time tell us
+// something about the link (and not just the socket buffer)
+constexpr size_t minBytesForBandwidthSample = 64 * 1024;
+constexpr double minSecondsForBandwidthSample = 1e-4;
+constexpr size_t maxFramesInFlight = 64;
+
+inline double smooth(double value, double sample)
+{
+  return value == 0.0 ? sample : 0.75 * value + 0.25 * sample;
+}
+
+} // namespace
+
+FrameEncoding AdaptiveEncoder::nextEncoding(
+    bool interactive, CompressionFeatures available)
+{
+  FrameEncoding enc;
+  enc.frameSeq = nextFrameSeq++;
+  enc.interactive = interactive;
+
+  if (!adaptive) {
+    // Fixed mode, behaves like the remote device always did
+    enc.codec =
+        available.hasTurboJPEG ? FrameEncoding::TurboJPEG : FrameEncoding::Raw;
+    return enc;
+  }
+
+  if (!interactive) {
+    // Idle: send lossless, full-resolution refinement
+    enc.codec =
+        available.hasSNAPPY ? FrameEncoding::SNAPPY : FrameEncoding::Raw;
+    return enc;
+  }
+
+  const Level *levels = available.hasTurboJPEG ? jpegLevels : losslessLevels;
+  int numLevels = available.hasTurboJPEG
+      ? int(sizeof(jpegLevels) / sizeof(Level))
+      : int(sizeof(losslessLevels) / sizeof(Level));
+
+  // Start out like the fixed mode (JPEG at quality 80, or lossless)
+  if (level < 0)
+    level = available.hasTurboJPEG ? 1 : 0;
+
+  if (stats.bandwidth > 0.0 && lastBytes > 0 && targetFrameRate > 0.f) {
+    double frameTime = 1.0 / targetFrameRate;
+    double budget = stats.bandwidth * frameTime;
+    bool tooSlow = lastBytes > budget || stats.latency > 2.0 * frameTime;
+    bool headroom = lastBytes < 0.5 * budget && stats.latency < frameTime;
+    if (tooSlow)
+      level++;
+    else if (headroom)
+      level--;
+  }
+
+  level = std::max(0, std::min(level, numLevels - 1));
+
+  if (available.hasTurboJPEG)
+    enc.codec = FrameEncoding::TurboJPEG;
+  else
+    enc.codec =
+        available.hasSNAPPY ? FrameEncoding::SNAPPY : FrameEncoding::Raw;
+  enc.quality = levels[level].quality;
+  enc.subsampling = (uint32_t)levels[level].subsampling;
+  enc.downscale = levels[level].downscale;
+
+  return enc;
+}
+
+void AdaptiveEncoder::frameEncoded(const FrameEncoding &enc, size_t numBytes)
+{
+  auto now = Clock::now();
+
+  // Idle frames don't tell how big interactive frames will be
+  if (enc.interactive)
+    lastBytes = numBytes;
+
+  pendingWrites.push_back(now);
+
+  inFlight.push_back({enc.frameSeq, now});
+  // Don't grow unbounded when the client never acknowledges
+  if (inFlight.size() > maxFramesInFlight)
+    inFlight.pop_front();
+}
+
+void AdaptiveEncoder::messageWritten(size_t numBytes)
+{
+  if (pendingWrites.empty())
+    return;
+
+  auto now = Clock::now();
+  auto enqueued = pendingWrites.front();
+  pendingWrites.pop_front();
+
+  // Writes are FIFO; the link was busy with this message
+  // since it was enqueued or the previous one completed
+  auto start = std::max(enqueued, lastWriteDone);
+  lastWriteDone = now;
+
+  double seconds = std::chrono::duration<double>(now - start).count();
+  if (numBytes < minBytesForBandwidthSample
+      || seconds < minSecondsForBandwidthSample)
+    return;
+
+  stats.bandwidth = smooth(stats.bandwidth, numBytes / seconds);
+}
+
+void AdaptiveEncoder::frameAcknowledged(uint64_t frameSeq)
+{
+  while (!inFlight.empty() && inFlight.front().frameSeq < frameSeq)
+    inFlight.pop_front();
+
+  if (inFlight.empty() || inFlight.front().frameSeq != frameSeq)
+    return;
+
+  double seconds = std::chrono::duration<double>(
+      Clock::now() - inFlight.front().sent)
+                       .count();
+  inFlight.pop_front();
+
+  stats.latency = smooth(stats.latency, seconds);
+}
+
+LinkStats AdaptiveEncoder::linkStats() const
+{
+  return stats;
+}
+
+} // namespace remote
@@ -0,0 +1,127 @@
+// Copyright 2023-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <anari/anari.h>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "Compression.h"
+
+namespace remote {
+
+// Describes how the server encoded a color channel; sent along
+// with each ChannelColor message so the client can decode it
+struct FrameEncoding
+{
+  enum Codec : uint32_t
+  {
+    Raw,
+    TurboJPEG,
+    SNAPPY,
+  };
+
+  uint32_t codec{Raw};
+  int32_t quality{80};
+  uint32_t subsampling{(uint32_t)TurboJPEGOptions::Subsampling::S444};
+  // Factor by which width and height were reduced before encoding
+  uint32_t downscale{1};
+  // Frame was rendered while the scene was being changed
+  uint32_t interactive{1};
+  uint64_t frameSeq{0};
+};
+
+// Link stats as measured by the server
+struct LinkStats
+{
+  // Send throughput in bytes/sec
+  double bandwidth{0.0};
+  // Time from sending a frame until the client acknowledged it, in sec.
+  double latency{0.0};
+};
+
+// Size of a FrameEncoding on the wire: its fields in declaration order,
+// without the struct's padding
+constexpr size_t frameEncodingWireSize =
+    5 * sizeof(uint32_t) + sizeof(uint64_t);
+
+// Write enc to out, which holds frameEncodingWireSize bytes
+void packFrameEncoding(const FrameEncoding &enc, uint8_t *out);
+
+// Read enc from in, as written by packFrameEncoding()
+void unpackFrameEncoding(const uint8_t *in, FrameEncoding &enc);
+
+// Whether images encoded with a and b are of the same quality
+bool sameQuality(const FrameEncoding &a, const FrameEncoding &b);
+
+const char *toString(FrameEncoding::Codec codec);
+const char *toString(TurboJPEGOptions::Subsampling subsampling);
+
+// Encode a color buffer of size width x height according to the codec,
+// quality, subsampling and downscale factor requested in enc. Falls back
+// to codecs that can handle the pixel type; enc is updated to reflect
+// what was actually done.
+bool encodeColor(const uint8_t *color,
+    uint32_t width,
+    uint32_t height,
+    ANARIDataType type,
+    FrameEncoding &enc,
+    std::vector<uint8_t> &out);
+
+// Decode a payload produced by encodeColor() into a full-sized
+// color buffer of size width x height
+bool decodeColor(const uint8_t *payload,
+    size_t payloadSize,
+    const FrameEncoding &enc,
+    uint32_t width,
+    uint32_t height,
+    ANARIDataType type,
+    uint8_t *color);
+
+// Chooses per frame how to encode the color channel so that, given the
+// measured send throughput and client-acknowledged latency, the target
+// frame rate can be held. While the scene is changing, quality, chroma
+// subsampling and resolution are traded for speed; once idle, frames are
+// sent lossless and at full resolution.
+class AdaptiveEncoder
+{
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  float targetFrameRate{30.f};
+  bool adaptive{true};
+
+  // Encoding to use for the next frame
+  FrameEncoding nextEncoding(bool interactive, CompressionFeatures available);
+
+  // A frame was encoded to numBytes and enqueued for sending
+  void frameEncoded(const FrameEncoding &enc, size_t numBytes);
+
+  // The connection finished writing a color message of numBytes
+  void messageWritten(size_t numBytes);
+
+  // The client acknowledged that it received and decoded the frame
+  void frameAcknowledged(uint64_t frameSeq);
+
+  LinkStats linkStats() const;
+
+ private:
+  struct InFlight
+  {
+    uint64_t frameSeq;
+    Clock::time_point sent;
+  };
+
+  // Index into the ladder of encodings, chosen on first use
+  int level{-1};
+  uint64_t nextFrameSeq{1};
+  size_t lastBytes{0};
+  LinkStats stats;
+  std::deque<Clock::time_point> pendingWrites;
+  std::deque<InFlight> inFlight;
+  Clock::time_point lastWriteDone;
+};
+
+} // namespace remote
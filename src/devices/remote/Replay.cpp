@@ -0,0 +1,253 @@
+// Copyright 2023-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Capture.h"
+#include "async/connection_manager.h"
+#include "common.h"
+
+// Global variables
+static std::string g_captureFile;
+static std::string g_hostname = "localhost";
+static unsigned short g_port = 31050;
+static bool g_maxSpeed = false;
+static bool g_statsOnly = false;
+static double g_timeout = 30.0;
+
+namespace remote {
+
+// Drives a server with the client messages of a capture. Before sending
+// a message, waits for as many replies as the original client had
+// received at that point, so the server sees the same request order and
+// blocking behavior as in the captured session.
+struct Replay
+{
+  using Clock = std::chrono::steady_clock;
+
+  struct Message
+  {
+    CaptureRecord record;
+    std::vector<char> data;
+  };
+
+  std::vector<Message> messages;
+  // Types of the replies expected from the server, in order
+  std::vector<uint32_t> expectedReplies;
+
+  async::connection_manager_pointer manager;
+  async::connection_pointer conn;
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  Clock::time_point start;
+  ProtocolStats stats;
+  size_t received{0};
+  size_t mismatches{0};
+  bool disconnected{false};
+
+  bool load(const std::string &fileName)
+  {
+    CaptureReader reader;
+    if (!reader.open(fileName))
+      return false;
+
+    Message msg;
+    while (reader.next(msg.record, msg.data)) {
+      if (msg.record.direction == CaptureRecord::ServerToClient)
+        expectedReplies.push_back(msg.record.type);
+      messages.push_back(msg);
+    }
+
+    return true;
+  }
+
+  void printCaptured()
+  {
+    ProtocolStats captured;
+    for (const Message &msg : messages) {
+      captured.add((CaptureRecord::Direction)msg.record.direction,
+          msg.record.type,
+          msg.record.size,
+          msg.record.time * 1e-9);
+    }
+    captured.finish();
+
+    std::cout << "=== captured: " << g_captureFile << '\n';
+    captured.print(std::cout);
+  }
+
+  double now() const
+  {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  }
+
+  void handleMessage(async::connection::reason reason,
+      async::message_pointer message,
+      std::error_code const &e)
+  {
+    std::unique_lock<std::mutex> l(mtx);
+
+    if (e) {
+      disconnected = true;
+    } else if (reason == async::connection::Read) {
+      if (received >= expectedReplies.size()
+          || expectedReplies[received] != message->type())
+        mismatches++;
+      received++;
+      stats.add(CaptureRecord::ServerToClient,
+          message->type(),
+          message->size(),
+          now());
+    }
+
+    cv.notify_all();
+  }
+
+  // Wait until n replies were received; false on timeout or disconnect
+  bool waitForReplies(size_t n)
+  {
+    std::unique_lock<std::mutex> l(mtx);
+    return cv.wait_for(l,
+               std::chrono::duration<double>(g_timeout),
+               [&]() { return received >= n || disconnected; })
+        && received >= n;
+  }
+
+  bool run()
+  {
+    manager = async::make_connection_manager();
+    conn = manager->connect(g_hostname, g_port);
+    if (!conn) {
+      std::cerr << "Cannot connect to " << g_hostname << ":" << g_port << '\n';
+      return false;
+    }
+
+    conn->set_handler(std::bind(&Replay::handleMessage,
+        this,
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3));
+    manager->run_in_thread();
+
+    start = Clock::now();
+    uint64_t firstTime = messages.empty() ? 0 : messages.front().record.time;
+
+    bool ok = true;
+    size_t repliesBefore = 0;
+    for (const Message &msg : messages) {
+      if (msg.record.direction == CaptureRecord::ServerToClient) {
+        repliesBefore++;
+        continue;
+      }
+
+      if (!waitForReplies(repliesBefore)) {
+        std::cerr << "Timeout or disconnect waiting for reply "
+                  << repliesBefore << " of " << expectedReplies.size()
+                  << '\n';
+        ok = false;
+        break;
+      }
+
+      if (!g_maxSpeed) {
+        std::this_thread::sleep_until(start
+            + std::chrono::nanoseconds(msg.record.time - firstTime));
+      }
+
+      {
+        std::unique_lock<std::mutex> l(mtx);
+        stats.add(CaptureRecord::ClientToServer,
+            msg.record.type,
+            msg.record.size,
+            now());
+      }
+      conn->write(msg.record.type, msg.data);
+    }
+
+    if (ok && !waitForReplies(expectedReplies.size())) {
+      std::cerr << "Timeout or disconnect waiting for the remaining replies\n";
+      ok = false;
+    }
+
+    manager->stop();
+    manager->wait();
+
+    std::unique_lock<std::mutex> l(mtx);
+    stats.finish();
+
+    std::cout << "=== replayed"
+              << (g_maxSpeed ? " at maximum speed" : " at original speed")
+              << ": " << g_hostname << ":" << g_port << '\n';
+    stats.print(std::cout);
+    std::cout << "replies: " << received << " of " << expectedReplies.size()
+              << " expected, " << mismatches << " of unexpected type\n";
+
+    return ok && mismatches == 0 && received == expectedReplies.size();
+  }
+};
+
+} // namespace remote
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void printUsage()
+{
+  std::cout << "./anariRemoteReplay [{--help|-h}]\n"
+            << "   [{--hostname|-n} <host>]\n"
+            << "   [{--port|-p} <N>]\n"
+            << "   [{--max-speed|-x}]\n"
+            << "   [{--stats-only|-s}]\n"
+            << "   [{--timeout|-t} <sec.>]\n"
+            << "   <capture file>\n";
+}
+
+static void parseCommandLine(int argc, char *argv[])
+{
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      printUsage();
+      std::exit(0);
+    } else if (arg == "-n" || arg == "--hostname")
+      g_hostname = argv[++i];
+    else if (arg == "-p" || arg == "--port")
+      g_port = std::stoi(argv[++i]);
+    else if (arg == "-x" || arg == "--max-speed")
+      g_maxSpeed = true;
+    else if (arg == "-s" || arg == "--stats-only")
+      g_statsOnly = true;
+    else if (arg == "-t" || arg == "--timeout")
+      g_timeout = std::stod(argv[++i]);
+    else
+      g_captureFile = arg;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  parseCommandLine(argc, argv);
+
+  if (g_captureFile.empty()) {
+    printUsage();
+    return 1;
+  }
+
+  remote::Replay replay;
+  if (!replay.load(g_captureFile)) {
+    std::cerr << "Cannot read capture file: " << g_captureFile << '\n';
+    return 1;
+  }
+
+  replay.printCaptured();
+
+  if (g_statsOnly)
+    return 0;
+
+  return replay.run() ? 0 : 1;
+}
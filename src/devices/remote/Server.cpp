@@ -2,18 +2,28 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <anari/anari_cpp.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <system_error>
+#include <thread>
 #include "ArrayInfo.h"
 #include "Buffer.h"
+#include "Capture.h"
 #include "Compression.h"
+#include "FrameEncoding.h"
 #include "Logging.h"
 #include "ObjectDesc.h"
+#include "TileDiff.h"
 #include "async/connection.h"
 #include "async/connection_manager.h"
-#include "async/work_queue.h"
 #include "common.h"
 
 using namespace std::placeholders;
@@ -23,6 +33,10 @@ static std::string g_libraryType = "environment";
 static ANARILibrary g_library = nullptr;
 static bool g_verbose = false;
 static unsigned short g_port = 31050;
+static size_t g_maxClients = 8;
+static size_t g_numThreads =
+    std::max(1u, std::thread::hardware_concurrency());
+static std::string g_captureFile;
 
 namespace remote {
 
@@ -55,6 +69,18 @@ void statusFunc(const void *userData,
   }
 }
 
+// A mask size of zero means that the full image follows
+static void writeTileMask(Buffer &buf, const TileMask *mask)
+{
+  if (!mask) {
+    buf.write(uint32_t(0));
+    return;
+  }
+
+  buf.write(uint32_t(mask->bits.size()));
+  buf.write((const char *)mask->bits.data(), mask->bits.size());
+}
+
 static ANARIObject newObject(
     ANARIDevice dev, ANARIDataType type, std::string subtype)
 {
@@ -208,61 +234,72 @@ struct ResourceManager
   std::vector<std::vector<ArrayInfo>> registeredArrays;
 };
 
-struct Server
+// One client connection with its own device instances, handle space and
+// worker strand. All messages of a session are processed (and all replies
+// are written) in order on the session's strand; different sessions are
+// processed concurrently on the server's thread pool.
+struct Session
 {
-  // For now only one client:
+  using Strand = boost::asio::strand<boost::asio::thread_pool::executor_type>;
+
   struct
   {
     CompressionFeatures compression;
   } client;
 
+  struct Stats
+  {
+    uint64_t messagesIn{0};
+    uint64_t messagesOut{0};
+    uint64_t bytesIn{0};
+    uint64_t bytesOut{0};
+    uint64_t framesRendered{0};
+    double renderTime{0.0};
+  };
+
+  uint64_t id;
   ResourceManager resourceManager;
-  async::connection_manager_pointer manager;
   async::connection_pointer conn;
-  async::work_queue queue;
-
-  explicit Server(unsigned short port = 31050)
-      : manager(async::make_connection_manager(port))
-  {
-    logging::Initialize();
-
-    g_library = anariLoadLibrary(g_libraryType.c_str(), statusFunc, &g_verbose);
-  }
-
-  ~Server()
-  {
-    anariUnloadLibrary(g_library);
-  }
-
-  void accept()
+  Strand strand;
+  Stats stats;
+  std::chrono::steady_clock::time_point startTime;
+  // Message stream of this session, if capturing
+  CaptureWriter capture;
+
+  // Color encoding state per frame object
+  std::map<Handle, AdaptiveEncoder> encoders;
+  // Images last sent per frame object, to only send the tiles that changed
+  struct SentImages
   {
-    LOG(logging::Level::Info) << "Server: accepting...";
-
-    manager->accept(std::bind(&Server::handleNewConnection,
-        this,
-        std::placeholders::_1,
-        std::placeholders::_2));
-  }
-
-  void run()
-  {
-    manager->run_in_thread();
-    queue.run_in_thread();
-  }
-
-  void wait()
-  {
-    manager->wait();
-  }
+    TileDiff color;
+    TileDiff depth;
+    FrameEncoding colorEncoding;
+    // sceneVersion when this frame was last rendered
+    uint64_t renderedVersion{0};
+  };
+  std::map<Handle, SentImages> sentImages;
+  // Bumped whenever the scene changes, so that each frame can tell if it
+  // changed since that frame was last rendered
+  uint64_t sceneVersion{1};
+
+  Session(uint64_t id,
+      async::connection_pointer conn,
+      boost::asio::thread_pool::executor_type executor)
+      : id(id),
+        conn(conn),
+        strand(executor),
+        startTime(std::chrono::steady_clock::now())
+  {}
 
   void write(unsigned type, std::shared_ptr<Buffer> buf)
   {
-    queue.post(std::bind(&Server::writeImpl, this, type, buf));
-  }
-
-  void writeImpl(unsigned type, std::shared_ptr<Buffer> buf)
-  {
-    conn->write(type, *buf);
+    // Called on the session strand; the connection manager
+    // serializes the actual socket writes
+    stats.messagesOut++;
+    stats.bytesOut += buf->size();
+    capture.write(
+        CaptureRecord::ServerToClient, type, buf->data(), buf->size());
+    conn->write(async::make_message(type, std::move(*buf)));
   }
 
   std::vector<uint8_t> translateArrayData(
@@ -291,566 +328,818 @@ struct Server
     return arrayData;
   }
 
-  bool handleNewConnection(
-      async::connection_pointer new_conn, std::error_code const &e)
+  void messageWritten(async::message_pointer message)
   {
-    if (e) {
-      LOG(logging::Level::Error)
-          << "Server: could not connect to client: " << e.message();
-      manager->stop();
-      return false;
+    if (message->type() == MessageType::ChannelColor) {
+      Handle frame = 0;
+      memcpy(&frame, message->data(), sizeof(frame));
+      encoders[frame].messageWritten(message->size());
     }
-
-    LOG(logging::Level::Info) << "server: connected";
-
-    // Accept and save this connection
-    // and set the message handler of the connection
-    conn = new_conn;
-    conn->set_handler(std::bind(&Server::handleMessage,
-        this,
-        std::placeholders::_1,
-        std::placeholders::_2,
-        std::placeholders::_3));
-
-    // Accept new connections (TODO: the new connection
-    // will overwrite the current one, so, store these
-    // in a list of connections)
-    accept();
-
-    return true;
   }
 
-  void handleMessage(async::connection::reason reason,
-      async::message_pointer message,
-      std::error_code const &e)
+  // Release all devices this client created; called once,
+  // on the strand, after the connection went away
+  void releaseDevices()
   {
-    if (e) {
-      LOG(logging::Level::Error) << "Server: error: " << e.message();
+    for (ANARIDevice dev : resourceManager.anariDevices) {
+      if (dev)
+        anariRelease(dev, dev);
+    }
+    resourceManager = ResourceManager{};
+  }
 
-      manager->stop();
-      return;
+  // captureStats are those of the session's message stream, if captured
+  void logStats(const ProtocolStats *captureStats) const
+  {
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - startTime)
+                         .count();
+    LOG(logging::Level::Stats)
+        << "Session " << id << ": " << seconds << " sec., received "
+        << stats.messagesIn << " messages (" << prettyBytes(stats.bytesIn)
+        << "), sent " << stats.messagesOut << " messages ("
+        << prettyBytes(stats.bytesOut) << "), " << stats.framesRendered
+        << " frames rendered (" << stats.renderTime << " sec.)";
+
+    if (captureStats) {
+      std::stringstream out;
+      captureStats->print(out);
+      LOG(logging::Level::Stats)
+          << "Session " << id << ", captured message stream:\n" << out.str();
     }
+  }
 
+  void handleMessage(async::message_pointer message)
+  {
     LOG(logging::Level::Info)
-        << "Message: " << toString(message->type())
+        << "Session " << id << ", message: " << toString(message->type())
         << ", message size: " << prettyBytes(message->size());
 
+    stats.messagesIn++;
+    stats.bytesIn += message->size();
+
+    capture.write(CaptureRecord::ClientToServer,
+        message->type(),
+        message->data(),
+        message->size());
+
 #define CHECK(obj, errorMessage)                                               \
   if (!obj) {                                                                  \
     LOG(logging::Level::Error) << errorMessage;                                \
     return;                                                                    \
   }
 
-    if (reason == async::connection::Read) {
-      // Buffer with all the inputs
-      auto inputBuffer =
-          std::make_shared<Buffer>(message->data(), message->size());
-
-      // Receive common object information:
-      ObjectDesc remoteObj, serverObj;
-      inputBuffer->read(remoteObj);
+    // Buffer with all the inputs
+    auto inputBuffer =
+        std::make_shared<Buffer>(message->data(), message->size());
+
+    // Receive common object information:
+    ObjectDesc remoteObj, serverObj;
+    inputBuffer->read(remoteObj);
+
+    // Translate to handles compatible with the underlying device:
+    serverObj = resourceManager.getObjectDesc(
+        (Handle)remoteObj.device, (Handle)remoteObj.object);
+    // Bring these in sync, in case the object wasn't registered yet:
+    serverObj.type = remoteObj.type;
+    serverObj.subtype = remoteObj.subtype;
+
+    if (message->type() == MessageType::NewDevice) {
+      std::string deviceType;
+      inputBuffer->read(deviceType);
+      inputBuffer->read(client.compression);
+
+      ANARIDevice dev = anariNewDevice(g_library, deviceType.c_str());
+      Handle deviceHandle = resourceManager.registerDevice(dev);
+      CompressionFeatures cf = getCompressionFeatures();
+
+      // return device handle and other info to client
+      auto outputBuffer = std::make_shared<Buffer>();
+      outputBuffer->write(deviceHandle);
+      outputBuffer->write(cf);
+      write(MessageType::DeviceHandle, outputBuffer);
+
+      LOG(logging::Level::Info)
+          << "Creating new device, type: " << deviceType
+          << ", device ID: " << deviceHandle << ", ANARI handle: " << dev;
+      LOG(logging::Level::Info)
+          << "Client has TurboJPEG: " << client.compression.hasTurboJPEG;
+      LOG(logging::Level::Info)
+          << "Client has SNAPPY: " << client.compression.hasSNAPPY;
+    } else if (message->type() == MessageType::NewObject) {
+      sceneVersion++;
+
+      CHECK(serverObj.device, "Error on anariNewObject: invalid device");
+
+      ANARIObject anariObj =
+          newObject(serverObj.device, serverObj.type, serverObj.subtype);
+
+      resourceManager.registerObject((Handle)remoteObj.device,
+          (Handle)remoteObj.object,
+          anariObj,
+          remoteObj.type);
+
+      LOG(logging::Level::Info)
+          << "Creating new object, objectID: " << remoteObj.object
+          << ", ANARI handle: " << anariObj;
+    } else if (message->type() == MessageType::NewArray) {
+      sceneVersion++;
+
+      CHECK(serverObj.device, "Error on anariNewArray: invalid device");
+
+      ArrayInfo info;
+      info.type = serverObj.type;
+
+      inputBuffer->read(info.elementType);
+      inputBuffer->read(info.numItems1);
+      inputBuffer->read(info.numItems2);
+      inputBuffer->read(info.numItems3);
+
+      std::vector<uint8_t> arrayData;
+      if (inputBuffer->pos < message->size()) {
+        arrayData = translateArrayData(*inputBuffer, remoteObj.device, info);
+      }
 
-      // Translate to handles compatible with the underlying device:
-      serverObj = resourceManager.getObjectDesc(
-          (Handle)remoteObj.device, (Handle)remoteObj.object);
-      // Bring these in sync, in case the object wasn't registered yet:
-      serverObj.type = remoteObj.type;
-      serverObj.subtype = remoteObj.subtype;
+      ANARIArray anariArr =
+          newArray(serverObj.device, info, arrayData.data());
+      resourceManager.registerArray((uint64_t)remoteObj.device,
+          (uint64_t)remoteObj.object,
+          anariArr,
+          info);
+
+      LOG(logging::Level::Info)
+          << "Creating new array, objectID: " << remoteObj.object
+          << ", ANARI handle: " << anariArr;
+    } else if (message->type() == MessageType::SetParam) {
+      CHECK(serverObj.device, "Error on anariSetParameter: invalid device");
+      CHECK(serverObj.object, "Error on anariSetParameter: invalid object");
+
+      std::string name;
+      inputBuffer->read(name);
+
+      ANARIDataType parmType;
+      inputBuffer->read(parmType);
+
+      // Frame parameters controlling the remote connection
+      // itself are not passed on to the device
+      if (name.compare(0, 7, "remote.") == 0) {
+        AdaptiveEncoder &encoder = encoders[(Handle)remoteObj.object];
+        if (name == "remote.targetFrameRate" && parmType == ANARI_FLOAT32)
+          inputBuffer->read(encoder.targetFrameRate);
+        else if (name == "remote.adaptive" && parmType == ANARI_BOOL) {
+          int32_t adaptive = 1;
+          inputBuffer->read(adaptive);
+          encoder.adaptive = adaptive;
+        } else {
+          LOG(logging::Level::Warning)
+              << "Unknown or ill-typed remote parameter: " << name;
+        }
+        return;
+      }
 
-      if (message->type() == MessageType::NewDevice) {
-        std::string deviceType;
-        inputBuffer->read(deviceType);
-        inputBuffer->read(client.compression);
+      sceneVersion++;
 
-        ANARIDevice dev = anariNewDevice(g_library, deviceType.c_str());
-        Handle deviceHandle = resourceManager.registerDevice(dev);
-        CompressionFeatures cf = getCompressionFeatures();
+      if (anari::isObject(parmType)) {
+        Handle hnd;
+        inputBuffer->read((char *)&hnd, sizeof(hnd));
 
-        // return device handle and other info to client
-        auto outputBuffer = std::make_shared<Buffer>();
-        outputBuffer->write(deviceHandle);
-        outputBuffer->write(cf);
-        write(MessageType::DeviceHandle, outputBuffer);
+        const auto &registeredObjects =
+            resourceManager.registeredObjects[(uint64_t)remoteObj.device];
+        anariSetParameter(serverObj.device,
+            serverObj.object,
+            name.c_str(),
+            parmType,
+            &registeredObjects[hnd].object);
 
         LOG(logging::Level::Info)
-            << "Creating new device, type: " << deviceType
-            << ", device ID: " << deviceHandle << ", ANARI handle: " << dev;
+            << "Set param \"" << name << "\" on object: " << remoteObj.object
+            << ", param is an object. Handle: " << hnd
+            << ", ANARI handle: " << registeredObjects[hnd].object;
+      } else if (parmType == ANARI_STRING) {
+        std::string parmValue;
+        inputBuffer->read(parmValue);
+
+        anariSetParameter(serverObj.device,
+            serverObj.object,
+            name.c_str(),
+            parmType,
+            parmValue.c_str());
+
         LOG(logging::Level::Info)
-            << "Client has TurboJPEG: " << client.compression.hasTurboJPEG;
+            << "Set param \"" << name << "\" on object: " << remoteObj.object;
+      } else {
+        std::vector<char> parmValue(anari::sizeOf(parmType));
+        inputBuffer->read((char *)parmValue.data(), anari::sizeOf(parmType));
+
+        anariSetParameter(serverObj.device,
+            serverObj.object,
+            name.c_str(),
+            parmType,
+            parmValue.data());
+
         LOG(logging::Level::Info)
-            << "Client has SNAPPY: " << client.compression.hasSNAPPY;
-      } else if (message->type() == MessageType::NewObject) {
-        CHECK(serverObj.device, "Error on anariNewObject: invalid device");
+            << "Set param \"" << name << "\" on object: " << remoteObj.object;
+      }
+    } else if (message->type() == MessageType::UnsetParam) {
+      sceneVersion++;
 
-        ANARIObject anariObj =
-            newObject(serverObj.device, serverObj.type, serverObj.subtype);
+      CHECK(serverObj.device, "Error on anariUnsetParameter: invalid device");
+      CHECK(serverObj.object, "Error on anariUnsetParameter: invalid object");
 
-        resourceManager.registerObject((Handle)remoteObj.device,
-            (Handle)remoteObj.object,
-            anariObj,
-            remoteObj.type);
+      std::string name;
+      inputBuffer->read(name);
 
-        LOG(logging::Level::Info)
-            << "Creating new object, objectID: " << remoteObj.object
-            << ", ANARI handle: " << anariObj;
-      } else if (message->type() == MessageType::NewArray) {
-        CHECK(serverObj.device, "Error on anariNewArray: invalid device");
-
-        ArrayInfo info;
-        info.type = serverObj.type;
-
-        inputBuffer->read(info.elementType);
-        inputBuffer->read(info.numItems1);
-        inputBuffer->read(info.numItems2);
-        inputBuffer->read(info.numItems3);
-
-        std::vector<uint8_t> arrayData;
-        if (inputBuffer->pos < message->size()) {
-          arrayData = translateArrayData(*inputBuffer, remoteObj.device, info);
-        }
+      anariUnsetParameter(serverObj.device, serverObj.object, name.c_str());
+    } else if (message->type() == MessageType::UnsetAllParams) {
+      sceneVersion++;
 
-        ANARIArray anariArr =
-            newArray(serverObj.device, info, arrayData.data());
-        resourceManager.registerArray((uint64_t)remoteObj.device,
-            (uint64_t)remoteObj.object,
-            anariArr,
-            info);
+      CHECK(serverObj.device,
+          "Error on anariUnsetAllParameters: invalid device");
+      CHECK(serverObj.device,
+          "Error on anariUnsetAllParameters: invalid object");
 
-        LOG(logging::Level::Info)
-            << "Creating new array, objectID: " << remoteObj.object
-            << ", ANARI handle: " << anariArr;
-      } else if (message->type() == MessageType::SetParam) {
-        CHECK(serverObj.device, "Error on anariSetParameter: invalid device");
-        CHECK(serverObj.object, "Error on anariSetParameter: invalid object");
-
-        std::string name;
-        inputBuffer->read(name);
-
-        ANARIDataType parmType;
-        inputBuffer->read(parmType);
-
-        if (anari::isObject(parmType)) {
-          Handle hnd;
-          inputBuffer->read((char *)&hnd, sizeof(hnd));
-
-          const auto &registeredObjects =
-              resourceManager.registeredObjects[(uint64_t)remoteObj.device];
-          anariSetParameter(serverObj.device,
-              serverObj.object,
-              name.c_str(),
-              parmType,
-              &registeredObjects[hnd].object);
-
-          LOG(logging::Level::Info)
-              << "Set param \"" << name << "\" on object: " << remoteObj.object
-              << ", param is an object. Handle: " << hnd
-              << ", ANARI handle: " << registeredObjects[hnd].object;
-        } else if (parmType == ANARI_STRING) {
-          std::string parmValue;
-          inputBuffer->read(parmValue);
-
-          anariSetParameter(serverObj.device,
-              serverObj.object,
-              name.c_str(),
-              parmType,
-              parmValue.c_str());
-
-          LOG(logging::Level::Info)
-              << "Set param \"" << name << "\" on object: " << remoteObj.object;
-        } else {
-          std::vector<char> parmValue(anari::sizeOf(parmType));
-          inputBuffer->read((char *)parmValue.data(), anari::sizeOf(parmType));
+      anariUnsetAllParameters(serverObj.device, serverObj.object);
+    } else if (message->type() == MessageType::CommitParams) {
+      sceneVersion++;
 
-          anariSetParameter(serverObj.device,
-              serverObj.object,
-              name.c_str(),
-              parmType,
-              parmValue.data());
+      CHECK(
+          serverObj.device, "Error on anariCommitParameters: invalid device");
+      CHECK(
+          serverObj.object, "Error on anariCommitParameters: invalid object");
 
-          LOG(logging::Level::Info)
-              << "Set param \"" << name << "\" on object: " << remoteObj.object;
-        }
-      } else if (message->type() == MessageType::UnsetParam) {
-        CHECK(serverObj.device, "Error on anariUnsetParameter: invalid device");
-        CHECK(serverObj.object, "Error on anariUnsetParameter: invalid object");
+      anariCommitParameters(serverObj.device, serverObj.object);
 
-        std::string name;
-        inputBuffer->read(name);
+      LOG(logging::Level::Info)
+          << "Committed object. Handle: " << remoteObj.object;
+    } else if (message->type() == MessageType::Release) {
+      CHECK(serverObj.device, "Error on anariRelease: invalid device");
+      CHECK(serverObj.object, "Error on anariRelease: invalid object");
 
-        anariUnsetParameter(serverObj.device, serverObj.object, name.c_str());
-      } else if (message->type() == MessageType::UnsetAllParams) {
-        CHECK(serverObj.device,
-            "Error on anariUnsetAllParameters: invalid device");
-        CHECK(serverObj.device,
-            "Error on anariUnsetAllParameters: invalid object");
+      anariRelease(serverObj.device, serverObj.object);
 
-        anariUnsetAllParameters(serverObj.device, serverObj.object);
-      } else if (message->type() == MessageType::CommitParams) {
-        CHECK(
-            serverObj.device, "Error on anariCommitParameters: invalid device");
-        CHECK(
-            serverObj.object, "Error on anariCommitParameters: invalid object");
+      sentImages.erase((Handle)remoteObj.object);
 
-        anariCommitParameters(serverObj.device, serverObj.object);
+      LOG(logging::Level::Info)
+          << "Released object. Handle: " << remoteObj.object;
+    } else if (message->type() == MessageType::Retain) {
+      CHECK(serverObj.device, "Error on anariRetain: invalid device");
+      CHECK(serverObj.object, "Error on anariRetain: invalid object");
 
-        LOG(logging::Level::Info)
-            << "Committed object. Handle: " << remoteObj.object;
-      } else if (message->type() == MessageType::Release) {
-        CHECK(serverObj.device, "Error on anariRelease: invalid device");
-        CHECK(serverObj.object, "Error on anariRelease: invalid object");
+      anariRetain(serverObj.device, serverObj.object);
 
-        anariRelease(serverObj.device, serverObj.object);
+      LOG(logging::Level::Info)
+          << "Retained object. Handle: " << remoteObj.object;
+    } else if (message->type() == MessageType::MapArray) {
+      CHECK(serverObj.device, "Error on anariMapArray: invalid device");
+      CHECK(serverObj.object, "Error on anariMapArray: invalid object");
 
-        LOG(logging::Level::Info)
-            << "Released object. Handle: " << remoteObj.object;
-      } else if (message->type() == MessageType::Retain) {
-        CHECK(serverObj.device, "Error on anariRetain: invalid device");
-        CHECK(serverObj.object, "Error on anariRetain: invalid object");
+      void *ptr =
+          anariMapArray(serverObj.device, (ANARIArray)serverObj.object);
 
-        anariRetain(serverObj.device, serverObj.object);
+      const ArrayInfo &info = resourceManager.getArrayInfo(
+          (Handle)remoteObj.device, (Handle)remoteObj.object);
 
-        LOG(logging::Level::Info)
-            << "Retained object. Handle: " << remoteObj.object;
-      } else if (message->type() == MessageType::MapArray) {
-        CHECK(serverObj.device, "Error on anariMapArray: invalid device");
-        CHECK(serverObj.object, "Error on anariMapArray: invalid object");
+      uint64_t numBytes = info.getSizeInBytes();
 
-        void *ptr =
-            anariMapArray(serverObj.device, (ANARIArray)serverObj.object);
+      auto outputBuffer = std::make_shared<Buffer>();
+      outputBuffer->write(remoteObj.object);
+      outputBuffer->write(numBytes);
+      outputBuffer->write((const char *)ptr, numBytes);
+      write(MessageType::ArrayMapped, outputBuffer);
 
-        const ArrayInfo &info = resourceManager.getArrayInfo(
-            (Handle)remoteObj.device, (Handle)remoteObj.object);
+      LOG(logging::Level::Info)
+          << "Mapped array. Handle: " << remoteObj.object;
+    } else if (message->type() == MessageType::UnmapArray) {
+      sceneVersion++;
 
-        uint64_t numBytes = info.getSizeInBytes();
+      CHECK(serverObj.device, "Error on anariUnmapArray: invalid device");
+      CHECK(serverObj.object, "Error on anariUnmapArray: invalid object");
 
-        auto outputBuffer = std::make_shared<Buffer>();
-        outputBuffer->write(remoteObj.object);
-        outputBuffer->write(numBytes);
-        outputBuffer->write((const char *)ptr, numBytes);
-        write(MessageType::ArrayMapped, outputBuffer);
+      // Array is currently mapped - unmap
+      anariUnmapArray(serverObj.device, (ANARIArray)serverObj.object);
 
-        LOG(logging::Level::Info)
-            << "Mapped array. Handle: " << remoteObj.object;
-      } else if (message->type() == MessageType::UnmapArray) {
-        CHECK(serverObj.device, "Error on anariUnmapArray: invalid device");
-        CHECK(serverObj.object, "Error on anariUnmapArray: invalid object");
-
-        // Array is currently mapped - unmap
-        anariUnmapArray(serverObj.device, (ANARIArray)serverObj.object);
-
-        // Now map so we can write to it
-        void *ptr =
-            anariMapArray(serverObj.device, (ANARIArray)serverObj.object);
-
-        // Fetch data into separate buffer and copy
-        std::vector<uint8_t> arrayData;
-        if (inputBuffer->pos < message->size()) {
-          ArrayInfo info = resourceManager.getArrayInfo(
-              (Handle)remoteObj.device, (Handle)remoteObj.object);
-          arrayData = translateArrayData(*inputBuffer, remoteObj.device, info);
-          memcpy(ptr, arrayData.data(), arrayData.size());
-        }
+      // Now map so we can write to it
+      void *ptr =
+          anariMapArray(serverObj.device, (ANARIArray)serverObj.object);
 
-        // Unmap again..
-        anariUnmapArray(serverObj.device, (ANARIArray)serverObj.object);
+      // Fetch data into separate buffer and copy
+      std::vector<uint8_t> arrayData;
+      if (inputBuffer->pos < message->size()) {
+        ArrayInfo info = resourceManager.getArrayInfo(
+            (Handle)remoteObj.device, (Handle)remoteObj.object);
+        arrayData = translateArrayData(*inputBuffer, remoteObj.device, info);
+        memcpy(ptr, arrayData.data(), arrayData.size());
+      }
+
+      // Unmap again..
+      anariUnmapArray(serverObj.device, (ANARIArray)serverObj.object);
+
+      auto outputBuffer = std::make_shared<Buffer>();
+      outputBuffer->write(remoteObj.object);
+      write(MessageType::ArrayUnmapped, outputBuffer);
+
+      LOG(logging::Level::Info)
+          << "Unmapped array. Handle: " << remoteObj.object;
+    } else if (message->type() == MessageType::RenderFrame) {
+      CHECK(serverObj.device, "Error on anariRenderFrame: invalid device");
+      CHECK(serverObj.object, "Error on anariRenderFrame: invalid object");
+
+      ANARIFrame frame = (ANARIFrame)serverObj.object;
+
+      // Frames rendered without any scene changes since the
+      // frame's last render are refinements of an otherwise static image
+      SentImages &sent = sentImages[(Handle)remoteObj.object];
+      bool interactive = sent.renderedVersion != sceneVersion;
+      sent.renderedVersion = sceneVersion;
+
+      auto renderStart = std::chrono::steady_clock::now();
+
+      anariRenderFrame(serverObj.device, frame);
+
+      // Block and send image over the wire
+      anariFrameReady(serverObj.device, frame, ANARI_WAIT);
+
+      stats.framesRendered++;
+      stats.renderTime += std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - renderStart)
+                              .count();
+
+      CompressionFeatures cf = getCompressionFeatures();
+
+      uint32_t width, height;
+      ANARIDataType type;
+      const char *color = (const char *)anariMapFrame(
+          serverObj.device, frame, "channel.color", &width, &height, &type);
+      size_t colorSize =
+          type == ANARI_UNKNOWN ? 0 : width * height * anari::sizeOf(type);
+
+      if (color != nullptr && colorSize != 0) {
+        AdaptiveEncoder &encoder = encoders[(Handle)remoteObj.object];
+
+        CompressionFeatures available;
+        available.hasTurboJPEG =
+            cf.hasTurboJPEG && client.compression.hasTurboJPEG;
+        available.hasSNAPPY = cf.hasSNAPPY && client.compression.hasSNAPPY;
+
+        FrameEncoding enc = encoder.nextEncoding(interactive, available);
+
+        // Unchanged tiles on the client are only as good as the encoding
+        // they were sent with; send everything when that changes
+        if (!sameQuality(enc, sent.colorEncoding))
+          sent.color.reset();
+        sent.colorEncoding = enc;
+
+        TileMask mask;
+        bool delta = sent.color.update(
+            (const uint8_t *)color, width, height, type, mask);
+
+        std::vector<uint8_t> payload;
+        if (!delta) {
+          encodeColor(
+              (const uint8_t *)color, width, height, type, enc, payload);
+        } else if (uint32_t numTiles = mask.count()) {
+          std::vector<uint8_t> strip;
+          gatherTiles((const uint8_t *)color,
+              width,
+              height,
+              anari::sizeOf(type),
+              mask,
+              strip);
+          encodeColor(strip.data(),
+              tileSize,
+              tileSize * numTiles,
+              type,
+              enc,
+              payload);
+        }
+        encoder.frameEncoded(enc, payload.size());
 
         auto outputBuffer = std::make_shared<Buffer>();
         outputBuffer->write(remoteObj.object);
-        write(MessageType::ArrayUnmapped, outputBuffer);
+        outputBuffer->write(width);
+        outputBuffer->write(height);
+        outputBuffer->write(type);
+        writeTileMask(*outputBuffer, delta ? &mask : nullptr);
+        uint8_t encWire[frameEncodingWireSize];
+        packFrameEncoding(enc, encWire);
+        outputBuffer->write((const char *)encWire, sizeof(encWire));
+        outputBuffer->write(encoder.linkStats());
+        outputBuffer->write(uint32_t(payload.size()));
+        outputBuffer->write((const char *)payload.data(), payload.size());
+        write(MessageType::ChannelColor, outputBuffer);
 
         LOG(logging::Level::Info)
-            << "Unmapped array. Handle: " << remoteObj.object;
-      } else if (message->type() == MessageType::RenderFrame) {
-        CHECK(serverObj.device, "Error on anariRenderFrame: invalid device");
-        CHECK(serverObj.object, "Error on anariRenderFrame: invalid object");
-
-        ANARIFrame frame = (ANARIFrame)serverObj.object;
-
-        anariRenderFrame(serverObj.device, frame);
-
-        // Block and send image over the wire
-        anariFrameReady(serverObj.device, frame, ANARI_WAIT);
-
-        CompressionFeatures cf = getCompressionFeatures();
-
-        uint32_t width, height;
-        ANARIDataType type;
-        const char *color = (const char *)anariMapFrame(
-            serverObj.device, frame, "channel.color", &width, &height, &type);
-        size_t colorSize =
-            type == ANARI_UNKNOWN ? 0 : width * height * anari::sizeOf(type);
-        if (color != nullptr && colorSize != 0) {
-          auto outputBuffer = std::make_shared<Buffer>();
-          outputBuffer->write(remoteObj.object);
-          outputBuffer->write(width);
-          outputBuffer->write(height);
-          outputBuffer->write(type);
-
-          bool compressionTurboJPEG =
-              cf.hasTurboJPEG && client.compression.hasTurboJPEG;
-
-          if (compressionTurboJPEG
-              && type == ANARI_UFIXED8_RGBA_SRGB) { // TODO: more formats..
-            TurboJPEGOptions options;
-            options.width = width;
-            options.height = height;
-            options.pixelFormat = TurboJPEGOptions::PixelFormat::RGBX;
-            options.quality = 80;
-
-            std::vector<uint8_t> compressed(
-                getMaxCompressedBufferSizeTurboJPEG(options));
-
-            if (compressed.size() != 0) {
-              size_t compressedSize;
-              if (compressTurboJPEG((const uint8_t *)color,
-                      compressed.data(),
-                      compressedSize,
-                      options)) {
-                uint32_t compressedSize32(compressedSize);
-                outputBuffer->write(compressedSize32);
-                outputBuffer->write(
-                    (const char *)compressed.data(), compressedSize);
-
-                LOG(logging::Level::Info) << "turbojpeg compression size: "
-                                          << prettyBytes(compressedSize);
-              }
-            }
-          } else {
-            outputBuffer->write(color, colorSize);
-          }
-          write(MessageType::ChannelColor, outputBuffer);
+            << "Color encoding: " << toString((FrameEncoding::Codec)enc.codec)
+            << ", quality: " << enc.quality << ", subsampling: "
+            << toString((TurboJPEGOptions::Subsampling)enc.subsampling)
+            << ", downscale: " << enc.downscale << ", tiles: "
+            << (delta ? mask.count() : mask.numTiles()) << "/"
+            << mask.numTiles() << ", size: " << prettyBytes(payload.size());
+      }
+
+      const char *depth = (const char *)anariMapFrame(
+          serverObj.device, frame, "channel.depth", &width, &height, &type);
+      size_t depthSize =
+          type == ANARI_UNKNOWN ? 0 : width * height * anari::sizeOf(type);
+      if (depth != nullptr && depthSize != 0) {
+        TileMask mask;
+        bool delta = sent.depth.update(
+            (const uint8_t *)depth, width, height, type, mask);
+
+        std::vector<uint8_t> strip;
+        if (delta) {
+          gatherTiles((const uint8_t *)depth,
+              width,
+              height,
+              anari::sizeOf(type),
+              mask,
+              strip);
+          depth = (const char *)strip.data();
+          depthSize = strip.size();
         }
 
-        const char *depth = (const char *)anariMapFrame(
-            serverObj.device, frame, "channel.depth", &width, &height, &type);
-        size_t depthSize =
-            type == ANARI_UNKNOWN ? 0 : width * height * anari::sizeOf(type);
-        if (depth != nullptr && depthSize != 0) {
-          auto outputBuffer = std::make_shared<Buffer>();
-          outputBuffer->write(remoteObj.object);
-          outputBuffer->write(width);
-          outputBuffer->write(height);
-          outputBuffer->write(type);
+        auto outputBuffer = std::make_shared<Buffer>();
+        outputBuffer->write(remoteObj.object);
+        outputBuffer->write(width);
+        outputBuffer->write(height);
+        outputBuffer->write(type);
+        writeTileMask(*outputBuffer, delta ? &mask : nullptr);
 
-          bool compressionSNAPPY = cf.hasSNAPPY && client.compression.hasSNAPPY;
+        bool compressionSNAPPY = cf.hasSNAPPY && client.compression.hasSNAPPY;
 
-          if (compressionSNAPPY && type == ANARI_FLOAT32) {
-            SNAPPYOptions options;
-            options.inputSize = depthSize;
+        if (compressionSNAPPY && type == ANARI_FLOAT32) {
+          SNAPPYOptions options;
+          options.inputSize = depthSize;
 
-            std::vector<uint8_t> compressed(
-                getMaxCompressedBufferSizeSNAPPY(options));
+          std::vector<uint8_t> compressed(
+              getMaxCompressedBufferSizeSNAPPY(options));
 
-            size_t compressedSize = 0;
+          size_t compressedSize = 0;
 
+          if (depthSize != 0) {
             compressSNAPPY((const uint8_t *)depth,
                 compressed.data(),
                 compressedSize,
                 options);
-
-            uint32_t compressedSize32(compressedSize);
-            outputBuffer->write(compressedSize32);
-            outputBuffer->write(
-                (const char *)compressed.data(), compressedSize);
-          } else {
-            outputBuffer->write(depth, depthSize);
           }
-          write(MessageType::ChannelDepth, outputBuffer);
+
+          uint32_t compressedSize32(compressedSize);
+          outputBuffer->write(compressedSize32);
+          outputBuffer->write(
+              (const char *)compressed.data(), compressedSize);
+        } else {
+          outputBuffer->write(depth, depthSize);
         }
+        write(MessageType::ChannelDepth, outputBuffer);
+      }
 
-        LOG(logging::Level::Info)
-            << "Frame rendered. Object handle: " << remoteObj.object;
-      } else if (message->type() == MessageType::FrameReady) {
-        CHECK(serverObj.device, "Error on anariFrameReady: invalid device");
-        CHECK(serverObj.object, "Error on anariFrameReady: invalid object");
+      LOG(logging::Level::Info)
+          << "Frame rendered. Object handle: " << remoteObj.object;
+    } else if (message->type() == MessageType::FrameReady) {
+      CHECK(serverObj.device, "Error on anariFrameReady: invalid device");
+      CHECK(serverObj.object, "Error on anariFrameReady: invalid object");
 
-        ANARIWaitMask waitMask;
-        inputBuffer->read(waitMask);
+      ANARIWaitMask waitMask;
+      inputBuffer->read(waitMask);
 
-        ANARIFrame frame = (ANARIFrame)serverObj.object;
-        anariFrameReady(serverObj.device, frame, waitMask);
+      ANARIFrame frame = (ANARIFrame)serverObj.object;
+      anariFrameReady(serverObj.device, frame, waitMask);
+
+      auto outputBuffer = std::make_shared<Buffer>();
+      outputBuffer->write(remoteObj.object);
+      write(MessageType::FrameIsReady, outputBuffer);
+
+      LOG(logging::Level::Info) << "Signal frame is ready to client";
+    } else if (message->type() == MessageType::FrameAck) {
+      uint64_t frameSeq = 0;
+      inputBuffer->read(frameSeq);
+      encoders[(Handle)remoteObj.object].frameAcknowledged(frameSeq);
+    } else if (message->type() == MessageType::GetProperty) {
+      CHECK(serverObj.device, "Error on anariGetProperty: invalid device");
+      CHECK(serverObj.object, "Error on anariGetProperty: invalid object");
+
+      std::string name;
+      inputBuffer->read(name);
+
+      ANARIDataType type;
+      inputBuffer->read(type);
+
+      uint64_t size;
+      inputBuffer->read(size);
+
+      ANARIWaitMask mask;
+      inputBuffer->read(mask);
+
+      auto outputBuffer = std::make_shared<Buffer>();
+
+      if (type == ANARI_STRING_LIST) {
+        const char *const *value = nullptr;
+        int result = anariGetProperty(serverObj.device,
+            serverObj.object,
+            name.data(),
+            type,
+            &value,
+            size,
+            mask);
+
+        outputBuffer->write(remoteObj.object);
+        outputBuffer->write(name);
+        outputBuffer->write(type);
+        outputBuffer->write(size);
+        outputBuffer->write(result);
+
+        StringList stringList((const char **)value);
+        outputBuffer->write(stringList);
+      } else if (type == ANARI_DATA_TYPE_LIST) {
+        throw std::runtime_error(
+            "getProperty with ANARI_DATA_TYPE_LIST not implemented yet!");
+      } else { // POD!
+        std::vector<char> mem(size);
+
+        int result = anariGetProperty(serverObj.device,
+            serverObj.object,
+            name.data(),
+            type,
+            mem.data(),
+            size,
+            mask);
 
-        auto outputBuffer = std::make_shared<Buffer>();
         outputBuffer->write(remoteObj.object);
-        write(MessageType::FrameIsReady, outputBuffer);
+        outputBuffer->write(name);
+        outputBuffer->write(type);
+        outputBuffer->write(size);
+        outputBuffer->write(result);
+        outputBuffer->write((const char *)mem.data(), size);
+      }
+      write(MessageType::Property, outputBuffer);
+    } else if (message->type() == MessageType::GetObjectSubtypes) {
+      CHECK(serverObj.device,
+          "Error on anariGetObjectSubtypes: invalid device");
 
-        LOG(logging::Level::Info) << "Signal frame is ready to client";
-      } else if (message->type() == MessageType::GetProperty) {
-        CHECK(serverObj.device, "Error on anariGetProperty: invalid device");
-        CHECK(serverObj.object, "Error on anariGetProperty: invalid object");
+      ANARIDataType objectType;
+      inputBuffer->read(objectType);
 
-        std::string name;
-        inputBuffer->read(name);
+      auto outputBuffer = std::make_shared<Buffer>();
+      outputBuffer->write(objectType);
 
-        ANARIDataType type;
-        inputBuffer->read(type);
+      const char **subtypes =
+          anariGetObjectSubtypes(serverObj.device, objectType);
 
-        uint64_t size;
-        inputBuffer->read(size);
+      StringList stringList(subtypes);
+      outputBuffer->write(stringList);
 
-        ANARIWaitMask mask;
-        inputBuffer->read(mask);
+      write(MessageType::ObjectSubtypes, outputBuffer);
+    } else if (message->type() == MessageType::GetObjectInfo) {
+      CHECK(serverObj.device, "Error on anariGetObjectInfo: invalid device");
 
-        auto outputBuffer = std::make_shared<Buffer>();
+      ANARIDataType objectType;
+      inputBuffer->read(objectType);
 
-        if (type == ANARI_STRING_LIST) {
-          const char *const *value = nullptr;
-          int result = anariGetProperty(serverObj.device,
-              serverObj.object,
-              name.data(),
-              type,
-              &value,
-              size,
-              mask);
+      std::string objectSubtype;
+      inputBuffer->read(objectSubtype);
+
+      std::string infoName;
+      inputBuffer->read(infoName);
 
-          outputBuffer->write(remoteObj.object);
-          outputBuffer->write(name);
-          outputBuffer->write(type);
-          outputBuffer->write(size);
-          outputBuffer->write(result);
+      ANARIDataType infoType;
+      inputBuffer->read(infoType);
 
-          StringList stringList((const char **)value);
+      auto outputBuffer = std::make_shared<Buffer>();
+      outputBuffer->write(objectType);
+      outputBuffer->write(std::string(objectSubtype));
+      outputBuffer->write(std::string(infoName));
+      outputBuffer->write(infoType);
+
+      const void *info = anariGetObjectInfo(serverObj.device,
+          objectType,
+          objectSubtype.data(),
+          infoName.data(),
+          infoType);
+
+      if (info != nullptr) {
+        if (infoType == ANARI_STRING) {
+          auto *str = (const char *)info;
+          outputBuffer->write(std::string(str));
+        } else if (infoType == ANARI_STRING_LIST) {
+          StringList stringList((const char **)info);
           outputBuffer->write(stringList);
-        } else if (type == ANARI_DATA_TYPE_LIST) {
-          throw std::runtime_error(
-              "getProperty with ANARI_DATA_TYPE_LIST not implemented yet!");
-        } else { // POD!
-          std::vector<char> mem(size);
-
-          int result = anariGetProperty(serverObj.device,
-              serverObj.object,
-              name.data(),
-              type,
-              mem.data(),
-              size,
-              mask);
-
-          outputBuffer->write(remoteObj.object);
-          outputBuffer->write(name);
-          outputBuffer->write(type);
-          outputBuffer->write(size);
-          outputBuffer->write(result);
-          outputBuffer->write((const char *)mem.data(), size);
+        } else if (infoType == ANARI_PARAMETER_LIST) {
+          ParameterList parameterList((const Parameter *)info);
+          outputBuffer->write(parameterList);
+        } else {
+          outputBuffer->write((const char *)info, anari::sizeOf(infoType));
         }
-        write(MessageType::Property, outputBuffer);
-      } else if (message->type() == MessageType::GetObjectSubtypes) {
-        CHECK(serverObj.device,
-            "Error on anariGetObjectSubtypes: invalid device");
+      }
+      write(MessageType::ObjectInfo, outputBuffer);
+    } else if (message->type() == MessageType::GetParameterInfo) {
+      CHECK(
+          serverObj.device, "Error on anariGetParameterInfo: invalid device");
+
+      ANARIDataType objectType;
+      inputBuffer->read(objectType);
+
+      std::string objectSubtype;
+      inputBuffer->read(objectSubtype);
+
+      std::string parameterName;
+      inputBuffer->read(parameterName);
+
+      ANARIDataType parameterType;
+      inputBuffer->read(parameterType);
+
+      std::string infoName;
+      inputBuffer->read(infoName);
+
+      ANARIDataType infoType;
+      inputBuffer->read(infoType);
+
+      auto outputBuffer = std::make_shared<Buffer>();
+      outputBuffer->write(objectType);
+      outputBuffer->write(objectSubtype);
+      outputBuffer->write(parameterName);
+      outputBuffer->write(parameterType);
+      outputBuffer->write(infoName);
+      outputBuffer->write(infoType);
+
+      const void *info = anariGetParameterInfo(serverObj.device,
+          objectType,
+          objectSubtype.data(),
+          parameterName.data(),
+          parameterType,
+          infoName.data(),
+          infoType);
+
+      if (info != nullptr) {
+        if (infoType == ANARI_STRING) {
+          auto *str = (const char *)info;
+          outputBuffer->write(std::string(str));
+        } else if (infoType == ANARI_STRING_LIST) {
+          StringList stringList((const char **)info);
+          outputBuffer->write(stringList);
+        } else if (infoType == ANARI_PARAMETER_LIST) {
+          ParameterList parameterList((const Parameter *)info);
+          outputBuffer->write(parameterList);
+        } else {
+          outputBuffer->write((const char *)info, anari::sizeOf(infoType));
+        }
+      }
+      write(MessageType::ParameterInfo, outputBuffer);
+    } else {
+      LOG(logging::Level::Warning)
+          << "Unhandled message of size: " << message->size();
+    }
 
-        ANARIDataType objectType;
-        inputBuffer->read(objectType);
+#undef CHECK
+  }
+};
 
-        auto outputBuffer = std::make_shared<Buffer>();
-        outputBuffer->write(objectType);
+using SessionPointer = std::shared_ptr<Session>;
 
-        const char **subtypes =
-            anariGetObjectSubtypes(serverObj.device, objectType);
+struct Server
+{
+  async::connection_manager_pointer manager;
+  boost::asio::thread_pool pool;
 
-        StringList stringList(subtypes);
-        outputBuffer->write(stringList);
+  std::mutex sessionMutex;
+  std::map<uint64_t, SessionPointer> sessions;
+  uint64_t nextSessionID = 1;
+  size_t maxSessions;
 
-        write(MessageType::ObjectSubtypes, outputBuffer);
-      } else if (message->type() == MessageType::GetObjectInfo) {
-        CHECK(serverObj.device, "Error on anariGetObjectInfo: invalid device");
+  Server(unsigned short port, size_t maxClients, size_t numThreads)
+      : manager(async::make_connection_manager(port)),
+        pool(numThreads),
+        maxSessions(maxClients)
+  {
+    logging::Initialize();
 
-        ANARIDataType objectType;
-        inputBuffer->read(objectType);
+    g_library = anariLoadLibrary(g_libraryType.c_str(), statusFunc, &g_verbose);
+  }
 
-        std::string objectSubtype;
-        inputBuffer->read(objectSubtype);
+  ~Server()
+  {
+    pool.join();
+    sessions.clear();
+    anariUnloadLibrary(g_library);
+  }
 
-        std::string infoName;
-        inputBuffer->read(infoName);
+  void accept()
+  {
+    LOG(logging::Level::Info) << "Server: accepting...";
 
-        ANARIDataType infoType;
-        inputBuffer->read(infoType);
+    manager->accept(std::bind(&Server::handleNewConnection,
+        this,
+        std::placeholders::_1,
+        std::placeholders::_2));
+  }
 
-        auto outputBuffer = std::make_shared<Buffer>();
-        outputBuffer->write(objectType);
-        outputBuffer->write(std::string(objectSubtype));
-        outputBuffer->write(std::string(infoName));
-        outputBuffer->write(infoType);
-
-        const void *info = anariGetObjectInfo(serverObj.device,
-            objectType,
-            objectSubtype.data(),
-            infoName.data(),
-            infoType);
-
-        if (info != nullptr) {
-          if (infoType == ANARI_STRING) {
-            auto *str = (const char *)info;
-            outputBuffer->write(std::string(str));
-          } else if (infoType == ANARI_STRING_LIST) {
-            StringList stringList((const char **)info);
-            outputBuffer->write(stringList);
-          } else if (infoType == ANARI_PARAMETER_LIST) {
-            ParameterList parameterList((const Parameter *)info);
-            outputBuffer->write(parameterList);
-          } else {
-            outputBuffer->write((const char *)info, anari::sizeOf(infoType));
-          }
-        }
-        write(MessageType::ObjectInfo, outputBuffer);
-      } else if (message->type() == MessageType::GetParameterInfo) {
-        CHECK(
-            serverObj.device, "Error on anariGetParameterInfo: invalid device");
+  void run()
+  {
+    manager->run_in_thread();
+  }
 
-        ANARIDataType objectType;
-        inputBuffer->read(objectType);
+  void wait()
+  {
+    manager->wait();
+  }
 
-        std::string objectSubtype;
-        inputBuffer->read(objectSubtype);
+  bool handleNewConnection(
+      async::connection_pointer new_conn, std::error_code const &e)
+  {
+    if (e) {
+      LOG(logging::Level::Error)
+          << "Server: could not connect to client: " << e.message();
+      manager->stop();
+      return false;
+    }
 
-        std::string parameterName;
-        inputBuffer->read(parameterName);
+    // Keep accepting new connections, whether we can serve this one or not
+    accept();
 
-        ANARIDataType parameterType;
-        inputBuffer->read(parameterType);
+    std::unique_lock<std::mutex> l(sessionMutex);
 
-        std::string infoName;
-        inputBuffer->read(infoName);
+    if (maxSessions > 0 && sessions.size() >= maxSessions) {
+      LOG(logging::Level::Warning)
+          << "Server: rejecting connection, session limit (" << maxSessions
+          << ") reached";
+      // Not adding the connection closes it once new_conn goes out of scope
+      return false;
+    }
 
-        ANARIDataType infoType;
-        inputBuffer->read(infoType);
+    auto session = std::make_shared<Session>(
+        nextSessionID++, new_conn, pool.get_executor());
+    sessions[session->id] = session;
 
-        auto outputBuffer = std::make_shared<Buffer>();
-        outputBuffer->write(objectType);
-        outputBuffer->write(objectSubtype);
-        outputBuffer->write(parameterName);
-        outputBuffer->write(parameterType);
-        outputBuffer->write(infoName);
-        outputBuffer->write(infoType);
-
-        const void *info = anariGetParameterInfo(serverObj.device,
-            objectType,
-            objectSubtype.data(),
-            parameterName.data(),
-            parameterType,
-            infoName.data(),
-            infoType);
-
-        if (info != nullptr) {
-          if (infoType == ANARI_STRING) {
-            auto *str = (const char *)info;
-            outputBuffer->write(std::string(str));
-          } else if (infoType == ANARI_STRING_LIST) {
-            StringList stringList((const char **)info);
-            outputBuffer->write(stringList);
-          } else if (infoType == ANARI_PARAMETER_LIST) {
-            ParameterList parameterList((const Parameter *)info);
-            outputBuffer->write(parameterList);
-          } else {
-            outputBuffer->write((const char *)info, anari::sizeOf(infoType));
-          }
-        }
-        write(MessageType::ParameterInfo, outputBuffer);
-      } else {
+    if (!g_captureFile.empty()) {
+      // One file per session, suffixed with its ID
+      std::string fileName = g_captureFile + "." + std::to_string(session->id);
+      if (!session->capture.open(fileName)) {
         LOG(logging::Level::Warning)
-            << "Unhandled message of size: " << message->size();
+            << "Server: cannot open capture file: " << fileName;
       }
-    } else {
-      // LOG(logging::Level::Info) << "written";
+    }
+
+    LOG(logging::Level::Info) << "Server: connected, session " << session->id
+                              << " (" << sessions.size() << " active)";
+
+    // The connection only holds a weak reference; the session
+    // is owned by the server until the client disconnects
+    std::weak_ptr<Session> weakSession = session;
+    new_conn->set_handler(std::bind(&Server::handleMessage,
+        this,
+        weakSession,
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3));
+
+    return true;
+  }
+
+  void closeSession(uint64_t sessionID)
+  {
+    SessionPointer session;
+    {
+      std::unique_lock<std::mutex> l(sessionMutex);
+      auto it = sessions.find(sessionID);
+      if (it == sessions.end())
+        return; // already closed (read and write errors both report)
+      session = it->second;
+      sessions.erase(it);
+    }
+
+    // Let pending work of this session drain before tearing it down
+    boost::asio::post(session->strand, [session]() {
+      session->releaseDevices();
+      ProtocolStats captureStats;
+      bool captured = session->capture.close(&captureStats);
+      session->logStats(captured ? &captureStats : nullptr);
+      LOG(logging::Level::Info) << "Server: session " << session->id
+                                << " closed";
+    });
+  }
+
+  void handleMessage(std::weak_ptr<Session> weakSession,
+      async::connection::reason reason,
+      async::message_pointer message,
+      std::error_code const &e)
+  {
+    SessionPointer session = weakSession.lock();
+    if (!session)
+      return;
+
+    if (e) {
+      LOG(logging::Level::Info) << "Server: session " << session->id
+                                << " disconnected: " << e.message();
+      closeSession(session->id);
+      return;
+    }
+
+    if (reason == async::connection::Read) {
+      boost::asio::post(session->strand,
+          [session, message]() { session->handleMessage(message); });
+    } else if (message->type() == MessageType::ChannelColor) {
+      // Write completion; feeds the send throughput estimate
+      boost::asio::post(session->strand,
+          [session, message]() { session->messageWritten(message); });
     }
   }
 };
@@ -864,7 +1153,10 @@ static void printUsage()
   std::cout << "./anari-remote-server [{--help|-h}]\n"
             << "   [{--verbose|-v}]\n"
             << "   [{--library|-l} <ANARI library>]\n"
-            << "   [{--port|-p} <N>]\n";
+            << "   [{--port|-p} <N>]\n"
+            << "   [{--max-clients|-m} <N>]\n"
+            << "   [{--threads|-t} <N>]\n"
+            << "   [{--capture|-c} <file>]\n";
 }
 
 static void parseCommandLine(int argc, char *argv[])
@@ -880,13 +1172,19 @@ static void parseCommandLine(int argc, char *argv[])
       g_libraryType = argv[++i];
     else if (arg == "-p" || arg == "--port")
       g_port = std::stoi(argv[++i]);
+    else if (arg == "-m" || arg == "--max-clients")
+      g_maxClients = std::stoul(argv[++i]);
+    else if (arg == "-t" || arg == "--threads")
+      g_numThreads = std::max(size_t(1), (size_t)std::stoul(argv[++i]));
+    else if (arg == "-c" || arg == "--capture")
+      g_captureFile = argv[++i];
   }
 }
 
 int main(int argc, char *argv[])
 {
   parseCommandLine(argc, argv);
-  remote::Server srv(g_port);
+  remote::Server srv(g_port, g_maxClients, g_numThreads);
   srv.accept();
   srv.run();
   srv.wait();
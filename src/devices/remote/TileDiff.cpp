@@ -0,0 +1,191 @@
+// Copyright 2023-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TileDiff.h"
+#include <anari/anari_cpp.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace remote {
+
+// ==================================================================
+// TileMask
+// ==================================================================
+
+void TileMask::resize(uint32_t width, uint32_t height)
+{
+  tilesX = (width + tileSize - 1) / tileSize;
+  tilesY = (height + tileSize - 1) / tileSize;
+  bits.resize((numTiles() + 7) / 8);
+  clear();
+}
+
+void TileMask::clear()
+{
+  std::fill(bits.begin(), bits.end(), 0);
+}
+
+uint32_t TileMask::numTiles() const
+{
+  return tilesX * tilesY;
+}
+
+uint32_t TileMask::count() const
+{
+  uint32_t result = 0;
+  for (uint32_t i = 0; i < numTiles(); ++i) {
+    if (test(i))
+      result++;
+  }
+  return result;
+}
+
+bool TileMask::test(uint32_t tile) const
+{
+  return bits[tile / 8] & (1 << (tile % 8));
+}
+
+void TileMask::set(uint32_t tile)
+{
+  bits[tile / 8] |= 1 << (tile % 8);
+}
+
+// ==================================================================
+// TileDiff
+// ==================================================================
+
+namespace {
+
+struct TileRect
+{
+  uint32_t x0, y0, x1, y1;
+};
+
+TileRect tileRect(uint32_t tile, const TileMask &mask, uint32_t w, uint32_t h)
+{
+  TileRect r;
+  r.x0 = (tile % mask.tilesX) * tileSize;
+  r.y0 = (tile / mask.tilesX) * tileSize;
+  r.x1 = std::min(w, r.x0 + tileSize);
+  r.y1 = std::min(h, r.y0 + tileSize);
+  return r;
+}
+
+// Sending the mask and reassembling the tiles doesn't pay
+// off when more than this fraction of the tiles changed
+constexpr uint32_t maxChangedNumerator = 3;
+constexpr uint32_t maxChangedDenominator = 4;
+
+} // namespace
+
+bool TileDiff::update(const uint8_t *image,
+    uint32_t w,
+    uint32_t h,
+    ANARIDataType t,
+    TileMask &changed)
+{
+  size_t pixelSize = anari::sizeOf(t);
+  size_t numBytes = size_t(w) * h * pixelSize;
+
+  changed.resize(w, h);
+
+  if (w != width || h != height || t != type || previous.size() != numBytes) {
+    width = w;
+    height = h;
+    type = t;
+    previous.assign(image, image + numBytes);
+    return false;
+  }
+
+  uint32_t numChanged = 0;
+  for (uint32_t tile = 0; tile < changed.numTiles(); ++tile) {
+    TileRect r = tileRect(tile, changed, w, h);
+    size_t rowBytes = (r.x1 - r.x0) * pixelSize;
+
+    bool differs = false;
+    for (uint32_t y = r.y0; y < r.y1 && !differs; ++y) {
+      size_t off = (size_t(y) * w + r.x0) * pixelSize;
+      differs = memcmp(image + off, previous.data() + off, rowBytes) != 0;
+    }
+
+    if (!differs)
+      continue;
+
+    changed.set(tile);
+    numChanged++;
+
+    // Only changed tiles need to be updated in the reference
+    for (uint32_t y = r.y0; y < r.y1; ++y) {
+      size_t off = (size_t(y) * w + r.x0) * pixelSize;
+      memcpy(previous.data() + off, image + off, rowBytes);
+    }
+  }
+
+  return numChanged * maxChangedDenominator
+      <= changed.numTiles() * maxChangedNumerator;
+}
+
+void TileDiff::reset()
+{
+  previous.clear();
+  width = height = 0;
+  type = ANARI_UNKNOWN;
+}
+
+// ==================================================================
+// Gather/scatter
+// ==================================================================
+
+void gatherTiles(const uint8_t *image,
+    uint32_t width,
+    uint32_t height,
+    size_t pixelSize,
+    const TileMask &mask,
+    std::vector<uint8_t> &strip)
+{
+  size_t tileBytes = size_t(tileSize) * tileSize * pixelSize;
+  strip.resize(mask.count() * tileBytes);
+
+  uint8_t *dst = strip.data();
+  for (uint32_t tile = 0; tile < mask.numTiles(); ++tile) {
+    if (!mask.test(tile))
+      continue;
+
+    TileRect r = tileRect(tile, mask, width, height);
+    for (uint32_t y = 0; y < tileSize; ++y) {
+      uint32_t yy = std::min(r.y0 + y, r.y1 - 1);
+      const uint8_t *row = image + (size_t(yy) * width + r.x0) * pixelSize;
+      size_t rowBytes = (r.x1 - r.x0) * pixelSize;
+      memcpy(dst, row, rowBytes);
+      for (uint32_t x = r.x1 - r.x0; x < tileSize; ++x)
+        memcpy(dst + x * pixelSize, row + rowBytes - pixelSize, pixelSize);
+      dst += tileSize * pixelSize;
+    }
+  }
+}
+
+void scatterTiles(const uint8_t *strip,
+    uint32_t width,
+    uint32_t height,
+    size_t pixelSize,
+    const TileMask &mask,
+    uint8_t *image)
+{
+  const uint8_t *src = strip;
+  for (uint32_t tile = 0; tile < mask.numTiles(); ++tile) {
+    if (!mask.test(tile))
+      continue;
+
+    TileRect r = tileRect(tile, mask, width, height);
+    for (uint32_t y = 0; y < tileSize; ++y) {
+      if (r.y0 + y < r.y1) {
+        memcpy(image + (size_t(r.y0 + y) * width + r.x0) * pixelSize,
+            src,
+            (r.x1 - r.x0) * pixelSize);
+      }
+      src += tileSize * pixelSize;
+    }
+  }
+}
+
+} // namespace remote
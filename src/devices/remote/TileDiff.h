@@ -0,0 +1,77 @@
+// Copyright 2023-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <anari/anari.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace remote {
+
+constexpr uint32_t tileSize = 32;
+
+// One bit per tileSize x tileSize tile, in row-major order; tiles
+// at the right and bottom border may be smaller than that
+struct TileMask
+{
+  uint32_t tilesX{0};
+  uint32_t tilesY{0};
+  std::vector<uint8_t> bits;
+
+  void resize(uint32_t width, uint32_t height);
+  void clear();
+
+  uint32_t numTiles() const;
+  // Number of tiles set
+  uint32_t count() const;
+
+  bool test(uint32_t tile) const;
+  void set(uint32_t tile);
+};
+
+// Keeps a copy of the image last sent for one channel of a frame
+// and determines which of its tiles changed since then
+class TileDiff
+{
+ public:
+  // Compare image to the previous one and make it the new reference.
+  // Returns true if only the tiles set in changed need to be sent; false
+  // if the full image should be sent instead (first image, size or type
+  // changed, reset() was called, or most of the tiles changed anyway)
+  bool update(const uint8_t *image,
+      uint32_t width,
+      uint32_t height,
+      ANARIDataType type,
+      TileMask &changed);
+
+  // Forget the reference, the next image will be sent in full
+  void reset();
+
+ private:
+  std::vector<uint8_t> previous;
+  uint32_t width{0};
+  uint32_t height{0};
+  ANARIDataType type{ANARI_UNKNOWN};
+};
+
+// Copy the tiles set in mask to a strip that is tileSize pixels wide and
+// holds the tiles stacked on top of each other. Border tiles are padded
+// by repeating their last column and row.
+void gatherTiles(const uint8_t *image,
+    uint32_t width,
+    uint32_t height,
+    size_t pixelSize,
+    const TileMask &mask,
+    std::vector<uint8_t> &strip);
+
+// Inverse of gatherTiles(), copies the tiles from the strip to the image
+void scatterTiles(const uint8_t *strip,
+    uint32_t width,
+    uint32_t height,
+    size_t pixelSize,
+    const TileMask &mask,
+    uint8_t *image);
+
+} // namespace remote
@@ -12,6 +12,9 @@
 
 #include <system_error>
 #include <memory>
+#include <set>
+#include <string>
+#include <vector>
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
@@ -21,6 +24,7 @@
 #include <boost/signals2/signal.hpp>
 
 #include "message.h"
+#include "shared_memory.h"
 
 namespace async {
 
@@ -97,6 +101,13 @@ class connection : public std::enable_shared_from_this<connection>
   signal_type signal_;
   // Slot
   boost::signals2::connection slot_;
+  // Ring this side reads large messages from; offered to the other side
+  shared_ring_pointer shm_in_;
+  // Ring the other side offered, if it runs on the same host
+  shared_ring_pointer shm_out_;
+  // Segments sent to the other side and not yet acknowledged; removed when
+  // the connection goes away in case the other side never got to open them
+  std::set<std::string> shm_segments_;
 };
 
 } // namespace async
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <cstdio>
+#include <cstring>
 #include <sstream>
 
 #include <boost/asio/buffer.hpp>
@@ -30,6 +31,44 @@ inline std::string to_string(T const &x)
   return stream.str();
 }
 
+namespace {
+
+// Message types used by the connection manager itself to set up and use
+// shared memory. These are never passed on to the connection's handler.
+enum : unsigned
+{
+  // The sender created a ring to receive messages through.
+  // Data: nonce, followed by the ring's name
+  shm_offer = 0xFFFFFF00,
+  // The ring was opened, the sender will use it from now on
+  shm_ack,
+  // A message stored in the ring. Data: shm_data
+  shm_ring_data,
+  // A message stored in a segment of its own.
+  // Data: shm_data, followed by the segment's name
+  shm_segment_data,
+  // The segment was opened and its name removed. Data: the segment's name
+  shm_segment_ack,
+};
+
+struct shm_data
+{
+  // The type of the message stored in shared memory
+  unsigned type;
+  // Where the message is stored
+  uint64_t begin;
+  uint64_t end;
+};
+
+// Smaller messages are cheap to send over the socket
+const size_t shm_min_message_size = 64 * 1024;
+// Memory is only committed as the ring is being written to
+const size_t shm_ring_capacity = 128 * 1024 * 1024;
+// Larger messages are sent in segments of their own
+const size_t shm_max_ring_message_size = shm_ring_capacity / 4;
+
+} // namespace
+
 //--------------------------------------------------------------------------------------------------
 // connection_manager
 //
@@ -154,6 +193,8 @@ void connection_manager::close(connection_pointer conn)
     return;
   }
 
+  release_shared_memory(conn);
+
   // Remove the handler!
   conn->remove_handler();
 
@@ -328,7 +369,8 @@ void connection_manager::handle_read_data(boost::system::error_code const &e,
     connection_pointer conn)
 {
   // Call the connection's slot
-  conn->signal_(connection::Read, message, e);
+  if (e || handle_shared_memory(message, conn))
+    conn->signal_(connection::Read, message, e);
 
   if (!e) {
     // Read the next message
@@ -368,24 +410,29 @@ void connection_manager::do_write_0()
   //
 
   assert(msg.second->header_.size_ != 0);
-  assert(msg.second->header_.size_ == msg.second->data_.size());
+  assert(msg.second->header_.size_ == msg.second->size());
+
+  // Large messages only go through the socket if there's no shared memory
+  message_pointer wire = msg.second;
+  if (msg.first->shm_out_ && msg.second->size() >= shm_min_message_size) {
+    if (message_pointer desc = write_shared_memory(msg.second, msg.first))
+      wire = desc;
+  }
 
   // Send the header and the data in a single write operation.
   std::vector<boost::asio::const_buffer> buffers;
 
-  buffers.push_back(boost::asio::const_buffer(
-      &msg.second->header_, sizeof(msg.second->header_)));
-  buffers.push_back(boost::asio::const_buffer(
-      &msg.second->data_[0], msg.second->data_.size()));
+  buffers.push_back(
+      boost::asio::const_buffer(&wire->header_, sizeof(wire->header_)));
+  buffers.push_back(boost::asio::const_buffer(wire->data(), wire->size()));
 
   // Start the write operation.
+  // The handler is passed the original message, not what was written.
   boost::asio::async_write(msg.first->socket_,
       buffers,
-      boost::bind(&connection_manager::handle_write,
-          this,
-          boost::asio::placeholders::error,
-          msg.second,
-          msg.first));
+      [this, wire, msg](boost::system::error_code const &e, size_t) {
+        handle_write(e, msg.second, msg.first);
+      });
 }
 
 void connection_manager::handle_write(boost::system::error_code const &e,
@@ -420,10 +467,160 @@ void connection_manager::add_connection(connection_pointer conn)
 
   // Start reading messages
   do_read(conn);
+
+  offer_shared_memory(conn);
 }
 
 void connection_manager::remove_connection(connection_pointer conn)
 {
+  release_shared_memory(conn);
+
   // Delete the connection
   connections_.erase(conn);
 }
+
+void connection_manager::offer_shared_memory(connection_pointer conn)
+{
+  if (!shared_memory_enabled())
+    return;
+
+  // Whether the other side really runs on the same host is only known
+  // once it managed to open the ring; don't bother if it can't
+  boost::system::error_code e1, e2;
+  auto local = conn->socket_.local_endpoint(e1).address();
+  auto remote = conn->socket_.remote_endpoint(e2).address();
+  if (e1 || e2 || (remote != local && !remote.is_loopback()))
+    return;
+
+  conn->shm_in_ = shared_ring::create(shm_ring_capacity);
+  if (!conn->shm_in_)
+    return;
+
+  std::string const &name = conn->shm_in_->name();
+  boost::uuids::uuid const &nonce = conn->shm_in_->nonce();
+
+  message::data_type data(sizeof(nonce) + name.size());
+  memcpy(data.data(), &nonce, sizeof(nonce));
+  memcpy(data.data() + sizeof(nonce), name.data(), name.size());
+
+  write(make_message(shm_offer, std::move(data)), conn);
+}
+
+bool connection_manager::handle_shared_memory(
+    message_pointer message, connection_pointer conn)
+{
+  unsigned type = message->type();
+
+  if (type == shm_offer) {
+    boost::uuids::uuid nonce;
+    if (message->size() <= sizeof(nonce) || !shared_memory_enabled())
+      return false;
+
+    memcpy(&nonce, message->data(), sizeof(nonce));
+    std::string name(message->data() + sizeof(nonce), message->end());
+
+    conn->shm_out_ = shared_ring::open(name, nonce);
+    if (conn->shm_out_)
+      write(make_message(shm_ack, message::data_type(1)), conn);
+
+    return false;
+  }
+
+  if (type == shm_ack) {
+    // The other side has it mapped, the name is no longer needed
+    if (conn->shm_in_)
+      shared_segment::unlink(conn->shm_in_->name());
+    return false;
+  }
+
+  if (type == shm_segment_ack) {
+    // Unlinked by the other side; the memory goes away with its mapping
+    conn->shm_segments_.erase(std::string(message->data(), message->end()));
+    return false;
+  }
+
+  if (type != shm_ring_data && type != shm_segment_data)
+    return true;
+
+  shm_data desc;
+  if (message->size() < sizeof(desc))
+    return false;
+  memcpy(&desc, message->data(), sizeof(desc));
+
+  std::shared_ptr<char> external;
+
+  if (type == shm_ring_data && conn->shm_in_) {
+    shared_ring_pointer ring = conn->shm_in_;
+    uint64_t begin = desc.begin;
+    if (char *data = ring->acquire(desc.begin, desc.end)) {
+      external = std::shared_ptr<char>(
+          data, [ring, begin](char *) { ring->release(begin); });
+    }
+  } else if (type == shm_segment_data) {
+    std::string name(message->data() + sizeof(desc), message->end());
+    shared_segment_pointer segment = shared_segment::open(name);
+    shared_segment::unlink(name);
+    write(make_message(
+              shm_segment_ack, message::data_type(name.begin(), name.end())),
+        conn);
+    if (segment && segment->size() >= desc.end) {
+      external =
+          std::shared_ptr<char>(segment->data(), [segment](char *) {});
+    }
+  }
+
+  if (!external) {
+#ifndef NDEBUG
+    printf("connection_manager::handle_shared_memory: invalid message\n");
+#endif
+    return false;
+  }
+
+  // Turn this into the message that was stored in shared memory
+  message->data_.clear();
+  message->external_ = external;
+  message->header_.type_ = desc.type;
+  message->header_.size_ = static_cast<unsigned>(desc.end - desc.begin);
+
+  return true;
+}
+
+message_pointer connection_manager::write_shared_memory(
+    message_pointer message, connection_pointer conn)
+{
+  shm_data desc{message->type(), 0, message->size()};
+  std::string name;
+  unsigned type = shm_ring_data;
+
+  if (message->size() <= shm_max_ring_message_size
+      && conn->shm_out_->write(message->data(), message->size(), desc.begin)) {
+    desc.end = desc.begin + message->size();
+  } else {
+    // Too large for the ring, or the ring is full
+    name = make_shared_memory_name();
+    shared_segment_pointer segment =
+        shared_segment::create(name, message->size());
+    if (!segment)
+      return message_pointer();
+
+    memcpy(segment->data(), message->data(), message->size());
+    conn->shm_segments_.insert(name);
+    type = shm_segment_data;
+  }
+
+  message::data_type data(sizeof(desc) + name.size());
+  memcpy(data.data(), &desc, sizeof(desc));
+  memcpy(data.data() + sizeof(desc), name.data(), name.size());
+
+  return make_message(type, std::move(data));
+}
+
+void connection_manager::release_shared_memory(connection_pointer conn)
+{
+  if (conn->shm_in_)
+    shared_segment::unlink(conn->shm_in_->name());
+
+  for (std::string const &name : conn->shm_segments_)
+    shared_segment::unlink(name);
+  conn->shm_segments_.clear();
+}
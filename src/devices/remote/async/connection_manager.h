@@ -119,6 +119,22 @@ class connection_manager
   // Remove an existing connection
   void remove_connection(connection_pointer conn);
 
+  // Offer shared memory to the other side if it might run on the same host
+  void offer_shared_memory(connection_pointer conn);
+
+  // Handle messages that set up shared memory and resolve messages that
+  // were sent through it. Returns false if the message is not meant for
+  // the connection's handler.
+  bool handle_shared_memory(message_pointer message, connection_pointer conn);
+
+  // Copy the message to shared memory and return a message that refers to
+  // it, or null if the message should be sent over the socket
+  message_pointer write_shared_memory(
+      message_pointer message, connection_pointer conn);
+
+  // Remove any shared memory names still held by the connection
+  void release_shared_memory(connection_pointer conn);
+
  private:
   using connections = std::set<connection_pointer>;
   using messages = std::deque<std::pair<connection_pointer, message_pointer>>;
@@ -46,6 +46,9 @@ class message
  private:
   // The message data
   data_type data_;
+  // The message data if not stored in data_, e.g., if it was received
+  // through shared memory; keeps the memory valid as long as needed
+  std::shared_ptr<char> external_;
   // The message header
   header header_;
 
@@ -61,6 +64,12 @@ class message
         header_(generate_id(), type, static_cast<unsigned>(data_.size()))
   {}
 
+  // Creates a message that takes ownership of the given buffer.
+  explicit message(unsigned type, data_type &&data)
+      : data_(std::move(data)),
+        header_(generate_id(), type, static_cast<unsigned>(data_.size()))
+  {}
+
   ~message();
 
   // Returns the unique ID of this message
@@ -78,51 +87,55 @@ class message
   // Returns the size of the message
   unsigned size() const
   {
+    if (external_)
+      return header_.size_;
+
     assert(header_.size_ == data_.size());
     return static_cast<unsigned>(data_.size());
   }
 
   // Returns an iterator to the first element of the data
-  data_type::iterator begin()
+  char *begin()
   {
-    return data_.begin();
+    return data();
   }
 
   // Returns an iterator to the element following the last element of the data
-  data_type::iterator end()
+  char *end()
   {
-    return data_.end();
+    return data() + size();
   }
 
   // Returns an iterator to the first element of the data
-  data_type::const_iterator begin() const
+  char const *begin() const
   {
-    return data_.begin();
+    return data();
   }
 
   // Returns an iterator to the element following the last element of the data
-  data_type::const_iterator end() const
+  char const *end() const
   {
-    return data_.end();
+    return data() + size();
   }
 
   // Swaps the data buffer with the given buffer and resets the header.
   void swap_data(data_type &buffer)
   {
     data_.swap(buffer);
+    external_.reset();
     header_ = {};
   }
 
   // Returns a pointer to the data
   char *data()
   {
-    return data_.data();
+    return external_ ? external_.get() : data_.data();
   }
 
   // Returns a pointer to the data
   char const *data() const
   {
-    return data_.data();
+    return external_ ? external_.get() : data_.data();
   }
 
  private:
@@ -141,4 +154,9 @@ inline message_pointer make_message(unsigned type, It first, It last)
   return std::make_shared<message>(type, first, last);
 }
 
+inline message_pointer make_message(unsigned type, message::data_type &&data)
+{
+  return std::make_shared<message>(type, std::move(data));
+}
+
 } // namespace async
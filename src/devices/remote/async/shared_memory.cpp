@@ -0,0 +1,278 @@
+// Copyright 2023-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <boost/version.hpp>
+
+#if BOOST_VERSION == 106900
+#define BOOST_ALLOW_DEPRECATED_HEADERS
+#endif
+
+#include <boost/uuid/uuid_generators.hpp>
+
+#include "shared_memory.h"
+
+using namespace async;
+
+//--------------------------------------------------------------------------------------------------
+// Misc.
+//
+
+bool async::shared_memory_enabled()
+{
+#ifdef _WIN32
+  return false;
+#else
+  const char *env = getenv("ANARI_REMOTE_SHARED_MEMORY");
+  return env == nullptr || std::string(env) != "0";
+#endif
+}
+
+std::string async::make_shared_memory_name()
+{
+  static std::atomic<unsigned> counter{0};
+
+  // Keep it short, macOS limits names to 31 characters
+  std::ostringstream stream;
+#ifndef _WIN32
+  stream << "/anari-remote-" << getpid() << "-" << counter++;
+#endif
+  return stream.str();
+}
+
+//--------------------------------------------------------------------------------------------------
+// shared_segment
+//
+
+shared_segment::shared_segment(std::string const &name, char *data, size_t size)
+    : name_(name), data_(data), size_(size)
+{}
+
+shared_segment::~shared_segment()
+{
+#ifndef _WIN32
+  munmap(data_, size_);
+#endif
+}
+
+shared_segment_pointer shared_segment::create(
+    std::string const &name, size_t size)
+{
+#ifdef _WIN32
+  return shared_segment_pointer();
+#else
+  int fd =
+      shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd < 0)
+    return shared_segment_pointer();
+
+  if (ftruncate(fd, size) != 0) {
+    close(fd);
+    shm_unlink(name.c_str());
+    return shared_segment_pointer();
+  }
+
+  void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (data == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    return shared_segment_pointer();
+  }
+
+  return shared_segment_pointer(new shared_segment(name, (char *)data, size));
+#endif
+}
+
+shared_segment_pointer shared_segment::open(std::string const &name)
+{
+#ifdef _WIN32
+  return shared_segment_pointer();
+#else
+  int fd = shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0)
+    return shared_segment_pointer();
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return shared_segment_pointer();
+  }
+
+  size_t size = size_t(st.st_size);
+  void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (data == MAP_FAILED)
+    return shared_segment_pointer();
+
+  return shared_segment_pointer(new shared_segment(name, (char *)data, size));
+#endif
+}
+
+void shared_segment::unlink(std::string const &name)
+{
+#ifndef _WIN32
+  shm_unlink(name.c_str());
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+// shared_ring
+//
+
+static const uint64_t ring_magic = 0x474e495249524e41ull; // "ANRIRING"
+
+struct shared_ring::header
+{
+  uint64_t magic;
+  boost::uuids::uuid nonce;
+  uint64_t capacity;
+  // Written by the producer only
+  alignas(64) std::atomic<uint64_t> head;
+  // Written by the consumer only
+  alignas(64) std::atomic<uint64_t> tail;
+};
+
+size_t shared_ring::data_offset()
+{
+  return (sizeof(header) + 63) / 64 * 64;
+}
+
+shared_ring::shared_ring(shared_segment_pointer segment) : segment_(segment) {}
+
+shared_ring_pointer shared_ring::create(size_t capacity)
+{
+  auto segment = shared_segment::create(
+      make_shared_memory_name(), data_offset() + capacity);
+  if (!segment)
+    return shared_ring_pointer();
+
+  static boost::uuids::random_generator gen;
+
+  header *h = new (segment->data()) header;
+  h->magic = ring_magic;
+  h->nonce = gen();
+  h->capacity = capacity;
+  h->head.store(0);
+  h->tail.store(0);
+
+  return shared_ring_pointer(new shared_ring(segment));
+}
+
+shared_ring_pointer shared_ring::open(
+    std::string const &name, boost::uuids::uuid const &nonce)
+{
+  auto segment = shared_segment::open(name);
+  if (!segment || segment->size() < data_offset())
+    return shared_ring_pointer();
+
+  header const *h = (header const *)segment->data();
+  if (h->magic != ring_magic || h->nonce != nonce
+      || segment->size() != data_offset() + h->capacity)
+    return shared_ring_pointer();
+
+  return shared_ring_pointer(new shared_ring(segment));
+}
+
+std::string const &shared_ring::name() const
+{
+  return segment_->name();
+}
+
+boost::uuids::uuid const &shared_ring::nonce() const
+{
+  return ((header const *)segment_->data())->nonce;
+}
+
+size_t shared_ring::capacity() const
+{
+  return ((header const *)segment_->data())->capacity;
+}
+
+shared_ring::header *shared_ring::get_header()
+{
+  return (header *)segment_->data();
+}
+
+char *shared_ring::at(uint64_t pos)
+{
+  return segment_->data() + data_offset() + pos % capacity();
+}
+
+bool shared_ring::write(char const *data, size_t size, uint64_t &begin)
+{
+  header *h = get_header();
+  uint64_t cap = h->capacity;
+
+  if (size == 0 || size > cap)
+    return false;
+
+  uint64_t pos = h->head.load(std::memory_order_relaxed);
+  uint64_t tail = h->tail.load(std::memory_order_acquire);
+
+  // Data is always contiguous, skip what's left at the end
+  if (pos % cap + size > cap)
+    pos += cap - pos % cap;
+
+  if (pos + size - tail > cap)
+    return false;
+
+  memcpy(at(pos), data, size);
+  h->head.store(pos + size, std::memory_order_release);
+
+  begin = pos;
+  return true;
+}
+
+char *shared_ring::acquire(uint64_t begin, uint64_t end)
+{
+  uint64_t cap = capacity();
+  if (end <= begin || end - begin > cap || begin % cap + (end - begin) > cap)
+    return nullptr;
+
+  std::unique_lock<std::mutex> l(mutex_);
+  if (!acquired_.empty() && begin < acquired_.back().end)
+    return nullptr;
+  acquired_.push_back({begin, end, false});
+
+  return at(begin);
+}
+
+void shared_ring::release(uint64_t begin)
+{
+  std::unique_lock<std::mutex> l(mutex_);
+
+  auto it = std::find_if(acquired_.begin(),
+      acquired_.end(),
+      [begin](range const &r) { return r.begin == begin; });
+  if (it == acquired_.end())
+    return;
+
+  it->released = true;
+
+  // Space is handed back to the producer in order
+  uint64_t tail = 0;
+  bool advanced = false;
+  while (!acquired_.empty() && acquired_.front().released) {
+    tail = acquired_.front().end;
+    advanced = true;
+    acquired_.pop_front();
+  }
+
+  if (advanced)
+    get_header()->tail.store(tail, std::memory_order_release);
+}
@@ -0,0 +1,135 @@
+// Copyright 2023-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <boost/uuid/uuid.hpp>
+
+namespace async {
+
+class shared_segment;
+class shared_ring;
+
+using shared_segment_pointer = std::shared_ptr<shared_segment>;
+using shared_ring_pointer = std::shared_ptr<shared_ring>;
+
+// Returns true if shared memory is supported on this platform and was not
+// disabled by setting ANARI_REMOTE_SHARED_MEMORY=0
+bool shared_memory_enabled();
+
+// Returns a new, unique name for a shared memory segment
+std::string make_shared_memory_name();
+
+//--------------------------------------------------------------------------------------------------
+// shared_segment
+//
+
+// A named POSIX shared memory segment mapped into this process
+class shared_segment
+{
+ public:
+  // Creates a new segment of the given size; only this user can open it.
+  // Returns null on failure.
+  static shared_segment_pointer create(std::string const &name, size_t size);
+
+  // Maps an existing segment. Returns null on failure.
+  static shared_segment_pointer open(std::string const &name);
+
+  // Removes the name; the memory stays valid until all mappings are gone
+  static void unlink(std::string const &name);
+
+  ~shared_segment();
+
+  char *data()
+  {
+    return data_;
+  }
+
+  size_t size() const
+  {
+    return size_;
+  }
+
+  std::string const &name() const
+  {
+    return name_;
+  }
+
+ private:
+  shared_segment(std::string const &name, char *data, size_t size);
+
+  std::string name_;
+  char *data_;
+  size_t size_;
+};
+
+//--------------------------------------------------------------------------------------------------
+// shared_ring
+//
+
+// A single-producer, single-consumer byte ring buffer in shared memory.
+// The consumer creates the ring and hands its name and nonce to the
+// producer, which can only open it if both run on the same host.
+// Positions are absolute byte offsets that only ever grow.
+class shared_ring
+{
+  struct header;
+
+ public:
+  // Creates a ring for reading. Returns null on failure.
+  static shared_ring_pointer create(size_t capacity);
+
+  // Opens a ring created by the other side for writing. Returns null if the
+  // segment doesn't exist or doesn't carry the expected nonce.
+  static shared_ring_pointer open(
+      std::string const &name, boost::uuids::uuid const &nonce);
+
+  std::string const &name() const;
+
+  boost::uuids::uuid const &nonce() const;
+
+  size_t capacity() const;
+
+  // Producer: copies the data to the ring. Returns false if there's not
+  // enough free space; otherwise the data is stored at [begin, begin+size).
+  bool write(char const *data, size_t size, uint64_t &begin);
+
+  // Consumer: returns a pointer to the data stored at [begin, end) and
+  // keeps the range from being overwritten until release() is called
+  char *acquire(uint64_t begin, uint64_t end);
+
+  // Consumer: the data stored at begin is no longer needed. Ranges may be
+  // released in any order and from any thread.
+  void release(uint64_t begin);
+
+ private:
+  shared_ring(shared_segment_pointer segment);
+
+  header *get_header();
+
+  // Data starts at the first cache line after the header
+  static size_t data_offset();
+
+  char *at(uint64_t pos);
+
+  struct range
+  {
+    uint64_t begin;
+    uint64_t end;
+    bool released;
+  };
+
+  shared_segment_pointer segment_;
+  // Consumer: acquired ranges in order
+  std::deque<range> acquired_;
+  std::mutex mutex_;
+};
+
+} // namespace async
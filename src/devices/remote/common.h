@@ -49,6 +49,7 @@ struct MessageType
     ParameterInfo,
     ChannelColor,
     ChannelDepth,
+    FrameAck,
   };
 };
 
@@ -111,6 +112,8 @@ inline const char *toString(unsigned mt)
     return "CannelColor";
   case MessageType::ChannelDepth:
     return "ChannelDepth";
+  case MessageType::FrameAck:
+    return "FrameAck";
   default:
     return "Unknown";
   }
@@ -5,6 +5,8 @@
 
 #include "anari/anari_cpp.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 
 namespace sink_device {
@@ -88,6 +90,7 @@ ANARIArray3D SinkDevice::newArray3D(const void *appMemory,
 
 void *SinkDevice::mapArray(ANARIArray a)
 {
+  spin(delays.mapArray);
   if (auto obj = getObject(a)) {
     return const_cast<void *>(obj->memory);
   } else {
@@ -224,6 +227,11 @@ void frame_deleter(const void *userdata, const void *memory)
 void SinkDevice::setParameter(
     ANARIObject object, const char *name, ANARIDataType type, const void *mem)
 {
+  spin(delays.setParameter);
+  if (handleIsDevice(object)) {
+    setDeviceParameter(name, type, mem);
+    return;
+  }
   if (auto obj = getObject(object)) {
     if (obj->type == ANARI_FRAME) {
       FrameData *data =
@@ -249,6 +257,7 @@ void *SinkDevice::mapParameterArray1D(ANARIObject object,
     uint64_t numElements1,
     uint64_t *elementStride)
 {
+  spin(delays.mapArray);
   if (auto obj = getObject(object)) {
     if (elementStride)
       *elementStride = sizeOf(dataType);
@@ -265,6 +274,7 @@ void *SinkDevice::mapParameterArray2D(ANARIObject object,
     uint64_t numElements2,
     uint64_t *elementStride)
 {
+  spin(delays.mapArray);
   if (auto obj = getObject(object)) {
     if (elementStride)
       *elementStride = sizeOf(dataType);
@@ -282,6 +292,7 @@ void *SinkDevice::mapParameterArray3D(ANARIObject object,
     uint64_t numElements3,
     uint64_t *elementStride)
 {
+  spin(delays.mapArray);
   if (auto obj = getObject(object)) {
     if (elementStride)
       *elementStride = sizeOf(dataType);
@@ -294,7 +305,12 @@ void *SinkDevice::mapParameterArray3D(ANARIObject object,
 
 void SinkDevice::unmapParameterArray(ANARIObject object, const char *name) {}
 
-void SinkDevice::commitParameters(ANARIObject) {}
+void SinkDevice::commitParameters(ANARIObject object)
+{
+  spin(delays.commitParameters);
+  if (handleIsDevice(object))
+    delays = stagedDelays;
+}
 
 void SinkDevice::release(ANARIObject object)
 {
@@ -355,7 +371,10 @@ ANARIRenderer SinkDevice::newRenderer(const char *)
   return nextHandle<ANARIRenderer>();
 }
 
-void SinkDevice::renderFrame(ANARIFrame) {}
+void SinkDevice::renderFrame(ANARIFrame)
+{
+  spin(delays.renderFrame);
+}
 
 int SinkDevice::frameReady(ANARIFrame, ANARIWaitMask)
 {
@@ -371,6 +390,46 @@ SinkDevice::SinkDevice(ANARILibrary library) : DeviceImpl(library)
   nextHandle<ANARIObject>(); // insert a handle at 0
 }
 
+void SinkDevice::setDeviceParameter(
+    const char *name, ANARIDataType type, const void *mem)
+{
+  uint64_t value = 0;
+  if (mem == nullptr)
+    value = 0;
+  else if (type == ANARI_UINT64)
+    value = *static_cast<const uint64_t *>(mem);
+  else if (type == ANARI_INT64)
+    value = uint64_t(std::max<int64_t>(*static_cast<const int64_t *>(mem), 0));
+  else if (type == ANARI_UINT32)
+    value = *static_cast<const uint32_t *>(mem);
+  else if (type == ANARI_INT32)
+    value = uint64_t(std::max<int32_t>(*static_cast<const int32_t *>(mem), 0));
+  else
+    return;
+
+  if (std::strcmp(name, "setParameterDelay") == 0)
+    stagedDelays.setParameter = value;
+  else if (std::strcmp(name, "commitParametersDelay") == 0)
+    stagedDelays.commitParameters = value;
+  else if (std::strcmp(name, "newObjectDelay") == 0)
+    stagedDelays.newObject = value;
+  else if (std::strcmp(name, "mapArrayDelay") == 0)
+    stagedDelays.mapArray = value;
+  else if (std::strcmp(name, "renderFrameDelay") == 0)
+    stagedDelays.renderFrame = value;
+}
+
+void SinkDevice::spin(uint64_t nanoseconds)
+{
+  if (nanoseconds == 0)
+    return;
+  // sleeping is far too coarse for the sub-microsecond costs of most calls
+  auto end = std::chrono::steady_clock::now()
+      + std::chrono::nanoseconds(nanoseconds);
+  while (std::chrono::steady_clock::now() < end) {
+  }
+}
+
 const char **query_extensions();
 
 } // namespace sink_device
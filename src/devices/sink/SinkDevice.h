@@ -8,6 +8,7 @@
 // helium
 #include "helium/utility/IntrusivePtr.h"
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -157,6 +158,25 @@ struct SinkDevice : public anari::DeviceImpl, public helium::RefCounted
   ~SinkDevice() = default;
 
  private:
+  // Synthetic backend costs in nanoseconds, spent busy waiting so that front
+  // end overhead can be measured against a device of known cost. Set through
+  // the device parameters "<call>Delay", effective at the device commit.
+  struct Delays
+  {
+    uint64_t setParameter = 0;
+    uint64_t commitParameters = 0;
+    uint64_t newObject = 0;
+    uint64_t mapArray = 0;
+    uint64_t renderFrame = 0;
+  };
+
+  Delays delays;
+  Delays stagedDelays;
+
+  void setDeviceParameter(
+      const char *name, ANARIDataType type, const void *mem);
+  static void spin(uint64_t nanoseconds);
+
   struct Object
   {
     int64_t refcount = 1;
@@ -204,6 +224,7 @@ struct SinkDevice : public anari::DeviceImpl, public helium::RefCounted
   template <typename T>
   T nextHandle()
   {
+    spin(delays.newObject);
     uintptr_t next = objects.size();
     objects.emplace_back(new Object(ANARITypeFor<T>::value));
     return reinterpret_cast<T>(next);
@@ -6,9 +6,21 @@
 #include "array/Array.h"
 // anari
 #include "anari/backend/LibraryImpl.h"
+// std
+#include <vector>
 
 namespace helium {
 
+// Applies one anariSetParameter() value, returns whether the object changed
+static bool setObjectParameter(
+    BaseObject &o, const char *name, ANARIDataType type, const void *mem)
+{
+  if (anari::isObject(type) && mem == nullptr)
+    return o.removeParam(name);
+  else
+    return o.setParam(name, type, mem);
+}
+
 // Data Arrays ////////////////////////////////////////////////////////////////
 
 void *BaseDevice::mapArray(ANARIArray a)
@@ -55,17 +67,129 @@ void BaseDevice::setParameter(
     return;
   }
 
+  auto &o = referenceFromHandle(object);
+  if (setObjectParameter(o, name, type, mem))
+    o.markParameterChanged();
+}
+
+void BaseDevice::setParameters(
+    ANARIObject object, const ANARIParameterValue *params, uint64_t count)
+{
+  auto lock = getObjectLock(object);
+
+  if (handleIsDevice(object)) {
+    for (uint64_t i = 0; i < count; i++)
+      deviceSetParameter(params[i].name, params[i].type, params[i].value);
+    return;
+  }
+
   bool valueChanged = false;
   auto &o = referenceFromHandle(object);
-  if (anari::isObject(type) && mem == nullptr)
-    valueChanged = o.removeParam(name);
-  else
-    valueChanged = o.setParam(name, type, mem);
+  for (uint64_t i = 0; i < count; i++) {
+    valueChanged |= setObjectParameter(
+        o, params[i].name, params[i].type, params[i].value);
+  }
 
   if (valueChanged)
     o.markParameterChanged();
 }
 
+void BaseDevice::setParameterOnObjects(const ANARIObject *objects,
+    uint64_t count,
+    const char *name,
+    ANARIDataType type,
+    const void *values,
+    uint64_t valueStride)
+{
+  auto *value = static_cast<const uint8_t *>(values);
+  for (uint64_t i = 0; i < count; i++) {
+    const void *mem = value ? value + i * valueStride : nullptr;
+    if (handleIsDevice(objects[i])) {
+      setParameter(objects[i], name, type, mem);
+      continue;
+    }
+
+    auto lock = getObjectLock(objects[i]);
+    auto &o = referenceFromHandle(objects[i]);
+    if (setObjectParameter(o, name, type, mem))
+      o.markParameterChanged();
+  }
+}
+
+void BaseDevice::submitCommandBuffer(anari::CommandBuffer &buffer)
+{
+  // Parameters are applied and snapshotted in recorded order, but committed
+  // objects only reach the commit buffer together at the end, so a frame
+  // started meanwhile sees none of the buffer's commits. Releases come last
+  // as a released object may still be waiting to be enqueued.
+  std::vector<BaseObject *> committed;
+  std::vector<ANARIObject> released;
+
+  anari::CommandBuffer::Command cmd;
+  size_t offset = 0;
+  bool more = buffer.next(offset, cmd);
+  while (more) {
+    if (cmd.op == anari::CommandBuffer::NEW_OBJECT) {
+      buffer.setObject(cmd.object, newObjectOfType(cmd.type, cmd.name));
+      more = buffer.next(offset, cmd);
+      continue;
+    }
+
+    if (cmd.object == nullptr) {
+      more = buffer.next(offset, cmd);
+      continue;
+    }
+
+    if (handleIsDevice(cmd.object)) {
+      if (cmd.op == anari::CommandBuffer::SET_PARAMETER)
+        setParameter(cmd.object, cmd.name, cmd.type, cmd.value);
+      else if (cmd.op == anari::CommandBuffer::UNSET_PARAMETER)
+        unsetParameter(cmd.object, cmd.name);
+      else if (cmd.op == anari::CommandBuffer::COMMIT_PARAMETERS)
+        commitParameters(cmd.object);
+      else if (cmd.op == anari::CommandBuffer::RELEASE)
+        released.push_back(cmd.object);
+      more = buffer.next(offset, cmd);
+      continue;
+    }
+
+    // Consecutive commands on the same object are applied under one lock
+    ANARIObject handle = cmd.object;
+    auto &o = referenceFromHandle(handle);
+    auto lock = o.scopeLockObject();
+    do {
+      switch (cmd.op) {
+      case anari::CommandBuffer::SET_PARAMETER:
+        if (setObjectParameter(o, cmd.name, cmd.type, cmd.value))
+          o.markParameterChanged();
+        break;
+      case anari::CommandBuffer::UNSET_PARAMETER:
+        if (o.removeParam(cmd.name))
+          o.markParameterChanged();
+        break;
+      case anari::CommandBuffer::COMMIT_PARAMETERS:
+        o.snapshotParameters();
+        committed.push_back(&o);
+        break;
+      case anari::CommandBuffer::RELEASE:
+        released.push_back(handle);
+        break;
+      default:
+        break;
+      }
+      more = buffer.next(offset, cmd);
+    } while (more && cmd.op != anari::CommandBuffer::NEW_OBJECT
+        && cmd.object == handle);
+  }
+
+  if (!committed.empty()) {
+    m_state->commitBuffer.addObjectsToCommit(
+        committed.data(), committed.size());
+  }
+  for (auto o : released)
+    release(o);
+}
+
 void BaseDevice::unsetParameter(ANARIObject o, const char *name)
 {
   auto lock = getObjectLock(o);
@@ -47,6 +47,18 @@ struct BaseDevice : public anari::DeviceImpl,
       ANARIDataType type,
       const void *mem) override;
 
+  void setParameters(ANARIObject o,
+      const ANARIParameterValue *params,
+      uint64_t count) override;
+  void setParameterOnObjects(const ANARIObject *objects,
+      uint64_t count,
+      const char *name,
+      ANARIDataType type,
+      const void *values,
+      uint64_t valueStride) override;
+
+  void submitCommandBuffer(anari::CommandBuffer &buffer) override;
+
   void unsetParameter(ANARIObject o, const char *name) override;
   void unsetAllParameters(ANARIObject o) override;
 
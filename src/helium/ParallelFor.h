@@ -0,0 +1,95 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace helium::tasking {
+
+/*
+ * Number of threads parallelFor() runs `count` items on: `threads`, or the
+ * hardware concurrency when 0, but never more than there are items.
+ */
+uint32_t parallelThreadCount(size_t count, uint32_t threads);
+
+/*
+ * Calls f(i) for every i in [0, count), spread over parallelThreadCount()
+ * threads, the calling thread being one of them. Items are handed out one at
+ * a time in increasing order, so uneven items balance out.
+ *
+ * f may instead take (i, worker), where worker in [0, parallelThreadCount())
+ * identifies the calling thread, e.g. to index per-thread scratch space.
+ *
+ * Once a call throws no new items are started, and the first exception is
+ * rethrown after every thread has finished.
+ *
+ * Example:
+ *   parallelFor(images.size(), 0, [&](size_t i) { process(images[i]); });
+ */
+template <typename F>
+void parallelFor(size_t count, uint32_t threads, F &&f);
+
+// Inlined definitions ////////////////////////////////////////////////////////
+
+inline uint32_t parallelThreadCount(size_t count, uint32_t threads)
+{
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  return uint32_t(std::min<size_t>(threads, count));
+}
+
+template <typename F>
+inline void parallelFor(size_t count, uint32_t threads, F &&f)
+{
+  auto call = [&](size_t i, uint32_t worker) {
+    if constexpr (std::is_invocable_v<F &, size_t, uint32_t>)
+      f(i, worker);
+    else
+      f(i);
+  };
+
+  threads = parallelThreadCount(count, threads);
+  if (threads <= 1) {
+    for (size_t i = 0; i < count; ++i)
+      call(i, 0);
+    return;
+  }
+
+  std::atomic<size_t> next{0};
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  auto work = [&](uint32_t worker) {
+    for (size_t i; (i = next.fetch_add(1)) < count;) {
+      try {
+        call(i, worker);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error)
+          error = std::current_exception();
+        next = count;
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (uint32_t i = 1; i < threads; ++i)
+    workers.emplace_back(work, i);
+  work(0);
+  for (auto &t : workers)
+    t.join();
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+} // namespace helium::tasking
@@ -44,6 +44,16 @@ void DeferredCommitBuffer::addObjectToCommit(BaseObject *obj)
   m_commitBufferStaging.push_back(obj);
 }
 
+void DeferredCommitBuffer::addObjectsToCommit(
+    BaseObject *const *objs, size_t count)
+{
+  std::lock_guard<std::recursive_mutex> guard(m_swapMutex);
+  for (size_t i = 0; i < count; i++) {
+    objs[i]->refInc(RefType::INTERNAL);
+    m_commitBufferStaging.push_back(objs[i]);
+  }
+}
+
 void DeferredCommitBuffer::addObjectToFinalize(BaseObject *obj)
 {
   std::lock_guard<std::recursive_mutex> guard(m_swapMutex);
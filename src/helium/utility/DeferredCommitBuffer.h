@@ -34,6 +34,10 @@ struct DeferredCommitBuffer
   // buffer if-needed (don't do this at the call site).
   void addObjectToCommit(BaseObject *obj);
 
+  // Add several objects to be committed at once, a concurrent flush() either
+  // sees all of them or none.
+  void addObjectsToCommit(BaseObject *const *objs, size_t count);
+
   // Add an object to be finalized only.
   void addObjectToFinalize(BaseObject *obj);
 
@@ -0,0 +1,242 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures the per-call overhead of each validation level of the debug device
+// on a parameter heavy workload, relative to calling the wrapped device
+// directly.
+
+#include "anari/anari_cpp.hpp"
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Global variables
+static std::string g_libraryName = "sink";
+static std::string g_deviceName = "default";
+static uint32_t g_objects = 1000;
+static uint32_t g_iterations = 100;
+static uint32_t g_repeats = 5;
+static uint32_t g_sampleRate = 16;
+static uint64_t g_messages = 0;
+
+static void statusFunc(const void *,
+    ANARIDevice,
+    ANARIObject,
+    ANARIDataType,
+    ANARIStatusSeverity severity,
+    ANARIStatusCode,
+    const char *message)
+{
+  if (severity == ANARI_SEVERITY_FATAL_ERROR)
+    fprintf(stderr, "[FATAL] %s\n", message);
+  else if (severity <= ANARI_SEVERITY_WARNING)
+    g_messages++;
+}
+
+static void printUsage()
+{
+  std::cout << "./anariDebugBenchmark [{--help|-h}]\n"
+            << "   [{--library|-l} <wrapped ANARI library>]\n"
+            << "   [{--device|-d} <device subtype>]\n"
+            << "   [{--objects|-n} <surfaces>]\n"
+            << "   [{--iterations|-i} <updates per surface>]\n"
+            << "   [{--repeats|-r} <runs, the fastest counts>]\n"
+            << "   [{--sample-rate|-s} <N of the sampled level>]\n";
+}
+
+static void parseCommandLine(int argc, char *argv[])
+{
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      printUsage();
+      std::exit(0);
+    } else if ((arg == "-l" || arg == "--library") && i + 1 < argc)
+      g_libraryName = argv[++i];
+    else if ((arg == "-d" || arg == "--device") && i + 1 < argc)
+      g_deviceName = argv[++i];
+    else if ((arg == "-n" || arg == "--objects") && i + 1 < argc)
+      g_objects = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+    else if ((arg == "-i" || arg == "--iterations") && i + 1 < argc)
+      g_iterations = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+    else if ((arg == "-r" || arg == "--repeats") && i + 1 < argc)
+      g_repeats = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+    else if ((arg == "-s" || arg == "--sample-rate") && i + 1 < argc)
+      g_sampleRate = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+    else {
+      printUsage();
+      std::exit(1);
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Updates the parameters of many small surfaces, as an application animating
+// materials and swapping geometry would
+struct Workload
+{
+  static const uint64_t callsPerUpdate = 8;
+
+  ANARIDevice device{nullptr};
+  ANARIArray1D vertices{nullptr};
+  std::vector<ANARIGeometry> geometries;
+  std::vector<ANARIMaterial> materials;
+  std::vector<ANARISurface> surfaces;
+  // fastest pass so far in nanoseconds per API call
+  double best{0.0};
+
+  void create(ANARIDevice d);
+  void pass();
+  void release();
+};
+
+void Workload::create(ANARIDevice d)
+{
+  static float positions[9] = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+  device = d;
+  vertices = anariNewArray1D(
+      d, positions, nullptr, nullptr, ANARI_FLOAT32_VEC3, 3);
+
+  geometries.resize(g_objects);
+  materials.resize(g_objects);
+  surfaces.resize(g_objects);
+  for (uint32_t i = 0; i < g_objects; i++) {
+    geometries[i] = anariNewGeometry(d, "triangle");
+    materials[i] = anariNewMaterial(d, "matte");
+    surfaces[i] = anariNewSurface(d);
+  }
+}
+
+void Workload::pass()
+{
+  ANARIDevice d = device;
+  auto start = Clock::now();
+  for (uint32_t it = 0; it < g_iterations; it++) {
+    for (uint32_t i = 0; i < g_objects; i++) {
+      float color[3] = {float(it % 7) / 7.f, float(i % 5) / 5.f, 0.5f};
+      float opacity = float(it % 3) / 3.f;
+      anariSetParameter(d, materials[i], "color", ANARI_FLOAT32_VEC3, color);
+      anariSetParameter(d, materials[i], "opacity", ANARI_FLOAT32, &opacity);
+      anariCommitParameters(d, materials[i]);
+      anariSetParameter(
+          d, geometries[i], "vertex.position", ANARI_ARRAY1D, &vertices);
+      anariCommitParameters(d, geometries[i]);
+      anariSetParameter(
+          d, surfaces[i], "geometry", ANARI_GEOMETRY, &geometries[i]);
+      anariSetParameter(
+          d, surfaces[i], "material", ANARI_MATERIAL, &materials[i]);
+      anariCommitParameters(d, surfaces[i]);
+    }
+  }
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  double ns =
+      seconds * 1e9 / (double(g_iterations) * g_objects * callsPerUpdate);
+  best = best == 0.0 ? ns : std::min(best, ns);
+}
+
+void Workload::release()
+{
+  for (uint32_t i = 0; i < g_objects; i++) {
+    anariRelease(device, surfaces[i]);
+    anariRelease(device, materials[i]);
+    anariRelease(device, geometries[i]);
+  }
+  anariRelease(device, vertices);
+  anariRelease(device, device);
+}
+
+static ANARIDevice newWrappedDevice()
+{
+  ANARILibrary lib =
+      anariLoadLibrary(g_libraryName.c_str(), statusFunc, nullptr);
+  if (!lib)
+    return nullptr;
+  ANARIDevice d = anariNewDevice(lib, g_deviceName.c_str());
+  if (d)
+    anariCommitParameters(d, d);
+  return d;
+}
+
+int main(int argc, char *argv[])
+{
+  parseCommandLine(argc, argv);
+
+  ANARILibrary debugLib = anariLoadLibrary("debug", statusFunc, nullptr);
+  if (!debugLib) {
+    fprintf(stderr, "cannot load the debug device library\n");
+    return 1;
+  }
+
+  const char *levels[] = {"direct", "off", "handles", "sampled", "full"};
+  const int levelCount = 5;
+  Workload workloads[levelCount];
+  uint64_t messages[levelCount] = {};
+
+  for (int l = 0; l < levelCount; l++) {
+    ANARIDevice wrapped = newWrappedDevice();
+    if (!wrapped) {
+      fprintf(stderr,
+          "cannot create a '%s' device from library '%s'\n",
+          g_deviceName.c_str(),
+          g_libraryName.c_str());
+      return 1;
+    }
+    if (l == 0) {
+      workloads[l].create(wrapped);
+      continue;
+    }
+    ANARIDevice d = anariNewDevice(debugLib, "default");
+    anariSetParameter(d, d, "wrappedDevice", ANARI_DEVICE, &wrapped);
+    anariSetParameter(d, d, "validation", ANARI_STRING, levels[l]);
+    anariSetParameter(
+        d, d, "validationSampleRate", ANARI_UINT32, &g_sampleRate);
+    anariCommitParameters(d, d);
+    anariRelease(wrapped, wrapped);
+    workloads[l].create(d);
+  }
+
+  // interleave the levels so that drifting machine load affects all alike
+  for (uint32_t r = 0; r < g_repeats; r++) {
+    for (int l = 0; l < levelCount; l++) {
+      g_messages = 0;
+      workloads[l].pass();
+      messages[l] += g_messages;
+    }
+  }
+
+  printf("%u surfaces x %u updates x %d calls, library '%s', best of %u\n",
+      g_objects,
+      g_iterations,
+      int(Workload::callsPerUpdate),
+      g_libraryName.c_str(),
+      g_repeats);
+  printf("%-10s %10s %12s %12s %10s\n",
+      "level",
+      "ns/call",
+      "vs direct",
+      "vs off",
+      "messages");
+  for (int l = 0; l < levelCount; l++) {
+    double ns = workloads[l].best;
+    printf("%-10s %10.1f %+11.1f%% %+11.1f%% %10llu\n",
+        levels[l],
+        ns,
+        (ns / workloads[0].best - 1.0) * 100.0,
+        (ns / workloads[1].best - 1.0) * 100.0,
+        (unsigned long long)messages[l]);
+  }
+
+  for (int l = 0; l < levelCount; l++)
+    workloads[l].release();
+  anariUnloadLibrary(debugLib);
+  return 0;
+}
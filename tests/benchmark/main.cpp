@@ -0,0 +1,349 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures what the front end costs per API call: anariSetParameter(),
+// anariCommitParameters(), anariNewArray1D() and anariMapArray() go through
+// API.cpp into the sink device (which does nothing unless given synthetic
+// delays), the debug device layered on sink, and helium based devices.
+// Allocations are counted by replacing the global operator new, which the
+// device libraries resolve to as well.
+
+#include "anari/anari_cpp.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Allocation counting ////////////////////////////////////////////////////////
+
+static std::atomic<uint64_t> g_allocations{0};
+
+void *operator new(std::size_t size)
+{
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  return std::malloc(size ? size : 1);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &t) noexcept
+{
+  return operator new(size, t);
+}
+
+void operator delete(void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+// Global variables ///////////////////////////////////////////////////////////
+
+static std::vector<std::string> g_libraries = {
+    "sink", "debug", "hecore", "helide"};
+static uint32_t g_iterations = 100000;
+static uint32_t g_repeats = 5;
+static std::string g_validation = "full";
+static std::string g_jsonFile;
+// sink device parameter name and value of each --delay
+static std::vector<std::pair<std::string, uint64_t>> g_delays;
+
+static void statusFunc(const void *,
+    ANARIDevice,
+    ANARIObject,
+    ANARIDataType,
+    ANARIStatusSeverity severity,
+    ANARIStatusCode,
+    const char *message)
+{
+  if (severity <= ANARI_SEVERITY_ERROR)
+    fprintf(stderr, "[ERROR] %s\n", message);
+}
+
+static void printUsage()
+{
+  std::cout
+      << "./anariFrontendBenchmark [{--help|-h}]\n"
+      << "   [{--libraries|-l} <comma separated, default "
+         "sink,debug,hecore,helide>]\n"
+      << "   [{--iterations|-i} <calls per pass>]\n"
+      << "   [{--repeats|-r} <passes, the fastest counts>]\n"
+      << "   [--validation <validation level of the debug device>]\n"
+      << "   [--delay <call>=<ns>] sink cost of setParameter, "
+         "commitParameters,\n"
+      << "                         newObject, mapArray or renderFrame\n"
+      << "   [--json <file>]\n\n"
+      << "'debug' is the debug device layered on sink, libraries which "
+         "cannot be\nloaded are skipped.\n";
+}
+
+static std::vector<std::string> splitList(const std::string &list)
+{
+  std::vector<std::string> items;
+  size_t start = 0;
+  while (start <= list.size()) {
+    size_t end = std::min(list.find(',', start), list.size());
+    if (end > start)
+      items.push_back(list.substr(start, end - start));
+    start = end + 1;
+  }
+  return items;
+}
+
+static void parseCommandLine(int argc, char *argv[])
+{
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      printUsage();
+      std::exit(0);
+    } else if ((arg == "-l" || arg == "--libraries") && i + 1 < argc)
+      g_libraries = splitList(argv[++i]);
+    else if ((arg == "-i" || arg == "--iterations") && i + 1 < argc)
+      g_iterations = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+    else if ((arg == "-r" || arg == "--repeats") && i + 1 < argc)
+      g_repeats = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+    else if (arg == "--validation" && i + 1 < argc)
+      g_validation = argv[++i];
+    else if (arg == "--json" && i + 1 < argc)
+      g_jsonFile = argv[++i];
+    else if (arg == "--delay" && i + 1 < argc) {
+      std::string delay = argv[++i];
+      size_t eq = delay.find('=');
+      if (eq == std::string::npos) {
+        printUsage();
+        std::exit(1);
+      }
+      g_delays.emplace_back(delay.substr(0, eq) + "Delay",
+          std::strtoull(delay.c_str() + eq + 1, nullptr, 10));
+    } else {
+      printUsage();
+      std::exit(1);
+    }
+  }
+  g_iterations = std::max(g_iterations, 1u);
+  g_repeats = std::max(g_repeats, 1u);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Result
+{
+  std::string device;
+  std::string call;
+  double nsPerCall{0.0};
+  double allocationsPerCall{0.0};
+};
+
+// Each pass makes 'calls' API calls per iteration
+struct Pass
+{
+  const char *call;
+  int calls;
+  void (*run)(ANARIDevice, ANARIObject, uint32_t);
+};
+
+static void runSetParameter(ANARIDevice d, ANARIObject o, uint32_t iterations)
+{
+  for (uint32_t i = 0; i < iterations; i++) {
+    float color[3] = {float(i & 7) / 7.f, 0.5f, 0.25f};
+    anariSetParameter(d, o, "color", ANARI_FLOAT32_VEC3, color);
+  }
+}
+
+static void runCommitParameters(
+    ANARIDevice d, ANARIObject o, uint32_t iterations)
+{
+  for (uint32_t i = 0; i < iterations; i++)
+    anariCommitParameters(d, o);
+}
+
+static void runNewArray1D(ANARIDevice d, ANARIObject, uint32_t iterations)
+{
+  static float positions[9] = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+  for (uint32_t i = 0; i < iterations; i++) {
+    ANARIArray1D a =
+        anariNewArray1D(d, positions, nullptr, nullptr, ANARI_FLOAT32_VEC3, 3);
+    anariRelease(d, a);
+  }
+}
+
+static void runMapArray(ANARIDevice d, ANARIObject, uint32_t iterations)
+{
+  ANARIArray1D a =
+      anariNewArray1D(d, nullptr, nullptr, nullptr, ANARI_FLOAT32_VEC3, 3);
+  for (uint32_t i = 0; i < iterations; i++) {
+    anariMapArray(d, a);
+    anariUnmapArray(d, a);
+  }
+  anariRelease(d, a);
+}
+
+static const Pass g_passes[] = {
+    {"anariSetParameter", 1, runSetParameter},
+    {"anariCommitParameters", 1, runCommitParameters},
+    {"anariNewArray1D+anariRelease", 2, runNewArray1D},
+    {"anariMapArray+anariUnmapArray", 2, runMapArray}};
+
+static ANARIDevice newDevice(const std::string &name, ANARILibrary &lib)
+{
+  lib = anariLoadLibrary(name.c_str(), statusFunc, nullptr);
+  if (!lib)
+    return nullptr;
+  ANARIDevice d = anariNewDevice(lib, "default");
+  if (d && name == "sink") {
+    for (auto &delay : g_delays) {
+      anariSetParameter(
+          d, d, delay.first.c_str(), ANARI_UINT64, &delay.second);
+    }
+  }
+  if (d)
+    anariCommitParameters(d, d);
+  return d;
+}
+
+static void benchmarkDevice(const std::string &name,
+    ANARIDevice d,
+    std::vector<Result> &results)
+{
+  ANARIMaterial material = anariNewMaterial(d, "matte");
+
+  for (const auto &pass : g_passes) {
+    // warm up caches and any lazily grown device storage first
+    pass.run(d, material, std::min(g_iterations, 1000u));
+
+    Result r;
+    r.device = name;
+    r.call = pass.call;
+    for (uint32_t rep = 0; rep < g_repeats; rep++) {
+      uint64_t allocations = g_allocations.load();
+      auto start = Clock::now();
+      pass.run(d, material, g_iterations);
+      double seconds =
+          std::chrono::duration<double>(Clock::now() - start).count();
+      double calls = double(g_iterations) * pass.calls;
+      double ns = seconds * 1e9 / calls;
+      double allocs = double(g_allocations.load() - allocations) / calls;
+      r.nsPerCall = rep == 0 ? ns : std::min(r.nsPerCall, ns);
+      r.allocationsPerCall =
+          rep == 0 ? allocs : std::min(r.allocationsPerCall, allocs);
+    }
+    results.push_back(r);
+  }
+
+  anariRelease(d, material);
+}
+
+static bool writeJson(const std::vector<Result> &results)
+{
+  FILE *file = std::fopen(g_jsonFile.c_str(), "w");
+  if (!file)
+    return false;
+  std::fprintf(file, "[\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto &r = results[i];
+    std::fprintf(file,
+        "  {\"device\": \"%s\", \"call\": \"%s\", \"nsPerCall\": %.2f, "
+        "\"allocationsPerCall\": %.3f}%s\n",
+        r.device.c_str(),
+        r.call.c_str(),
+        r.nsPerCall,
+        r.allocationsPerCall,
+        i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(file, "]\n");
+  std::fclose(file);
+  return true;
+}
+
+int main(int argc, char *argv[])
+{
+  parseCommandLine(argc, argv);
+
+  std::vector<Result> results;
+
+  for (const auto &name : g_libraries) {
+    ANARILibrary lib = nullptr;
+    ANARILibrary wrappedLib = nullptr;
+    ANARIDevice d = nullptr;
+
+    if (name == "debug") {
+      ANARIDevice wrapped = newDevice("sink", wrappedLib);
+      if (wrapped) {
+        lib = anariLoadLibrary("debug", statusFunc, nullptr);
+        d = lib ? anariNewDevice(lib, "default") : nullptr;
+        if (d) {
+          anariSetParameter(d, d, "wrappedDevice", ANARI_DEVICE, &wrapped);
+          anariSetParameter(
+              d, d, "validation", ANARI_STRING, g_validation.c_str());
+          anariCommitParameters(d, d);
+        }
+        anariRelease(wrapped, wrapped);
+      }
+    } else
+      d = newDevice(name, lib);
+
+    if (!d) {
+      printf("skipping '%s', the library cannot be loaded\n", name.c_str());
+    } else {
+      benchmarkDevice(name, d, results);
+      anariRelease(d, d);
+    }
+    if (lib)
+      anariUnloadLibrary(lib);
+    if (wrappedLib)
+      anariUnloadLibrary(wrappedLib);
+  }
+
+  printf("%u calls per pass, best of %u\n", g_iterations, g_repeats);
+  printf("%-8s %-30s %10s %12s\n", "device", "call", "ns/call", "allocs/call");
+  for (const auto &r : results) {
+    printf("%-8s %-30s %10.1f %12.3f\n",
+        r.device.c_str(),
+        r.call.c_str(),
+        r.nsPerCall,
+        r.allocationsPerCall);
+  }
+
+  if (!g_jsonFile.empty() && !writeJson(results)) {
+    fprintf(stderr, "cannot write '%s'\n", g_jsonFile.c_str());
+    return 1;
+  }
+
+  return results.empty() ? 1 : 0;
+}
@@ -0,0 +1,207 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures the CTS image metrics, cts::ssim() and cts::psnr(), at sizes from
+// the CTS default of 256x256 up to 4K, with SSIM on one thread and on several.
+// The images are noise with a smooth gradient underneath, so the scores are
+// neither trivially 1 nor degenerate.
+
+#include "cts/Image.h"
+#include "cts/Metrics.h"
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using anari::cts::Image;
+
+// Global variables ///////////////////////////////////////////////////////////
+
+static std::vector<std::string> g_sizes = {
+    "256x256", "512x512", "1024x1024", "1920x1080", "3840x2160"};
+static std::vector<uint32_t> g_threads = {1, 0};
+static uint32_t g_repeats = 5;
+static std::string g_jsonFile;
+
+static void printUsage()
+{
+  std::cout
+      << "./anariMetricsBenchmark [{--help|-h}]\n"
+      << "   [{--sizes|-s} <comma separated WxH, default "
+         "256x256,...,3840x2160>]\n"
+      << "   [{--threads|-t} <comma separated SSIM thread counts, 0 is one "
+         "per\n"
+      << "                    hardware thread, default 1,0>]\n"
+      << "   [{--repeats|-r} <passes, the fastest counts>]\n"
+      << "   [--json <file>]\n";
+}
+
+static std::vector<std::string> splitList(const std::string &list)
+{
+  std::vector<std::string> items;
+  size_t start = 0;
+  while (start <= list.size()) {
+    size_t end = std::min(list.find(',', start), list.size());
+    if (end > start)
+      items.push_back(list.substr(start, end - start));
+    start = end + 1;
+  }
+  return items;
+}
+
+static void parseCommandLine(int argc, char *argv[])
+{
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      printUsage();
+      std::exit(0);
+    } else if ((arg == "-s" || arg == "--sizes") && i + 1 < argc)
+      g_sizes = splitList(argv[++i]);
+    else if ((arg == "-t" || arg == "--threads") && i + 1 < argc) {
+      g_threads.clear();
+      for (const auto &t : splitList(argv[++i]))
+        g_threads.push_back(uint32_t(std::strtoul(t.c_str(), nullptr, 10)));
+    } else if ((arg == "-r" || arg == "--repeats") && i + 1 < argc)
+      g_repeats = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+    else if (arg == "--json" && i + 1 < argc)
+      g_jsonFile = argv[++i];
+    else {
+      printUsage();
+      std::exit(1);
+    }
+  }
+  g_repeats = std::max(g_repeats, 1u);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Result
+{
+  uint32_t width{0};
+  uint32_t height{0};
+  std::string metric;
+  uint32_t threads{1};
+  double ms{0.0};
+  double score{0.0};
+};
+
+static Image makeImage(uint32_t w, uint32_t h, uint32_t seed)
+{
+  std::mt19937 rng(seed);
+  Image img;
+  img.width = w;
+  img.height = h;
+  img.rgba.resize(size_t(w) * h * 4);
+  for (uint32_t y = 0; y < h; y++) {
+    for (uint32_t x = 0; x < w; x++) {
+      uint8_t *p = &img.rgba[(size_t(y) * w + x) * 4];
+      const int base = int((x + y) * 255 / (w + h));
+      for (int c = 0; c < 3; c++)
+        p[c] = uint8_t(std::clamp(base + int(rng() % 32) - 16, 0, 255));
+      p[3] = 255;
+    }
+  }
+  return img;
+}
+
+template <typename F>
+static Result measure(
+    uint32_t w, uint32_t h, const char *metric, uint32_t threads, F &&f)
+{
+  Result r;
+  r.width = w;
+  r.height = h;
+  r.metric = metric;
+  r.threads = threads;
+  for (uint32_t rep = 0; rep < g_repeats; rep++) {
+    auto start = Clock::now();
+    r.score = f();
+    double ms =
+        std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    r.ms = rep == 0 ? ms : std::min(r.ms, ms);
+  }
+  return r;
+}
+
+static bool writeJson(const std::vector<Result> &results)
+{
+  FILE *file = std::fopen(g_jsonFile.c_str(), "w");
+  if (!file)
+    return false;
+  std::fprintf(file, "[\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto &r = results[i];
+    std::fprintf(file,
+        "  {\"width\": %u, \"height\": %u, \"metric\": \"%s\", "
+        "\"threads\": %u, \"ms\": %.3f, \"score\": %.9f}%s\n",
+        r.width,
+        r.height,
+        r.metric.c_str(),
+        r.threads,
+        r.ms,
+        r.score,
+        i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(file, "]\n");
+  std::fclose(file);
+  return true;
+}
+
+int main(int argc, char *argv[])
+{
+  parseCommandLine(argc, argv);
+
+  std::vector<Result> results;
+  for (const auto &size : g_sizes) {
+    uint32_t w = 0, h = 0;
+    if (std::sscanf(size.c_str(), "%ux%u", &w, &h) != 2 || !w || !h) {
+      fprintf(stderr, "invalid size '%s'\n", size.c_str());
+      return 1;
+    }
+    const Image a = makeImage(w, h, 1);
+    const Image b = makeImage(w, h, 2);
+
+    results.push_back(measure(
+        w, h, "psnr", 1, [&]() { return anari::cts::psnr(a, b); }));
+    for (uint32_t threads : g_threads) {
+      results.push_back(measure(w, h, "ssim", threads, [&]() {
+        return anari::cts::ssim(a, b, threads);
+      }));
+    }
+  }
+
+  printf("best of %u, threads 0 is one per hardware thread\n", g_repeats);
+  printf("%-10s %-6s %8s %10s %12s %10s\n",
+      "size",
+      "metric",
+      "threads",
+      "ms",
+      "Mpixel/s",
+      "score");
+  for (const auto &r : results) {
+    const std::string size =
+        std::to_string(r.width) + "x" + std::to_string(r.height);
+    printf("%-10s %-6s %8u %10.2f %12.1f %10.6f\n",
+        size.c_str(),
+        r.metric.c_str(),
+        r.threads,
+        r.ms,
+        double(r.width) * r.height / (r.ms * 1e3),
+        r.score);
+  }
+
+  if (!g_jsonFile.empty() && !writeJson(results)) {
+    fprintf(stderr, "cannot write '%s'\n", g_jsonFile.c_str());
+    return 1;
+  }
+
+  return 0;
+}
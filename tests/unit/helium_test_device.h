@@ -0,0 +1,82 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+// Minimal helium device for tests of BaseDevice itself, without any of the
+// rendering a real device adds on top.
+
+#pragma once
+
+#include "helium/BaseDevice.h"
+#include "helium/BaseObject.h"
+
+namespace helium_test {
+
+struct TestObject : public helium::BaseObject
+{
+  TestObject(
+      helium::BaseGlobalDeviceState *s, ANARIDataType type = ANARI_GEOMETRY)
+      : helium::BaseObject(type, s)
+  {}
+  bool isValid() const override
+  {
+    return true;
+  }
+  bool getProperty(const std::string_view &,
+      ANARIDataType,
+      void *,
+      uint64_t,
+      uint32_t) override
+  {
+    return false;
+  }
+  void commitParameters() override
+  {
+    commits++;
+  }
+  void finalize() override {}
+
+  int commits{0};
+};
+
+// Only geometries and surfaces can be created, introspection is left out
+struct TestDevice : public helium::BaseDevice
+{
+  TestDevice() : helium::BaseDevice(nullptr, nullptr)
+  {
+    m_state = std::make_unique<helium::BaseGlobalDeviceState>(this_device());
+  }
+
+  helium::BaseGlobalDeviceState *state() const
+  {
+    return m_state.get();
+  }
+
+  void flushCommits()
+  {
+    m_state->commitBuffer.flush();
+  }
+
+  // clang-format off
+  ANARIArray1D newArray1D(const void *, ANARIMemoryDeleter, const void *, ANARIDataType, uint64_t) override { return nullptr; }
+  ANARIArray2D newArray2D(const void *, ANARIMemoryDeleter, const void *, ANARIDataType, uint64_t, uint64_t) override { return nullptr; }
+  ANARIArray3D newArray3D(const void *, ANARIMemoryDeleter, const void *, ANARIDataType, uint64_t, uint64_t, uint64_t) override { return nullptr; }
+  ANARIGeometry newGeometry(const char *) override { return (ANARIGeometry) new TestObject(state(), ANARI_GEOMETRY); }
+  ANARIMaterial newMaterial(const char *) override { return nullptr; }
+  ANARISampler newSampler(const char *) override { return nullptr; }
+  ANARISurface newSurface() override { return (ANARISurface) new TestObject(state(), ANARI_SURFACE); }
+  ANARISpatialField newSpatialField(const char *) override { return nullptr; }
+  ANARIVolume newVolume(const char *) override { return nullptr; }
+  ANARILight newLight(const char *) override { return nullptr; }
+  ANARIGroup newGroup() override { return nullptr; }
+  ANARIInstance newInstance(const char *) override { return nullptr; }
+  ANARIWorld newWorld() override { return nullptr; }
+  ANARICamera newCamera(const char *) override { return nullptr; }
+  ANARIRenderer newRenderer(const char *) override { return nullptr; }
+  ANARIFrame newFrame() override { return nullptr; }
+  const char **getObjectSubtypes(ANARIDataType) override { return nullptr; }
+  const void *getObjectInfo(ANARIDataType, const char *, const char *, ANARIDataType) override { return nullptr; }
+  const void *getParameterInfo(ANARIDataType, const char *, const char *, ANARIDataType, const char *, ANARIDataType) override { return nullptr; }
+  // clang-format on
+};
+
+} // namespace helium_test
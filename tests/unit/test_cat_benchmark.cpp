@@ -0,0 +1,232 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "catch.hpp"
+// anariCat
+#include "Benchmark.h"
+// std
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace anari_cat;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// One trial per entry of `trials`, each sampling its frames as App latency
+// and a build time of 1ms as Scene build.
+SceneBenchmark benchmarkOf(const std::vector<std::vector<double>> &trials)
+{
+  SceneBenchmark b;
+  b.Scene = "perf:test";
+  for (const auto &frames : trials) {
+    const auto start = BeginTrial(b);
+    b.Samples[TIME_SCENE_BUILD].push_back(1.0);
+    for (double ms : frames)
+      b.Samples[LATENCY_APPLICATION].push_back(ms);
+    EndTrial(b, start);
+  }
+  return b;
+}
+
+std::vector<std::vector<double>> scaled(
+    std::vector<std::vector<double>> trials, double factor)
+{
+  for (auto &frames : trials) {
+    for (auto &ms : frames)
+      ms *= factor;
+  }
+  return trials;
+}
+
+const MetricComparison *find(
+    const std::vector<MetricComparison> &comparisons, MetricType type)
+{
+  for (const auto &c : comparisons) {
+    if (c.Type == type)
+      return &c;
+  }
+  return nullptr;
+}
+
+const std::vector<std::vector<double>> fiveTrials = {
+    {10.0, 10.4, 9.8},
+    {10.1, 10.3, 9.9},
+    {10.2, 10.0, 9.7},
+    {9.9, 10.2, 10.1},
+    {10.0, 10.3, 9.8},
+};
+
+} // namespace
+
+TEST_CASE("ComputeSampleStatistics summarizes order statistics",
+    "[cat_benchmark]")
+{
+  // 1..19 and one far outlier, in no particular order
+  std::vector<double> samples = {100.0};
+  for (int i = 19; i >= 1; --i)
+    samples.push_back(i);
+
+  const auto s = ComputeSampleStatistics(samples);
+  CHECK(s.Count == 20);
+  CHECK(s.Mean == Approx(14.5));
+  CHECK(s.Median == Approx(10.5));
+  CHECK(s.Minimum == 1.0);
+  CHECK(s.Maximum == 100.0);
+  CHECK(s.P5 == Approx(1.95));
+  // Ranks 5 and 16 of 20 bracket the median with ~95% confidence
+  CHECK(s.MedianLow == 5.0);
+  CHECK(s.MedianHigh == 16.0);
+  CHECK(s.MedianLow <= s.Median);
+  CHECK(s.Median <= s.MedianHigh);
+  // Only 100 lies beyond the upper fence 15.25 + 1.5 * 9.5
+  CHECK(s.Outliers == 1);
+
+  const auto empty = ComputeSampleStatistics({});
+  CHECK(empty.Count == 0);
+  CHECK(empty.Outliers == 0);
+}
+
+TEST_CASE("EndTrial records the median of each trial", "[cat_benchmark]")
+{
+  const auto b = benchmarkOf({{3.0, 1.0, 2.0}, {4.0, 8.0}});
+  CHECK(b.Samples[LATENCY_APPLICATION].size() == 5);
+  CHECK(b.TrialMedians[LATENCY_APPLICATION] == std::vector<double>{2.0, 6.0});
+  CHECK(b.TrialMedians[TIME_SCENE_BUILD] == std::vector<double>{1.0, 1.0});
+  // Metrics without samples get no trial medians
+  CHECK(b.TrialMedians[LATENCY_ANARI_DEVICE].empty());
+}
+
+TEST_CASE("CompareBenchmarks tests trial medians", "[cat_benchmark]")
+{
+  const RegressionThresholds thresholds; // 5% slowdown, p < 0.05
+  const auto baseline = benchmarkOf(fiveTrials);
+
+  SECTION("A consistent slowdown over all trials regresses")
+  {
+    const auto comparisons = CompareBenchmarks(
+        baseline, benchmarkOf(scaled(fiveTrials, 1.2)), thresholds);
+    const auto *app = find(comparisons, LATENCY_APPLICATION);
+    REQUIRE(app != nullptr);
+    CHECK(app->BaselineMedian == Approx(10.0));
+    CHECK(app->Median == Approx(12.0));
+    CHECK(app->PValue < 0.05);
+    CHECK(app->Regressed);
+
+    // Equal build times are no evidence of a slowdown
+    const auto *build = find(comparisons, TIME_SCENE_BUILD);
+    REQUIRE(build != nullptr);
+    CHECK_FALSE(build->Regressed);
+    // Nothing to compare the device latency on
+    CHECK(find(comparisons, LATENCY_ANARI_DEVICE) == nullptr);
+  }
+
+  SECTION("A significant change below the slowdown threshold passes")
+  {
+    const auto comparisons = CompareBenchmarks(
+        baseline, benchmarkOf(scaled(fiveTrials, 1.03)), thresholds);
+    const auto *app = find(comparisons, LATENCY_APPLICATION);
+    REQUIRE(app != nullptr);
+    CHECK(app->PValue < 0.05);
+    CHECK_FALSE(app->Regressed);
+  }
+
+  SECTION("A faster candidate passes")
+  {
+    const auto comparisons = CompareBenchmarks(
+        baseline, benchmarkOf(scaled(fiveTrials, 0.8)), thresholds);
+    const auto *app = find(comparisons, LATENCY_APPLICATION);
+    REQUIRE(app != nullptr);
+    CHECK(app->PValue > 0.95);
+    CHECK_FALSE(app->Regressed);
+  }
+
+  SECTION("Many frames of too few trials are not tested")
+  {
+    // Pooled as independent samples, 400 slower frames would look decisive
+    const std::vector<double> frames(200, 10.0);
+    const std::vector<double> slower(200, 20.0);
+    const auto comparisons = CompareBenchmarks(benchmarkOf({frames, frames}),
+        benchmarkOf({slower, slower}),
+        thresholds);
+    const auto *app = find(comparisons, LATENCY_APPLICATION);
+    REQUIRE(app != nullptr);
+    CHECK(std::isnan(app->PValue));
+    CHECK_FALSE(app->Regressed);
+  }
+}
+
+TEST_CASE("Benchmark reports round-trip through JSON", "[cat_benchmark]")
+{
+  const fs::path dir = fs::temp_directory_path() / "anari_cat_benchmark_test";
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+  const std::string path = (dir / "summary.json").string();
+
+  BenchmarkReport report;
+  report.Library = "helide";
+  report.Device = "default";
+  report.Renderer = "default";
+  report.Size = {640, 480};
+  report.Animate = true;
+  report.TimeStep = 0.25f;
+  report.Seed = 7;
+  report.CameraPath = "orbit";
+  report.PathFrames = 120;
+  report.Trials = fiveTrials.size();
+  report.WarmupFrames = 2;
+  report.Frames = 3;
+  report.Baseline = "before.json";
+  report.Scenes.push_back(benchmarkOf(fiveTrials));
+  report.Scenes[0].Comparisons = CompareBenchmarks(
+      report.Scenes[0], report.Scenes[0], RegressionThresholds{});
+
+  REQUIRE(WriteBenchmarkJson(path, report));
+
+  BenchmarkReport back;
+  REQUIRE(ReadBenchmarkJson(path, back));
+  CHECK(back.Library == "helide");
+  CHECK(back.Device == "default");
+  CHECK(back.Renderer == "default");
+  CHECK(back.Trials == fiveTrials.size());
+  CHECK(SameWorkload(report, back));
+  REQUIRE(back.Scenes.size() == 1);
+  CHECK(back.Scenes[0].Scene == "perf:test");
+  for (const MetricType type : BenchmarkMetrics) {
+    CHECK(back.Scenes[0].Samples[type] == report.Scenes[0].Samples[type]);
+    CHECK(back.Scenes[0].TrialMedians[type]
+        == report.Scenes[0].TrialMedians[type]);
+  }
+
+  back.Frames = 4;
+  CHECK_FALSE(SameWorkload(report, back));
+
+  SECTION("Version 1 files have samples but are not compared with")
+  {
+    {
+      std::ofstream out(path, std::ios::out | std::ios::trunc);
+      out << R"({"version": 1, "scenes": {"perf:test": {"metrics":
+                {"app": {"samples": [10.0, 11.0, 12.0]}}}}})";
+    }
+    REQUIRE(ReadBenchmarkJson(path, back));
+    REQUIRE(back.Scenes.size() == 1);
+    CHECK(back.Scenes[0].Samples[LATENCY_APPLICATION].size() == 3);
+    CHECK(back.Scenes[0].TrialMedians[LATENCY_APPLICATION].empty());
+    CHECK(CompareBenchmarks(back.Scenes[0], report.Scenes[0], {}).empty());
+  }
+
+  SECTION("Malformed files are rejected")
+  {
+    {
+      std::ofstream out(path, std::ios::out | std::ios::trunc);
+      out << "{ not json";
+    }
+    CHECK_FALSE(ReadBenchmarkJson(path, back));
+    CHECK_FALSE(ReadBenchmarkJson((dir / "missing.json").string(), back));
+  }
+
+  fs::remove_all(dir);
+}
@@ -324,6 +324,36 @@ TEST_CASE("every built-in Test has a human-readable description",
   }
 }
 
+TEST_CASE("the scaling Tests declare a workload for every Case",
+    "[cts][catalog][scaling]")
+{
+  Catalog catalog;
+  registerBuiltinTests(catalog);
+  int scalingTests = 0;
+  for (const auto &test : catalog.tests()) {
+    // Scaling Tests are exactly the scaling category.
+    CHECK(bool(test.scaling) == (test.category == "scaling"));
+    if (!test.scaling)
+      continue;
+    ++scalingTests;
+    for (const Case &c : expand(test)) {
+      DYNAMIC_SECTION(c.id())
+      {
+        BuildContext ctx;
+        for (const auto &cv : c.values)
+          ctx.set(cv.axisName, cv.value);
+        const ScalingWork work = test.scaling(ctx);
+        CHECK_FALSE(work.unit.empty());
+        CHECK(work.elements > 0);
+        CHECK((work.width == 0) == (work.height == 0));
+        if (test.name == "resolution")
+          CHECK(work.width * work.height >= 256u * 256u);
+      }
+    }
+  }
+  CHECK(scalingTests == 6);
+}
+
 TEST_CASE("isSupported requires every feature to be present", "[cts][features]")
 {
   auto t = makeTest("geometry", "sphere")
@@ -447,6 +477,17 @@ TEST_CASE(
     ctx.setValue("radius", 2.5f);
     CHECK(ctx.get<float>("radius", 0.f) == Approx(2.5f));
   }
+
+  SECTION("every name looked up is recorded, present or not")
+  {
+    ctx.set("primitiveMode", Any("indexed"));
+    ctx.getString("primitiveMode", "soup");
+    ctx.has("notThere");
+    ctx.value("alsoNotThere");
+    CHECK(ctx.readNames()
+        == std::set<std::string>{
+            "alsoNotThere", "notThere", "primitiveCount", "primitiveMode"});
+  }
 }
 
 // Catalog /////////////////////////////////////////////////////////////////////
@@ -7,7 +7,11 @@
 #include "cts/Metrics.h"
 // std
 #include <cmath>
+#include <cstring>
 #include <filesystem>
+#include <limits>
+#include <random>
+#include <vector>
 
 using namespace anari::cts;
 
@@ -49,6 +53,90 @@ Image gradient(uint32_t w, uint32_t h, int offset = 0)
   return im;
 }
 
+// A noisy, partly transparent image: exercises the alpha compositing and
+// gives every window a different variance.
+Image noise(uint32_t w, uint32_t h, uint32_t seed)
+{
+  std::mt19937 rng(seed);
+  Image im;
+  im.width = w;
+  im.height = h;
+  im.rgba.resize(static_cast<size_t>(w) * h * 4);
+  for (size_t i = 0; i < im.rgba.size(); ++i)
+    im.rgba[i] = static_cast<uint8_t>(rng() % 256);
+  for (size_t i = 0; i < im.pixelCount(); i += 3)
+    im.rgba[i * 4 + 3] = 255;
+  return im;
+}
+
+// The direct formulation the metrics were first written in: composite each
+// channel, take 7x7 box means with scipy's reflect boundary for every pixel,
+// and average the SSIM map over the interior.
+double referenceSsim(const Image &a, const Image &b)
+{
+  const int w = static_cast<int>(a.width);
+  const int h = static_cast<int>(a.height);
+  auto composited = [](const Image &img, int c) {
+    std::vector<double> out(img.pixelCount());
+    for (size_t i = 0; i < out.size(); ++i) {
+      const double v = img.rgba[i * 4 + c];
+      const double al = img.rgba[i * 4 + 3];
+      out[i] = std::round(v * al / 255.0 + (255.0 - al));
+    }
+    return out;
+  };
+  auto reflect = [](int i, int n) {
+    while (i < 0 || i >= n)
+      i = i < 0 ? -i - 1 : 2 * n - i - 1;
+    return i;
+  };
+  auto boxMean = [&](const std::vector<double> &in) {
+    std::vector<double> tmp(in.size()), out(in.size());
+    for (int y = 0; y < h; ++y)
+      for (int x = 0; x < w; ++x) {
+        double sum = 0.0;
+        for (int k = -3; k <= 3; ++k)
+          sum += in[size_t(y) * w + reflect(x + k, w)];
+        tmp[size_t(y) * w + x] = sum / 7.0;
+      }
+    for (int y = 0; y < h; ++y)
+      for (int x = 0; x < w; ++x) {
+        double sum = 0.0;
+        for (int k = -3; k <= 3; ++k)
+          sum += tmp[size_t(reflect(y + k, h)) * w + x];
+        out[size_t(y) * w + x] = sum / 7.0;
+      }
+    return out;
+  };
+
+  const double c1 = 2.55 * 2.55, c2 = 7.65 * 7.65, covNorm = 49.0 / 48.0;
+  double total = 0.0;
+  for (int c = 0; c < 3; ++c) {
+    const auto x = composited(a, c);
+    const auto y = composited(b, c);
+    std::vector<double> xx(x.size()), yy(x.size()), xy(x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+      xx[i] = x[i] * x[i];
+      yy[i] = y[i] * y[i];
+      xy[i] = x[i] * y[i];
+    }
+    const auto ux = boxMean(x), uy = boxMean(y), uxx = boxMean(xx),
+               uyy = boxMean(yy), uxy = boxMean(xy);
+    double sum = 0.0;
+    for (int j = 3; j < h - 3; ++j)
+      for (int i = 3; i < w - 3; ++i) {
+        const size_t k = size_t(j) * w + i;
+        const double vx = covNorm * (uxx[k] - ux[k] * ux[k]);
+        const double vy = covNorm * (uyy[k] - uy[k] * uy[k]);
+        const double vxy = covNorm * (uxy[k] - ux[k] * uy[k]);
+        sum += ((2.0 * ux[k] * uy[k] + c1) * (2.0 * vxy + c2))
+            / ((ux[k] * ux[k] + uy[k] * uy[k] + c1) * (vx + vy + c2));
+      }
+    total += sum / (double(w - 6) * (h - 6));
+  }
+  return total / 3.0;
+}
+
 } // namespace
 
 // PSNR ///////////////////////////////////////////////////////////////////////
@@ -119,6 +207,31 @@ TEST_CASE("ssim is NaN when smaller than the window or mismatched",
       ssim(solid(32, 32, 0, 0, 0, 255), solid(16, 16, 0, 0, 0, 255))));
 }
 
+TEST_CASE("ssim matches the direct box filter formulation", "[cts][metrics]")
+{
+  // Sizes at the window minimum, in one row band, and spanning several bands
+  // with a partial last one.
+  const std::pair<uint32_t, uint32_t> sizes[] = {
+      {7, 7}, {9, 200}, {130, 71}, {61, 157}};
+  uint32_t seed = 1;
+  for (const auto &[w, h] : sizes) {
+    const auto a = noise(w, h, seed++);
+    const auto b = noise(w, h, seed++);
+    CHECK(ssim(a, b) == Approx(referenceSsim(a, b)).epsilon(1e-12));
+    CHECK(ssim(a, gradient(w, h))
+        == Approx(referenceSsim(a, gradient(w, h))).epsilon(1e-12));
+  }
+}
+
+TEST_CASE("ssim does not depend on the thread count", "[cts][metrics]")
+{
+  const auto a = noise(96, 300, 7);
+  const auto b = noise(96, 300, 8);
+  const double single = ssim(a, b, 1);
+  CHECK(ssim(a, b, 3) == single);
+  CHECK(ssim(a, b, 0) == single);
+}
+
 // Alpha compositing //////////////////////////////////////////////////////////
 
 TEST_CASE("metrics composite alpha over white before comparing", "[cts][metrics]")
@@ -156,3 +269,81 @@ TEST_CASE("savePNG/loadPNG round-trips RGBA8 pixels", "[cts][metrics][image]")
 
   std::filesystem::remove_all(dir.parent_path(), ec);
 }
+
+// Raw ground truth ///////////////////////////////////////////////////////////
+
+namespace {
+
+RawImage rawIds(std::vector<uint32_t> ids)
+{
+  RawImage raw;
+  raw.format = RawImage::Format::UInt32;
+  raw.width = static_cast<uint32_t>(ids.size());
+  raw.height = 1;
+  raw.values = std::move(ids);
+  return raw;
+}
+
+RawImage rawDepths(const std::vector<float> &depths)
+{
+  RawImage raw;
+  raw.format = RawImage::Format::Float32;
+  raw.width = static_cast<uint32_t>(depths.size());
+  raw.height = 1;
+  raw.values.resize(depths.size());
+  std::memcpy(raw.values.data(), depths.data(), depths.size() * sizeof(float));
+  return raw;
+}
+
+} // namespace
+
+TEST_CASE("saveRaw/loadRaw round-trips raw values", "[cts][metrics][image]")
+{
+  const auto dir = std::filesystem::temp_directory_path() / "cts_raw_test";
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+
+  auto depth = rawDepths({0.f, 1.5f, std::numeric_limits<float>::infinity()});
+  depth.width = 1;
+  depth.height = 3;
+  const auto path = (dir / "nested" / "depth.raw").string();
+  REQUIRE(saveRaw(path, depth));
+
+  auto loaded = loadRaw(path);
+  REQUIRE(loaded.valid());
+  CHECK(loaded.format == RawImage::Format::Float32);
+  CHECK(loaded.width == 1);
+  CHECK(loaded.height == 3);
+  CHECK(loaded.values == depth.values);
+
+  // A truncated file or a PNG is not raw ground truth.
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+  CHECK_FALSE(loadRaw(path).valid());
+  const auto png = (dir / "image.png").string();
+  REQUIRE(savePNG(png, solid(2, 2, 0, 0, 0, 255)));
+  CHECK_FALSE(loadRaw(png).valid());
+  CHECK_FALSE(loadRaw((dir / "does_not_exist.raw").string()).valid());
+
+  std::filesystem::remove_all(dir, ec);
+}
+
+TEST_CASE("rawMatch compares ids exactly and depths within tolerance",
+    "[cts][metrics]")
+{
+  const float inf = std::numeric_limits<float>::infinity();
+
+  CHECK(rawMatch(rawIds({1, 2, 3, 4}), rawIds({1, 2, 3, 4})) == 1.0);
+  CHECK(rawMatch(rawIds({1, 2, 3, 4}), rawIds({1, 2, 3, 5})) == 0.75);
+
+  CHECK(rawMatch(rawDepths({1.f, 100.f}), rawDepths({1.0005f, 100.05f}))
+      == 1.0);
+  CHECK(rawMatch(rawDepths({1.f, 100.f}), rawDepths({1.01f, 100.f})) == 0.5);
+  // A pixel with no hit matches only another pixel with no hit.
+  CHECK(rawMatch(rawDepths({inf, 1.f}), rawDepths({inf, 1.f})) == 1.0);
+  CHECK(rawMatch(rawDepths({inf, 1.f}), rawDepths({1e30f, inf})) == 0.0);
+
+  CHECK(std::isnan(rawMatch(rawIds({1, 2}), rawIds({1, 2, 3}))));
+  CHECK(std::isnan(rawMatch(rawIds({0}), rawDepths({0.f}))));
+  CHECK(std::isnan(rawMatch(RawImage{}, RawImage{})));
+  CHECK_FALSE(metricPassed(rawMatch(rawIds({1}), rawIds({1, 2})), 0.98));
+}
@@ -159,6 +159,51 @@ TEST_CASE("base64Encode matches RFC 4648 test vectors", "[cts][html]")
   CHECK(base64Encode("foobar") == "Zm9vYmFy");
 }
 
+TEST_CASE("writeBase64File streams a file in chunks", "[cts][html]")
+{
+  const auto path =
+      std::filesystem::temp_directory_path() / "cts_base64_stream.bin";
+  // Longer than one read chunk and not a multiple of 3, so both the chunk
+  // boundary and the final padding are exercised.
+  std::string bytes(200000, '\0');
+  for (size_t i = 0; i < bytes.size(); ++i)
+    bytes[i] = static_cast<char>((i * 131 + 7) & 0xff);
+  std::ofstream(path, std::ios::binary) << bytes;
+
+  std::ostringstream out;
+  REQUIRE(writeBase64File(out, path));
+  CHECK(out.str() == base64Encode(bytes));
+
+  std::ostringstream missing;
+  CHECK_FALSE(writeBase64File(missing, path.string() + ".absent"));
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+}
+
+TEST_CASE("downscaleMax keeps the largest difference of each block", "[cts][html]")
+{
+  Image diff;
+  diff.width = 1024;
+  diff.height = 512;
+  diff.rgba.assign(diff.pixelCount() * 4, 0);
+  const size_t hot = (size_t(301) * diff.width + 777) * 4;
+  diff.rgba[hot + 1] = 200;
+
+  const Image thumb = downscaleMax(diff, 256);
+  REQUIRE(thumb.valid());
+  CHECK(thumb.width == 256);
+  CHECK(thumb.height == 128);
+  const size_t at = (size_t(301 / 4) * thumb.width + 777 / 4) * 4;
+  CHECK(int(thumb.rgba[at + 1]) == 200);
+  size_t lit = 0;
+  for (size_t i = 0; i < thumb.rgba.size(); ++i)
+    lit += thumb.rgba[i] != 0;
+  CHECK(lit == 1);
+
+  // Already within the bound: unchanged.
+  CHECK(downscaleMax(thumb, 256).rgba == thumb.rgba);
+}
+
 TEST_CASE("htmlEscape neutralizes markup", "[cts][html]")
 {
   CHECK(htmlEscape("<a href=\"x\">&'</a>")
@@ -227,6 +272,110 @@ TEST_CASE(
   std::filesystem::remove_all(root, ec);
 }
 
+TEST_CASE("a linked report inlines cached diff thumbnails", "[cts][html]")
+{
+  const auto root = std::filesystem::temp_directory_path() / "cts_thumb_test";
+  std::error_code ec;
+  std::filesystem::remove_all(root, ec);
+  Image diff;
+  diff.width = diff.height = 512;
+  diff.rgba.assign(diff.pixelCount() * 4, 0);
+  diff.rgba[(size_t(10) * diff.width + 20) * 4] = 255;
+  REQUIRE(savePNG(
+      (root / "run" / "results" / "geometry" / "cone" / "b.color.diff.png")
+          .string(),
+      diff));
+  REQUIRE(savePNG(
+      (root / "run" / "results" / "geometry" / "sphere" / "a.color.diff.png")
+          .string(),
+      diff));
+
+  CaseResult failed = makeCase("geometry", "cone", "b", Verdict::Failed);
+  ChannelResult ch = colorChannel(0.1, false);
+  ch.diffImage = "results/geometry/cone/b.color.diff.png";
+  failed.channels = {ch};
+  CaseResult passed = makeCase("geometry", "sphere", "a", Verdict::Passed);
+  ChannelResult ok = colorChannel(0.9, true);
+  ok.diffImage = "results/geometry/sphere/a.color.diff.png";
+  passed.channels = {ok};
+  const auto results = keyed({failed, passed});
+
+  HtmlOptions opts;
+  opts.htmlPath = root / "run" / "report.html";
+  REQUIRE(writeHtmlFile(root / "run", results, opts));
+  CHECK_FALSE(std::filesystem::exists(root / "run" / "report.html.tmp"));
+  std::ifstream in(opts.htmlPath, std::ios::binary);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  const std::string doc = buffer.str();
+
+  // The failed Case's mask reads an inlined, downscaled copy of its diff...
+  const auto thumbPath = root / "run" / "thumbnails" / "256" / ch.diffImage;
+  const Image thumb = loadPNG(thumbPath.string());
+  REQUIRE(thumb.valid());
+  CHECK(thumb.width == 256);
+  CHECK(int(thumb.rgba[(size_t(5) * thumb.width + 10) * 4]) == 255);
+  CHECK(doc.find("data-diff=\"data:image/png;base64,") != std::string::npos);
+  // ...while the initially-hidden passing Case references its full diff.
+  CHECK(doc.find("data-diff=\"results/geometry/sphere/a.color.diff.png\"")
+      != std::string::npos);
+  CHECK_FALSE(std::filesystem::exists(
+      root / "run" / "thumbnails" / "256" / ok.diffImage));
+
+  // A current thumbnail is reused rather than generated again.
+  const auto written = std::filesystem::last_write_time(thumbPath);
+  CHECK(generateHtml(root / "run", results, opts) == doc);
+  CHECK(std::filesystem::last_write_time(thumbPath) == written);
+
+  // Another edge gets thumbnails of its own size, not the cached ones.
+  opts.thumbnailEdge = 128;
+  generateHtml(root / "run", results, opts);
+  const Image small = loadPNG(
+      (root / "run" / "thumbnails" / "128" / ch.diffImage).string());
+  REQUIRE(small.valid());
+  CHECK(small.width == 128);
+  CHECK(std::filesystem::last_write_time(thumbPath) == written);
+
+  std::filesystem::remove_all(root, ec);
+}
+
+TEST_CASE("timing regressions are counted and shown", "[cts][report]")
+{
+  CaseResult slow = makeCase("geometry", "cone", "b", Verdict::Failed);
+  slow.channels = {colorChannel(0.9, true)};
+  slow.timing.emplace();
+  slow.timing->frameMs = {13.0, 13.1, 13.2};
+  TimingComparison frame;
+  frame.measure = "frame";
+  frame.baselineMedian = 10.0;
+  frame.median = 13.1;
+  frame.baselineP95 = 10.2;
+  frame.p95 = 13.2;
+  frame.pValue = 0.001;
+  frame.regressed = true;
+  slow.timing->comparisons = {frame};
+  CaseResult fast = makeCase("geometry", "sphere", "a", Verdict::Passed);
+  fast.channels = {colorChannel(0.9, true)};
+  fast.timing.emplace();
+  fast.timing->frameMs = {5.0, 5.0, 5.0};
+  const auto results = keyed({slow, fast});
+
+  const Summary s = summarize(results);
+  CHECK(s.timed == 2);
+  CHECK(s.timingRegressions == 1);
+
+  std::ostringstream text;
+  writeTextSummary(text, "run", results, false);
+  CHECK(text.str().find("2 cases timed, 1 slower than baseline")
+      != std::string::npos);
+  CHECK(text.str().find("Timing: frame median 10.00 -> 13.10 ms (+31.0%)")
+      != std::string::npos);
+
+  const std::string doc = generateHtml("/tmp/myrun", results, HtmlOptions{});
+  CHECK(doc.find("Timing regressions") != std::string::npos);
+  CHECK(doc.find("SLOWER") != std::string::npos);
+}
+
 // Results tree loading ///////////////////////////////////////////////////////
 
 TEST_CASE("loadResults globs the results tree", "[cts][report]")
@@ -5,6 +5,7 @@
 // cts
 #include "cts/ArtifactPublication.h"
 #include "cts/Case.h"
+#include "cts/Fingerprint.h"
 #include "cts/Metrics.h"
 #include "cts/Sidecar.h"
 #include "cts/Workdir.h"
@@ -198,6 +199,51 @@ TEST_CASE(
   CHECK(text.find("\"channels\": []") != std::string::npos);
 }
 
+TEST_CASE("the input fingerprint and device build round-trip",
+    "[cts][sidecar]")
+{
+  CaseResult r;
+  r.verdict = Verdict::Failed;
+  r.device = {"helide", "default", "default", "0123456789abcdef"};
+  r.fingerprint = "fedcba9876543210";
+
+  CaseResult back;
+  REQUIRE(fromJson(toJson(r), back));
+  CHECK(back.device.build == "0123456789abcdef");
+  CHECK(back.fingerprint == "fedcba9876543210");
+
+  // Sidecars written before either field existed read them as empty.
+  REQUIRE(fromJson(R"({"verdict": "passed", "device": {"library": "x"}})",
+      back));
+  CHECK(back.device.build.empty());
+  CHECK(back.fingerprint.empty());
+}
+
+TEST_CASE("fingerprints separate the fields they are built from",
+    "[cts][sidecar]")
+{
+  const auto a = Fingerprint().add("ab").add("c").hex();
+  CHECK(a.size() == 16);
+  CHECK(a == Fingerprint().add("ab").add("c").hex());
+  CHECK(a != Fingerprint().add("a").add("bc").hex());
+  CHECK(Fingerprint().add(1.0).hex() != Fingerprint().add(uint64_t(1)).hex());
+
+  const auto file = std::filesystem::temp_directory_path() / "cts_fp_test.bin";
+  {
+    std::ofstream out(file, std::ios::binary);
+    out << "device library";
+  }
+  const std::string before = fileFingerprint(file);
+  CHECK(before.size() == 16);
+  {
+    std::ofstream out(file, std::ios::binary);
+    out << "device library, rebuilt";
+  }
+  CHECK(fileFingerprint(file) != before);
+  std::filesystem::remove(file);
+  CHECK(fileFingerprint(file).empty());
+}
+
 TEST_CASE("non-finite scores serialize as JSON null", "[cts][sidecar]")
 {
   CaseResult r;
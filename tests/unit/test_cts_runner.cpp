@@ -5,6 +5,7 @@
 // cts
 #include "cts/Case.h"
 #include "cts/Catalog.h"
+#include "cts/Expansion.h"
 #include "cts/FrameFormats.h"
 #include "cts/FrameReadback.h"
 #include "cts/GeometryBuilder.h"
@@ -14,6 +15,8 @@
 #include "cts/TestBuilder.h"
 #include "cts/WorldBuilder.h"
 // std
+#include <cmath>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <limits>
@@ -395,6 +398,49 @@ TEST_CASE("frame readback decodes every ID channel", "[cts][framereadback]")
   }
 }
 
+TEST_CASE("frame readback keeps the raw values of depth and ID channels",
+    "[cts][framereadback]")
+{
+  SECTION("depth")
+  {
+    const float pixels[] = {0.5f, std::numeric_limits<float>::infinity()};
+    const MappedFrameDescriptor mapped{pixels, 2, 1, ANARI_FLOAT32};
+    const auto result = decodeFrameChannel(Channel::Depth, mapped, 2, 1, 4.f);
+
+    REQUIRE(result);
+    REQUIRE(result.raw.valid());
+    CHECK(result.raw.format == RawImage::Format::Float32);
+    CHECK(result.raw.width == 2);
+    CHECK(result.raw.height == 1);
+    float depths[2];
+    std::memcpy(depths, result.raw.values.data(), sizeof(depths));
+    CHECK(depths[0] == 0.5f);
+    CHECK(std::isinf(depths[1]));
+  }
+
+  SECTION("IDs")
+  {
+    const uint32_t pixels[] = {7, 0xFFFFFFFFu};
+    const MappedFrameDescriptor mapped{pixels, 2, 1, ANARI_UINT32};
+    const auto result = decodeFrameChannel(Channel::ObjectId, mapped, 2, 1);
+
+    REQUIRE(result);
+    REQUIRE(result.raw.valid());
+    CHECK(result.raw.format == RawImage::Format::UInt32);
+    CHECK(result.raw.values == std::vector<uint32_t>{7, 0xFFFFFFFFu});
+  }
+
+  SECTION("image channels keep none")
+  {
+    const uint8_t pixel[] = {10, 20, 30, 40};
+    const MappedFrameDescriptor mapped{pixel, 1, 1, ANARI_UFIXED8_VEC4};
+    const auto result = decodeFrameChannel(Channel::Color, mapped, 1, 1);
+
+    REQUIRE(result);
+    CHECK_FALSE(result.raw.valid());
+  }
+}
+
 TEST_CASE("output-format strings map to ANARIDataType", "[cts][frameformat]")
 {
   CHECK(colorFormatFromString("UFIXED8_RGBA_SRGB") == ANARI_UFIXED8_RGBA_SRGB);
@@ -519,12 +565,23 @@ TEST_CASE(
         std::filesystem::exists(wd.groundTruthImagePath(sph, Channel::Color)));
     CHECK(
         std::filesystem::exists(wd.groundTruthImagePath(sph, Channel::Depth)));
+    // Depth is scored against its raw values; the PNG is only for viewing.
+    const auto depthRaw =
+        loadRaw(wd.groundTruthRawPath(sph, Channel::Depth).string());
+    REQUIRE(depthRaw.valid());
+    CHECK(depthRaw.format == RawImage::Format::Float32);
+    CHECK(depthRaw.width == 64);
+    CHECK(depthRaw.height == 64);
+    CHECK_FALSE(std::filesystem::exists(
+        wd.groundTruthRawPath(tri, Channel::Color)));
 
     // A candidate identical to the reference (both helide) must pass.
     auto runSummary = runner.run(catalog, Filter{""}, features);
     CHECK(runSummary.total == 6);
     CHECK(runSummary.passed == 5);
     CHECK(runSummary.skipped == 1); // the bogus-feature test
+    const auto sphereText = readFile(wd.sidecarPath(sph));
+    CHECK(sphereText.find("\"match\"") != std::string::npos);
 
     // Sidecar + result image for a triangle case.
     const auto sidecar = wd.sidecarPath(tri);
@@ -1000,3 +1057,430 @@ TEST_CASE("Runner verifies behavioral tests via the behavior hook",
   anari::release(d, d);
   anari::unloadLibrary(lib);
 }
+
+TEST_CASE("Runner spreads Cases over several devices with the same results",
+    "[cts][runner][helide]")
+{
+  std::vector<anari::Library> libs;
+  std::vector<anari::Device> devices;
+  for (int i = 0; i < 3; ++i) {
+    anari::Library lib = anari::loadLibrary("helide", statusFunc, nullptr);
+    if (!lib)
+      break;
+    anari::Device d = anari::newDevice(lib, "default");
+    REQUIRE(d != nullptr);
+    anari::commitParameters(d, d);
+    libs.push_back(lib);
+    devices.push_back(d);
+  }
+  if (devices.size() != 3) {
+    WARN("helide library not available; skipping multi-device runner test");
+    for (size_t i = 0; i < devices.size(); ++i) {
+      anari::release(devices[i], devices[i]);
+      anari::unloadLibrary(libs[i]);
+    }
+    return;
+  }
+
+  const auto root = std::filesystem::temp_directory_path() / "cts_jobs_test";
+  std::error_code ec;
+  std::filesystem::remove_all(root, ec);
+
+  auto catalog = makeCatalog();
+  const std::set<std::string> features;
+  RunOptions opts;
+  opts.width = 16;
+  opts.height = 16;
+  opts.publishThreads = 2;
+  opts.device = {"helide", "default", "default"};
+
+  Runner serial(devices.front(), Workdir(root), opts);
+  Runner parallel(devices, Workdir(root), opts);
+
+  const auto gen = parallel.generate(catalog, Filter{""}, features);
+  CHECK(gen.total == 6);
+  CHECK(gen.passed == 5);
+  CHECK(gen.skipped == 1);
+  CHECK_FALSE(hasPublicationTemporary(root));
+
+  const auto expected = serial.run(catalog, Filter{""}, features);
+  const auto s = parallel.run(catalog, Filter{""}, features);
+  CHECK(s.total == expected.total);
+  CHECK(s.passed == expected.passed);
+  CHECK(s.failed == expected.failed);
+  CHECK(s.skipped == expected.skipped);
+  CHECK(s.passed == 5);
+
+  Workdir wd(root);
+  Case tri;
+  tri.category = "geometry";
+  tri.testName = "triangle";
+  tri.values = {{"primitiveCount", Any(8), AxisKind::Permutation},
+      {"primitiveMode", Any("indexed"), AxisKind::Variant}};
+  const auto text = readFile(wd.sidecarPath(tri));
+  CHECK(text.find("\"verdict\": \"passed\"") != std::string::npos);
+  CHECK(std::filesystem::exists(wd.resultImagePath(tri, Channel::Color)));
+  CHECK_FALSE(hasPublicationTemporary(root));
+
+  std::filesystem::remove_all(root, ec);
+  for (size_t i = 0; i < devices.size(); ++i) {
+    anari::release(devices[i], devices[i]);
+    anari::unloadLibrary(libs[i]);
+  }
+}
+
+TEST_CASE("Runner builds a world once for Cases whose build reads the same axes",
+    "[cts][runner][helide]")
+{
+  anari::Library lib = anari::loadLibrary("helide", statusFunc, nullptr);
+  if (!lib) {
+    WARN("helide library not available; skipping world reuse test");
+    return;
+  }
+  anari::Device d = anari::newDevice(lib, "default");
+  REQUIRE(d != nullptr);
+  anari::commitParameters(d, d);
+
+  const auto root =
+      std::filesystem::temp_directory_path() / "cts_world_reuse_test";
+  std::error_code ec;
+  std::filesystem::remove_all(root, ec);
+
+  // The build reads only primitiveCount; the background axis only reaches the
+  // renderer, so its three values share each world.
+  auto builds = std::make_shared<int>(0);
+  Catalog cat;
+  makeTest("renderer", "reuse")
+      .build([builds](BuildContext &ctx) {
+        (*builds)++;
+        return buildTriangleWorld(ctx);
+      })
+      .renderer([](BuildContext &ctx, anari::Renderer renderer) {
+        const float gray = ctx.get<float>("background", 0.f);
+        anari::setParameter(ctx.device(),
+            renderer,
+            "background",
+            anari::math::float4(gray, gray, gray, 1.f));
+      })
+      .permute("primitiveCount", {4, 8})
+      .permute("background", {0.f, 0.5f, 1.f})
+      .registerInto(cat);
+
+  RunOptions opts;
+  opts.width = 32;
+  opts.height = 32;
+  Runner runner(d, Workdir(root), opts);
+
+  // buildTriangleWorld also reads primitiveMode, which no Case sets.
+  const auto gen = runner.generate(cat, Filter{""}, {});
+  CHECK(gen.passed == 6);
+  CHECK(*builds == 2);
+  CHECK(gen.worldsReused == 4);
+
+  // The background still differs between the Cases sharing a world.
+  Case dark;
+  dark.category = "renderer";
+  dark.testName = "reuse";
+  dark.values = {{"primitiveCount", Any(4), AxisKind::Permutation},
+      {"background", Any(0.f), AxisKind::Permutation}};
+  Case light = dark;
+  light.values[1].value = Any(1.f);
+  const Workdir wd(root);
+  CHECK(imageEnergy(loadPNG(
+            wd.groundTruthImagePath(dark, Channel::Color).string()))
+      < imageEnergy(loadPNG(
+          wd.groundTruthImagePath(light, Channel::Color).string())));
+
+  // Worlds are not kept from one run to the next.
+  const auto s = runner.run(cat, Filter{""}, {});
+  CHECK(s.passed == 6);
+  CHECK(*builds == 4);
+  CHECK(s.worldsReused == 4);
+
+  std::filesystem::remove_all(root, ec);
+  anari::release(d, d);
+  anari::unloadLibrary(lib);
+}
+
+TEST_CASE("An incremental run keeps results whose inputs are unchanged",
+    "[cts][runner][helide]")
+{
+  anari::Library lib = anari::loadLibrary("helide", statusFunc, nullptr);
+  if (!lib) {
+    WARN("helide library not available; skipping incremental run test");
+    return;
+  }
+  anari::Device d = anari::newDevice(lib, "default");
+  REQUIRE(d != nullptr);
+  anari::commitParameters(d, d);
+
+  const auto root =
+      std::filesystem::temp_directory_path() / "cts_incremental_test";
+  std::error_code ec;
+  std::filesystem::remove_all(root, ec);
+
+  auto builds = std::make_shared<int>(0);
+  auto makeCountingCatalog = [&](uint32_t revision) {
+    Catalog cat;
+    makeTest("geometry", "counted")
+        .build([builds](BuildContext &ctx) {
+          (*builds)++;
+          return buildTriangleWorld(ctx);
+        })
+        .permute("primitiveCount", {4, 8})
+        .revision(revision)
+        .registerInto(cat);
+    return cat;
+  };
+  const auto cat = makeCountingCatalog(0);
+
+  RunOptions opts;
+  opts.width = 16;
+  opts.height = 16;
+  opts.device = {"helide", "default", "default", "build-a"};
+  REQUIRE(Runner(d, Workdir(root), opts).generate(cat, Filter{""}, {}).passed
+      == 2);
+
+  // The first incremental run has nothing to keep.
+  opts.incremental = true;
+  *builds = 0;
+  auto s = Runner(d, Workdir(root), opts).run(cat, Filter{""}, {});
+  CHECK(s.passed == 2);
+  CHECK(s.unchanged == 0);
+  CHECK(*builds == 2);
+
+  *builds = 0;
+  s = Runner(d, Workdir(root), opts).run(cat, Filter{""}, {});
+  CHECK(s.total == 2);
+  CHECK(s.passed == 2);
+  CHECK(s.unchanged == 2);
+  CHECK(*builds == 0);
+
+  SECTION("a missing result image renders that Case again")
+  {
+    Case c;
+    c.category = "geometry";
+    c.testName = "counted";
+    c.values = {{"primitiveCount", Any(8), AxisKind::Permutation}};
+    std::filesystem::remove(
+        Workdir(root).resultImagePath(c, Channel::Color), ec);
+    s = Runner(d, Workdir(root), opts).run(cat, Filter{""}, {});
+    CHECK(s.unchanged == 1);
+    CHECK(*builds == 1);
+  }
+
+  SECTION("changed inputs render again")
+  {
+    opts.device.build = "build-b";
+    s = Runner(d, Workdir(root), opts).run(cat, Filter{""}, {});
+    CHECK(s.unchanged == 0);
+    CHECK(*builds == 2);
+
+    s = Runner(d, Workdir(root), opts)
+            .run(makeCountingCatalog(1), Filter{""}, {});
+    CHECK(s.unchanged == 0);
+    CHECK(*builds == 4);
+  }
+
+  SECTION("--changed-since renders a device build's results again")
+  {
+    opts.changedSince = {"build-a"};
+    s = Runner(d, Workdir(root), opts).run(cat, Filter{""}, {});
+    CHECK(s.passed == 2);
+    CHECK(s.unchanged == 0);
+    CHECK(*builds == 2);
+  }
+
+  std::filesystem::remove_all(root, ec);
+  anari::release(d, d);
+  anari::unloadLibrary(lib);
+}
+
+TEST_CASE("A performance run times Cases and compares them with a baseline",
+    "[cts][runner][helide]")
+{
+  anari::Library lib = anari::loadLibrary("helide", statusFunc, nullptr);
+  if (!lib) {
+    WARN("helide library not available; skipping performance run test");
+    return;
+  }
+  anari::Device d = anari::newDevice(lib, "default");
+  REQUIRE(d != nullptr);
+  anari::commitParameters(d, d);
+
+  const auto root = std::filesystem::temp_directory_path() / "cts_perf_test";
+  const auto baseline =
+      std::filesystem::temp_directory_path() / "cts_perf_baseline";
+  std::error_code ec;
+  std::filesystem::remove_all(root, ec);
+  std::filesystem::remove_all(baseline, ec);
+
+  auto builds = std::make_shared<int>(0);
+  Catalog cat;
+  makeTest("geometry", "timed")
+      .build([builds](BuildContext &ctx) {
+        (*builds)++;
+        return buildTriangleWorld(ctx);
+      })
+      .permute("primitiveCount", {4, 8})
+      .registerInto(cat);
+
+  RunOptions opts;
+  opts.width = 16;
+  opts.height = 16;
+  opts.device = {"helide", "default", "default"};
+  REQUIRE(Runner(d, Workdir(root), opts).generate(cat, Filter{""}, {}).passed
+      == 2);
+
+  // Timed Cases build their own worlds and are never kept incrementally.
+  opts.perf.enabled = true;
+  opts.perf.warmupFrames = 1;
+  opts.perf.frames = 5;
+  opts.incremental = true;
+  *builds = 0;
+  auto s = Runner(d, Workdir(root), opts).run(cat, Filter{""}, {});
+  CHECK(s.passed == 2);
+  CHECK(s.timingRegressions == 0);
+  CHECK(*builds == 2);
+
+  std::vector<std::filesystem::path> sidecars;
+  for (const auto &e :
+      std::filesystem::recursive_directory_iterator(root / "results"))
+    if (e.path().extension() == ".json")
+      sidecars.push_back(e.path());
+  REQUIRE(sidecars.size() == 2);
+  for (const auto &path : sidecars) {
+    CaseResult r;
+    REQUIRE(readSidecar(path, r));
+    REQUIRE(r.timing.has_value());
+    CHECK(r.timing->warmupFrames == 1);
+    CHECK(r.timing->frameMs.size() == 5);
+    CHECK(r.timing->buildMs > 0.0);
+    CHECK(r.timing->commitMs > 0.0);
+    CHECK(r.timing->comparisons.empty());
+  }
+
+  // A baseline whose every frame took `ms`, so the comparison is decided.
+  auto writeBaseline = [&](double ms) {
+    std::filesystem::remove_all(baseline, ec);
+    std::filesystem::copy(
+        root, baseline, std::filesystem::copy_options::recursive);
+    for (const auto &path : sidecars) {
+      const auto copy = baseline / std::filesystem::relative(path, root);
+      CaseResult r;
+      REQUIRE(readSidecar(copy, r));
+      r.timing->frameMs.assign(10, ms);
+      r.timing->deviceMs.clear();
+      REQUIRE(writeSidecar(copy, r));
+    }
+  };
+  opts.perf.baseline = baseline;
+
+  SECTION("slower than the baseline fails")
+  {
+    writeBaseline(1e-6);
+    s = Runner(d, Workdir(root), opts).run(cat, Filter{""}, {});
+    CHECK(s.failed == 2);
+    CHECK(s.timingRegressions == 2);
+    CaseResult r;
+    REQUIRE(readSidecar(sidecars[0], r));
+    CHECK(r.verdict == Verdict::Failed);
+    CHECK(r.detail.find("timing regressed: frame median") != std::string::npos);
+    REQUIRE(r.timing.has_value());
+    CHECK(r.timing->baseline == baseline.string());
+    CHECK(timingRegressions(r).size() == 1);
+  }
+
+  SECTION("faster than the baseline passes")
+  {
+    writeBaseline(1e6);
+    s = Runner(d, Workdir(root), opts).run(cat, Filter{""}, {});
+    CHECK(s.passed == 2);
+    CHECK(s.timingRegressions == 0);
+  }
+
+  std::filesystem::remove_all(root, ec);
+  std::filesystem::remove_all(baseline, ec);
+  anari::release(d, d);
+  anari::unloadLibrary(lib);
+}
+
+TEST_CASE("A scaling run measures only scaling Tests and writes their CSV",
+    "[cts][runner][helide]")
+{
+  anari::Library lib = anari::loadLibrary("helide", statusFunc, nullptr);
+  if (!lib) {
+    WARN("helide library not available; skipping scaling run test");
+    return;
+  }
+  anari::Device d = anari::newDevice(lib, "default");
+  REQUIRE(d != nullptr);
+  anari::commitParameters(d, d);
+
+  const auto root = std::filesystem::temp_directory_path() / "cts_scaling_run";
+  std::error_code ec;
+  std::filesystem::remove_all(root, ec);
+
+  Catalog cat;
+  makeTest("geometry", "image").build(buildTriangleWorld).registerInto(cat);
+  makeTest("scaling", "triangles")
+      .build(buildTriangleWorld)
+      .scaling([](BuildContext &ctx) {
+        return ScalingWork{
+            "triangles", uint64_t(ctx.get<int>("primitiveCount", 1))};
+      })
+      .permute("primitiveCount", {4, 16})
+      .registerInto(cat);
+  makeTest("scaling", "resolution")
+      .build(buildTriangleWorld)
+      .scaling([](BuildContext &) { return ScalingWork{"triangles", 1, 8, 4}; })
+      .registerInto(cat);
+
+  RunOptions opts;
+  opts.width = 16;
+  opts.height = 16;
+  opts.device = {"helide", "default", "default"};
+  opts.perf.warmupFrames = 1;
+  opts.perf.frames = 3;
+
+  // Ground truth and ordinary runs leave the scaling Tests alone.
+  auto g = Runner(d, Workdir(root), opts).generate(cat, Filter{""}, {});
+  CHECK(g.passed == 1);
+  auto s = Runner(d, Workdir(root), opts).run(cat, Filter{""}, {});
+  CHECK(s.passed == 1);
+  CHECK_FALSE(std::filesystem::exists(root / "results" / "scaling"));
+
+  opts.scaling.enabled = true;
+  s = Runner(d, Workdir(root), opts).run(cat, Filter{""}, {});
+  CHECK(s.passed == 3);
+  CHECK(s.failed == 0);
+
+  const Workdir wd(root);
+  for (const auto &test : cat.tests()) {
+    if (!test.scaling)
+      continue;
+    for (const Case &c : expand(test)) {
+      CaseResult r;
+      REQUIRE(readSidecar(wd.sidecarPath(c), r));
+      CHECK(r.verdict == Verdict::Passed);
+      REQUIRE(r.scaling.has_value());
+      REQUIRE(r.timing.has_value());
+      CHECK(r.timing->frameMs.size() == 3);
+      CHECK(r.scaling->elements > 0);
+      // The workload's resolution overrides the run's.
+      CHECK(r.scaling->width == (test.name == "resolution" ? 8u : 16u));
+      CHECK(r.scaling->height == (test.name == "resolution" ? 4u : 16u));
+
+      std::ifstream csv(wd.measurementsPath(c));
+      std::string header, row;
+      REQUIRE(std::getline(csv, header));
+      REQUIRE(std::getline(csv, row));
+      CHECK(row.rfind("scaling," + test.name + "," + c.id() + ",triangles,", 0)
+          == 0);
+    }
+  }
+
+  std::filesystem::remove_all(root, ec);
+  anari::release(d, d);
+  anari::unloadLibrary(lib);
+}
@@ -0,0 +1,120 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "catch.hpp"
+// cts
+#include "cts/Scaling.h"
+#include "cts/Sidecar.h"
+// std
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+using namespace anari::cts;
+
+namespace {
+
+CaseResult measured(const std::string &test,
+    const std::string &caseId,
+    uint64_t elements,
+    double buildMs,
+    double frameMs)
+{
+  CaseResult r;
+  r.category = "scaling";
+  r.test = test;
+  r.caseId = caseId;
+  r.verdict = Verdict::Passed;
+  r.scaling = ScalingResult{"spheres", elements, 100, 100, std::nullopt};
+  r.timing.emplace();
+  r.timing->buildMs = buildMs;
+  r.timing->commitMs = buildMs;
+  r.timing->frameMs = {frameMs, frameMs, frameMs};
+  return r;
+}
+
+} // namespace
+
+TEST_CASE("the scaling workload round-trips through the sidecar",
+    "[cts][scaling]")
+{
+  CaseResult r = measured("spheres", "primitiveCount_1000", 1000, 1.0, 2.0);
+  r.scaling->memoryBytes = 64000;
+
+  CaseResult back;
+  REQUIRE(fromJson(toJson(r), back));
+  REQUIRE(back.scaling.has_value());
+  CHECK(back.scaling->unit == "spheres");
+  CHECK(back.scaling->elements == 1000);
+  CHECK(back.scaling->width == 100);
+  CHECK(back.scaling->height == 100);
+  CHECK(back.scaling->memoryBytes == 64000);
+
+  // An unreported memory use stays absent.
+  r.scaling->memoryBytes.reset();
+  REQUIRE(fromJson(toJson(r), back));
+  CHECK_FALSE(back.scaling->memoryBytes.has_value());
+}
+
+TEST_CASE("throughput derives rates from the workload and timings",
+    "[cts][scaling]")
+{
+  CaseResult r = measured("spheres", "a", 1000000, 250.0, 2.0);
+  r.scaling->memoryBytes = 32000000;
+  const Throughput t = throughput(r);
+  // 1e6 spheres over 250 ms build + 250 ms first frame
+  CHECK(t.elementsPerSecond == Approx(2e6));
+  // 100x100 primary rays in 2 ms
+  CHECK(t.mraysPerSecond == Approx(5.0));
+  CHECK(t.bytesPerElement == Approx(32.0));
+
+  r.scaling->memoryBytes.reset();
+  r.timing.reset();
+  const Throughput missing = throughput(r);
+  CHECK(std::isnan(missing.elementsPerSecond));
+  CHECK(std::isnan(missing.mraysPerSecond));
+  CHECK(std::isnan(missing.bytesPerElement));
+}
+
+TEST_CASE("the scaling CSV orders each Test's rows by workload",
+    "[cts][scaling]")
+{
+  std::map<std::string, CaseResult> results;
+  results["scaling/spheres/b"] = measured("spheres", "b", 100000, 10.0, 4.0);
+  results["scaling/spheres/a"] = measured("spheres", "a", 1000, 1.0, 2.0);
+  results["scaling/curves/c"] = measured("curves", "c", 1000, 1.0, 2.0);
+  CaseResult image;
+  image.category = "geometry";
+  results["geometry/sphere/x"] = image; // not a scaling result
+
+  const auto path =
+      std::filesystem::temp_directory_path() / "cts_scaling_test" / "all.csv";
+  std::error_code ec;
+  std::filesystem::remove_all(path.parent_path(), ec);
+  REQUIRE(writeScalingCsv(path, results));
+
+  std::ifstream in(path);
+  std::string line;
+  std::vector<std::string> lines;
+  while (std::getline(in, line))
+    lines.push_back(line);
+  REQUIRE(lines.size() == 4);
+  CHECK(lines[0] == scalingCsvHeader());
+  CHECK(lines[1].rfind("scaling,curves,c,spheres,1000,", 0) == 0);
+  CHECK(lines[2].rfind("scaling,spheres,a,spheres,1000,", 0) == 0);
+  CHECK(lines[3].rfind("scaling,spheres,b,spheres,100000,", 0) == 0);
+  // Every row has the header's columns; the unreported memory cells are empty.
+  for (const auto &l : lines)
+    CHECK(std::count(l.begin(), l.end(), ',') == 15);
+  CHECK(lines[1].substr(lines[1].size() - 2) == ",,");
+
+  std::filesystem::remove_all(path.parent_path(), ec);
+
+  // Text cells holding separators or quotes are quoted
+  CaseResult odd = measured("spheres", "a,\"b\"", 1, 1.0, 1.0);
+  CHECK(scalingCsvRow(odd).rfind("scaling,spheres,\"a,\"\"b\"\"\",", 0) == 0);
+}
@@ -0,0 +1,125 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "catch.hpp"
+// cts
+#include "cts/Sidecar.h"
+#include "cts/Timing.h"
+// std
+#include <cmath>
+#include <vector>
+
+using namespace anari::cts;
+
+namespace {
+
+TimingResult timed(std::vector<double> frameMs)
+{
+  TimingResult t;
+  t.warmupFrames = 2;
+  t.buildMs = 4.0;
+  t.commitMs = 8.0;
+  t.frameMs = std::move(frameMs);
+  return t;
+}
+
+} // namespace
+
+TEST_CASE("median and percentile interpolate between samples", "[cts][timing]")
+{
+  CHECK(median({3.0, 1.0, 2.0}) == 2.0);
+  CHECK(median({4.0, 1.0, 2.0, 3.0}) == 2.5);
+  CHECK(percentile({1.0, 2.0, 3.0, 4.0, 5.0}, 0.0) == 1.0);
+  CHECK(percentile({1.0, 2.0, 3.0, 4.0, 5.0}, 100.0) == 5.0);
+  CHECK(percentile({1.0, 2.0, 3.0, 4.0, 5.0}, 95.0) == Approx(4.8));
+  CHECK(std::isnan(median({})));
+}
+
+TEST_CASE("mannWhitneyGreater detects a shifted sample", "[cts][timing]")
+{
+  const std::vector<double> base = {10.0, 10.4, 9.8, 10.1, 10.3, 9.9, 10.2};
+  std::vector<double> slower;
+  for (double v : base)
+    slower.push_back(v + 2.0);
+
+  CHECK(mannWhitneyGreater(base, slower) < 0.01);
+  // One-sided: a faster candidate is no evidence of a slowdown.
+  CHECK(mannWhitneyGreater(slower, base) > 0.99);
+  // Identical samples are all ties.
+  CHECK(mannWhitneyGreater(base, base) > 0.4);
+  CHECK(mannWhitneyGreater({1.0, 1.0, 1.0}, {1.0, 1.0, 1.0}) == 1.0);
+  // Too few samples to test.
+  CHECK(std::isnan(mannWhitneyGreater({1.0, 2.0}, {3.0, 4.0, 5.0})));
+}
+
+TEST_CASE("compareTiming flags only significant, large slowdowns",
+    "[cts][timing]")
+{
+  const TimingResult base =
+      timed({10.0, 10.4, 9.8, 10.1, 10.3, 9.9, 10.2, 10.0});
+  TimingThresholds thresholds; // 10% median, 25% p95, p < 0.05
+
+  SECTION("a 30% slower run regresses")
+  {
+    std::vector<double> frames;
+    for (double v : base.frameMs)
+      frames.push_back(v * 1.3);
+    const auto cmp = compareTiming(base, timed(frames), thresholds);
+    REQUIRE(cmp.size() == 3); // frame, build, commit; no device durations
+    CHECK(cmp[0].measure == "frame");
+    CHECK(cmp[0].regressed);
+    CHECK(cmp[0].median == Approx(median(base.frameMs) * 1.3));
+    CHECK(describeTiming(cmp[0]).find("frame median") == 0);
+    CHECK(cmp[1].measure == "build");
+    CHECK(std::isnan(cmp[1].pValue));
+    CHECK_FALSE(cmp[1].regressed);
+  }
+
+  SECTION("a consistent 5% slowdown is within tolerance")
+  {
+    std::vector<double> frames;
+    for (double v : base.frameMs)
+      frames.push_back(v * 1.05);
+    const auto cmp = compareTiming(base, timed(frames), thresholds);
+    CHECK(cmp[0].pValue < thresholds.significance);
+    CHECK_FALSE(cmp[0].regressed);
+  }
+
+  SECTION("a single slow outlier is not significant")
+  {
+    std::vector<double> frames = base.frameMs;
+    frames.back() = 40.0;
+    const auto cmp = compareTiming(base, timed(frames), thresholds);
+    CHECK(cmp[0].p95 > cmp[0].baselineP95 * 1.25);
+    CHECK_FALSE(cmp[0].regressed);
+  }
+}
+
+TEST_CASE("timing round-trips through the sidecar", "[cts][timing]")
+{
+  CaseResult r;
+  r.verdict = Verdict::Failed;
+  r.timing = timed({1.0, 2.0, 3.0});
+  r.timing->deviceMs = {0.5, 1.5, 2.5};
+  r.timing->baseline = "baseline_workdir";
+  r.timing->comparisons = compareTiming(*r.timing, *r.timing, {});
+
+  CaseResult back;
+  REQUIRE(fromJson(toJson(r), back));
+  REQUIRE(back.timing.has_value());
+  CHECK(back.timing->warmupFrames == 2);
+  CHECK(back.timing->buildMs == 4.0);
+  CHECK(back.timing->commitMs == 8.0);
+  CHECK(back.timing->frameMs == r.timing->frameMs);
+  CHECK(back.timing->deviceMs == r.timing->deviceMs);
+  CHECK(back.timing->baseline == "baseline_workdir");
+  REQUIRE(back.timing->comparisons.size() == 4);
+  CHECK(back.timing->comparisons[1].measure == "device");
+  // Single samples are untested; their NaN p-value travels as null.
+  CHECK(std::isnan(back.timing->comparisons[2].pValue));
+  CHECK(timingRegressions(back).empty());
+
+  // Results of ordinary runs carry no timing.
+  REQUIRE(fromJson(toJson(CaseResult{}), back));
+  CHECK_FALSE(back.timing.has_value());
+}
@@ -0,0 +1,142 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "catch.hpp"
+
+#include "HandleTable.h"
+#include "anari/ext/debug/DebugObject.h"
+
+// std
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using anari::debug_device::DebugObjectBase;
+using anari::debug_device::GenericDebugObject;
+using anari::debug_device::HandleTable;
+
+ANARIObject wrappedHandle(uintptr_t i)
+{
+  // wrapped devices hand out aligned pointers
+  return ANARIObject(0x10000 + i * 16);
+}
+
+TEST_CASE("HandleTable looks up inserted handles", "[debug_handle_table]")
+{
+  auto table = std::unique_ptr<HandleTable>(new HandleTable);
+
+  ANARIObject a = table->reserve();
+  ANARIObject b = table->reserve();
+  CHECK(uintptr_t(b) == uintptr_t(a) + 1);
+  CHECK(table->size() == 2);
+
+  // Reserved handles are unknown until their info is stored
+  CHECK(table->get(a) == nullptr);
+
+  DebugObjectBase *infoA = new GenericDebugObject;
+  DebugObjectBase *infoB = new GenericDebugObject;
+  table->insert(a, wrappedHandle(1), infoA);
+  table->insert(b, wrappedHandle(2), infoB);
+  CHECK(table->get(a) == infoA);
+  CHECK(table->get(b) == infoB);
+  CHECK(table->find(wrappedHandle(1)) == a);
+  CHECK(table->find(wrappedHandle(2)) == b);
+}
+
+TEST_CASE("HandleTable rejects handles it never gave out",
+    "[debug_handle_table]")
+{
+  auto table = std::unique_ptr<HandleTable>(new HandleTable);
+  ANARIObject a = table->reserve();
+  table->insert(a, wrappedHandle(1), new GenericDebugObject);
+
+  CHECK(table->get(ANARIObject(uintptr_t(a) + 1)) == nullptr);
+  // e.g. a pointer from another device, far beyond the table's capacity
+  CHECK(table->get(ANARIObject(uintptr_t(0x7fff12345678))) == nullptr);
+  CHECK(table->find(wrappedHandle(3)) == nullptr);
+}
+
+TEST_CASE("HandleTable keeps stale handles when wrapped handles are reused",
+    "[debug_handle_table]")
+{
+  auto table = std::unique_ptr<HandleTable>(new HandleTable);
+
+  // The wrapped device freed the first object and reused its handle
+  ANARIObject stale = table->reserve();
+  DebugObjectBase *staleInfo = new GenericDebugObject;
+  table->insert(stale, wrappedHandle(1), staleInfo);
+  ANARIObject fresh = table->reserve();
+  DebugObjectBase *freshInfo = new GenericDebugObject;
+  table->insert(fresh, wrappedHandle(1), freshInfo);
+
+  CHECK(table->find(wrappedHandle(1)) == fresh);
+  // The stale handle still resolves, so calls on it can be reported
+  CHECK(table->get(stale) == staleInfo);
+  CHECK(table->get(fresh) == freshInfo);
+}
+
+TEST_CASE("HandleTable samples calls and caches profile subtypes per handle",
+    "[debug_handle_table]")
+{
+  auto table = std::unique_ptr<HandleTable>(new HandleTable);
+  ANARIObject a = table->reserve();
+  table->insert(a, wrappedHandle(1), new GenericDebugObject);
+  ANARIObject b = table->reserve();
+  table->insert(b, wrappedHandle(2), new GenericDebugObject);
+
+  std::vector<bool> sampled;
+  for (int i = 0; i < 9; ++i)
+    sampled.push_back(table->sample(a, 4));
+  CHECK(sampled
+      == std::vector<bool>{
+          true, false, false, false, true, false, false, false, true});
+  // Each handle counts its own calls
+  CHECK(table->sample(b, 4));
+  CHECK(table->sample(b, 1));
+
+  CHECK(table->profileSubtype(a) == UINT32_MAX);
+  table->setProfileSubtype(a, 7);
+  CHECK(table->profileSubtype(a) == 7);
+  CHECK(table->profileSubtype(b) == UINT32_MAX);
+}
+
+TEST_CASE("HandleTable lookups run while other threads insert",
+    "[debug_handle_table]")
+{
+  auto table = std::unique_ptr<HandleTable>(new HandleTable);
+  const int threadCount = 4;
+  // enough objects to fill several pages of the table
+  const int perThread = 5000;
+  std::atomic<int> failures{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t) {
+    threads.emplace_back([&, t]() {
+      std::vector<ANARIObject> handles;
+      for (int i = 0; i < perThread; ++i) {
+        ANARIObject h = table->reserve();
+        ANARIObject w = wrappedHandle(uintptr_t(t) * perThread + i);
+        DebugObjectBase *info = new GenericDebugObject;
+        table->insert(h, w, info);
+        if (table->get(h) != info || table->find(w) != h)
+          failures++;
+        handles.push_back(h);
+      }
+      for (ANARIObject h : handles) {
+        if (table->get(h) == nullptr)
+          failures++;
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  CHECK(failures == 0);
+  CHECK(table->size() == uint64_t(threadCount * perThread));
+}
+
+} // namespace
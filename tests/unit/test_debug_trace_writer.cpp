@@ -0,0 +1,71 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "catch.hpp"
+
+#include "TraceWriter.h"
+
+// std
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+using anari::debug_device::TraceWriter;
+
+std::vector<char> readFile(const std::string &path)
+{
+  std::ifstream in(path, std::ios::binary);
+  return std::vector<char>(
+      std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// A new blob record: reference 0, its size and its bytes
+std::vector<char> newBlob(const std::vector<char> &contents)
+{
+  std::vector<char> record(2 + contents.size());
+  record[1] = char(contents.size());
+  std::copy(contents.begin(), contents.end(), record.begin() + 2);
+  return record;
+}
+
+TEST_CASE("TraceWriter stores identical blobs once", "[debug_trace_writer]")
+{
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "debug_trace_writer.bin")
+          .string();
+  const std::vector<char> a(40, 'a');
+  std::vector<char> b = a;
+  b.back() = 'b';
+
+  for (uint64_t queueSize : {uint64_t(0), uint64_t(1 << 20)}) {
+    INFO("queue size " << queueSize);
+    {
+      TraceWriter writer;
+      REQUIRE(writer.open(path, queueSize, TraceWriter::POLICY_BLOCK));
+      writer.writeBlob(a.data(), a.size());
+      writer.writeBlob(a.data(), a.size());
+      // same size, different contents
+      writer.writeBlob(b.data(), b.size());
+      writer.writeBlob(b.data(), b.size());
+      writer.close();
+    }
+
+    std::vector<char> expected = newBlob(a);
+    expected.push_back(1);
+    const std::vector<char> second = newBlob(b);
+    expected.insert(expected.end(), second.begin(), second.end());
+    expected.push_back(2);
+    CHECK(readFile(path) == expected);
+  }
+
+  std::remove(path.c_str());
+}
+
+} // namespace
@@ -0,0 +1,115 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+// Runs the debug device over the sink device at each validation level and
+// counts the messages a misused object produces.
+
+#include "catch.hpp"
+
+#include <anari/anari.h>
+
+// std
+#include <cstdint>
+#include <string>
+
+namespace {
+
+struct Messages
+{
+  int errors{0};
+  int warnings{0};
+};
+
+void statusFunc(const void *userData,
+    ANARIDevice,
+    ANARIObject,
+    ANARIDataType,
+    ANARIStatusSeverity severity,
+    ANARIStatusCode,
+    const char *)
+{
+  auto *messages = (Messages *)userData;
+  if (severity <= ANARI_SEVERITY_ERROR)
+    messages->errors++;
+  else if (severity == ANARI_SEVERITY_WARNING)
+    messages->warnings++;
+}
+
+// A debug device at the given level wrapping a sink device, nullptr if either
+// library is missing
+ANARIDevice newDebugDevice(ANARILibrary debugLib,
+    ANARILibrary sinkLib,
+    const char *validation,
+    uint32_t sampleRate)
+{
+  ANARIDevice wrapped = anariNewDevice(sinkLib, "default");
+  if (!wrapped)
+    return nullptr;
+  anariCommitParameters(wrapped, wrapped);
+
+  ANARIDevice d = anariNewDevice(debugLib, "default");
+  anariSetParameter(d, d, "wrappedDevice", ANARI_DEVICE, &wrapped);
+  anariSetParameter(d, d, "validation", ANARI_STRING, validation);
+  anariSetParameter(d, d, "validationSampleRate", ANARI_UINT32, &sampleRate);
+  anariCommitParameters(d, d);
+  anariRelease(wrapped, wrapped);
+  return d;
+}
+
+TEST_CASE("Debug device validation levels", "[debug_validation]")
+{
+  Messages messages;
+  ANARILibrary debugLib = anariLoadLibrary("debug", statusFunc, &messages);
+  ANARILibrary sinkLib = anariLoadLibrary("sink", statusFunc, &messages);
+  if (!debugLib || !sinkLib) {
+    WARN("debug or sink library not available; skipping validation test");
+    if (debugLib)
+      anariUnloadLibrary(debugLib);
+    if (sinkLib)
+      anariUnloadLibrary(sinkLib);
+    return;
+  }
+
+  struct Level
+  {
+    const char *name;
+    // warnings from 8 commits of an object without new parameters
+    int commitWarnings;
+    // errors from a call on a released object
+    int releasedErrors;
+  };
+  const Level levels[] = {
+      {"off", 0, 0},
+      {"handles", 0, 1},
+      {"sampled", 2, 1}, // 1 in 4 calls
+      {"full", 8, 1},
+  };
+
+  for (const Level &level : levels) {
+    SECTION(std::string("validation ") + level.name)
+    {
+      ANARIDevice d = newDebugDevice(debugLib, sinkLib, level.name, 4);
+      REQUIRE(d != nullptr);
+
+      ANARIGeometry geometry = anariNewGeometry(d, "triangle");
+      messages = Messages();
+      for (int i = 0; i < 8; ++i)
+        anariCommitParameters(d, geometry);
+      CHECK(messages.warnings == level.commitWarnings);
+      CHECK(messages.errors == 0);
+
+      // Calls on a released handle are caught at every level but off
+      anariRelease(d, geometry);
+      messages = Messages();
+      anariCommitParameters(d, geometry);
+      CHECK(messages.errors == level.releasedErrors);
+
+      anariRelease(d, d);
+    }
+  }
+
+  anariUnloadLibrary(sinkLib);
+  anariUnloadLibrary(debugLib);
+}
+
+} // namespace
@@ -0,0 +1,75 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "catch.hpp"
+
+#include "helium/ParallelFor.h"
+
+// std
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using helium::tasking::parallelFor;
+using helium::tasking::parallelThreadCount;
+
+TEST_CASE("parallelThreadCount never exceeds the item count",
+    "[helium_ParallelFor]")
+{
+  CHECK(parallelThreadCount(100, 4) == 4);
+  CHECK(parallelThreadCount(3, 4) == 3);
+  CHECK(parallelThreadCount(0, 4) == 0);
+  CHECK(parallelThreadCount(100, 0) >= 1);
+}
+
+TEST_CASE("parallelFor calls every index exactly once", "[helium_ParallelFor]")
+{
+  for (uint32_t threads : {0u, 1u, 4u}) {
+    std::vector<std::atomic<int>> calls(1000);
+    parallelFor(calls.size(), threads, [&](size_t i) { calls[i]++; });
+    int wrong = 0;
+    for (auto &c : calls)
+      wrong += c != 1;
+    CHECK(wrong == 0);
+  }
+  parallelFor(0, 4, [](size_t) { FAIL("no items to call"); });
+}
+
+TEST_CASE("parallelFor passes each thread its own worker index",
+    "[helium_ParallelFor]")
+{
+  const uint32_t threads = parallelThreadCount(1000, 4);
+  std::vector<std::atomic<int>> perWorker(threads);
+  std::atomic<int> outOfRange{0};
+  parallelFor(1000, 4, [&](size_t, uint32_t worker) {
+    if (worker < threads)
+      perWorker[worker]++;
+    else
+      outOfRange++;
+  });
+  CHECK(outOfRange == 0);
+  int total = 0;
+  for (auto &n : perWorker)
+    total += n;
+  CHECK(total == 1000);
+}
+
+TEST_CASE("parallelFor rethrows the first exception once all threads are done",
+    "[helium_ParallelFor]")
+{
+  std::atomic<int> running{0};
+  auto f = [&](size_t i) {
+    running++;
+    if (i == 10)
+      throw std::runtime_error("item 10");
+    running--;
+  };
+  CHECK_THROWS_WITH(parallelFor(1000, 4, f), "item 10");
+  // only the throwing call is left unfinished
+  CHECK(running == 1);
+}
+
+} // namespace
@@ -0,0 +1,143 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+// Checks the bulk parameter extension on a minimal helium device: the
+// functions returned by getProcAddress() reach BaseDevice's native versions,
+// which must leave objects exactly as the DeviceImpl fallback (one
+// setParameter() per value) does.
+
+#include "catch.hpp"
+
+#include "helium_test_device.h"
+
+namespace {
+
+using helium_test::TestDevice;
+using helium_test::TestObject;
+
+SCENARIO("helium::BaseDevice bulk parameter extension",
+    "[helium_bulk_parameters]")
+{
+  GIVEN("A helium device and its bulk parameter functions")
+  {
+    TestDevice device;
+    ANARIDevice d = device.this_device();
+
+    auto setParameters = (PFNANARISETPARAMETERS)device.getProcAddress(
+        "anariSetParameters");
+    auto setParameterOnObjects =
+        (PFNANARISETPARAMETERONOBJECTS)device.getProcAddress(
+            "anariSetParameterOnObjects");
+
+    THEN("Both functions are found, unknown names are not")
+    {
+      REQUIRE(setParameters != nullptr);
+      REQUIRE(setParameterOnObjects != nullptr);
+      REQUIRE(device.getProcAddress("anariSetParametersUnknown") == nullptr);
+    }
+
+    TestObject native(device.state());
+    TestObject fallback(device.state());
+    TestObject other(device.state());
+
+    int count = 3;
+    float scale[2] = {0.5f, 2.f};
+    ANARIObject ref = (ANARIObject)&other;
+    ANARIParameterValue params[] = {{"count", ANARI_INT32, &count},
+        {"scale", ANARI_FLOAT32_VEC2, scale},
+        {"name", ANARI_STRING, "bulk"},
+        {"ref", ANARI_GEOMETRY, &ref}};
+
+    WHEN("Several parameters are set on one object")
+    {
+      setParameters(d, (ANARIObject)&native, params, 4);
+      device.DeviceImpl::setParameters((ANARIObject)&fallback, params, 4);
+
+      THEN("Each value is stored as anariSetParameter() would")
+      {
+        for (auto *o : {&native, &fallback}) {
+          REQUIRE(o->getParam<int>("count", 0) == 3);
+          REQUIRE(o->hasParam("scale", ANARI_FLOAT32_VEC2));
+          REQUIRE(o->getParamString("name", "") == "bulk");
+          REQUIRE(o->getParamObject<helium::BaseObject>("ref") == &other);
+        }
+      }
+
+      THEN("The object is marked changed, but not again for equal values")
+      {
+        auto changed = native.lastParameterChanged();
+        REQUIRE(changed != 0);
+        setParameters(d, (ANARIObject)&native, params, 4);
+        REQUIRE(native.lastParameterChanged() == changed);
+      }
+
+      THEN("A null object value removes the parameter")
+      {
+        ANARIParameterValue unset = {"ref", ANARI_GEOMETRY, nullptr};
+        setParameters(d, (ANARIObject)&native, &unset, 1);
+        REQUIRE(!native.hasParam("ref"));
+      }
+    }
+
+    WHEN("One parameter is set on several objects")
+    {
+      ANARIObject objects[] = {(ANARIObject)&native, (ANARIObject)&fallback};
+      int values[] = {7, 9};
+      setParameterOnObjects(d, objects, 2, "count", ANARI_INT32, values, 4);
+      setParameterOnObjects(d, objects, 2, "shared", ANARI_INT32, values, 0);
+
+      THEN("Each object reads its own value from the strided array")
+      {
+        REQUIRE(native.getParam<int>("count", 0) == 7);
+        REQUIRE(fallback.getParam<int>("count", 0) == 9);
+      }
+
+      THEN("A zero stride shares one value")
+      {
+        REQUIRE(native.getParam<int>("shared", 0) == 7);
+        REQUIRE(fallback.getParam<int>("shared", 0) == 7);
+      }
+
+      THEN("Null object values remove the parameter from every object")
+      {
+        ANARIObject refs[] = {ref, ref};
+        setParameterOnObjects(d,
+            objects,
+            2,
+            "ref",
+            ANARI_GEOMETRY,
+            refs,
+            sizeof(ANARIObject));
+        REQUIRE(native.hasParam("ref"));
+        setParameterOnObjects(d, objects, 2, "ref", ANARI_GEOMETRY, nullptr, 8);
+        REQUIRE(!native.hasParam("ref"));
+        REQUIRE(!fallback.hasParam("ref"));
+
+        device.DeviceImpl::setParameterOnObjects(
+            objects, 2, "ref", ANARI_GEOMETRY, refs, sizeof(ANARIObject));
+        REQUIRE(fallback.hasParam("ref"));
+        device.DeviceImpl::setParameterOnObjects(
+            objects, 2, "ref", ANARI_GEOMETRY, nullptr, 8);
+        REQUIRE(!native.hasParam("ref"));
+        REQUIRE(!fallback.hasParam("ref"));
+      }
+    }
+
+    WHEN("Parameters are set on the device handle")
+    {
+      uint32_t value = 1;
+      ANARIParameterValue param = {"test", ANARI_UINT32, &value};
+      setParameters(d, d, &param, 1);
+
+      THEN("They go to the device like anariSetParameter() does")
+      {
+        REQUIRE(device.getParam<uint32_t>("test", 0) == 1);
+      }
+    }
+
+    native.removeParam("ref");
+    fallback.removeParam("ref");
+  }
+}
+
+} // namespace
@@ -0,0 +1,163 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+// Records command buffers and submits them to a minimal helium device, which
+// applies them natively, and through the DeviceImpl replay fallback.
+
+#include "catch.hpp"
+
+#include "helium_test_device.h"
+
+namespace {
+
+using helium_test::TestDevice;
+using helium_test::TestObject;
+
+// Submits through DeviceImpl::submitCommandBuffer() instead of helium's
+struct ReplayDevice : public TestDevice
+{
+  void submitCommandBuffer(anari::CommandBuffer &buffer) override
+  {
+    anari::DeviceImpl::submitCommandBuffer(buffer);
+  }
+};
+
+template <typename DEVICE_T>
+static void checkSubmission(const char *name)
+{
+  INFO(name);
+  DEVICE_T device;
+  ANARIDevice d = device.this_device();
+
+  ANARI_EXT_command_buffer_interface cb{};
+  REQUIRE(init_ANARI_EXT_command_buffer_interface(d, &cb));
+
+  ANARICommandBuffer buffer = cb.anariNewCommandBuffer();
+
+  // a geometry made outside of the buffer, referenced from inside it
+  auto *existing = new TestObject(device.state(), ANARI_GEOMETRY);
+
+  ANARIObject geometry =
+      cb.anariCommandBufferNewObject(buffer, ANARI_GEOMETRY, "triangle");
+  ANARIObject surface =
+      cb.anariCommandBufferNewObject(buffer, ANARI_SURFACE, nullptr);
+  REQUIRE(geometry != nullptr);
+  REQUIRE(surface != nullptr);
+  REQUIRE(cb.anariCommandBufferNewObject(buffer, ANARI_ARRAY1D, nullptr)
+      == nullptr);
+
+  float color[3] = {1.f, 0.5f, 0.25f};
+  int count = 4;
+  cb.anariCommandBufferSetParameter(
+      buffer, geometry, "color", ANARI_FLOAT32_VEC3, color);
+  cb.anariCommandBufferSetParameter(
+      buffer, geometry, "name", ANARI_STRING, "recorded");
+  cb.anariCommandBufferSetParameter(
+      buffer, geometry, "count", ANARI_INT32, &count);
+  cb.anariCommandBufferSetParameter(
+      buffer, geometry, "stale", ANARI_INT32, &count);
+  cb.anariCommandBufferUnsetParameter(buffer, geometry, "stale");
+  cb.anariCommandBufferCommitParameters(buffer, geometry);
+  cb.anariCommandBufferSetParameter(
+      buffer, surface, "geometry", ANARI_GEOMETRY, &geometry);
+  ANARIObject existingHandle = (ANARIObject)existing;
+  cb.anariCommandBufferSetParameter(
+      buffer, surface, "other", ANARI_GEOMETRY, &existingHandle);
+  cb.anariCommandBufferCommitParameters(buffer, surface);
+
+  // values were copied while recording
+  color[0] = 0.f;
+  count = 0;
+
+  REQUIRE(cb.anariCommandBufferGetObject(buffer, geometry) == nullptr);
+  cb.anariSubmitCommandBuffer(d, buffer);
+
+  auto *g = (TestObject *)cb.anariCommandBufferGetObject(buffer, geometry);
+  auto *s = (TestObject *)cb.anariCommandBufferGetObject(buffer, surface);
+  REQUIRE(g != nullptr);
+  REQUIRE(s != nullptr);
+  REQUIRE(g->type() == ANARI_GEOMETRY);
+  REQUIRE(s->type() == ANARI_SURFACE);
+
+  float stored[3] = {};
+  REQUIRE(g->getParam("color", ANARI_FLOAT32_VEC3, stored));
+  REQUIRE(stored[0] == 1.f);
+  REQUIRE(stored[2] == 0.25f);
+  REQUIRE(g->getParamString("name", "") == "recorded");
+  REQUIRE(g->getParam<int>("count", 0) == 4);
+  REQUIRE(!g->hasParam("stale"));
+  REQUIRE(s->getParamObject<helium::BaseObject>("geometry") == g);
+  REQUIRE(s->getParamObject<helium::BaseObject>("other") == existing);
+
+  device.flushCommits();
+  REQUIRE(g->commits == 1);
+  REQUIRE(s->commits == 1);
+
+  // placeholders stay usable in later recordings of the same buffer
+  count = 8;
+  cb.anariCommandBufferSetParameter(
+      buffer, geometry, "count", ANARI_INT32, &count);
+  cb.anariCommandBufferCommitParameters(buffer, geometry);
+  cb.anariCommandBufferRelease(buffer, surface);
+  cb.anariCommandBufferRelease(buffer, geometry);
+  cb.anariSubmitCommandBuffer(d, buffer);
+  device.flushCommits();
+
+  // released placeholders are recycled instead of growing the buffer
+  REQUIRE(cb.anariCommandBufferGetObject(buffer, geometry) == nullptr);
+  ANARIObject reused =
+      cb.anariCommandBufferNewObject(buffer, ANARI_GEOMETRY, "sphere");
+  REQUIRE((reused == geometry || reused == surface));
+  cb.anariSubmitCommandBuffer(d, buffer);
+  auto *r = (TestObject *)cb.anariCommandBufferGetObject(buffer, reused);
+  REQUIRE(r != nullptr);
+  REQUIRE(r->type() == ANARI_GEOMETRY);
+  cb.anariCommandBufferRelease(buffer, reused);
+  cb.anariSubmitCommandBuffer(d, buffer);
+
+  cb.anariReleaseCommandBuffer(buffer);
+  device.release((ANARIObject)existing);
+}
+
+TEST_CASE("helium::BaseDevice command buffer submission",
+    "[helium_command_buffer]")
+{
+  checkSubmission<TestDevice>("helium native submission");
+  checkSubmission<ReplayDevice>("DeviceImpl replay");
+}
+
+SCENARIO("helium::BaseDevice applies buffers recorded on existing objects",
+    "[helium_command_buffer]")
+{
+  GIVEN("A buffer updating and committing two objects")
+  {
+    TestDevice device;
+    auto *a = new TestObject(device.state());
+    auto *b = new TestObject(device.state());
+
+    anari::CommandBuffer buffer;
+    int value = 1;
+    buffer.setParameter((ANARIObject)a, "value", ANARI_INT32, &value);
+    buffer.commitParameters((ANARIObject)a);
+    buffer.setParameter((ANARIObject)b, "value", ANARI_INT32, &value);
+    buffer.commitParameters((ANARIObject)b);
+
+    WHEN("It is submitted")
+    {
+      device.submitCommandBuffer(buffer);
+
+      THEN("Both objects are committed by the next flush")
+      {
+        device.flushCommits();
+        REQUIRE(a->commits == 1);
+        REQUIRE(b->commits == 1);
+        REQUIRE(b->getParam<int>("value", 0) == 1);
+      }
+    }
+
+    device.release((ANARIObject)a);
+    device.release((ANARIObject)b);
+  }
+}
+
+} // namespace
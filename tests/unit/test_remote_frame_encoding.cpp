@@ -0,0 +1,242 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "catch.hpp"
+
+#include "FrameEncoding.h"
+
+// std
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using remote::AdaptiveEncoder;
+using remote::CompressionFeatures;
+using remote::FrameEncoding;
+using remote::TurboJPEGOptions;
+
+CompressionFeatures features(bool turboJPEG, bool snappy)
+{
+  CompressionFeatures f;
+  f.hasTurboJPEG = turboJPEG;
+  f.hasSNAPPY = snappy;
+  return f;
+}
+
+// Feed the encoder one interactive frame of numBytes that took `seconds` to
+// write, which gives it a bandwidth sample
+void sendFrame(AdaptiveEncoder &encoder, size_t numBytes, double seconds)
+{
+  FrameEncoding enc = encoder.nextEncoding(true, features(true, true));
+  encoder.frameEncoded(enc, numBytes);
+  std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+  encoder.messageWritten(numBytes);
+}
+
+TEST_CASE("FrameEncoding round-trips through its wire format",
+    "[remote_frame_encoding]")
+{
+  FrameEncoding enc;
+  enc.codec = FrameEncoding::SNAPPY;
+  enc.quality = 42;
+  enc.subsampling = (uint32_t)TurboJPEGOptions::Subsampling::S420;
+  enc.downscale = 4;
+  enc.interactive = 0;
+  enc.frameSeq = 0x0123456789abcdefull;
+
+  uint8_t wire[remote::frameEncodingWireSize];
+  std::memset(wire, 0xff, sizeof(wire));
+  remote::packFrameEncoding(enc, wire);
+
+  FrameEncoding decoded;
+  remote::unpackFrameEncoding(wire, decoded);
+  CHECK(decoded.codec == enc.codec);
+  CHECK(decoded.quality == enc.quality);
+  CHECK(decoded.subsampling == enc.subsampling);
+  CHECK(decoded.downscale == enc.downscale);
+  CHECK(decoded.interactive == enc.interactive);
+  CHECK(decoded.frameSeq == enc.frameSeq);
+  CHECK(remote::sameQuality(decoded, enc));
+
+  decoded.quality = 43;
+  CHECK_FALSE(remote::sameQuality(decoded, enc));
+}
+
+TEST_CASE("AdaptiveEncoder picks codecs by mode and what both sides support",
+    "[remote_frame_encoding]")
+{
+  AdaptiveEncoder encoder;
+
+  SECTION("fixed mode always uses JPEG when available")
+  {
+    encoder.adaptive = false;
+    CHECK(encoder.nextEncoding(true, features(true, true)).codec
+        == FrameEncoding::TurboJPEG);
+    CHECK(encoder.nextEncoding(false, features(true, true)).codec
+        == FrameEncoding::TurboJPEG);
+    CHECK(encoder.nextEncoding(true, features(false, true)).codec
+        == FrameEncoding::Raw);
+  }
+
+  SECTION("idle frames are lossless and full resolution")
+  {
+    FrameEncoding enc = encoder.nextEncoding(false, features(true, true));
+    CHECK(enc.codec == FrameEncoding::SNAPPY);
+    CHECK(enc.downscale == 1);
+    CHECK(enc.interactive == 0);
+    CHECK(encoder.nextEncoding(false, features(true, false)).codec
+        == FrameEncoding::Raw);
+  }
+
+  SECTION("interactive frames start out like the fixed mode")
+  {
+    FrameEncoding enc = encoder.nextEncoding(true, features(true, true));
+    CHECK(enc.codec == FrameEncoding::TurboJPEG);
+    CHECK(enc.quality == 80);
+    CHECK(enc.downscale == 1);
+    CHECK(enc.interactive == 1);
+
+    AdaptiveEncoder lossless;
+    enc = lossless.nextEncoding(true, features(false, true));
+    CHECK(enc.codec == FrameEncoding::SNAPPY);
+    CHECK(enc.downscale == 1);
+  }
+
+  SECTION("frames are numbered in order")
+  {
+    uint64_t first = encoder.nextEncoding(true, features(true, true)).frameSeq;
+    CHECK(encoder.nextEncoding(false, features(true, true)).frameSeq
+        == first + 1);
+  }
+}
+
+TEST_CASE("AdaptiveEncoder trades quality for the measured bandwidth",
+    "[remote_frame_encoding]")
+{
+  AdaptiveEncoder encoder;
+  const size_t frameBytes = 1024 * 1024;
+
+  SECTION("frames larger than the frame budget lower the quality")
+  {
+    // Far more frames than a 1 MiB frame per millisecond can carry
+    encoder.targetFrameRate = 1e6f;
+    sendFrame(encoder, frameBytes, 1e-3);
+    REQUIRE(encoder.linkStats().bandwidth > 0.0);
+
+    int previous = encoder.nextEncoding(true, features(true, true)).quality;
+    CHECK(previous < 80);
+    for (int i = 0; i < 16; ++i)
+      encoder.nextEncoding(true, features(true, true));
+
+    // Bottoms out at the smallest encoding
+    FrameEncoding enc = encoder.nextEncoding(true, features(true, true));
+    CHECK(enc.quality == 30);
+    CHECK(enc.downscale == 4);
+  }
+
+  SECTION("frames well within the budget raise the quality")
+  {
+    encoder.targetFrameRate = 1e-3f;
+    sendFrame(encoder, frameBytes, 1e-3);
+    REQUIRE(encoder.linkStats().bandwidth > 0.0);
+
+    CHECK(encoder.nextEncoding(true, features(true, true)).quality == 90);
+  }
+}
+
+TEST_CASE("AdaptiveEncoder measures latency from acknowledged frames",
+    "[remote_frame_encoding]")
+{
+  AdaptiveEncoder encoder;
+  FrameEncoding first = encoder.nextEncoding(true, features(true, true));
+  encoder.frameEncoded(first, 100);
+  FrameEncoding second = encoder.nextEncoding(true, features(true, true));
+  encoder.frameEncoded(second, 100);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  // Acknowledging the second frame skips the first one
+  encoder.frameAcknowledged(second.frameSeq);
+  double latency = encoder.linkStats().latency;
+  CHECK(latency >= 2e-3);
+
+  // Unknown and repeated acknowledgements are ignored
+  encoder.frameAcknowledged(first.frameSeq);
+  encoder.frameAcknowledged(second.frameSeq);
+  CHECK(encoder.linkStats().latency == latency);
+}
+
+TEST_CASE("encodeColor and decodeColor round-trip raw and downscaled images",
+    "[remote_frame_encoding]")
+{
+  const uint32_t width = 5;
+  const uint32_t height = 3;
+  std::vector<uint8_t> color(width * height * 4);
+  for (size_t i = 0; i < color.size(); ++i)
+    color[i] = uint8_t(i * 7);
+
+  SECTION("raw")
+  {
+    FrameEncoding enc;
+    enc.codec = FrameEncoding::Raw;
+    std::vector<uint8_t> payload;
+    REQUIRE(remote::encodeColor(
+        color.data(), width, height, ANARI_UFIXED8_VEC4, enc, payload));
+    CHECK(payload.size() == color.size());
+
+    std::vector<uint8_t> decoded(color.size());
+    REQUIRE(remote::decodeColor(payload.data(),
+        payload.size(),
+        enc,
+        width,
+        height,
+        ANARI_UFIXED8_VEC4,
+        decoded.data()));
+    CHECK(decoded == color);
+  }
+
+  SECTION("downscaled by a box filter, upscaled to the full size")
+  {
+    std::vector<uint8_t> flat(width * height * 4, 0);
+    for (size_t i = 0; i < flat.size(); i += 4)
+      flat[i] = (i / 4) % 2 ? 200 : 100; // alternating red
+
+    FrameEncoding enc;
+    enc.codec = FrameEncoding::Raw;
+    enc.downscale = 2;
+    std::vector<uint8_t> payload;
+    REQUIRE(remote::encodeColor(
+        flat.data(), width, height, ANARI_UFIXED8_VEC4, enc, payload));
+    CHECK(enc.downscale == 2);
+    CHECK(payload.size() == 3 * 2 * 4); // 5x3 rounds up to 3x2
+
+    std::vector<uint8_t> decoded(flat.size());
+    REQUIRE(remote::decodeColor(payload.data(),
+        payload.size(),
+        enc,
+        width,
+        height,
+        ANARI_UFIXED8_VEC4,
+        decoded.data()));
+    // The top-left 2x2 block averages 100, 200, 200 and 100
+    CHECK(decoded[0] == 150);
+    CHECK(decoded[4 * (width + 1)] == 150);
+  }
+
+  SECTION("types that cannot be downscaled are sent at full size")
+  {
+    std::vector<uint8_t> ids(width * height * 4, 1);
+    FrameEncoding enc;
+    enc.codec = FrameEncoding::Raw;
+    enc.downscale = 2;
+    std::vector<uint8_t> payload;
+    REQUIRE(remote::encodeColor(
+        ids.data(), width, height, ANARI_UINT32, enc, payload));
+    CHECK(enc.downscale == 1);
+    CHECK(payload == ids);
+  }
+}
+
+} // namespace
@@ -0,0 +1,97 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "catch.hpp"
+
+#include "async/shared_memory.h"
+
+// std
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using async::shared_ring;
+using async::shared_ring_pointer;
+using async::shared_segment;
+
+std::vector<char> makeData(size_t size, char seed)
+{
+  std::vector<char> data(size);
+  for (size_t i = 0; i < size; ++i)
+    data[i] = char(seed + i);
+  return data;
+}
+
+bool holds(shared_ring &ring, uint64_t begin, const std::vector<char> &data)
+{
+  char *stored = ring.acquire(begin, begin + data.size());
+  return stored && std::memcmp(stored, data.data(), data.size()) == 0;
+}
+
+TEST_CASE("shared_ring only opens with the creator's nonce",
+    "[remote_shared_memory]")
+{
+  shared_ring_pointer consumer = shared_ring::create(1024);
+  if (!consumer) {
+    WARN("shared memory not available; skipping shared_ring test");
+    return;
+  }
+
+  boost::uuids::uuid wrong = consumer->nonce();
+  wrong.data[0] ^= 1;
+  CHECK_FALSE(shared_ring::open(consumer->name(), wrong));
+  CHECK(shared_ring::open(consumer->name(), consumer->nonce()));
+
+  shared_segment::unlink(consumer->name());
+  CHECK_FALSE(shared_ring::open(consumer->name(), consumer->nonce()));
+}
+
+TEST_CASE("shared_ring wraps around once space is released in order",
+    "[remote_shared_memory]")
+{
+  shared_ring_pointer consumer = shared_ring::create(1024);
+  if (!consumer) {
+    WARN("shared memory not available; skipping shared_ring test");
+    return;
+  }
+  shared_ring_pointer producer =
+      shared_ring::open(consumer->name(), consumer->nonce());
+  shared_segment::unlink(consumer->name());
+  REQUIRE(producer);
+  REQUIRE(producer->capacity() == 1024);
+
+  const auto a = makeData(400, 'a');
+  const auto b = makeData(400, 'b');
+  const auto c = makeData(400, 'c');
+
+  uint64_t beginA = 0, beginB = 0, beginC = 0;
+  REQUIRE(producer->write(a.data(), a.size(), beginA));
+  REQUIRE(producer->write(b.data(), b.size(), beginB));
+  CHECK(beginA == 0);
+  CHECK(beginB == 400);
+
+  // Messages are stored contiguously, so c must wrap to the start, where a
+  // still is
+  CHECK_FALSE(producer->write(c.data(), c.size(), beginC));
+  CHECK_FALSE(producer->write(c.data(), 2048, beginC));
+
+  REQUIRE(holds(*consumer, beginA, a));
+  REQUIRE(holds(*consumer, beginB, b));
+
+  // Space only goes back to the producer in order
+  consumer->release(beginB);
+  CHECK_FALSE(producer->write(c.data(), c.size(), beginC));
+  consumer->release(beginA);
+  REQUIRE(producer->write(c.data(), c.size(), beginC));
+  CHECK(beginC == 1024);
+  CHECK(holds(*consumer, beginC, c));
+
+  // A range may not cross the end of the ring or overlap an acquired one
+  CHECK(consumer->acquire(900, 1100) == nullptr);
+  CHECK(consumer->acquire(beginC, beginC + 10) == nullptr);
+  consumer->release(beginC);
+}
+
+} // namespace
@@ -0,0 +1,151 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "catch.hpp"
+
+#include "TileDiff.h"
+
+// std
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using remote::TileDiff;
+using remote::TileMask;
+using remote::tileSize;
+
+// A 70x40 RGBA8 image is 3x2 tiles; the right column and the bottom row of
+// tiles are cut off at the border
+constexpr uint32_t width = 70;
+constexpr uint32_t height = 40;
+
+std::vector<uint8_t> makeImage()
+{
+  std::vector<uint8_t> image(width * height * 4);
+  for (size_t i = 0; i < image.size(); ++i)
+    image[i] = uint8_t(i * 31 + i / 4);
+  return image;
+}
+
+void touch(std::vector<uint8_t> &image, uint32_t x, uint32_t y)
+{
+  image[(size_t(y) * width + x) * 4] ^= 0xff;
+}
+
+TEST_CASE("TileMask counts and tests tiles", "[remote_tile_diff]")
+{
+  TileMask mask;
+  mask.resize(width, height);
+  CHECK(mask.tilesX == 3);
+  CHECK(mask.tilesY == 2);
+  CHECK(mask.numTiles() == 6);
+  CHECK(mask.count() == 0);
+
+  mask.set(0);
+  mask.set(5);
+  CHECK(mask.test(0));
+  CHECK_FALSE(mask.test(1));
+  CHECK(mask.test(5));
+  CHECK(mask.count() == 2);
+
+  mask.clear();
+  CHECK(mask.count() == 0);
+}
+
+TEST_CASE("TileDiff finds the tiles that changed", "[remote_tile_diff]")
+{
+  TileDiff diff;
+  TileMask mask;
+  auto image = makeImage();
+
+  // Nothing to compare the first image to
+  CHECK_FALSE(
+      diff.update(image.data(), width, height, ANARI_UFIXED8_VEC4, mask));
+
+  SECTION("an unchanged image needs no tiles")
+  {
+    CHECK(diff.update(image.data(), width, height, ANARI_UFIXED8_VEC4, mask));
+    CHECK(mask.count() == 0);
+  }
+
+  SECTION("changed pixels mark their tiles, including border tiles")
+  {
+    touch(image, 33, 0); // tile 1
+    touch(image, 69, 39); // tile 5, the cut-off corner
+    REQUIRE(
+        diff.update(image.data(), width, height, ANARI_UFIXED8_VEC4, mask));
+    CHECK(mask.count() == 2);
+    CHECK(mask.test(1));
+    CHECK(mask.test(5));
+
+    // The changes became the new reference
+    CHECK(diff.update(image.data(), width, height, ANARI_UFIXED8_VEC4, mask));
+    CHECK(mask.count() == 0);
+  }
+
+  SECTION("the full image is sent when most tiles changed")
+  {
+    for (uint32_t tile = 0; tile < 5; ++tile)
+      touch(image, (tile % 3) * tileSize, (tile / 3) * tileSize);
+    CHECK_FALSE(
+        diff.update(image.data(), width, height, ANARI_UFIXED8_VEC4, mask));
+  }
+
+  SECTION("a new size or type starts over")
+  {
+    CHECK_FALSE(diff.update(
+        image.data(), width, height / 2, ANARI_UFIXED8_VEC4, mask));
+    CHECK_FALSE(
+        diff.update(image.data(), width / 2, height, ANARI_FLOAT32, mask));
+  }
+
+  SECTION("reset starts over")
+  {
+    diff.reset();
+    CHECK_FALSE(
+        diff.update(image.data(), width, height, ANARI_UFIXED8_VEC4, mask));
+  }
+}
+
+TEST_CASE("gatherTiles and scatterTiles move tiles through a padded strip",
+    "[remote_tile_diff]")
+{
+  const size_t pixelSize = 4;
+  auto image = makeImage();
+
+  TileMask mask;
+  mask.resize(width, height);
+  mask.set(2); // top right, 6 pixels wide
+  mask.set(3); // bottom left, 8 pixels high
+
+  std::vector<uint8_t> strip;
+  remote::gatherTiles(image.data(), width, height, pixelSize, mask, strip);
+  REQUIRE(strip.size() == 2 * tileSize * tileSize * pixelSize);
+
+  // Border tiles repeat their last column and row
+  auto stripPixel = [&](uint32_t tile, uint32_t x, uint32_t y) {
+    return strip[((size_t(tile) * tileSize + y) * tileSize + x) * pixelSize];
+  };
+  auto imagePixel = [&](uint32_t x, uint32_t y) {
+    return image[(size_t(y) * width + x) * pixelSize];
+  };
+  CHECK(stripPixel(0, 5, 3) == imagePixel(69, 3));
+  CHECK(stripPixel(0, 31, 3) == imagePixel(69, 3));
+  CHECK(stripPixel(1, 4, 7) == imagePixel(4, 39));
+  CHECK(stripPixel(1, 4, 31) == imagePixel(4, 39));
+
+  std::vector<uint8_t> copy(image.size(), 0);
+  remote::scatterTiles(
+      strip.data(), width, height, pixelSize, mask, copy.data());
+  for (uint32_t y = 0; y < height; ++y) {
+    for (uint32_t x = 0; x < width; ++x) {
+      uint32_t tile = (y / tileSize) * mask.tilesX + x / tileSize;
+      INFO("pixel " << x << ", " << y);
+      CHECK(copy[(size_t(y) * width + x) * pixelSize]
+          == (mask.test(tile) ? imagePixel(x, y) : 0));
+    }
+  }
+}
+
+} // namespace
@@ -0,0 +1,95 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "catch.hpp"
+// anari_test_scenes
+#include "anari_test_scenes.h"
+#include "scenes/AnimationClock.h"
+// std
+#include <vector>
+
+using anari::scenes::AnimationClock;
+namespace math = anari::math;
+
+TEST_CASE("A fixed-step animation clock replays the same frames",
+    "[scenes_animation]")
+{
+  AnimationClock clock;
+  auto record = [&](std::uint32_t seed) {
+    clock.reset(0.02f, seed);
+    std::vector<float> times;
+    std::vector<std::uint32_t> draws;
+    for (int i = 0; i < 100; ++i) {
+      CHECK(clock.advance() == Approx(0.02f));
+      times.push_back(clock.time());
+      draws.push_back(clock.rng()());
+    }
+    return std::make_pair(times, draws);
+  };
+
+  const auto first = record(7);
+  CHECK(clock.fixedStep());
+  CHECK(clock.frame() == 100);
+  CHECK(first.first.back() == Approx(2.f));
+
+  const auto again = record(7);
+  CHECK(first.first == again.first);
+  CHECK(first.second == again.second);
+
+  // The seed changes the random sequence but not the time base.
+  const auto reseeded = record(8);
+  CHECK(first.first == reseeded.first);
+  CHECK(first.second != reseeded.second);
+}
+
+TEST_CASE("A zero time step follows the wall clock", "[scenes_animation]")
+{
+  AnimationClock clock;
+  clock.reset(0.f, 0);
+  CHECK_FALSE(clock.fixedStep());
+  CHECK(clock.time() == 0.f);
+  CHECK(clock.advance() >= 0.f);
+  CHECK(clock.frame() == 1);
+}
+
+TEST_CASE("Camera paths loop around the scene bounds", "[scenes_animation]")
+{
+  const anari::scenes::Bounds bounds = {
+      math::float3(-1.f, 0.f, -1.f), math::float3(1.f, 2.f, 1.f)};
+  const math::float3 center(0.f, 1.f, 0.f);
+  const float distance = math::length(bounds[1] - bounds[0]);
+
+  for (const auto &path : anari::scenes::getAvailableCameraPaths()) {
+    DYNAMIC_SECTION(path)
+    {
+      const auto start = anari::scenes::getCameraPathPose(bounds, path, 0.f);
+      // Every path starts at the default view from +Z and loops back to it.
+      CHECK(start.position.x == Approx(0.f).margin(1e-5));
+      CHECK(start.position.z == Approx(distance));
+      const auto looped = anari::scenes::getCameraPathPose(bounds, path, 1.f);
+      CHECK(looped.position.x == Approx(start.position.x).margin(1e-4));
+      CHECK(looped.position.y == Approx(start.position.y).margin(1e-4));
+      CHECK(looped.position.z == Approx(start.position.z).margin(1e-4));
+
+      for (float phase : {0.1f, 0.25f, 0.6f}) {
+        const auto pose = anari::scenes::getCameraPathPose(bounds, path, phase);
+        CHECK(pose.at == center);
+        const math::float3 toCenter = center - pose.position;
+        CHECK(math::length(pose.direction) == Approx(1.f));
+        CHECK(math::dot(pose.direction, toCenter)
+            == Approx(math::length(toCenter)));
+        // Poses are pure functions of the phase.
+        const auto replay =
+            anari::scenes::getCameraPathPose(bounds, path, phase);
+        CHECK(replay.position == pose.position);
+      }
+    }
+  }
+
+  const auto orbit =
+      anari::scenes::getCameraPathPose(bounds, "orbit", 0.25f);
+  CHECK(orbit.position.x == Approx(distance));
+  CHECK(orbit.position.y == Approx(center.y));
+  const auto dolly = anari::scenes::getCameraPathPose(bounds, "dolly", 0.5f);
+  CHECK(math::length(dolly.position - center) == Approx(0.5f * distance));
+}
@@ -0,0 +1,84 @@
+// Copyright 2021-2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "catch.hpp"
+// anari_test_scenes
+#include "generators/PrimitiveGenerator.h"
+// std
+#include <cstring>
+
+using anari::scenes::PrimitiveGenerator;
+
+namespace {
+
+template <typename T>
+bool sameBits(const std::vector<T> &a, const std::vector<T> &b)
+{
+  return a.size() == b.size()
+      && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+// more primitives than one parallel chunk, so several threads take part
+constexpr size_t primitiveCount = 200000;
+
+} // namespace
+
+TEST_CASE("Parallel generation does not depend on the thread count",
+    "[scenes_generators]")
+{
+  PrimitiveGenerator serial(7);
+  serial.setThreadCount(1);
+  PrimitiveGenerator threaded(7);
+  threaded.setThreadCount(5);
+
+  SECTION("spheres")
+  {
+    auto [p1, r1] = serial.generateSpheresParallel(primitiveCount);
+    auto [p2, r2] = threaded.generateSpheresParallel(primitiveCount);
+    REQUIRE(p1.size() == primitiveCount);
+    REQUIRE(sameBits(p1, p2));
+    REQUIRE(sameBits(r1, r2));
+  }
+
+  SECTION("triangles")
+  {
+    REQUIRE(sameBits(serial.generateTrianglesParallel(primitiveCount),
+        threaded.generateTrianglesParallel(primitiveCount)));
+  }
+
+  SECTION("cylinders")
+  {
+    auto [p1, r1, c1] = serial.generateCylindersParallel(primitiveCount, 1);
+    auto [p2, r2, c2] = threaded.generateCylindersParallel(primitiveCount, 1);
+    REQUIRE(p1.size() == primitiveCount * 2);
+    REQUIRE(c1.size() == primitiveCount);
+    REQUIRE(sameBits(p1, p2));
+    REQUIRE(sameBits(r1, r2));
+  }
+}
+
+TEST_CASE("Parallel generation stays in the serial value ranges",
+    "[scenes_generators]")
+{
+  PrimitiveGenerator generator(0);
+
+  auto [positions, radii] = generator.generateSpheresParallel(1000);
+  for (size_t i = 0; i < positions.size(); ++i) {
+    REQUIRE(positions[i].x >= 0.f);
+    REQUIRE(positions[i].x < 1.f);
+    REQUIRE(radii[i] >= 0.f);
+    REQUIRE(radii[i] < 0.4f);
+  }
+
+  // the fourth corner of a quad completes the parallelogram
+  auto quads = generator.generateQuadsParallel(100);
+  for (size_t i = 0; i < quads.size(); i += 4) {
+    const auto d = (quads[i] + quads[i + 2]) - (quads[i + 1] + quads[i + 3]);
+    REQUIRE(anari::math::length(d) < 1e-5f);
+  }
+
+  // different seeds give different primitives
+  PrimitiveGenerator other(1);
+  REQUIRE(!sameBits(generator.generateTrianglesParallel(100),
+      other.generateTrianglesParallel(100)));
+}
@@ -0,0 +1,164 @@
+// Copyright 2026 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "catch.hpp"
+// anari_test_scenes
+#include "scenes/file/SceneCache.h"
+// std
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+using anari::scenes::SceneCache;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void writeFile(const fs::path &file, const std::string &contents)
+{
+  std::ofstream out(file, std::ios::out | std::ios::binary);
+  out << contents;
+}
+
+} // namespace
+
+SCENARIO("SceneCache stores loader output next to its source file",
+    "[scenes_cache]")
+{
+  const fs::path dir = fs::temp_directory_path() / "anari_scene_cache_test";
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+  const fs::path source = dir / "scene.obj";
+  writeFile(source, "v 0 0 0\n");
+
+#ifdef _WIN32
+  _putenv_s("ANARI_SCENE_CACHE_DIR", (dir / "cache").string().c_str());
+#else
+  setenv("ANARI_SCENE_CACHE_DIR", (dir / "cache").string().c_str(), 1);
+#endif
+
+  GIVEN("A cache written by a loader")
+  {
+    SceneCache written(source.string(), "test", 1);
+    REQUIRE(written.enabled());
+    REQUIRE(!written.load());
+
+    // two float3 elements
+    written.add("positions",
+        ANARI_FLOAT32_VEC3,
+        std::vector<float>{0.f, 1.f, 2.f, 3.f, 4.f, 5.f});
+    written.addString("name", "scene");
+    REQUIRE(written.save());
+
+    THEN("The next load of the unchanged file maps the same blobs")
+    {
+      SceneCache read(source.string(), "test", 1);
+      REQUIRE(read.load());
+
+      uint64_t count = 0;
+      const float *p = read.getData<float>("positions", &count);
+      REQUIRE(count == 6);
+      REQUIRE(p[5] == 5.f);
+      REQUIRE(reinterpret_cast<uintptr_t>(p) % 64 == 0);
+      REQUIRE(read.get("positions")->type == ANARI_FLOAT32_VEC3);
+      REQUIRE(read.get("positions")->size[0] == 2);
+      REQUIRE(read.get("name")->size[0] == 5);
+      REQUIRE(read.getString("name") == "scene");
+      REQUIRE(read.get("missing") == nullptr);
+    }
+
+    THEN("Another loader version does not use it")
+    {
+      SceneCache read(source.string(), "test", 2);
+      REQUIRE(!read.load());
+    }
+
+    THEN("A changed source file does not use it")
+    {
+      writeFile(source, "v 0 0 0\nv 1 0 0\n");
+      SceneCache read(source.string(), "test", 1);
+      REQUIRE(!read.load());
+      REQUIRE(read.get("positions") == nullptr);
+    }
+  }
+
+  GIVEN("A cache with a blob too small for the array it describes")
+  {
+    auto floats = std::make_shared<std::vector<float>>(6, 1.f);
+    SceneCache written(source.string(), "test", 1);
+    written.add("positions",
+        ANARI_FLOAT32_VEC3,
+        3,
+        1,
+        std::shared_ptr<const void>(floats, floats->data()),
+        floats->size() * sizeof(float));
+    REQUIRE(written.save());
+
+    THEN("It is not used")
+    {
+      SceneCache read(source.string(), "test", 1);
+      REQUIRE(!read.load());
+      REQUIRE(read.get("positions") == nullptr);
+    }
+  }
+
+  GIVEN("A cache of a source file that reads other files")
+  {
+    const fs::path library = dir / "scene.mtl";
+    const fs::path texture = dir / "texture.png";
+    writeFile(library, "newmtl a\n");
+
+    SceneCache written(source.string(), "test", 1);
+    written.addString("name", "scene");
+    written.addDependency(library.string());
+    written.addDependency(texture.string()); // missing
+    REQUIRE(written.save());
+
+    THEN("It is used while they are unchanged")
+    {
+      SceneCache read(source.string(), "test", 1);
+      REQUIRE(read.load());
+      // and keeps them when saved again
+      REQUIRE(read.save());
+      SceneCache again(source.string(), "test", 1);
+      REQUIRE(again.load());
+    }
+
+    THEN("A changed dependency does not use it")
+    {
+      writeFile(library, "newmtl a\nKd 1 0 0\n");
+      SceneCache read(source.string(), "test", 1);
+      REQUIRE(!read.load());
+    }
+
+    THEN("A missing dependency that appeared does not use it")
+    {
+      writeFile(texture, "png");
+      SceneCache read(source.string(), "test", 1);
+      REQUIRE(!read.load());
+    }
+  }
+
+  GIVEN("No cache directory")
+  {
+#ifdef _WIN32
+    _putenv_s("ANARI_SCENE_CACHE_DIR", "");
+#else
+    unsetenv("ANARI_SCENE_CACHE_DIR");
+#endif
+
+    THEN("Caching is off")
+    {
+      SceneCache cache(source.string(), "test", 1);
+      REQUIRE(!cache.enabled());
+      REQUIRE(!cache.load());
+      REQUIRE(!cache.save());
+    }
+  }
+
+  fs::remove_all(dir);
+}